@@ -1,14 +1,20 @@
 #ifndef AUDIO_AUDIO_ENGINE_H
 #define AUDIO_AUDIO_ENGINE_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include "audio/audio_buffer.h"
 #include "audio/audio_format.h"
+#include "audio/dsp/dither.h"
+#include "audio/dsp/volume_control.h"
 
 // 前向声明
 namespace core {
+class AudioAutomation;
 class EqualizerConfig;
+class MetadataCache;
 }
 
 namespace audio {
@@ -19,9 +25,12 @@ public:
     // 获取单例实例
     static std::shared_ptr<AudioEngine> instance();
     
-    // 初始化音频引擎
+    // 初始化音频引擎（先从配置文件读取各线程角色的调度策略）
     bool initialize();
     
+    // 设置initialize()读取线程调度策略的配置文件（默认config/default.json）
+    void set_config_file(const std::string& filename);
+    
     // 清理资源
     void cleanup();
     
@@ -34,6 +43,41 @@ public:
     // 设置音量（0.0 - 1.0）
     bool set_volume(float volume);
     
+    // 设置回放增益（来自响度扫描结果：增益dB与真峰值，增益受峰值限制不削波）
+    bool set_replay_gain(float gain_db, float peak);
+    
+    // 清除回放增益
+    void clear_replay_gain();
+    
+    // 获取线性回放增益（未设置时为1）
+    float get_replay_gain() const;
+    
+    // 从元数据缓存读取响度扫描结果并设置回放增益（album为真时优先专辑增益），
+    // 缓存中没有结果时清除回放增益并返回false
+    bool load_replay_gain(const core::MetadataCache& cache, const std::string& path, bool album = false);
+    
+    // 设置加载曲目时读取回放增益的元数据缓存（为空时不使用回放增益）
+    void set_metadata_cache(std::shared_ptr<const core::MetadataCache> cache, bool album = false);
+    
+    // 加载曲目：时间线位置归零，并按元数据缓存中的扫描结果设置回放增益
+    bool load_track(const std::string& path);
+    
+    // 设置音量自动化：parameter通道的值作为逐帧增益与音量、回放增益相乘（automation为空时取消）。
+    // 通道按时间线位置渲染，编辑通过AudioAutomation::commit()发布；不得与play_audio同时调用
+    void set_volume_automation(std::shared_ptr<core::AudioAutomation> automation, size_t parameter);
+    
+    // 获取时间线位置（已输出的帧数，停止播放时归零）
+    uint64_t get_position() const;
+    
+    // 获取最近一块的浮点输出（音量与自动化之后、设备格式转换之前）
+    const AudioBuffer& get_output() const;
+    
+    // 获取最近一块的设备格式输出（整数与双精度设备格式）
+    const std::vector<uint8_t>& get_device_buffer() const;
+    
+    // 设置输出抖动与噪声整形（16/24位设备格式，默认TPDF无整形）
+    bool set_dither(bool enabled, dsp::Dither::NoiseShaping shaping);
+    
     // 获取当前状态
     std::string get_status() const;
     
@@ -69,6 +113,33 @@ public:
     
     // 设置设备管理器
     void set_device_manager(std::shared_ptr<DeviceManager> manager);
+    
+private:
+    std::string config_file_;   // 线程调度策略的配置文件
+    
+    float replay_gain_;   // 线性回放增益，与音量合并为一个输出增益
+    
+    // 加载曲目时读取回放增益的元数据缓存
+    std::shared_ptr<const core::MetadataCache> metadata_cache_;
+    bool album_gain_;
+    
+    // 输出音量（带斜坡）
+    dsp::VolumeControl volume_control_;
+    
+    // 整数设备格式的抖动与噪声整形
+    dsp::Dither dither_;
+    
+    // 输出缓冲（按最大块长复用）
+    AudioBuffer output_buffer_;
+    std::vector<uint8_t> device_buffer_;   // 整数与双精度设备格式输出
+    
+    // 音量自动化
+    std::shared_ptr<core::AudioAutomation> volume_automation_;
+    size_t volume_parameter_;
+    std::vector<float> automation_gains_;   // 本块渲染的逐帧增益（按最大块长复用）
+    
+    // 时间线位置
+    uint64_t position_;
 };
 
 } // namespace audio
@@ -0,0 +1,63 @@
+#ifndef AUDIO_DSP_DITHER_H
+#define AUDIO_DSP_DITHER_H
+
+#include "audio/audio_format.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+namespace dsp {
+
+// 输出抖动级：浮点交错样本降位深到16/24位整数时叠加TPDF抖动，可选误差反馈噪声整形。
+// 按块处理：多路xorshift并行生成噪声并叠加，整形后直接调用SIMD转换内核写出，
+// 抖动与格式转换在同一遍内完成。32位整数、浮点与双精度输出不抖动，只做转换
+class Dither {
+public:
+    // 噪声整形滤波器（误差反馈系数按44.1kHz设计）
+    enum class NoiseShaping {
+        NONE,           // 仅TPDF，噪声频谱平坦
+        FIRST_ORDER,    // 一阶高通，噪声推向高频
+        E_WEIGHTED_5,   // 5阶改进E加权（Wannamaker）
+        F_WEIGHTED_9    // 9阶F加权（Wannamaker），听感噪声最低
+    };
+
+    // 最大声道数与最大整形阶数
+    static constexpr size_t kMaxChannels = 8;
+    static constexpr size_t kMaxTaps = 9;
+
+    Dither();
+    ~Dither() = default;
+
+    // 启用/禁用抖动（禁用时直接舍入）
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    // 设置/获取噪声整形
+    void setNoiseShaping(NoiseShaping shaping);
+    NoiseShaping getNoiseShaping() const;
+
+    // 清除整形滤波器的误差历史
+    void reset();
+
+    // 浮点交错样本转为format并抖动（声道数超过kMaxChannels时不抖动，直接转换）；不支持的格式返回false
+    bool process(const float* input, SampleFormat format, void* output, size_t frames, size_t channels);
+
+private:
+    // 生成count个TPDF噪声样本（单位为LSB，范围(-1, 1)）
+    void generateNoise(float* noise, size_t count);
+
+    // 整形一块交错帧（history为各声道的误差历史）
+    using ShapeFunction = void (*)(const float* input, const float* noise, float* output, size_t frames,
+                                   size_t channels, float scale, float (*history)[kMaxTaps]);
+
+    bool enabled_;
+    NoiseShaping shaping_;
+    ShapeFunction shape_;                       // 无整形时为nullptr
+    uint32_t noise_state_[8];                   // 多路并行的xorshift状态
+    float errors_[kMaxChannels][kMaxTaps];      // 每声道量化误差历史（[0]为最近一次）
+};
+
+} // namespace dsp
+} // namespace audio
+
+#endif // AUDIO_DSP_DITHER_H
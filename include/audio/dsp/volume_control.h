@@ -1,37 +1,71 @@
 #ifndef AUDIO_DSP_VOLUME_CONTROL_H
 #define AUDIO_DSP_VOLUME_CONTROL_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace audio {
 namespace dsp {
 
 // 音量控制类
+// 音量变化不会立即生效，而是在下一次处理的块内从当前增益过渡到目标增益（线性或指数斜坡），
+// 静音同样按斜坡淡出，避免咔嗒声。整数输出路径饱和截断（输出抖动由dsp::Dither完成）
 class VolumeControl {
 public:
+    // 增益斜坡形状
+    enum class RampShape {
+        LINEAR,         // 线性增益
+        EXPONENTIAL     // 按dB均匀变化（听感上更平滑）
+    };
+
     VolumeControl();
     ~VolumeControl() = default;
-    
+
     // 设置音量（0.0到2.0）
     void setVolume(float volume);
-    
+
     // 获取当前音量
     float getVolume() const;
-    
-    // 应用音量控制到音频数据
+
+    // 设置/获取斜坡形状
+    void setRampShape(RampShape shape);
+    RampShape getRampShape() const;
+
+    // 以目标增益（音量或静音）处理音频数据，不推进斜坡
     void applyVolume(float* buffer, size_t frames) const;
-    
+
+    // 应用音量控制到交错音频数据（同一帧的所有声道使用相同增益）
+    void applyVolume(float* buffer, size_t frames, size_t channels);
+
+    // 应用逐帧增益包络（如自动化通道渲染的结果），再乘以当前音量
+    void applyVolume(float* buffer, size_t frames, size_t channels, const float* gains);
+
+    // 应用音量控制到16位整型交错数据（饱和截断）
+    void applyVolume(int16_t* buffer, size_t frames, size_t channels);
+
+    // 应用音量并转换为16位整型交错数据（饱和截断）
+    void applyVolume(const float* input, int16_t* output, size_t frames, size_t channels);
+
     // 静音/取消静音
     void mute();
     void unmute();
     bool isMuted() const;
 
 private:
+    // 取本块的起止增益并推进当前增益
+    void beginBlock(float& start, float& end);
+
+    // 饱和转换为16位整型（samples以16位满刻度为单位）
+    static void storeInt16(const float* samples, int16_t* output, size_t count);
+
     float volume_;
     bool muted_;
+    float current_gain_;    // 上一块结束时的增益
+    RampShape ramp_shape_;
 };
 
 } // namespace dsp
 } // namespace audio
 
-#endif // AUDIO_DSP_VOLUME_CONTROL_H
\ No newline at end of file
+#endif // AUDIO_DSP_VOLUME_CONTROL_H
@@ -0,0 +1,37 @@
+#ifndef AUDIO_SIMD_MIX_KERNELS_H
+#define AUDIO_SIMD_MIX_KERNELS_H
+
+#include "audio/simd/sample_convert.h"
+#include <cstddef>
+
+namespace audio {
+namespace simd {
+
+// 混音累加内核表（交错样本，累加到output）
+struct MixKernels {
+    // output[i] += gain * input[i]
+    void (*accumulate)(const float* input, float* output, size_t samples, float gain);
+
+    // 逐帧线性增益斜坡：第f帧的增益为start + step * (f + 1)，同一帧各声道增益相同
+    void (*accumulateRamp)(const float* input, float* output, size_t frames, size_t channels,
+                           float start, float step);
+};
+
+// 获取指定级别的内核（AVX2级别使用FMA，CPU不支持FMA时退回标量版本），用于测试与基准
+const MixKernels& getMixKernels(SimdLevel level);
+
+// 获取当前CPU的最优内核（首次调用时检测）
+const MixKernels& getMixKernels();
+
+namespace detail {
+
+// 各指令集的内核表（标量版本由编译器自动向量化）
+const MixKernels& scalarMixKernels();
+const MixKernels* avx2FmaMixKernels();
+
+} // namespace detail
+
+} // namespace simd
+} // namespace audio
+
+#endif // AUDIO_SIMD_MIX_KERNELS_H
@@ -0,0 +1,77 @@
+#ifndef AUDIO_SIMD_SAMPLE_CONVERT_H
+#define AUDIO_SIMD_SAMPLE_CONVERT_H
+
+#include "audio/audio_format.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+namespace simd {
+
+// 指令集级别
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// 样本格式转换内核表。样本数均为交错样本总数（帧数 * 声道数）。
+// 整数与浮点之间按满刻度缩放（16位为32768，24位为8388608，32位为2147483648），
+// 浮点转整数先饱和截断到可表示范围，再按当前舍入模式（默认就近偶数）取整。
+// 24位为打包的3字节小端格式。各级别的结果与SCALAR逐位一致
+struct ConversionKernels {
+    void (*s16ToFloat)(const int16_t* input, float* output, size_t samples);
+    void (*floatToS16)(const float* input, int16_t* output, size_t samples);
+    void (*s24ToFloat)(const uint8_t* input, float* output, size_t samples);
+    void (*floatToS24)(const float* input, uint8_t* output, size_t samples);
+    void (*s32ToFloat)(const int32_t* input, float* output, size_t samples);
+    void (*floatToS32)(const float* input, int32_t* output, size_t samples);
+    void (*doubleToFloat)(const double* input, float* output, size_t samples);
+    void (*floatToDouble)(const float* input, double* output, size_t samples);
+
+    // 原地字节序交换（大端 <-> 小端）
+    void (*swap16)(uint16_t* data, size_t samples);
+    void (*swap24)(uint8_t* data, size_t samples);
+    void (*swap32)(uint32_t* data, size_t samples);
+
+    // 交错 <-> 平面（planes为每声道一个指针，立体声有专门的向量化路径）
+    void (*interleave)(const float* const* planes, float* output, size_t frames, size_t channels);
+    void (*deinterleave)(const float* input, float* const* planes, size_t frames, size_t channels);
+};
+
+// 当前CPU支持的最高级别
+SimdLevel detectSimdLevel();
+
+// 获取指定级别的内核（不支持的级别退回到更低级别），用于测试与基准
+const ConversionKernels& getKernels(SimdLevel level);
+
+// 获取当前CPU的最优内核（首次调用时检测）
+const ConversionKernels& getKernels();
+
+// 格式的每样本字节数（未知格式为0）
+size_t bytesPerSample(SampleFormat format);
+
+// 任意格式转为32位浮点（解码器输入），不支持的格式返回false
+bool toFloat(const void* input, SampleFormat format, float* output, size_t samples);
+
+// 32位浮点转为任意格式（设备输出），不支持的格式返回false
+bool fromFloat(const float* input, SampleFormat format, void* output, size_t samples);
+
+// 两种格式之间转换（经由浮点；同格式时直接拷贝），scratch至少容纳samples个浮点
+bool convert(const void* input, SampleFormat input_format,
+             void* output, SampleFormat output_format,
+             float* scratch, size_t samples);
+
+namespace detail {
+
+// 各指令集的内核表（x86以外的平台只有标量版本）
+const ConversionKernels& scalarKernels();
+const ConversionKernels* sse2Kernels();
+const ConversionKernels* avx2Kernels();
+
+} // namespace detail
+
+} // namespace simd
+} // namespace audio
+
+#endif // AUDIO_SIMD_SAMPLE_CONVERT_H
@@ -0,0 +1,148 @@
+#ifndef CORE_AUDIO_AUTOMATION_H
+#define CORE_AUDIO_AUTOMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace core {
+
+// 自动化曲线类型（描述从上一个断点到本断点的过渡）
+enum class AutomationCurve {
+    STEP,           // 在本断点处跳变
+    LINEAR,         // 线性斜坡
+    EXPONENTIAL     // 指数斜坡（两端同号且非零时有效，否则按线性处理）
+};
+
+// 自动化断点：frame为时间线上的绝对帧位置
+struct AutomationPoint {
+    uint64_t frame;
+    float value;
+    AutomationCurve curve;
+};
+
+// 自动化通道：按帧排序的断点序列，发布后只读，可在音频线程上无锁读取
+class AutomationLane {
+public:
+    // 构造函数
+    AutomationLane();
+    explicit AutomationLane(float default_value);
+
+    // 获取指定帧的参数值
+    float valueAt(uint64_t frame) const;
+
+    // 获取块内下一个断点的偏移（[start, start + frames)内没有断点时返回frames）
+    size_t nextEvent(uint64_t start, size_t frames) const;
+
+    // 检查[start, start + frames)内参数是否为常数
+    bool isConstant(uint64_t start, size_t frames) const;
+
+    // 逐帧渲染参数值：每个断点段内为无分支的向量化循环
+    void render(uint64_t start, size_t frames, float* output) const;
+
+    // 获取断点
+    const std::vector<AutomationPoint>& getPoints() const { return points_; }
+
+    // 获取默认值（无断点时使用）
+    float getDefaultValue() const { return default_value_; }
+
+private:
+    friend class AudioAutomation;
+
+    // 获取frame所在段的终点断点索引（frame之后的第一个断点）
+    size_t segmentEnd(uint64_t frame) const;
+
+    // 段内取值
+    float segmentValue(size_t end, uint64_t frame) const;
+
+    std::vector<AutomationPoint> points_;
+    float default_value_;
+};
+
+// 自动化快照：所有参数通道的只读副本
+struct AutomationSnapshot {
+    uint64_t version;
+    std::vector<AutomationLane> lanes;
+
+    // 获取参数通道（索引无效时返回nullptr）
+    const AutomationLane* lane(size_t parameter) const {
+        return parameter < lanes.size() ? &lanes[parameter] : nullptr;
+    }
+};
+
+// 按断点切分块：fn(offset, count)在每段上调用一次，段内参数为常数或单一斜坡
+template <typename Fn>
+void forEachAutomationSegment(const AutomationLane& lane, uint64_t start, size_t frames, Fn&& fn) {
+    size_t offset = 0;
+    while (offset < frames) {
+        const size_t count = lane.nextEvent(start + offset, frames - offset);
+        fn(offset, count);
+        offset += count;
+    }
+}
+
+// 音频自动化类：编辑线程修改工作副本并通过commit()发布快照，
+// 音频线程每块调用一次acquire()获取当前快照（一次原子读写，无锁）。
+// 旧快照在音频线程确认使用更新版本后由编辑线程释放，音频线程不会释放内存。
+class AudioAutomation {
+public:
+    // 参数标识
+    using ParameterId = size_t;
+
+    // 构造函数
+    AudioAutomation();
+
+    // 析构函数
+    ~AudioAutomation();
+
+    // 添加参数通道
+    ParameterId addParameter(const std::string& name, float default_value);
+
+    // 按名称查找参数
+    bool findParameter(const std::string& name, ParameterId& parameter) const;
+
+    // 获取参数数量
+    size_t getParameterCount() const;
+
+    // 添加断点（同一帧上已有断点时替换）
+    bool addPoint(ParameterId parameter, uint64_t frame, float value,
+                  AutomationCurve curve = AutomationCurve::LINEAR);
+
+    // 添加斜坡：从start_frame处的from过渡到end_frame处的to
+    bool addRamp(ParameterId parameter, uint64_t start_frame, uint64_t end_frame,
+                 float from, float to, AutomationCurve curve = AutomationCurve::LINEAR);
+
+    // 移除[start_frame, end_frame)内的断点
+    bool clearRange(ParameterId parameter, uint64_t start_frame, uint64_t end_frame);
+
+    // 清空参数的所有断点
+    bool clearParameter(ParameterId parameter);
+
+    // 发布工作副本（之前的编辑在此之后对音频线程可见）
+    void commit();
+
+    // 获取当前快照（音频线程每块调用一次，返回值在下一次acquire前有效）
+    const AutomationSnapshot* acquire();
+
+private:
+    // 释放音频线程已不再使用的快照
+    void reclaim();
+
+    // 私有成员变量
+    mutable std::mutex edit_mutex_;
+    std::vector<std::string> names_;
+    std::vector<AutomationLane> working_;
+    std::vector<std::unique_ptr<AutomationSnapshot>> history_;
+    uint64_t version_;
+
+    std::atomic<const AutomationSnapshot*> published_;
+    std::atomic<uint64_t> acknowledged_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_AUTOMATION_H
@@ -0,0 +1,85 @@
+#ifndef CORE_AUDIO_CHANNEL_MIXER_H
+#define CORE_AUDIO_CHANNEL_MIXER_H
+
+#include "audio/audio_format.h"
+#include <cstddef>
+
+namespace core {
+
+// 声道上/下混器
+// 声道顺序：单声道 C；立体声 L R；四声道 L R Ls Rs；5.1 L R C LFE Ls Rs；7.1 L R C LFE Lb Rb Ls Rs。
+// 默认矩阵按ITU-R BS.775的做法生成（中置与环绕以-3dB并入左右，后环绕并入侧环绕，LFE默认丢弃），
+// 可逐系数覆盖。矩阵编译为按(输入声道数, 输出声道数)特化的内核：逐块转为平面格式后，
+// 每个输出声道只累加非零系数，累加循环在连续内存上向量化
+class ChannelMixer {
+public:
+    // 最大声道数
+    static constexpr size_t kMaxChannels = 8;
+
+    // 构造函数（默认立体声到立体声）
+    ChannelMixer();
+
+    // 布局对应的声道数（未知布局为0）
+    static size_t channelCount(audio::ChannelLayout layout);
+
+    // 设置输入/输出布局并重建默认矩阵（清除用户覆盖的系数）
+    bool setLayouts(audio::ChannelLayout input, audio::ChannelLayout output);
+
+    // 获取布局
+    audio::ChannelLayout getInputLayout() const;
+    audio::ChannelLayout getOutputLayout() const;
+
+    // 覆盖单个系数（输出声道output从输入声道input取gain倍）
+    bool setCoefficient(size_t output, size_t input, float gain);
+
+    // 获取当前系数
+    float getCoefficient(size_t output, size_t input) const;
+
+    // 清除所有覆盖，恢复默认矩阵
+    void resetCoefficients();
+
+    // 设置下混时LFE并入的增益（默认0，即丢弃）
+    void setLfeGain(float gain);
+
+    // 是否归一化默认矩阵，使任一输出声道的系数绝对值之和不超过1（默认开启，避免下混削波）。
+    // 归一化按所有输入同相满幅的最坏情况整体缩放，因此下混明显变轻：5.1到立体声的前置声道
+    // 约-7.7 dB（1/2.414），7.1到立体声约-9.9 dB（1/3.121）。这是有意的取舍，保证任何节目都不削波；
+    // 需要ITU的单位增益系数时关闭归一化，由后级限幅器处理峰值
+    void setNormalize(bool enabled);
+
+    // 混合交错帧；输出声道数不多于输入时可原地处理（output == input）
+    bool process(const float* input, float* output, size_t frames) const;
+
+    // 逐块处理的内核使用的非零系数
+    struct Tap {
+        size_t channel;
+        float gain;
+    };
+
+private:
+    // 生成默认矩阵、应用覆盖并编译内核
+    void rebuild();
+
+    // 编译非零系数列表并选择特化内核
+    void compile();
+
+    using Kernel = void (*)(const float* input, float* output, size_t frames, const Tap* taps, const size_t* counts);
+
+    audio::ChannelLayout input_layout_;
+    audio::ChannelLayout output_layout_;
+    size_t input_channels_;
+    size_t output_channels_;
+    float lfe_gain_;
+    bool normalize_;
+    bool identity_;
+
+    float matrix_[kMaxChannels][kMaxChannels];      // [输出][输入]
+    float overrides_[kMaxChannels][kMaxChannels];   // NaN表示未覆盖
+    Tap taps_[kMaxChannels * kMaxChannels];         // 每个输出声道kMaxChannels个槽
+    size_t tap_counts_[kMaxChannels];
+    Kernel kernel_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_CHANNEL_MIXER_H
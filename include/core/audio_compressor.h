@@ -2,13 +2,18 @@
 #define CORE_AUDIO_COMPRESSOR_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_dynamics.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频压缩器类
+// 宽带前馈压缩（MultibandDynamics的单频段形式），对数域软拐点，声道联动
 class AudioCompressor {
 public:
+    using DetectionMode = MultibandDynamics::DetectionMode;
+
     // 构造函数
     AudioCompressor();
     
@@ -21,14 +26,29 @@ public:
     // 关闭压缩器
     void shutdown();
     
-    // 应用压缩效果
+    // 应用压缩效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置压缩参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+
+    // 设置压缩参数：threshold（dB），ratio（1-100），attack/release（毫秒）
     bool setParameters(float threshold, float ratio, float attack, float release);
     
     // 获取压缩参数
     void getParameters(float& threshold, float& ratio, float& attack, float& release) const;
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置软拐点宽度（dB）
+    bool setKnee(float knee_db);
+
+    // 设置检测方式
+    void setDetectionMode(DetectionMode mode);
+
+    // 获取当前增益衰减（dB，<= 0）
+    float getGainReduction() const;
     
     // 重置压缩器
     void reset();
@@ -40,8 +60,12 @@ private:
     float ratio_;       // 压缩比
     float attack_;      // 攻击时间
     float release_;     // 释放时间
+    int sample_rate_;
+    int channels_;
+
+    MultibandDynamics dynamics_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_COMPRESSOR_H
\ No newline at end of file
+#endif // CORE_AUDIO_COMPRESSOR_H
@@ -2,6 +2,7 @@
 #define CORE_AUDIO_CONVERTER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_channel_mixer.h"
 #include <string>
 #include <memory>
 
@@ -37,6 +38,15 @@ public:
                         const std::string& output_file,
                         int target_channels);
     
+    // 按声道布局上/下混交错缓冲区（output按输出声道数调整大小）
+    bool convertChannels(const AudioBuffer& input,
+                        audio::ChannelLayout input_layout,
+                        AudioBuffer& output,
+                        audio::ChannelLayout output_layout);
+    
+    // 获取声道混合器（用于覆盖混合系数）
+    ChannelMixer& getChannelMixer();
+    
     // 转换位深度
     bool convertBitDepth(const std::string& input_file,
                         const std::string& output_file,
@@ -45,6 +55,7 @@ public:
 private:
     // 私有成员变量
     bool initialized_;
+    ChannelMixer channel_mixer_;
 };
 
 } // namespace core
@@ -2,11 +2,16 @@
 #define CORE_AUDIO_DELAY_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_delay_line.h"
+#include "core/audio_view.h"
 #include <memory>
+#include <vector>
 
 namespace core {
 
 // 音频延迟器类
+// 每声道一条分数延迟线，按块读写：块长不超过延迟时间，
+// 反馈路径在块内无需逐样本递推，读写都是连续内存上的向量化循环
 class AudioDelay {
 public:
     // 构造函数
@@ -21,26 +26,48 @@ public:
     // 关闭延迟器
     void shutdown();
     
-    // 应用延迟效果
+    // 应用延迟效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置延迟参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+    
+    // 设置延迟参数：delay_time（毫秒，1-2000），feedback（-0.95-0.95），mix（0-1）
     bool setParameters(float delay_time, float feedback, float mix);
     
     // 获取延迟参数
     void getParameters(float& delay_time, float& feedback, float& mix) const;
     
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
     // 重置延迟器
     void reset();
     
 private:
+    // 原地处理交错帧
+    void processFrames(float* data, size_t frames);
+    
+    // 分配延迟线
+    void allocateLines();
+    
+    // 最大延迟时间（毫秒）
+    static constexpr float kMaxDelay = 2000.0f;
+    
+    // 块长（帧）
+    static constexpr size_t kBlockFrames = 256;
+    
     // 私有成员变量
     bool initialized_;
     float delay_time_;   // 延迟时间
     float feedback_;     // 反馈量
     float mix_;          // 混合比例
+    int sample_rate_;
+    int channels_;
+    
+    std::vector<DelayLine> lines_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_DELAY_H
\ No newline at end of file
+#endif // CORE_AUDIO_DELAY_H
@@ -0,0 +1,135 @@
+#ifndef CORE_AUDIO_DELAY_LINE_H
+#define CORE_AUDIO_DELAY_LINE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+// 分数延迟线（单声道）：长度为2的幂的环形缓冲区，掩码索引（无取模）。
+// 缓冲区末尾镜像开头kGuard个样本，插值所需的相邻样本总是连续的。
+// 延迟以帧计，0为最近写入的样本；线性插值要求delay >= 0，Lagrange与全通要求delay >= 1。
+// 逐样本接口（read/write）供调制效果内联使用；块接口在整块写入后按块读取，
+// 固定延迟与多抽头读取是连续内存上的定长FIR，可自动向量化
+class DelayLine {
+public:
+    // 分数插值方式
+    enum class Interpolation {
+        LINEAR,     // 线性（两点）
+        LAGRANGE,   // 三阶Lagrange（四点），调制时高频损失小
+        ALLPASS     // 一阶全通（有状态，幅频平坦，适合反馈梳状滤波的缓慢调制）
+    };
+
+    // 构造函数
+    DelayLine();
+
+    // 分配缓冲区：支持最大max_delay帧的延迟与最多max_block帧的块读写（不在音频线程上调用）
+    void allocate(size_t max_delay, size_t max_block = 0);
+
+    // 清空缓冲区
+    void clear();
+
+    // 最大延迟（帧）
+    size_t getMaxDelay() const;
+
+    // 设置/获取插值方式（影响read与块读取）
+    void setInterpolation(Interpolation interpolation);
+    Interpolation getInterpolation() const;
+
+    // 写入一个样本
+    inline void write(float sample) {
+        write_index_ = (write_index_ + 1) & mask_;
+        float* samples = samples_.data();
+        samples[write_index_] = sample;
+        if (write_index_ < kGuard) {
+            samples[write_index_ + mask_ + 1] = sample;
+        }
+    }
+
+    // 按当前插值方式读取delay帧之前的样本
+    inline float read(float delay) {
+        switch (interpolation_) {
+            case Interpolation::LAGRANGE: return readLagrange(delay);
+            case Interpolation::ALLPASS: return readAllpass(delay);
+            default: return readLinear(delay);
+        }
+    }
+
+    // 读取整数延迟的样本
+    inline float readInteger(size_t delay) const {
+        return samples_[(write_index_ - delay) & mask_];
+    }
+
+    // 线性插值读取
+    inline float readLinear(float delay) const {
+        const size_t whole = static_cast<size_t>(delay);
+        const float frac = delay - static_cast<float>(whole);
+        const float* s = samples_.data() + ((write_index_ - whole - 1) & mask_);
+        return s[1] + (s[0] - s[1]) * frac;
+    }
+
+    // 三阶Lagrange插值读取（取延迟附近的四个样本，分数部分位于中间两点之间）
+    inline float readLagrange(float delay) const {
+        const size_t whole = static_cast<size_t>(delay);
+        const float* s = samples_.data() + ((write_index_ - whole - 2) & mask_);
+        float h[4];
+        lagrangeCoefficients(delay - static_cast<float>(whole), h);
+        return h[0] * s[3] + h[1] * s[2] + h[2] * s[1] + h[3] * s[0];
+    }
+
+    // 一阶全通插值读取（分数部分保持在[0.618, 1.618)以远离单位圆上的极点）
+    inline float readAllpass(float delay) {
+        size_t whole = static_cast<size_t>(delay);
+        float frac = delay - static_cast<float>(whole);
+        if (frac < 0.618f && whole > 0) {
+            --whole;
+            frac += 1.0f;
+        }
+        const float a = (1.0f - frac) / (1.0f + frac);
+        const float* s = samples_.data() + ((write_index_ - whole - 1) & mask_);
+        allpass_state_ = a * (s[1] - allpass_state_) + s[0];
+        return allpass_state_;
+    }
+
+    // 写入一块样本（input按stride跨步读取）
+    void write(const float* input, size_t frames, size_t stride = 1);
+
+    // 读取最近写入的frames帧各自延迟delay帧的样本（固定延迟）
+    void read(float delay, float* output, size_t frames);
+
+    // 读取最近写入的frames帧，每帧延迟由delays给出（调制延迟）
+    void readModulated(const float* delays, float* output, size_t frames);
+
+    // 多抽头读取：output = sum(gains[t] * 延迟delays[t]的样本)，作用于最近写入的frames帧
+    void readTaps(const float* delays, const float* gains, size_t taps, float* output, size_t frames) const;
+
+private:
+    // Lagrange系数：h[k]对应延迟为whole - 1 + k的样本（frac在[0, 1)）
+    static inline void lagrangeCoefficients(float frac, float* h) {
+        const float d = frac + 1.0f;
+        const float d1 = d - 1.0f;
+        const float d2 = d - 2.0f;
+        const float d3 = d - 3.0f;
+        h[0] = -d1 * d2 * d3 * (1.0f / 6.0f);
+        h[1] = d * d2 * d3 * 0.5f;
+        h[2] = -d * d1 * d3 * 0.5f;
+        h[3] = d * d1 * d2 * (1.0f / 6.0f);
+    }
+
+    // 固定延迟的块读取：gain倍累加（accumulate）或覆盖写入output
+    void readFixed(float delay, float gain, float* output, size_t frames, bool accumulate) const;
+
+    // 镜像样本数（覆盖四点插值与块读取的越界部分）
+    static constexpr size_t kGuard = 4;
+
+    std::vector<float> samples_;
+    size_t mask_;
+    size_t write_index_;
+    size_t max_delay_;
+    Interpolation interpolation_;
+    float allpass_state_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_DELAY_LINE_H
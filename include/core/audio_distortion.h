@@ -2,45 +2,78 @@
 #define CORE_AUDIO_DISTORTION_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_view.h"
+#include "core/audio_waveshaping.h"
 #include <memory>
+#include <vector>
 
 namespace core {
 
 // 音频失真器类
+// 过采样整形级（默认非对称曲线、4倍过采样）之后接一阶低通音色控制
 class AudioDistortion {
 public:
     // 构造函数
     AudioDistortion();
-    
+
     // 析构函数
     ~AudioDistortion();
-    
+
     // 初始化失真器
     bool initialize();
-    
+
     // 关闭失真器
     void shutdown();
-    
-    // 应用失真效果
+
+    // 应用失真效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置失真参数
+
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+
+    // 设置失真参数：drive范围0-1（输入增益0-40dB），tone范围0-1（低通截止500Hz-20kHz），mix范围0-1
     bool setParameters(float drive, float tone, float mix);
-    
+
     // 获取失真参数
     void getParameters(float& drive, float& tone, float& mix) const;
-    
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置/获取传递函数
+    void setCurve(TransferCurve curve);
+    TransferCurve getCurve() const;
+
+    // 设置/获取过采样倍数（1、2、4或8）
+    bool setOversampling(size_t factor);
+    size_t getOversampling() const;
+
+    // 获取处理延迟（帧）
+    size_t getLatency() const;
+
     // 重置失真器
     void reset();
-    
+
 private:
+    // 原地处理交错帧
+    void processFrames(float* data, size_t frames);
+
+    // 根据tone计算低通系数
+    void updateTone();
+
     // 私有成员变量
     bool initialized_;
     float drive_;   // 驱动强度
     float tone_;    // 音调
     float mix_;     // 混合比例
+    int sample_rate_;
+    int channels_;
+
+    WaveshapingStage stage_;
+    std::vector<float> tone_state_;   // 每声道一阶低通状态
+    float tone_coefficient_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_DISTORTION_H
\ No newline at end of file
+#endif // CORE_AUDIO_DISTORTION_H
@@ -2,13 +2,19 @@
 #define CORE_AUDIO_DYNAMIC_RANGE_COMPRESSOR_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_dynamics.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频动态范围压缩器类
+// 1-5频段前馈压缩：Linkwitz-Riley分频（频段求和相位一致），每频段独立的检测器与压缩参数，
+// 用于流输出上的广播式响度处理
 class AudioDynamicRangeCompressor {
 public:
+    using DetectionMode = MultibandDynamics::DetectionMode;
+
     // 构造函数
     AudioDynamicRangeCompressor();
     
@@ -21,14 +27,44 @@ public:
     // 关闭动态范围压缩器
     void shutdown();
     
-    // 应用动态范围压缩效果
+    // 应用动态范围压缩效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置压缩参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+
+    // 设置压缩参数（作用于所有频段）
     bool setParameters(float threshold, float ratio, float attack, float release, float makeup_gain);
     
-    // 获取压缩参数
+    // 获取压缩参数（全局设置）
     void getParameters(float& threshold, float& ratio, float& attack, float& release, float& makeup_gain) const;
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置/获取频段数（1-5）
+    bool setBandCount(int bands);
+    int getBandCount() const;
+
+    // 设置/获取分频点（index为0到频段数-2，Hz）
+    bool setCrossover(int index, float frequency);
+    float getCrossover(int index) const;
+
+    // 设置/获取单个频段的压缩参数
+    bool setBandParameters(int band, float threshold, float ratio, float attack, float release, float makeup_gain);
+    bool getBandParameters(int band, float& threshold, float& ratio, float& attack, float& release, float& makeup_gain) const;
+
+    // 设置软拐点宽度（dB）
+    bool setKnee(float knee_db);
+
+    // 设置检测方式
+    void setDetectionMode(DetectionMode mode);
+
+    // 设置声道联动
+    void setLinked(bool linked);
+
+    // 获取频段当前的增益衰减（dB，<= 0）
+    float getGainReduction(int band) const;
     
     // 重置动态范围压缩器
     void reset();
@@ -41,8 +77,12 @@ private:
     float attack_;         // 攻击时间
     float release_;        // 释放时间
     float makeup_gain_;    // 补偿增益
+    int sample_rate_;
+    int channels_;
+
+    MultibandDynamics dynamics_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_DYNAMIC_RANGE_COMPRESSOR_H
\ No newline at end of file
+#endif // CORE_AUDIO_DYNAMIC_RANGE_COMPRESSOR_H
@@ -0,0 +1,119 @@
+#ifndef CORE_AUDIO_DYNAMICS_H
+#define CORE_AUDIO_DYNAMICS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+// 多频段前馈压缩核心（AudioCompressor与AudioDynamicRangeCompressor共用）
+// 频段由Linkwitz-Riley四阶分频器分出，低频段经过后续分频点的全通补偿，各频段不压缩时求和为全通（幅度平坦）。
+// 每个频段×声道是一条独立的"通道"：分频滤波、电平检测与攻击/释放这些递归部分逐帧在所有通道上运算，
+// 对数域的静态曲线与增益转换（快速log2/exp2近似）在整个内部块上连续计算，两者都便于编译器向量化
+class MultibandDynamics {
+public:
+    // 电平检测方式
+    enum class DetectionMode {
+        PEAK,   // 峰值（快速上升，指数衰减）
+        RMS     // 均方根（约10ms窗口）
+    };
+
+    // 单个频段的压缩参数
+    struct BandSettings {
+        float threshold = -20.0f;  // 阈值（dB）
+        float ratio = 4.0f;        // 压缩比
+        float attack = 10.0f;      // 攻击时间（毫秒）
+        float release = 100.0f;    // 释放时间（毫秒）
+        float makeup = 0.0f;       // 补偿增益（dB）
+    };
+
+    // 最大频段数
+    static constexpr size_t kMaxBands = 5;
+
+    MultibandDynamics();
+
+    // 设置采样率与声道数并重新分配状态
+    void prepare(int sample_rate, size_t channels);
+
+    // 设置/获取频段数（1-5，1为宽带压缩）
+    bool setBandCount(size_t bands);
+    size_t getBandCount() const;
+
+    // 设置/获取分频点（index为0到频段数-2，须严格递增）
+    bool setCrossover(size_t index, float frequency);
+    float getCrossover(size_t index) const;
+
+    // 设置/获取频段参数
+    bool setBand(size_t band, const BandSettings& settings);
+    const BandSettings& getBand(size_t band) const;
+
+    // 设置/获取软拐点宽度（dB）
+    bool setKnee(float knee_db);
+    float getKnee() const;
+
+    // 设置/获取检测方式
+    void setDetectionMode(DetectionMode mode);
+    DetectionMode getDetectionMode() const;
+
+    // 设置声道联动：同一频段的所有声道共用检测电平（保持立体声像）
+    void setLinked(bool linked);
+
+    // 获取频段当前的增益衰减（dB，<= 0，各声道中的最大衰减）
+    float getGainReduction(size_t band) const;
+
+    // 原地处理交错帧
+    void process(float* data, size_t frames);
+
+    // 清除滤波器与检测器状态
+    void reset();
+
+private:
+    // 处理不超过kBlockFrames帧
+    void processBlock(float* data, size_t frames);
+
+    // 重新计算分频滤波器系数
+    void updateFilters();
+
+    // 重新计算各通道的增益计算参数
+    void updateBands();
+
+    // 分配状态
+    void allocateState();
+
+    // 内部处理块长（帧）
+    static constexpr size_t kBlockFrames = 64;
+
+    int sample_rate_;
+    size_t channels_;
+    size_t bands_;
+    size_t stride_;   // 每帧的通道数（频段×声道，补齐到4的倍数）
+    float crossovers_[kMaxBands - 1];
+    BandSettings settings_[kMaxBands];
+    float knee_;
+    DetectionMode detection_;
+    bool linked_;
+    float detector_coef_;
+
+    // 分频滤波器：每级两个二阶节，系数与状态按[节][通道]平铺
+    std::vector<float> b0_, b1_, b2_, a1_, a2_;
+    std::vector<float> z1_, z2_;
+
+    // 静态曲线参数（log2幅度单位），按[帧][通道]平铺一个内部块长
+    std::vector<float> threshold_;
+    std::vector<float> slope_;
+    std::vector<float> makeup_;
+
+    // 每通道的攻击/释放系数与状态
+    std::vector<float> attack_coef_;
+    std::vector<float> release_coef_;
+    std::vector<float> level_;      // 检测电平（功率）
+    std::vector<float> reduction_;  // 平滑后的增益衰减（log2）
+
+    // 块缓冲（[帧][通道]）
+    std::vector<float> signal_;     // 频段信号
+    std::vector<float> envelope_;   // 检测电平 -> 目标衰减 -> 平滑衰减
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_DYNAMICS_H
@@ -0,0 +1,143 @@
+#ifndef CORE_AUDIO_EFFECT_ADAPTER_H
+#define CORE_AUDIO_EFFECT_ADAPTER_H
+
+#include "core/audio_filter.h"
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace core {
+
+namespace detail {
+
+template <typename T, typename = void>
+struct HasViewProcess : std::false_type {};
+
+template <typename T>
+struct HasViewProcess<T, std::void_t<decltype(std::declval<T&>().process(std::declval<AudioView>()))>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct HasLatency : std::false_type {};
+
+template <typename T>
+struct HasLatency<T, std::void_t<decltype(std::declval<const T&>().getLatency())>> : std::true_type {};
+
+template <typename T, typename = void>
+struct HasFormat : std::false_type {};
+
+template <typename T>
+struct HasFormat<T, std::void_t<decltype(std::declval<T&>().setFormat(0, 0))>> : std::true_type {};
+
+// 三参数接口：setParameters(float, float, float)与getParameters(float&, float&, float&)都存在
+template <typename T, typename = void>
+struct HasThreeParameters : std::false_type {};
+
+template <typename T>
+struct HasThreeParameters<T, std::void_t<
+    decltype(std::declval<T&>().setParameters(0.0f, 0.0f, 0.0f)),
+    decltype(std::declval<const T&>().getParameters(std::declval<float&>(), std::declval<float&>(),
+                                                    std::declval<float&>()))>> : std::true_type {};
+
+} // namespace detail
+
+// 效果适配器：把具体效果类（AudioCompressor、AudioDelay、AudioGate等，各自的参数接口不同）
+// 包装为AudioFilter，使其可以放入效果链、效果图与混音器的效果槽。
+// 效果有process(AudioView)时原地处理，否则经由预分配的暂存缓冲区转调apply；
+// getLatency/setFormat在效果提供时转发；三参数的setParameters/getParameters只在效果恰好有该接口时转发，
+// 其他参数通过effect()直接设置
+template <typename Effect>
+class AudioEffectAdapter : public AudioFilter {
+public:
+    // 构造函数：name用于日志与getName，其余参数转发给效果的构造函数
+    template <typename... Args>
+    explicit AudioEffectAdapter(std::string name, Args&&... args)
+        : name_(std::move(name)), effect_(std::forward<Args>(args)...) {}
+
+    // 获取被包装的效果
+    Effect& effect() { return effect_; }
+    const Effect& effect() const { return effect_; }
+
+    bool apply(const AudioBuffer& input, AudioBuffer& output) override {
+        return effect_.apply(input, output);
+    }
+
+    bool process(AudioView view) override {
+        if constexpr (detail::HasViewProcess<Effect>::value) {
+            return effect_.process(view);
+        } else {
+            return AudioFilter::process(view);
+        }
+    }
+
+    bool setParameters(float param1, float param2, float param3) override {
+        if constexpr (detail::HasThreeParameters<Effect>::value) {
+            return effect_.setParameters(param1, param2, param3);
+        } else {
+            (void)param1;
+            (void)param2;
+            (void)param3;
+            return false;
+        }
+    }
+
+    void getParameters(float& param1, float& param2, float& param3) const override {
+        if constexpr (detail::HasThreeParameters<Effect>::value) {
+            effect_.getParameters(param1, param2, param3);
+        } else {
+            param1 = param2 = param3 = 0.0f;
+        }
+    }
+
+    std::string getName() const override {
+        return name_;
+    }
+
+    size_t getLatency() const override {
+        if constexpr (detail::HasLatency<Effect>::value) {
+            return effect_.getLatency();
+        } else {
+            return 0;
+        }
+    }
+
+    bool setFormat(int sample_rate, int channels) override {
+        if constexpr (detail::HasFormat<Effect>::value) {
+            return effect_.setFormat(sample_rate, channels);
+        } else {
+            (void)sample_rate;
+            (void)channels;
+            return true;
+        }
+    }
+
+    void prepare(size_t max_frames, size_t channels) override {
+        // 原地处理的效果不需要暂存缓冲区
+        if constexpr (!detail::HasViewProcess<Effect>::value) {
+            AudioFilter::prepare(max_frames, channels);
+        }
+    }
+
+    bool initialize() override {
+        return effect_.initialize();
+    }
+
+    void shutdown() override {
+        effect_.shutdown();
+    }
+
+private:
+    std::string name_;
+    Effect effect_;
+};
+
+// 创建包装好的效果，例如makeEffectFilter<AudioCompressor>("Compressor")
+template <typename Effect, typename... Args>
+std::unique_ptr<AudioFilter> makeEffectFilter(std::string name, Args&&... args) {
+    return std::make_unique<AudioEffectAdapter<Effect>>(std::move(name), std::forward<Args>(args)...);
+}
+
+} // namespace core
+
+#endif // CORE_AUDIO_EFFECT_ADAPTER_H
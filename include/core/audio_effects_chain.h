@@ -13,6 +13,7 @@
 #include "core/audio_stereo_widener.h"
 #include "core/audio_pitch_shifter.h"
 #include "core/audio_time_stretch.h"
+#include "core/audio_view.h"
 #include <vector>
 #include <memory>
 
@@ -33,23 +34,35 @@ public:
     // 关闭效果链
     void shutdown();
     
-    // 添加效果到链中
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
+    // 预分配旁路交叉淡化与各效果所需的块缓冲区（避免在处理时分配内存）
+    void prepare(size_t max_frames);
+    
+    // 设置旁路切换的交叉淡化时长 (ms)
+    void setBypassFadeTime(float fade_ms);
+    
+    // 添加效果到链中（效果按链的格式与块长配置，具体效果类用AudioEffectAdapter包装）
     bool addEffect(std::unique_ptr<AudioFilter> effect);
     
     // 移除效果
     bool removeEffect(size_t index);
     
-    // 应用效果链
+    // 应用效果链（输入只复制一次到输出，随后原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
+    // 原地处理一个块（处理期间启用FTZ/DAZ）
+    bool process(AudioView view);
+    
     // 清空效果链
     void clear();
     
     // 获取效果数量
     size_t getEffectCount() const;
     
-    // 获取指定索引的效果
-    std::unique_ptr<AudioFilter> getEffect(size_t index) const;
+    // 获取指定索引的效果（所有权仍归效果链）
+    AudioFilter* getEffect(size_t index) const;
     
     // 启用/禁用效果
     bool enableEffect(size_t index, bool enabled);
@@ -57,11 +70,32 @@ public:
     // 检查效果是否启用
     bool isEffectEnabled(size_t index) const;
     
+    // 获取处理延迟（已启用效果的延迟之和，帧）
+    size_t getLatency() const;
+    
 private:
+    // 效果槽：mix为当前湿信号比例，在启用/禁用时于fade帧内线性过渡
+    struct EffectSlot {
+        std::unique_ptr<AudioFilter> effect;
+        bool enabled;
+        float mix;
+    };
+    
+    // 处理一个正在交叉淡化的效果（块长超过预分配的干信号缓冲区时分段处理）
+    bool processCrossfade(EffectSlot& slot, AudioView view);
+    
+    // 更新淡化步长
+    void updateFadeStep();
+    
     // 私有成员变量
     bool initialized_;
-    std::vector<std::unique_ptr<AudioFilter>> effects_;
-    std::vector<bool> enabled_;
+    int sample_rate_;
+    size_t channels_;
+    float fade_ms_;
+    float fade_step_;
+    size_t max_frames_;
+    std::vector<EffectSlot> effects_;
+    AudioBuffer dry_;
 };
 
 } // namespace core
@@ -0,0 +1,134 @@
+#ifndef CORE_AUDIO_EFFECTS_GRAPH_H
+#define CORE_AUDIO_EFFECTS_GRAPH_H
+
+#include "core/audio_buffer.h"
+#include "core/audio_effects_chain.h"
+#include "core/audio_filter.h"
+#include "core/audio_thread_pool.h"
+#include "core/audio_view.h"
+#include <memory>
+#include <vector>
+
+namespace core {
+
+// 音频效果图类：由效果节点、总线节点和带增益的连接组成的有向无环图。
+// 每个节点的输入为所有入边来源输出的加权和（合并），一个节点可连接到多个目标（分支/发送）。
+// 图在编辑时拓扑排序为若干层，同层节点互不依赖，处理时在线程池上并行执行。
+// 节点缓冲区按prepare的块长预分配，更长的块分段处理，处理时不分配内存。
+// 编辑操作（添加/连接/移除）不得与process同时进行。
+class AudioEffectsGraph {
+public:
+    // 节点标识
+    using NodeId = size_t;
+
+    // 构造函数
+    AudioEffectsGraph();
+
+    // 析构函数
+    ~AudioEffectsGraph();
+
+    // 初始化效果图
+    bool initialize();
+
+    // 关闭效果图
+    void shutdown();
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 预分配各节点的块缓冲区（避免在处理时分配内存）
+    void prepare(size_t max_frames);
+
+    // 设置用于并行执行的线程池（为空时在调用线程上串行执行）
+    void setThreadPool(AudioThreadPool* pool);
+
+    // 获取图的输入节点
+    NodeId getInputNode() const;
+
+    // 获取图的输出节点
+    NodeId getOutputNode() const;
+
+    // 添加效果节点
+    NodeId addEffect(std::unique_ptr<AudioFilter> effect);
+
+    // 添加效果链节点
+    NodeId addChain(std::unique_ptr<AudioEffectsChain> chain);
+
+    // 添加总线节点（仅对输入求和）
+    NodeId addBus();
+
+    // 移除节点及其所有连接
+    bool removeNode(NodeId node);
+
+    // 连接两个节点（形成环路时失败）
+    bool connect(NodeId source, NodeId destination, float gain = 1.0f);
+
+    // 断开两个节点
+    bool disconnect(NodeId source, NodeId destination);
+
+    // 设置连接增益
+    bool setConnectionGain(NodeId source, NodeId destination, float gain);
+
+    // 应用效果图
+    bool apply(const AudioBuffer& input, AudioBuffer& output);
+
+    // 原地处理一个块（视图既是图的输入也是图的输出）
+    bool process(AudioView view);
+
+    // 获取效果节点中的效果（所有权仍归效果图）
+    AudioFilter* getEffect(NodeId node) const;
+
+    // 获取效果链节点中的效果链（所有权仍归效果图）
+    AudioEffectsChain* getChain(NodeId node) const;
+
+    // 获取节点数量（含输入/输出节点）
+    size_t getNodeCount() const;
+
+    // 获取拓扑层数
+    size_t getLevelCount() const;
+
+private:
+    // 入边
+    struct Connection {
+        NodeId source;
+        float gain;
+    };
+
+    // 图节点
+    struct Node {
+        bool active;
+        std::unique_ptr<AudioFilter> effect;
+        std::unique_ptr<AudioEffectsChain> chain;
+        std::vector<Connection> inputs;
+        AudioBuffer buffer;
+        float* data;
+    };
+
+    // 添加节点
+    NodeId addNode(std::unique_ptr<AudioFilter> effect, std::unique_ptr<AudioEffectsChain> chain);
+
+    // 拓扑排序并分层（存在环路时返回false，保留原有调度）
+    bool compile();
+
+    // 处理单个节点：对入边求和后运行效果
+    bool processNode(NodeId node, size_t frames);
+
+    // 处理不超过块长的一块
+    bool processBlock(AudioView view);
+
+    // 执行一层节点
+    bool runLevel(size_t level, size_t frames);
+
+    // 私有成员变量
+    bool initialized_;
+    int sample_rate_;
+    size_t channels_;
+    size_t max_frames_;
+    AudioThreadPool* pool_;
+    std::vector<Node> nodes_;
+    std::vector<std::vector<NodeId>> levels_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_EFFECTS_GRAPH_H
@@ -2,44 +2,115 @@
 #define CORE_AUDIO_FADE_H
 
 #include "core/audio_buffer.h"
+#include <cstdint>
 #include <memory>
 
 namespace core {
 
 // 音频淡入淡出类
+// 除整缓冲区淡入淡出外，提供两路流之间的流式交叉淡化：增益曲线取自预计算表，
+// 按输出时间线上的帧位置精确触发（可在曲目结束前自动开始），
+// 混合直接从两路解码输出读取并可原地写回淡出流的缓冲区，不需要额外拷贝
 class AudioFade {
 public:
+    // 淡化曲线
+    enum class Curve {
+        LINEAR,        // 线性（等增益，中点-6dB）
+        EQUAL_POWER,   // 等功率（正弦/余弦，中点-3dB）
+        S_CURVE        // S曲线（两端平缓）
+    };
+
     // 构造函数
     AudioFade();
-    
+
     // 析构函数
     ~AudioFade();
-    
+
     // 初始化淡入淡出器
     bool initialize();
-    
+
     // 关闭淡入淡出器
     void shutdown();
-    
-    // 应用淡入效果
+
+    // 应用淡入效果（缓冲区开头duration秒，可原地处理）
     bool fadeIn(const AudioBuffer& input, AudioBuffer& output, double duration);
-    
-    // 应用淡出效果
+
+    // 应用淡出效果（缓冲区末尾duration秒，可原地处理）
     bool fadeOut(const AudioBuffer& input, AudioBuffer& output, double duration);
-    
+
     // 设置淡入淡出参数
     bool setParameters(double fade_in_time, double fade_out_time);
-    
+
     // 获取淡入淡出参数
     void getParameters(double& fade_in_time, double& fade_out_time) const;
-    
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置/获取淡化曲线
+    void setCurve(Curve curve);
+    Curve getCurve() const;
+
+    // 在输出时间线的position帧处开始交叉淡化，持续duration秒
+    bool scheduleCrossfade(uint64_t position, double duration);
+
+    // 自动交叉淡化：使淡化恰好在淡出流结束（end_position帧）时完成
+    bool scheduleCrossfadeAtEnd(uint64_t end_position, double duration);
+
+    // 取消尚未完成的交叉淡化（恢复为只输出淡出流）
+    void cancelCrossfade();
+
+    // 交叉淡化完成后，调用者切换到新流时调用（恢复为直通）
+    void finishCrossfade();
+
+    // 混合一个块（交错格式）：淡化开始前输出outgoing，完成后输出incoming。
+    // output可与outgoing或incoming相同；outgoing/incoming为空时视为静音
+    bool crossfade(const float* outgoing, const float* incoming, float* output, size_t frames);
+
+    // 是否正在交叉淡化
+    bool isCrossfading() const;
+
+    // 交叉淡化是否已完成（此后输出为incoming）
+    bool isComplete() const;
+
+    // 当前输出时间线位置（帧）
+    uint64_t getPosition() const;
+
+    // 重置时间线与交叉淡化状态
+    void reset();
+
 private:
+    // 交叉淡化状态
+    enum class State {
+        IDLE,
+        PENDING,
+        ACTIVE,
+        COMPLETE
+    };
+
+    // 混合淡化区间内的frames帧（offset为从淡化起点算起的帧数）
+    void mixFrames(const float* outgoing, const float* incoming, float* output, size_t frames, uint64_t offset);
+
+    // 以表中增益处理单路缓冲区的一段（淡入或淡出）
+    void applyTable(float* data, size_t frames, size_t length, size_t offset, const float* table);
+
     // 私有成员变量
     bool initialized_;
     double fade_in_time_;   // 淡入时间
     double fade_out_time_;  // 淡出时间
+    int sample_rate_;
+    int channels_;
+    Curve curve_;
+    const float* in_table_;    // 淡入曲线表
+    const float* out_table_;   // 淡出曲线表
+
+    // 流式交叉淡化
+    State state_;
+    uint64_t position_;
+    uint64_t start_;
+    uint64_t length_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_FADE_H
\ No newline at end of file
+#endif // CORE_AUDIO_FADE_H
@@ -0,0 +1,46 @@
+#ifndef CORE_AUDIO_FFT_H
+#define CORE_AUDIO_FFT_H
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+// 基2复数FFT（实部/虚部分离存储，旋转因子与位反转表在setSize时预计算）
+class AudioFFT {
+public:
+    // 构造函数
+    AudioFFT();
+
+    // 带大小的构造函数
+    explicit AudioFFT(size_t size);
+
+    // 设置FFT大小（必须为2的幂），会重新计算查找表
+    bool setSize(size_t size);
+
+    // 获取FFT大小
+    size_t getSize() const;
+
+    // 正变换（原地）
+    void forward(float* re, float* im) const;
+
+    // 逆变换（原地，结果已按1/N缩放）
+    void inverse(float* re, float* im) const;
+
+    // 检查是否为2的幂
+    static bool isPowerOfTwo(size_t value);
+
+private:
+    // 蝶形运算，sign为旋转方向（-1正变换，+1逆变换）
+    void transform(float* re, float* im, float sign) const;
+
+    // 私有成员变量
+    size_t size_;
+    std::vector<size_t> bit_reverse_;
+    std::vector<float> cos_table_;
+    std::vector<float> sin_table_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_FFT_H
@@ -2,6 +2,8 @@
 #define CORE_AUDIO_FILTER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_view.h"
+#include <algorithm>
 #include <string>
 
 namespace core {
@@ -10,7 +12,7 @@ namespace core {
 class AudioFilter {
 public:
     // 构造函数
-    AudioFilter();
+    AudioFilter() = default;
     
     // 虚析构函数
     virtual ~AudioFilter() = default;
@@ -18,6 +20,21 @@ public:
     // 应用滤波效果
     virtual bool apply(const AudioBuffer& input, AudioBuffer& output) = 0;
     
+    // 原地处理视图中的样本（效果链使用的接口）
+    // 默认实现经由内部暂存缓冲区转调apply，支持原地处理的滤波器应重写此函数以避免复制；
+    // 暂存缓冲区由prepare预分配，块长不超过预分配大小时不分配内存
+    virtual bool process(AudioView view) {
+        if (scratch_.size() != view.size()) {
+            scratch_.resize(view.size());
+        }
+        std::copy(view.data(), view.data() + view.size(), scratch_.data());
+        if (!apply(scratch_, scratch_) || scratch_.size() != view.size()) {
+            return false;
+        }
+        std::copy(scratch_.data(), scratch_.data() + view.size(), view.data());
+        return true;
+    }
+    
     // 设置滤波器参数
     virtual bool setParameters(float param1, float param2, float param3) = 0;
     
@@ -27,11 +44,30 @@ public:
     // 获取滤波器名称
     virtual std::string getName() const = 0;
     
+    // 获取处理延迟（帧），混音器据此做延迟补偿；默认无延迟
+    virtual size_t getLatency() const { return 0; }
+    
+    // 设置音频格式（效果链/效果图在配置时调用）；默认与格式无关
+    virtual bool setFormat(int sample_rate, int channels) {
+        (void)sample_rate;
+        (void)channels;
+        return true;
+    }
+    
+    // 预分配每块最多max_frames帧所需的缓冲区（不在音频线程上调用）
+    virtual void prepare(size_t max_frames, size_t channels) {
+        scratch_.resize(max_frames * channels);
+    }
+    
     // 初始化滤波器
     virtual bool initialize() = 0;
     
     // 关闭滤波器
     virtual void shutdown() = 0;
+    
+private:
+    // 默认process实现使用的暂存缓冲区
+    AudioBuffer scratch_;
 };
 
 } // namespace core
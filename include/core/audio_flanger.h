@@ -2,11 +2,12 @@
 #define CORE_AUDIO_FLANGER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_modulation_cores.h"
 #include <memory>
 
 namespace core {
 
-// 音频镶边器类
+// 音频镶边器类（正弦LFO的镶边核心，与调制版本共用延迟线内核）
 class AudioFlanger {
 public:
     // 构造函数
@@ -21,7 +22,7 @@ public:
     // 关闭镶边器
     void shutdown();
     
-    // 应用镶边效果
+    // 应用镶边效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
     // 设置镶边参数
@@ -30,6 +31,9 @@ public:
     // 获取镶边参数
     void getParameters(float& rate, float& depth, float& feedback, float& mix) const;
     
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
     // 重置镶边器
     void reset();
     
@@ -40,8 +44,10 @@ private:
     float depth_;      // 调制深度
     float feedback_;   // 反馈量
     float mix_;        // 混合比例
+
+    modulation::ModulatedEffect<modulation::FlangerCore, modulation::SineLfo> effect_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_FLANGER_H
\ No newline at end of file
+#endif // CORE_AUDIO_FLANGER_H
@@ -1,49 +1,17 @@
 #ifndef CORE_AUDIO_FLANGER_MODULATED_H
 #define CORE_AUDIO_FLANGER_MODULATED_H
 
-#include "core/audio_buffer.h"
-#include <memory>
+#include "core/audio_modulation_cores.h"
 
 namespace core {
 
-// 音频调制镶边器类
-class AudioFlangerModulated {
-public:
-    // 构造函数
-    AudioFlangerModulated();
-    
-    // 析构函数
-    ~AudioFlangerModulated();
-    
-    // 初始化调制镶边器
-    bool initialize();
-    
-    // 关闭调制镶边器
-    void shutdown();
-    
-    // 应用调制镶边效果
-    bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置调制镶边参数
-    bool setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth);
-    
-    // 获取调制镶边参数
-    void getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth) const;
-    
-    // 重置调制镶边器
-    void reset();
-    
-private:
-    // 私有成员变量
-    bool initialized_;
-    float rate_;              // 基础调制速率
-    float depth_;             // 基础调制深度
-    float feedback_;          // 反馈量
-    float mix_;               // 混合比例
-    float modulation_rate_;  // 调制速率
-    float modulation_depth_; // 调制深度
-};
+// 音频调制镶边器类（LFO波形由lfo_waveform参数选择）
+using AudioFlangerModulated = modulation::AudioModulatedEffect<modulation::FlangerCore>;
+
+// 版本2/3已合并，保留类名以兼容旧代码
+using AudioFlangerModulated2 = AudioFlangerModulated;
+using AudioFlangerModulated3 = AudioFlangerModulated;
 
 } // namespace core
 
-#endif // CORE_AUDIO_FLANGER_MODULATED_H
\ No newline at end of file
+#endif // CORE_AUDIO_FLANGER_MODULATED_H
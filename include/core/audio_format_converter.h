@@ -1,12 +1,16 @@
 #ifndef CORE_AUDIO_FORMAT_CONVERTER_H
 #define CORE_AUDIO_FORMAT_CONVERTER_H
 
+#include "audio/audio_format.h"
+#include "audio/dsp/dither.h"
 #include "core/audio_buffer.h"
 #include <string>
+#include <vector>
 
 namespace core {
 
 // 音频格式转换器类
+// 样本格式转换使用audio::simd中按CPU选择的SSE2/AVX2内核
 class AudioFormatConverter {
 public:
     // 构造函数
@@ -26,6 +30,21 @@ public:
                  AudioBuffer& output,
                  const std::string& target_format);
     
+    // 转换交错样本的格式（解码器输入转浮点、浮点转设备输出），samples为样本总数。
+    // 启用抖动时，输出16/24位整数的转换按setParameters设置的声道数抖动并整形
+    bool convert(const void* input, audio::SampleFormat input_format,
+                 void* output, audio::SampleFormat output_format,
+                 size_t samples);
+    
+    // 平面格式转交错格式（planes为每声道一个指针）
+    bool interleave(const float* const* planes, float* output, size_t frames, size_t channels);
+    
+    // 交错格式转平面格式
+    bool deinterleave(const float* input, float* const* planes, size_t frames, size_t channels);
+    
+    // 设置降位深时的抖动与噪声整形（默认关闭，转换结果逐位确定）
+    bool setDither(bool enabled, audio::dsp::Dither::NoiseShaping shaping);
+    
     // 设置转换参数
     bool setParameters(int sample_rate, int channels, int bit_depth);
     
@@ -41,6 +60,8 @@ private:
     int sample_rate_;
     int channels_;
     int bit_depth_;
+    std::vector<float> scratch_;   // 两种整数格式互转时的中间浮点缓冲区
+    audio::dsp::Dither dither_;
 };
 
 } // namespace core
@@ -2,45 +2,139 @@
 #define CORE_AUDIO_GATE_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_view.h"
 #include <memory>
+#include <vector>
 
 namespace core {
 
 // 音频门控器类
+// 门限/扩展器：检测路径（可选侧链高通）在未延迟的信号上运行，增益作用于延迟lookahead的音频，
+// 瞬态到来前门已打开。开门阈值为threshold，关门阈值低hysteresis dB，低于关门阈值后保持hold
+// 再开始释放；关闭时按ratio向下扩展，最大衰减为range。检测与门状态按声道平铺存放，
+// 每帧在所有声道上做无分支的向量化更新，适合多路输入同时处理
 class AudioGate {
 public:
+    // 电平检测方式
+    enum class DetectionMode {
+        PEAK,   // 峰值（快速上升，指数衰减）
+        RMS     // 均方根（约10ms窗口）
+    };
+
     // 构造函数
     AudioGate();
-    
+
     // 析构函数
     ~AudioGate();
-    
+
     // 初始化门控器
     bool initialize();
-    
+
     // 关闭门控器
     void shutdown();
-    
-    // 应用门控效果
+
+    // 应用门控效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置门控参数
+
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+
+    // 设置门控参数：threshold（dB），attack/release（毫秒）
     bool setParameters(float threshold, float attack, float release);
-    
+
     // 获取门控参数
     void getParameters(float& threshold, float& attack, float& release) const;
-    
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置保持时间（毫秒）
+    bool setHold(float hold_ms);
+
+    // 设置迟滞（dB，关门阈值 = threshold - hysteresis）
+    bool setHysteresis(float hysteresis_db);
+
+    // 设置最大衰减（dB，负值）与扩展比（>= 1，越大越接近硬门限）
+    bool setRange(float range_db, float ratio);
+
+    // 设置预读时间（0-10毫秒），即处理延迟
+    bool setLookahead(float lookahead_ms);
+
+    // 设置侧链高通截止频率（Hz），0为关闭
+    bool setSidechainHighpass(float frequency);
+
+    // 设置检测方式
+    void setDetectionMode(DetectionMode mode);
+
+    // 设置立体声联动：所有声道共用一个检测电平与增益
+    void setLinked(bool linked);
+
+    // 获取处理延迟（帧）
+    size_t getLatency() const;
+
+    // 门是否打开（联动模式下所有声道相同）
+    bool isOpen(size_t channel) const;
+
     // 重置门控器
     void reset();
-    
+
 private:
+    // 原地处理交错帧
+    void processFrames(float* data, size_t frames);
+
+    // 计算检测器关闭时的扩展增益（按控制速率调用）
+    void updateClosedGain(size_t detector, float level);
+
+    // 重新计算系数
+    void updateCoefficients();
+
+    // 分配状态
+    void allocateState();
+
+    // 最大预读时间（毫秒）
+    static constexpr float kMaxLookahead = 10.0f;
+
     // 私有成员变量
     bool initialized_;
     float threshold_;   // 阈值
     float attack_;      // 攻击时间
     float release_;     // 释放时间
+    float hold_;        // 保持时间（毫秒）
+    float hysteresis_;  // 迟滞（dB）
+    float range_;       // 最大衰减（dB）
+    float ratio_;       // 扩展比
+    float lookahead_;   // 预读时间（毫秒）
+    float sidechain_freq_;
+    DetectionMode detection_;
+    bool linked_;
+    int sample_rate_;
+    int channels_;
+
+    // 系数
+    float open_power_;        // 开门阈值（功率）
+    float close_power_;       // 关门阈值（功率）
+    float range_gain_;
+    float attack_coef_;
+    float release_coef_;
+    float detector_coef_;     // RMS平滑/峰值衰减
+    float hold_frames_;
+    size_t lookahead_frames_;
+    float hp_b0_, hp_b1_, hp_b2_, hp_a1_, hp_a2_;
+
+    // 每声道状态（平铺数组）
+    std::vector<float> hp_z1_;
+    std::vector<float> hp_z2_;
+    std::vector<float> level_;       // 检测电平（功率）
+    std::vector<float> hold_count_;  // 每检测器剩余保持帧数
+    std::vector<float> open_;        // 每检测器门状态（0/1）
+    std::vector<float> closed_gain_; // 每检测器关闭时的目标增益
+    std::vector<float> gain_;        // 每检测器当前增益
+    std::vector<float> gain_block_;  // 当前块的逐样本增益（交错）
+    std::vector<float> delay_history_;
+    std::vector<float> delay_work_;
+    size_t control_counter_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_GATE_H
\ No newline at end of file
+#endif // CORE_AUDIO_GATE_H
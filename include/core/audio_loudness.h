@@ -0,0 +1,106 @@
+#ifndef CORE_AUDIO_LOUDNESS_H
+#define CORE_AUDIO_LOUDNESS_H
+
+#include "core/audio_oversampler.h"
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+// 响度测量器（ITU-R BS.1770-4 / EBU R128）：流式分析交错PCM。
+// K加权（高架预滤波 + RLB高通）后按100ms子块累计各声道加权能量，由子块组合出
+// 400ms瞬时块（75%重叠，用于门限积分响度）和3s短时块（每秒一个，用于响度范围LRA）。
+// 真峰值在4倍（96kHz以上2倍，192kHz以上不过采样）过采样后取绝对值最大值。
+// 只保存超过绝对门限（-70 LUFS）的块能量，积分响度与LRA在查询时计算
+class LoudnessMeter {
+public:
+    // 构造函数
+    LoudnessMeter();
+
+    // 设置音频格式并清空测量（会分配内存，不在音频线程上调用）
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置声道权重（默认全部为1；6声道按5.1排列时LFE为0、环绕声道为1.41）
+    bool setChannelWeight(int channel, float weight);
+
+    // 获取音频格式
+    int getSampleRate() const;
+    int getChannels() const;
+
+    // 启用/禁用真峰值测量（关闭时只测采样峰值，分析更快）
+    void setTruePeakEnabled(bool enabled);
+
+    // 分析交错PCM
+    void process(const float* data, size_t frames);
+
+    // 合并另一测量器的块与峰值（同格式），用于专辑响度
+    bool merge(const LoudnessMeter& other);
+
+    // 瞬时响度（最近400ms，LUFS）
+    double getMomentaryLoudness() const;
+
+    // 短时响度（最近3s，LUFS）
+    double getShortTermLoudness() const;
+
+    // 门限积分响度（LUFS，无有效块时为负无穷）
+    double getIntegratedLoudness() const;
+
+    // 响度范围（LU）
+    double getLoudnessRange() const;
+
+    // 真峰值（线性，未启用时等于采样峰值）
+    float getTruePeak() const;
+
+    // 采样峰值（线性）
+    float getSamplePeak() const;
+
+    // 已分析的帧数
+    size_t getFrameCount() const;
+
+    // 清空测量（保留格式与权重）
+    void reset();
+
+private:
+    // 一个子块结束：更新瞬时/短时块
+    void finishSubBlock();
+
+    // 最近count个子块的平均能量
+    double recentEnergy(size_t count) const;
+
+    // 内部处理块长（帧）
+    static constexpr size_t kChunkFrames = 1024;
+
+    // 保留的子块数（一个短时块）
+    static constexpr size_t kSubBlockHistory = 30;
+
+    int sample_rate_;
+    int channels_;
+    bool true_peak_enabled_;
+    size_t sub_block_frames_;
+
+    // K加权滤波器（两个二阶节，双精度）
+    double pre_b_[3], pre_a_[3];
+    double rlb_b_[3], rlb_a_[3];
+    std::vector<double> state_;      // 每声道4个状态
+    std::vector<float> weights_;
+
+    // 子块累计
+    double sub_energy_;
+    size_t sub_frames_;
+    size_t sub_count_;
+    double sub_history_[kSubBlockHistory];
+
+    // 通过绝对门限的块能量
+    std::vector<double> momentary_blocks_;
+    std::vector<double> short_term_blocks_;
+
+    // 峰值
+    AudioOversampler oversampler_;
+    float sample_peak_;
+    float true_peak_;
+    size_t frames_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_LOUDNESS_H
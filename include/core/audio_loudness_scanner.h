@@ -0,0 +1,122 @@
+#ifndef CORE_AUDIO_LOUDNESS_SCANNER_H
+#define CORE_AUDIO_LOUDNESS_SCANNER_H
+
+#include "core/audio_loudness.h"
+#include "core/audio_thread_pool.h"
+#include "core/metadata_cache.h"
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace core {
+
+// 解码后的PCM来源（交错float），由调用者接入实际解码器
+class PcmSource {
+public:
+    virtual ~PcmSource() = default;
+
+    // 打开文件并返回格式
+    virtual bool open(const std::string& path, int& sample_rate, int& channels) = 0;
+
+    // 读取最多frames帧，返回实际帧数（0表示结束）
+    virtual size_t read(float* buffer, size_t frames) = 0;
+
+    // 关闭文件
+    virtual void close() = 0;
+};
+
+// 单曲（或专辑）响度分析结果
+struct LoudnessInfo {
+    double integrated = -std::numeric_limits<double>::infinity();   // 积分响度（LUFS）
+    double range = 0.0;                                              // 响度范围（LU）
+    float true_peak = 0.0f;                                          // 真峰值（线性）
+    float gain = 0.0f;                                               // ReplayGain 2.0增益（dB）
+    bool valid = false;
+};
+
+// 响度扫描器：批量分析曲库，结果（ReplayGain 2.0 / R128）写入元数据缓存。
+// 曲目在线程池上并行分析（原子计数认领曲目，调用线程同样参与），每个任务只分析一首曲目，
+// 每个执行者复用自己的PCM来源、测量器和读取缓冲，解码与磁盘读取同样并行。
+// 播放时只需从缓存读取增益（lookup），无运行时分析开销
+class LoudnessScanner {
+public:
+    using SourceFactory = std::function<std::unique_ptr<PcmSource>()>;
+
+    // ReplayGain 2.0参考响度（LUFS）
+    static constexpr double kReferenceLoudness = -18.0;
+
+    // 缓存键
+    static const char* const kTrackGainKey;
+    static const char* const kTrackPeakKey;
+    static const char* const kAlbumGainKey;
+    static const char* const kAlbumPeakKey;
+    static const char* const kIntegratedKey;
+    static const char* const kRangeKey;
+
+    // 构造函数
+    LoudnessScanner();
+
+    // 设置PCM来源工厂（每个工作线程创建一个来源并复用）
+    void setSourceFactory(SourceFactory factory);
+
+    // 设置共享线程池（为空时在调用线程上串行扫描）。
+    // 任务按该池的角色调度，WORKER池可能运行在实时优先级上，后台扫描宜用setThreadCount
+    void setThreadPool(AudioThreadPool* pool);
+
+    // 创建扫描器自有的后台线程池（ThreadRole::BACKGROUND的优先级与CPU绑定），0表示串行扫描
+    void setThreadCount(size_t num_threads);
+
+    // 设置结果写入的元数据缓存
+    void setMetadataCache(MetadataCache* cache);
+
+    // 启用/禁用真峰值测量
+    void setTruePeakEnabled(bool enabled);
+
+    // 扫描曲库（阻塞），skip_cached为真时跳过缓存中已有结果的曲目，返回成功分析的曲目数
+    size_t scanLibrary(const std::vector<std::string>& paths, bool skip_cached = true);
+
+    // 扫描一张专辑：写入各曲目增益与专辑增益
+    bool scanAlbum(const std::vector<std::string>& paths, LoudnessInfo* album = nullptr);
+
+    // 分析已解码的PCM（如播放时已解码的数据），结果同样写入缓存
+    LoudnessInfo analyzeDecoded(const std::string& path, const float* pcm, size_t frames, int sample_rate, int channels);
+
+    // 已处理的曲目数（可在其他线程查询进度）
+    size_t getProgress() const;
+
+    // 取消正在进行的扫描（已认领的曲目会完成）
+    void cancel();
+
+    // 从缓存读取播放增益（album为真时优先专辑增益）
+    static bool lookup(const MetadataCache& cache, const std::string& path, bool album, float& gain_db, float& peak);
+
+private:
+    struct Worker;
+
+    // 在线程池上并行执行count个任务
+    void runParallel(size_t count, const std::function<void(Worker&, size_t)>& task);
+
+    // 用工作线程的PCM来源解码并分析一首曲目
+    bool analyzeFile(Worker& worker, const std::string& path, LoudnessMeter& meter);
+
+    // 由测量器生成结果
+    static LoudnessInfo makeInfo(const LoudnessMeter& meter);
+
+    // 将曲目结果写入缓存
+    void storeTrack(const std::string& path, const LoudnessInfo& info);
+
+    SourceFactory factory_;
+    AudioThreadPool* pool_;
+    std::unique_ptr<AudioThreadPool> background_pool_;
+    MetadataCache* cache_;
+    bool true_peak_enabled_;
+    std::atomic<size_t> progress_;
+    std::atomic<bool> cancelled_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_LOUDNESS_SCANNER_H
@@ -0,0 +1,81 @@
+#ifndef CORE_AUDIO_MID_SIDE_H
+#define CORE_AUDIO_MID_SIDE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+namespace stereo {
+
+// 立体声2x2矩阵：L' = ll * L + rl * R，R' = lr * L + rr * R
+struct StereoMatrix {
+    float ll = 1.0f;
+    float rl = 0.0f;
+    float lr = 0.0f;
+    float rr = 1.0f;
+
+    bool operator==(const StereoMatrix& other) const {
+        return ll == other.ll && rl == other.rl && lr == other.lr && rr == other.rr;
+    }
+    bool operator!=(const StereoMatrix& other) const { return !(*this == other); }
+};
+
+// 构造M/S矩阵：中间/侧边信号分别乘以mid_gain/side_gain，再按balance（-1..1）调整左右声道，
+// 最后与原信号按mix混合（矩阵是线性的，混合直接并入系数）
+StereoMatrix makeMidSideMatrix(float mid_gain, float side_gain, float balance, float mix);
+
+// 原地应用矩阵（交错立体声）：系数在块内从from线性过渡到to，避免参数跳变产生咔嗒声。
+// 左右样本成对读写，不需要解交错，循环可由编译器向量化
+void applyStereoMatrix(float* data, size_t frames, const StereoMatrix& from, const StereoMatrix& to);
+
+// 低频单声道化：侧边信号经过4阶Linkwitz-Riley高通，分频点以下的声像收拢到中间
+class BassMonoFilter {
+public:
+    // 设置分频频率（Hz），cutoff <= 0时关闭
+    void setCutoff(float cutoff, int sample_rate);
+
+    // 是否启用
+    bool isEnabled() const { return enabled_; }
+
+    // 原地处理交错立体声，amount为去除比例（0-1）
+    void process(float* data, size_t frames, float amount);
+
+    // 清空滤波器状态
+    void reset();
+
+private:
+    bool enabled_ = false;
+    float b0_ = 0.0f;
+    float b1_ = 0.0f;
+    float b2_ = 0.0f;
+    float a1_ = 0.0f;
+    float a2_ = 0.0f;
+    float state_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+};
+
+// 哈斯去相关：把延迟若干毫秒的中间信号加入侧边信号（L += d，R -= d），
+// 单声道素材也能获得空间感，且左右相加时延迟分量相互抵消，保持单声道兼容
+class HaasDecorrelator {
+public:
+    // 分配最大延迟（毫秒）对应的缓冲区
+    void prepare(float max_delay_ms, int sample_rate);
+
+    // 设置延迟时间（毫秒），超过最大延迟时截断
+    void setDelay(float delay_ms, int sample_rate);
+
+    // 原地处理交错立体声，amount为加入侧边信号的比例
+    void process(float* data, size_t frames, float amount);
+
+    // 清空延迟线
+    void reset();
+
+private:
+    std::vector<float> history_;    // 中间信号环形缓冲区
+    size_t delay_ = 1;
+    size_t write_index_ = 0;
+};
+
+} // namespace stereo
+} // namespace core
+
+#endif // CORE_AUDIO_MID_SIDE_H
@@ -2,73 +2,335 @@
 #define CORE_AUDIO_MIXER_H
 
 #include "core/audio_buffer.h"
-#include <vector>
+#include "core/audio_channel_mixer.h"
+#include "core/audio_effects_chain.h"
+#include "core/audio_format.h"
+#include "core/audio_stream_resampler.h"
+#include "core/audio_thread_pool.h"
+#include "core/audio_view.h"
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace core {
 
+// 混音轨道的音频来源：混音时按块拉取交错float样本（来源自身的采样率与声道数）
+class MixerSource {
+public:
+    virtual ~MixerSource() = default;
+
+    // 读取最多frames帧，返回实际帧数；少于frames表示来源已结束
+    virtual size_t read(float* buffer, size_t frames) = 0;
+
+    // 剩余帧数（来源采样率下，未知时返回0）
+    virtual size_t remainingFrames() const { return 0; }
+
+    // 来源格式（采样率或声道数为0表示与混音器一致），格式不同时混音器逐块转换
+    virtual AudioFormat getFormat() const { return AudioFormat(); }
+};
+
+// 播放内存中缓冲区的来源（共享缓冲区，不复制样本）
+class BufferMixerSource : public MixerSource {
+public:
+    // 采样率与混音器一致
+    BufferMixerSource(std::shared_ptr<const AudioBuffer> buffer, size_t channels);
+
+    // 指定来源格式
+    BufferMixerSource(std::shared_ptr<const AudioBuffer> buffer, const AudioFormat& format);
+
+    size_t read(float* buffer, size_t frames) override;
+    size_t remainingFrames() const override;
+    AudioFormat getFormat() const override;
+
+private:
+    std::shared_ptr<const AudioBuffer> buffer_;
+    AudioFormat format_;
+    size_t channels_;
+    size_t position_;   // 已读取的样本数
+};
+
 // 音频混音器类
+// 轨道以整数句柄标识，混音时逐块（kBlockFrames帧）从各轨道来源拉取样本，
+// 用SIMD内核（AVX2可用时为FMA）累加到输出块中；音量或静音变化时增益在一个块内线性过渡。
+// 拉取缓冲区在setFormat时分配，输出写入调用者的存储，混音路径上没有字符串查找与内存分配（线程池任务提交除外）。
+// 按名称的接口保留用于兼容，只在控制路径上查找。
+// 轨道输出到总线，总线逐级汇入主总线（轨道 → 编组总线 → 主总线），每条总线可带效果链，
+// 并可按增益发送到其他总线（推子后发送）。总线在编辑时拓扑排序为若干层，
+// 同层总线互不依赖，混音时在线程池上并行渲染；上层总线在本层全部完成后读取下层的输出，不需要加锁。
+// 来源格式与混音器不同的轨道逐块做声道转换与流式重采样。轨道和总线可带效果链，
+// 混音器按效果链与重采样器报告的延迟自动补偿：同一总线的各路输入延迟到其中最大的延迟后再求和。
+// 编辑操作（添加/移除/路由）不得与mix同时进行
 class AudioMixer {
 public:
+    // 轨道句柄（0为无效句柄）
+    using TrackHandle = uint32_t;
+    static constexpr TrackHandle kInvalidTrack = 0;
+
+    // 总线句柄（编码方式与轨道句柄相同）
+    using BusHandle = uint32_t;
+    static constexpr BusHandle kInvalidBus = 0;
+
+    // 主总线（槽位0，代数1，始终存在）
+    static constexpr BusHandle kMasterBus = 1u << 16;
+
+    // 每次从来源拉取的帧数（也是增益斜坡的长度）
+    static constexpr size_t kBlockFrames = 256;
+
     // 构造函数
     AudioMixer();
-    
+
     // 析构函数
     ~AudioMixer();
-    
+
     // 初始化混音器
     bool initialize();
-    
+
     // 关闭混音器
     void shutdown();
-    
-    // 添加音频轨道
+
+    // 设置音频格式（默认44100Hz立体声）
+    bool setFormat(int sample_rate, int channels);
+
+    // 添加来源轨道，返回句柄（失败返回kInvalidTrack，如声道布局或采样率之比不受支持）
+    TrackHandle addTrack(std::unique_ptr<MixerSource> source, float volume = 1.0f);
+
+    // 添加共享缓冲区轨道（不复制样本）
+    TrackHandle addTrack(std::shared_ptr<const AudioBuffer> buffer, float volume = 1.0f);
+
+    // 移除轨道
+    bool removeTrack(TrackHandle track);
+
+    // 设置/获取轨道音量
+    bool setTrackVolume(TrackHandle track, float volume);
+    float getTrackVolume(TrackHandle track) const;
+
+    // 设置/获取轨道静音状态
+    bool setTrackMute(TrackHandle track, bool mute);
+    bool getTrackMute(TrackHandle track) const;
+
+    // 轨道来源是否已结束（含延迟尾部）
+    bool isTrackFinished(TrackHandle track) const;
+
+    // 设置轨道效果链（为空时移除），效果链的格式与块长由混音器设置，初始化由调用者负责
+    bool setTrackEffects(TrackHandle track, std::unique_ptr<AudioEffectsChain> effects);
+
+    // 获取轨道效果链（所有权仍归混音器）
+    AudioEffectsChain* getTrackEffects(TrackHandle track) const;
+
+    // 轨道自身的延迟（重采样器与效果链，混音器采样率下的帧数）
+    size_t getTrackLatency(TrackHandle track) const;
+
+    // 设置轨道输出的总线（新轨道默认输出到主总线）
+    bool setTrackBus(TrackHandle track, BusHandle bus);
+    BusHandle getTrackBus(TrackHandle track) const;
+
+    // 添加总线，输出到output总线，返回句柄（失败返回kInvalidBus）
+    BusHandle addBus(BusHandle output = kMasterBus, float volume = 1.0f);
+
+    // 移除总线：其轨道与子总线改为输出到它的输出总线，相关发送一并删除（主总线不可移除）
+    bool removeBus(BusHandle bus);
+
+    // 设置总线的输出总线（形成环路时失败）
+    bool setBusOutput(BusHandle bus, BusHandle output);
+    BusHandle getBusOutput(BusHandle bus) const;
+
+    // 设置/获取总线推子音量与静音状态
+    bool setBusVolume(BusHandle bus, float volume);
+    float getBusVolume(BusHandle bus) const;
+    bool setBusMute(BusHandle bus, bool mute);
+    bool getBusMute(BusHandle bus) const;
+
+    // 设置总线效果链（为空时移除），效果链的格式与块长由混音器设置，初始化由调用者负责
+    bool setBusEffects(BusHandle bus, std::unique_ptr<AudioEffectsChain> effects);
+
+    // 获取总线效果链（所有权仍归混音器）
+    AudioEffectsChain* getBusEffects(BusHandle bus) const;
+
+    // 设置推子后发送：source总线的输出按gain额外送入destination总线（已存在时更新增益，形成环路时失败）
+    bool setBusSend(BusHandle source, BusHandle destination, float gain);
+
+    // 删除发送
+    bool removeBusSend(BusHandle source, BusHandle destination);
+
+    // 总线输出的延迟（补偿后的输入延迟加上效果链延迟）
+    size_t getBusLatency(BusHandle bus) const;
+
+    // 混音器总延迟（主总线输出相对于来源的帧数）
+    size_t getLatency() const;
+
+    // 重新计算延迟补偿（效果参数改变了延迟后调用；增删与路由操作会自动调用）
+    void updateLatencies();
+
+    // 获取总线数量（含主总线）
+    size_t getBusCount() const;
+
+    // 获取总线拓扑层数（主总线单独为最后一层）
+    size_t getBusLevelCount() const;
+
+    // 设置用于并行渲染总线的线程池（为空时在调用线程上串行渲染）
+    void setThreadPool(AudioThreadPool* pool);
+
+    // 混合output.frames()帧到output（覆盖原内容），声道数须与混音器一致
+    bool mix(AudioView output);
+
+    // 添加音频轨道（兼容接口：复制缓冲区）
     bool addTrack(const std::string& name, const AudioBuffer& buffer);
-    
+
     // 移除音频轨道
     bool removeTrack(const std::string& name);
-    
+
     // 设置轨道音量
     bool setTrackVolume(const std::string& name, float volume);
-    
+
     // 获取轨道音量
     float getTrackVolume(const std::string& name) const;
-    
+
     // 设置轨道静音状态
     bool setTrackMute(const std::string& name, bool mute);
-    
+
     // 获取轨道静音状态
     bool getTrackMute(const std::string& name) const;
-    
-    // 混音所有轨道
+
+    // 获取轨道句柄（不存在返回kInvalidTrack）
+    TrackHandle findTrack(const std::string& name) const;
+
+    // 混音所有轨道：output非空时混合其容量对应的帧数并复用存储，
+    // 为空时按最长轨道的剩余长度调整大小
     bool mix(AudioBuffer& output);
-    
+
     // 清空所有轨道
     void clear();
-    
+
     // 获取轨道数量
     size_t getTrackCount() const;
-    
+
     // 获取轨道名称列表
     std::vector<std::string> getTrackNames() const;
-    
+
 private:
+    // 延迟补偿用的整数延迟（交错样本环形缓冲区，原地处理）
+    struct CompensationDelay {
+        std::vector<float> ring;
+        size_t position = 0;
+
+        // 设置延迟帧数（长度不变时保留内容）
+        void setLength(size_t frames, size_t channels);
+
+        // 原地延迟count个样本
+        void process(float* samples, size_t count);
+    };
+
     // 轨道信息结构体
     struct Track {
+        std::unique_ptr<MixerSource> source;
         std::string name;
-        AudioBuffer buffer;
         float volume;
         bool mute;
-        
-        Track(const std::string& n, const AudioBuffer& b) 
-            : name(n), buffer(b), volume(1.0f), mute(false) {}
+        float gain;         // 当前增益（上一块结束时的值）
+        bool finished;
+        uint32_t bus;       // 输出总线的槽位序号
+        size_t channels;    // 来源声道数
+        std::unique_ptr<ChannelMixer> channel_mixer;    // 声道数不同时
+        std::unique_ptr<StreamResampler> resampler;     // 采样率不同时
+        std::vector<float> input;                       // 来源格式的一个块
+        std::vector<float> converted;                   // 声道转换后、重采样前的一个块
+        std::unique_ptr<AudioEffectsChain> effects;
+        CompensationDelay delay;
+        size_t latency;     // 重采样器与效果链的延迟
+        size_t tail;        // 来源结束后还需输出的帧数（延迟尾部）
+        bool source_done;
+    };
+
+    // 句柄槽：generation在轨道移除时递增，使旧句柄失效
+    struct Slot {
+        Track track;
+        uint16_t generation;
+        bool used;
     };
-    
+
+    // 推子后发送（当前增益由目标总线在渲染时更新）
+    struct Send {
+        uint32_t destination;
+        float gain;
+        float current;
+    };
+
+    // 总线的一路输入：来源总线的主输出（send为-1）或其第send路发送
+    struct BusInput {
+        uint32_t source;
+        int send;
+        CompensationDelay delay;
+    };
+
+    // 总线：输出 = 效果链(所属轨道之和 + 各路输入之和)，汇入output时乘以推子增益
+    struct Bus {
+        uint32_t output;                        // 输出总线的槽位序号（主总线无输出）
+        float volume;
+        bool mute;
+        float gain;                             // 汇入输出总线的当前增益（由输出总线渲染时更新）
+        std::unique_ptr<AudioEffectsChain> effects;
+        std::vector<Send> sends;
+        std::vector<uint32_t> tracks;           // 输出到本总线的轨道槽位
+        std::vector<BusInput> inputs;           // 编译时生成
+        std::vector<float> buffer;              // 一个块的输出
+        std::vector<float> pull;                // 从轨道来源拉取的一个块（也用于延迟补偿输入）
+        size_t latency;                         // 输出延迟
+    };
+
+    // 总线句柄槽
+    struct BusSlot {
+        Bus bus;
+        uint16_t generation;
+        bool used;
+    };
+
+    // 句柄对应的轨道（无效句柄返回nullptr）
+    Track* findSlot(TrackHandle track);
+    const Track* findSlot(TrackHandle track) const;
+
+    // 句柄对应的总线槽位序号（无效句柄返回-1）
+    int findBus(BusHandle bus) const;
+
+    // 从总线的轨道列表中移除轨道
+    void detachTrack(uint32_t index);
+
+    // 按来源格式与混音器格式配置轨道的声道转换、重采样器与缓冲区（不支持时返回false）
+    bool prepareTrack(Track& track);
+
+    // 从轨道来源读取一个块并转换为混音器格式，返回含来源数据的帧数（其余补零）
+    size_t readTrack(Track& track, float* output, size_t frames);
+
+    // 拓扑排序总线并分层（存在环路时返回false，保留原有调度）
+    bool compileBuses();
+
+    // 按当前格式分配总线的块缓冲区与效果链
+    void prepareBus(Bus& bus);
+
+    // 混合一个不超过kBlockFrames帧的块
+    void mixBlock(float* output, size_t frames);
+
+    // 渲染一条总线的一个块
+    void renderBus(uint32_t index, size_t frames);
+
+    // 渲染一层总线
+    void runBusLevel(size_t level, size_t frames);
+
     // 私有成员变量
     bool initialized_;
-    std::vector<Track> tracks_;
+    int sample_rate_;
+    size_t channels_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    std::vector<uint32_t> active_;                          // 正在混音的槽位（紧凑数组）
+    std::unordered_map<std::string, TrackHandle> names_;    // 兼容接口的名称索引
+    std::vector<BusSlot> buses_;
+    std::vector<uint32_t> free_buses_;
+    std::vector<std::vector<uint32_t>> bus_levels_;         // 拓扑分层的总线槽位
+    AudioThreadPool* pool_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_MIXER_H
\ No newline at end of file
+#endif // CORE_AUDIO_MIXER_H
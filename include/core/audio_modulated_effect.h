@@ -0,0 +1,376 @@
+#ifndef CORE_AUDIO_MODULATED_EFFECT_H
+#define CORE_AUDIO_MODULATED_EFFECT_H
+
+#include "core/audio_automation.h"
+#include "core/audio_buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace core {
+namespace modulation {
+
+// LFO波形类型（与旧接口的lfo_waveform取值一致）
+enum class LfoWaveform {
+    SINE = 0,
+    TRIANGLE = 1,
+    SQUARE = 2,
+    SAWTOOTH = 3,
+    SAMPLE_HOLD = 4
+};
+
+// 调制效果的通用参数
+struct ModulationParameters {
+    float rate;               // LFO速率 (Hz)
+    float depth;              // LFO深度 (0-1)
+    float feedback;           // 反馈量 (-0.95-0.95)
+    float mix;                // 混合比例 (0-1)
+    float modulation_rate;    // LFO速率的二次调制速率 (Hz)
+    float modulation_depth;   // LFO速率的二次调制深度 (0-1)
+    LfoWaveform waveform;     // LFO波形
+
+    ModulationParameters()
+        : rate(1.0f), depth(0.5f), feedback(0.0f), mix(0.5f),
+          modulation_rate(0.0f), modulation_depth(0.0f), waveform(LfoWaveform::SINE) {}
+};
+
+// 调制参数的自动化通道（为空的通道保持setParameters设置的值）
+struct ModulationAutomation {
+    const AutomationLane* rate = nullptr;
+    const AutomationLane* depth = nullptr;
+    const AutomationLane* feedback = nullptr;
+    const AutomationLane* mix = nullptr;
+};
+
+// 向下取整，|value| < 2^31；只用截断转换与比较，不依赖SSE4.1的roundps，块循环中可向量化
+inline float fastFloor(float value) {
+    const int32_t truncated = static_cast<int32_t>(value);
+    return static_cast<float>(truncated - static_cast<int32_t>(static_cast<float>(truncated) > value));
+}
+
+// 条件成立时返回value，否则返回0。按位与实现：默认的-ftrapping-math下，
+// GCC不会把依赖浮点比较的选择转换为无分支代码，三目运算会阻止块循环向量化
+inline float maskIf(bool condition, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits &= 0u - static_cast<uint32_t>(condition);
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 快速正弦近似，输入为归一化相位，输出sin(2*pi*phase)
+// 折叠到[-1/4, 1/4]周期后使用9阶奇多项式，最大误差约4e-6，无分支
+inline float fastSine(float phase) {
+    float q = phase - fastFloor(phase + 0.5f);
+    const float folded = std::copysign(0.5f, q) - q;
+    const bool fold = std::fabs(q) > 0.25f;
+    q = maskIf(fold, folded) + maskIf(!fold, q);
+    const float x = 6.28318530717959f * q;
+    const float x2 = x * x;
+    return x * (1.0f + x2 * (-1.66666667e-1f + x2 * (8.33333333e-3f + x2 * (-1.98412698e-4f + x2 * 2.75573192e-6f))));
+}
+
+// 周期序号哈希到[-1, 1]，用于无状态的采样保持LFO
+inline float hashToBipolar(uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7feb352du;
+    value ^= value >> 15;
+    value *= 0x846ca68bu;
+    value ^= value >> 16;
+    return static_cast<float>(value) * (2.0f / 4294967295.0f) - 1.0f;
+}
+
+// LFO策略：value(phase, cycle)为无分支的纯函数，便于与效果核心内联到同一循环
+struct SineLfo {
+    static inline float value(float phase, uint32_t) { return fastSine(phase); }
+};
+
+struct TriangleLfo {
+    static inline float value(float phase, uint32_t) { return 1.0f - 4.0f * std::fabs(phase - 0.5f); }
+};
+
+struct SquareLfo {
+    static inline float value(float phase, uint32_t) { return phase < 0.5f ? 1.0f : -1.0f; }
+};
+
+struct SawtoothLfo {
+    static inline float value(float phase, uint32_t) { return 2.0f * phase - 1.0f; }
+};
+
+struct SampleHoldLfo {
+    static inline float value(float, uint32_t cycle) { return hashToBipolar(cycle); }
+};
+
+// 编译期组合的调制效果：Core提供单帧处理，Lfo提供调制波形，二者在renderBlock中内联为一个循环。
+// Core需要实现：
+//   void prepare(int sample_rate, size_t channels);
+//   void reset();
+//   void update(const ModulationParameters& params, int sample_rate);
+//   void process(const float* in, float* out, size_t channels, float lfo);
+template <typename Core>
+class ModulatedEffectBase {
+public:
+    // 构造函数
+    ModulatedEffectBase()
+        : initialized_(false), sample_rate_(44100), channels_(2),
+          lfo_phase_(0.0f), lfo_cycle_(0), rate_phase_(0.0f) {}
+
+    // 析构函数
+    ~ModulatedEffectBase() { shutdown(); }
+
+    // 初始化效果器（分配内部状态）
+    bool initialize() {
+        core_.prepare(sample_rate_, channels_);
+        core_.update(params_, sample_rate_);
+        initialized_ = true;
+        return true;
+    }
+
+    // 关闭效果器
+    void shutdown() { initialized_ = false; }
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels) {
+        if (sample_rate <= 0 || channels <= 0) {
+            return false;
+        }
+        sample_rate_ = sample_rate;
+        channels_ = static_cast<size_t>(channels);
+        if (initialized_) {
+            core_.prepare(sample_rate_, channels_);
+            core_.update(params_, sample_rate_);
+        }
+        return true;
+    }
+
+    // 设置调制参数
+    bool setParameters(float rate, float depth, float feedback, float mix,
+                       float modulation_rate, float modulation_depth, float lfo_waveform) {
+        const int waveform = std::clamp(static_cast<int>(lfo_waveform + 0.5f), 0,
+                                        static_cast<int>(LfoWaveform::SAMPLE_HOLD));
+        params_.waveform = static_cast<LfoWaveform>(waveform);
+        return setParameters(rate, depth, feedback, mix, modulation_rate, modulation_depth);
+    }
+
+    // 设置调制参数（保持当前LFO波形）
+    bool setParameters(float rate, float depth, float feedback, float mix,
+                       float modulation_rate, float modulation_depth) {
+        params_.rate = std::clamp(rate, 0.0f, 20.0f);
+        params_.depth = std::clamp(depth, 0.0f, 1.0f);
+        params_.feedback = std::clamp(feedback, -0.95f, 0.95f);
+        params_.mix = std::clamp(mix, 0.0f, 1.0f);
+        params_.modulation_rate = std::clamp(modulation_rate, 0.0f, 20.0f);
+        params_.modulation_depth = std::clamp(modulation_depth, 0.0f, 1.0f);
+        core_.update(params_, sample_rate_);
+        return true;
+    }
+
+    // 获取调制参数
+    void getParameters(float& rate, float& depth, float& feedback, float& mix,
+                       float& modulation_rate, float& modulation_depth, float& lfo_waveform) const {
+        getParameters(rate, depth, feedback, mix, modulation_rate, modulation_depth);
+        lfo_waveform = static_cast<float>(params_.waveform);
+    }
+
+    // 获取调制参数（不含LFO波形）
+    void getParameters(float& rate, float& depth, float& feedback, float& mix,
+                       float& modulation_rate, float& modulation_depth) const {
+        rate = params_.rate;
+        depth = params_.depth;
+        feedback = params_.feedback;
+        mix = params_.mix;
+        modulation_rate = params_.modulation_rate;
+        modulation_depth = params_.modulation_depth;
+    }
+
+    // 获取完整参数
+    const ModulationParameters& getModulationParameters() const { return params_; }
+
+    // 重置效果器（恢复默认参数并清空内部状态）
+    void reset() {
+        params_ = ModulationParameters();
+        lfo_phase_ = 0.0f;
+        lfo_cycle_ = 0;
+        rate_phase_ = 0.0f;
+        core_.reset();
+        core_.update(params_, sample_rate_);
+    }
+
+    // 访问效果核心（用于核心特有的参数）
+    Core& core() { return core_; }
+    const Core& core() const { return core_; }
+
+protected:
+    // 渲染一个块：LFO与效果核心内联为同一循环，无虚函数调用
+    template <typename Lfo>
+    void renderBlock(const float* in, float* out, size_t frames) {
+        // LFO速率的二次调制按块更新
+        float rate = params_.rate;
+        if (params_.modulation_depth > 0.0f && params_.modulation_rate > 0.0f) {
+            rate *= 1.0f + params_.modulation_depth * fastSine(rate_phase_);
+            rate_phase_ += params_.modulation_rate * static_cast<float>(frames) / static_cast<float>(sample_rate_);
+            rate_phase_ -= std::floor(rate_phase_);
+        }
+
+        const float increment = rate / static_cast<float>(sample_rate_);
+        const float phase = lfo_phase_;
+        const uint32_t cycle = lfo_cycle_;
+        const size_t channels = channels_;
+
+        for (size_t i = 0; i < frames; ++i) {
+            const float position = phase + static_cast<float>(i) * increment;
+            const float whole = std::floor(position);
+            const float lfo = Lfo::value(position - whole, cycle + static_cast<uint32_t>(whole));
+            core_.process(in + i * channels, out + i * channels, channels, lfo);
+        }
+
+        const float end = phase + static_cast<float>(frames) * increment;
+        const float whole = std::floor(end);
+        lfo_phase_ = end - whole;
+        lfo_cycle_ = cycle + static_cast<uint32_t>(whole);
+    }
+
+    // 按自动化事件切分块：断点处精确切分，斜坡段按kAutomationStride帧更新参数，
+    // 每段开始时更新参数后调用render(offset, count)
+    template <typename Render>
+    void renderAutomated(const ModulationAutomation& automation, uint64_t start_frame,
+                         size_t frames, Render&& render) {
+        const AutomationLane* lanes[] = {automation.rate, automation.depth, automation.feedback, automation.mix};
+        size_t offset = 0;
+        while (offset < frames) {
+            const uint64_t frame = start_frame + offset;
+            size_t count = frames - offset;
+            bool ramping = false;
+            for (const AutomationLane* lane : lanes) {
+                if (lane != nullptr) {
+                    count = std::min(count, lane->nextEvent(frame, count));
+                    ramping = ramping || !lane->isConstant(frame, count);
+                }
+            }
+            if (ramping) {
+                count = std::min(count, kAutomationStride);
+            }
+
+            setParameters(automation.rate ? automation.rate->valueAt(frame) : params_.rate,
+                          automation.depth ? automation.depth->valueAt(frame) : params_.depth,
+                          automation.feedback ? automation.feedback->valueAt(frame) : params_.feedback,
+                          automation.mix ? automation.mix->valueAt(frame) : params_.mix,
+                          params_.modulation_rate, params_.modulation_depth);
+            render(offset, count);
+            offset += count;
+        }
+    }
+
+    // 准备输出缓冲区
+    bool prepareOutput(const AudioBuffer& input, AudioBuffer& output) const {
+        if (!initialized_ || input.size() % channels_ != 0) {
+            return false;
+        }
+        if (output.size() != input.size()) {
+            output.resize(input.size());
+        }
+        return true;
+    }
+
+    // 斜坡自动化的参数更新间隔（帧）
+    static constexpr size_t kAutomationStride = 32;
+
+    bool initialized_;
+    int sample_rate_;
+    size_t channels_;
+    ModulationParameters params_;
+    Core core_;
+
+    float lfo_phase_;
+    uint32_t lfo_cycle_;
+    float rate_phase_;
+};
+
+// LFO波形在编译期确定的调制效果
+template <typename Core, typename Lfo>
+class ModulatedEffect : public ModulatedEffectBase<Core> {
+public:
+    // 应用调制效果（交错格式，可原地处理）
+    bool apply(const AudioBuffer& input, AudioBuffer& output) {
+        if (!this->prepareOutput(input, output)) {
+            return false;
+        }
+        this->template renderBlock<Lfo>(input.data(), output.data(), input.size() / this->channels_);
+        return true;
+    }
+
+    // 应用调制效果并跟随参数自动化，start_frame为块首帧在时间线上的位置
+    bool apply(const AudioBuffer& input, AudioBuffer& output,
+               const ModulationAutomation& automation, uint64_t start_frame) {
+        if (!this->prepareOutput(input, output)) {
+            return false;
+        }
+        const float* in = input.data();
+        float* out = output.data();
+        const size_t channels = this->channels_;
+        this->renderAutomated(automation, start_frame, input.size() / channels,
+                              [&](size_t offset, size_t count) {
+                                  this->template renderBlock<Lfo>(in + offset * channels, out + offset * channels, count);
+                              });
+        return true;
+    }
+};
+
+// LFO波形由lfo_waveform参数选择的调制效果：每块按波形分派一次到对应的特化循环
+template <typename Core>
+class AudioModulatedEffect : public ModulatedEffectBase<Core> {
+public:
+    // 应用调制效果（交错格式，可原地处理）
+    bool apply(const AudioBuffer& input, AudioBuffer& output) {
+        if (!this->prepareOutput(input, output)) {
+            return false;
+        }
+
+        render(input.data(), output.data(), input.size() / this->channels_);
+        return true;
+    }
+
+    // 应用调制效果并跟随参数自动化，start_frame为块首帧在时间线上的位置
+    bool apply(const AudioBuffer& input, AudioBuffer& output,
+               const ModulationAutomation& automation, uint64_t start_frame) {
+        if (!this->prepareOutput(input, output)) {
+            return false;
+        }
+        const float* in = input.data();
+        float* out = output.data();
+        const size_t channels = this->channels_;
+        this->renderAutomated(automation, start_frame, input.size() / channels,
+                              [&](size_t offset, size_t count) {
+                                  render(in + offset * channels, out + offset * channels, count);
+                              });
+        return true;
+    }
+
+private:
+    // 按波形分派到对应的特化循环
+    void render(const float* in, float* out, size_t frames) {
+        switch (this->params_.waveform) {
+        case LfoWaveform::SINE:
+            this->template renderBlock<SineLfo>(in, out, frames);
+            break;
+        case LfoWaveform::TRIANGLE:
+            this->template renderBlock<TriangleLfo>(in, out, frames);
+            break;
+        case LfoWaveform::SQUARE:
+            this->template renderBlock<SquareLfo>(in, out, frames);
+            break;
+        case LfoWaveform::SAWTOOTH:
+            this->template renderBlock<SawtoothLfo>(in, out, frames);
+            break;
+        case LfoWaveform::SAMPLE_HOLD:
+            this->template renderBlock<SampleHoldLfo>(in, out, frames);
+            break;
+        }
+    }
+};
+
+} // namespace modulation
+} // namespace core
+
+#endif // CORE_AUDIO_MODULATED_EFFECT_H
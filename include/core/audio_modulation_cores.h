@@ -0,0 +1,221 @@
+#ifndef CORE_AUDIO_MODULATION_CORES_H
+#define CORE_AUDIO_MODULATION_CORES_H
+
+#include "core/audio_delay_line.h"
+#include "core/audio_modulated_effect.h"
+#include <vector>
+
+namespace core {
+namespace modulation {
+
+// 合唱核心：20ms基础延迟，LFO扫动±8ms，奇数声道LFO反相以展宽立体声（Lagrange插值延迟线）
+class ChorusCore {
+public:
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const float modulation = (ch & 1) ? -lfo : lfo;
+            const float wet = lines_[ch].readLagrange(base_delay_ + sweep_ * modulation);
+            const float x = in[ch];
+            lines_[ch].write(x + feedback_ * wet);
+            out[ch] = dry_ * x + wet_ * wet;
+        }
+    }
+
+private:
+    std::vector<DelayLine> lines_;
+    float base_delay_ = 0.0f;
+    float sweep_ = 0.0f;
+    float feedback_ = 0.0f;
+    float dry_ = 1.0f;
+    float wet_ = 0.0f;
+};
+
+// 镶边核心：3ms基础延迟，LFO扫动±2.5ms，反馈形成梳状峰（Lagrange插值延迟线）
+class FlangerCore {
+public:
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        const float delay = base_delay_ + sweep_ * lfo;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const float wet = lines_[ch].readLagrange(delay);
+            const float x = in[ch];
+            lines_[ch].write(x + feedback_ * wet);
+            out[ch] = dry_ * x + wet_ * wet;
+        }
+    }
+
+private:
+    std::vector<DelayLine> lines_;
+    float base_delay_ = 0.0f;
+    float sweep_ = 0.0f;
+    float feedback_ = 0.0f;
+    float dry_ = 1.0f;
+    float wet_ = 0.0f;
+};
+
+// 移相核心：6级一阶全通，中心频率1kHz，LFO扫动±90%
+class PhaserCore {
+public:
+    static constexpr size_t kStages = 6;
+
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        // 小角度近似 tan(w) ≈ w，全通系数 a = (1 - w) / (1 + w)
+        const float w = center_ * (1.0f + sweep_ * lfo);
+        const float a = (1.0f - w) / (1.0f + w);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            float* z = &state_[ch * (kStages + 1)];
+            const float x = in[ch];
+            float y = x + feedback_ * z[kStages];
+            for (size_t s = 0; s < kStages; ++s) {
+                const float stage = a * y + z[s];
+                z[s] = y - a * stage;
+                y = stage;
+            }
+            z[kStages] = y;
+            out[ch] = dry_ * x + wet_ * y;
+        }
+    }
+
+private:
+    std::vector<float> state_;
+    float center_ = 0.0f;
+    float sweep_ = 0.0f;
+    float feedback_ = 0.0f;
+    float dry_ = 1.0f;
+    float wet_ = 0.0f;
+};
+
+// 颤音核心：增益在[1 - depth, 1]之间随LFO变化
+class TremoloCore {
+public:
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        const float gain = offset_ + scale_ * lfo;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            out[ch] = in[ch] * gain;
+        }
+    }
+
+private:
+    float offset_ = 1.0f;
+    float scale_ = 0.0f;
+};
+
+// 自动哇音核心：状态变量带通滤波器，中心频率在300Hz-3kHz间扫动，反馈控制谐振
+class AutoWahCore {
+public:
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        const float f = min_coefficient_ + range_ * (0.5f + 0.5f * lfo);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            float& low = low_[ch];
+            float& band = band_[ch];
+            const float x = in[ch];
+            const float high = x - low - damping_ * band;
+            band += f * high;
+            low += f * band;
+            out[ch] = dry_ * x + wet_ * band;
+        }
+    }
+
+private:
+    std::vector<float> low_;
+    std::vector<float> band_;
+    float min_coefficient_ = 0.0f;
+    float range_ = 0.0f;
+    float damping_ = 1.0f;
+    float dry_ = 1.0f;
+    float wet_ = 0.0f;
+};
+
+// 波形整形核心：LFO调制驱动量，有理函数近似tanh软削波，反馈作为不对称偏置
+class WaveshaperCore {
+public:
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    // 设置基础驱动量与形状（形状在硬/软削波之间插值）
+    void setDrive(float drive);
+    void setShape(float shape);
+    float getDrive() const { return drive_; }
+    float getShape() const { return shape_; }
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        const float drive = drive_ * (1.0f + depth_ * (0.5f + 0.5f * lfo) * 4.0f);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const float x = in[ch];
+            const float shaped = shapeSample(x * drive + bias_) - bias_shaped_;
+            out[ch] = dry_ * x + wet_ * shaped;
+        }
+    }
+
+private:
+    inline float shapeSample(float x) const {
+        const float clipped = std::clamp(x, -3.0f, 3.0f);
+        const float soft = clipped * (27.0f + clipped * clipped) / (27.0f + 9.0f * clipped * clipped);
+        const float hard = std::clamp(x, -1.0f, 1.0f);
+        return soft + shape_ * (hard - soft);
+    }
+
+    float drive_ = 1.0f;
+    float shape_ = 0.0f;
+    float depth_ = 0.0f;
+    float bias_ = 0.0f;
+    float bias_shaped_ = 0.0f;
+    float dry_ = 1.0f;
+    float wet_ = 0.0f;
+};
+
+// 声码器调制核心：内部载波与输入环形调制，LFO扫动载波频率
+class VocoderCore {
+public:
+    void prepare(int sample_rate, size_t channels);
+    void reset();
+    void update(const ModulationParameters& params, int sample_rate);
+
+    // 设置载波基础频率 (Hz)
+    void setCarrierFrequency(float frequency);
+    float getCarrierFrequency() const { return carrier_frequency_; }
+
+    inline void process(const float* in, float* out, size_t channels, float lfo) {
+        const float carrier = fastSine(carrier_phase_);
+        carrier_phase_ += carrier_increment_ * (1.0f + sweep_ * lfo);
+        carrier_phase_ -= std::floor(carrier_phase_);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const float x = in[ch];
+            out[ch] = dry_ * x + wet_ * x * carrier;
+        }
+    }
+
+private:
+    int sample_rate_ = 44100;
+    float carrier_frequency_ = 440.0f;
+    float carrier_increment_ = 0.0f;
+    float carrier_phase_ = 0.0f;
+    float sweep_ = 0.0f;
+    float dry_ = 1.0f;
+    float wet_ = 0.0f;
+};
+
+} // namespace modulation
+} // namespace core
+
+#endif // CORE_AUDIO_MODULATION_CORES_H
@@ -0,0 +1,81 @@
+#ifndef CORE_AUDIO_OSCILLATOR_BANK_H
+#define CORE_AUDIO_OSCILLATOR_BANK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+// 流式振荡器组：N个相位累加振荡器按块渲染，状态按数组结构（SoA）存放，
+// 每个振荡器的块循环无分支、沿时间轴向量化；方波/锯齿波/三角波可选PolyBLEP/PolyBLAMP抗混叠。
+// 不跨振荡器向量化：各振荡器的波形可以不同，跨通道需要逐通道混合四种波形并在每帧做水平求和。
+class AudioOscillatorBank {
+public:
+    // 波形类型
+    enum class Waveform : uint8_t {
+        SINE = 0,
+        SQUARE = 1,
+        TRIANGLE = 2,
+        SAWTOOTH = 3
+    };
+
+    // 抗混叠模式
+    enum class AntiAliasing {
+        NONE,       // 朴素波形
+        POLYBLEP    // 不连续点使用PolyBLEP/PolyBLAMP校正
+    };
+
+    // 构造函数
+    AudioOscillatorBank();
+
+    // 设置采样率
+    bool setSampleRate(int sample_rate);
+
+    // 获取采样率
+    int getSampleRate() const;
+
+    // 设置振荡器数量（预分配状态，不在渲染时分配）
+    void setOscillatorCount(size_t count);
+
+    // 获取振荡器数量
+    size_t getOscillatorCount() const;
+
+    // 配置振荡器
+    bool setOscillator(size_t index, Waveform waveform, float frequency, float amplitude);
+
+    // 设置振荡器频率
+    bool setFrequency(size_t index, float frequency);
+
+    // 设置振荡器幅度
+    bool setAmplitude(size_t index, float amplitude);
+
+    // 设置/获取抗混叠模式
+    void setAntiAliasing(AntiAliasing mode);
+    AntiAliasing getAntiAliasing() const;
+
+    // 渲染所有振荡器之和到output（覆盖写入）
+    void render(float* output, size_t frames);
+
+    // 渲染单个振荡器到output（覆盖写入）
+    void renderOscillator(size_t index, float* output, size_t frames);
+
+    // 将所有相位归零
+    void resetPhases();
+
+private:
+    // 渲染一个振荡器并推进其相位
+    void renderInto(size_t index, float* output, size_t frames, bool accumulate);
+
+    // 私有成员变量
+    int sample_rate_;
+    AntiAliasing anti_aliasing_;
+    std::vector<float> phases_;
+    std::vector<float> increments_;
+    std::vector<float> amplitudes_;
+    std::vector<Waveform> waveforms_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_OSCILLATOR_BANK_H
@@ -0,0 +1,90 @@
+#ifndef CORE_AUDIO_OVERSAMPLER_H
+#define CORE_AUDIO_OVERSAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+// 半带FIR插值/抽取级（多相实现）：半带滤波器偶数系数除中心外均为零，
+// 升采样时偶数相位为纯延迟，奇数相位与降采样都只需计算非零系数。
+// 卷积按"每个系数对整块做一次乘加"的顺序展开，内层循环可向量化
+class HalfbandStage {
+public:
+    // 设置半长K（滤波器长度4K+1，奇数相位2K个系数）并设计系数
+    void design(size_t half_length);
+
+    // 预分配输入块最大长度
+    void prepare(size_t max_frames);
+
+    // 清空历史
+    void reset();
+
+    // 2倍升采样：input为frames个样本，output为2 * frames个样本
+    void upsample(const float* input, size_t frames, float* output);
+
+    // 2倍降采样：input为2 * frames个样本，output为frames个样本
+    void downsample(const float* input, size_t frames, float* output);
+
+    // 往返延迟（输入采样率下的样本数）
+    size_t getLatency() const { return 2 * half_length_; }
+
+private:
+    size_t half_length_ = 0;
+    std::vector<float> taps_;           // 奇数相位系数 h[1], h[3], ..., h[4K-1]
+    std::vector<float> up_work_;        // 升采样：历史 + 输入块
+    std::vector<float> up_odd_;         // 升采样：奇数相位累加
+    std::vector<float> down_even_;      // 降采样：偶数样本历史 + 输入块
+    std::vector<float> down_odd_;       // 降采样：奇数样本历史 + 输入块
+};
+
+// 音频过采样器：1/2/4/8倍，由半带级级联组成（首级较长，后级过渡带更宽而较短）。
+// 逐声道使用：upsample返回内部缓冲区，调用者在其中原地处理后调用downsample，
+// 再处理下一个声道（各声道共享工作缓冲区，但滤波器历史独立）
+class AudioOversampler {
+public:
+    // 构造函数
+    AudioOversampler();
+
+    // 设置过采样倍数（1、2、4或8）
+    bool setFactor(size_t factor);
+
+    // 获取过采样倍数
+    size_t getFactor() const;
+
+    // 按声道数与最大块长分配缓冲区（不在音频线程上调用）
+    void prepare(size_t channels, size_t max_frames);
+
+    // 获取已分配的最大块长
+    size_t getMaxFrames() const;
+
+    // 升采样一个声道：input按stride跨步读取frames个样本，返回frames * factor个样本
+    float* upsample(size_t channel, const float* input, size_t frames, size_t stride = 1);
+
+    // 降采样一个声道：从upsample返回的缓冲区读取，按stride跨步写入frames个样本
+    void downsample(size_t channel, float* output, size_t frames, size_t stride = 1);
+
+    // 往返延迟（原采样率下的帧数）
+    size_t getLatency() const;
+
+    // 清空所有滤波器历史
+    void reset();
+
+private:
+    // 重建各声道的滤波器级
+    void rebuild();
+
+    // 私有成员变量
+    size_t factor_;
+    size_t stage_count_;
+    size_t channels_;
+    size_t max_frames_;
+    std::vector<std::vector<HalfbandStage>> stages_;   // [声道][级]
+    std::vector<float> buffer_a_;
+    std::vector<float> buffer_b_;
+    float* result_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_OVERSAMPLER_H
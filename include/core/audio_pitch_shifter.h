@@ -2,44 +2,114 @@
 #define CORE_AUDIO_PITCH_SHIFTER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_fft.h"
 #include <memory>
+#include <vector>
 
 namespace core {
 
 // 音频音高变换器类
+// 基于相位声码器的流式实现：频谱峰值区域按音高比例平移并锁定相位，
+// 可选倒谱包络校正以保持共振峰。分析缓冲区在initialize/setFormat时预分配，apply中不分配内存。
+// 直接在频域移调，不走“时间伸缩+重采样”两步：省去重采样器与其额外延迟，
+// 且峰值区域平移保持了主瓣形状，对和声类素材的相位感与重采样方案相当
 class AudioPitchShifter {
 public:
     // 构造函数
     AudioPitchShifter();
-    
+
     // 析构函数
     ~AudioPitchShifter();
-    
+
     // 初始化音高变换器
     bool initialize();
-    
+
     // 关闭音高变换器
     void shutdown();
-    
-    // 应用音高变换效果
+
+    // 应用音高变换效果（input为交错格式，可与output为同一缓冲区）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置音高变换参数
+
+    // 设置音高变换参数（pitch_shift为频率比例，1.0为不变）
     bool setParameters(float pitch_shift, float mix);
-    
+
     // 获取音高变换参数
     void getParameters(float& pitch_shift, float& mix) const;
-    
+
+    // 按半音设置音高变换量（用于变调功能）
+    bool setSemitones(float semitones);
+
+    // 设置音频格式（重新分配各声道的分析缓冲区）
+    bool setFormat(int sample_rate, int channels);
+
+    // 启用/禁用共振峰保持
+    void setFormantPreservation(bool enabled);
+
+    // 检查是否启用共振峰保持
+    bool isFormantPreservationEnabled() const;
+
+    // 获取处理延迟（帧）
+    size_t getLatency() const;
+
     // 重置音高变换器
     void reset();
-    
+
 private:
+    // 每声道的流式状态
+    struct ChannelState {
+        std::vector<float> in_fifo;
+        std::vector<float> out_fifo;
+        std::vector<float> output_accum;
+        std::vector<float> last_phase;
+        std::vector<float> sum_phase;
+        std::vector<float> dry_delay;   // 干信号的一跳延迟
+        size_t rover;
+    };
+
+    // 处理一个分析帧
+    void processFrame(ChannelState& state);
+
+    // 计算当前帧的倒谱包络（结果写入envelope）
+    void computeEnvelope(const float* magnitude, float* envelope);
+
+    // 分配并清零所有状态
+    void allocateState();
+
+    // 清零流式状态（保留分配）
+    void clearState();
+
+    // 帧长与重叠系数
+    static constexpr size_t kFrameSize = 2048;
+    static constexpr size_t kOversampling = 4;
+    static constexpr size_t kHopSize = kFrameSize / kOversampling;
+    static constexpr size_t kFifoLatency = kFrameSize - kHopSize;
+
     // 私有成员变量
     bool initialized_;
     float pitch_shift_;   // 音高变换量
     float mix_;           // 混合比例
+    int sample_rate_;
+    int channels_;
+    bool preserve_formants_;
+
+    AudioFFT fft_;
+    std::vector<ChannelState> states_;
+
+    // 帧处理共享的工作缓冲区
+    std::vector<float> window_;
+    std::vector<float> fft_re_;
+    std::vector<float> fft_im_;
+    std::vector<float> analysis_magnitude_;
+    std::vector<float> analysis_phase_;
+    std::vector<float> analysis_frequency_;
+    std::vector<float> synthesis_magnitude_;
+    std::vector<float> synthesis_phase_;
+    std::vector<size_t> peaks_;
+    std::vector<float> envelope_;
+    std::vector<float> cepstrum_re_;
+    std::vector<float> cepstrum_im_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_PITCH_SHIFTER_H
\ No newline at end of file
+#endif // CORE_AUDIO_PITCH_SHIFTER_H
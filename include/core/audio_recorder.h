@@ -2,6 +2,7 @@
 #define CORE_AUDIO_RECORDER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_gate.h"
 #include <string>
 #include <memory>
 
@@ -55,6 +56,15 @@ public:
     // 保存录制的音频数据
     bool saveRecording();
     
+    // 启用/禁用输入门控（所有输入声道在同一个门控器中并行处理）
+    void setInputGateEnabled(bool enabled);
+    
+    // 检查输入门控是否启用
+    bool isInputGateEnabled() const;
+    
+    // 获取输入门控器（用于设置阈值、保持时间等）
+    AudioGate& getInputGate();
+    
 private:
     // 私有成员变量
     bool initialized_;
@@ -65,6 +75,9 @@ private:
     int channels_;
     int bit_depth_;
     AudioBuffer audio_buffer_;
+    AudioGate input_gate_;
+    bool input_gate_enabled_;
+    AudioBuffer gated_buffer_;
 };
 
 } // namespace core
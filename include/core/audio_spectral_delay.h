@@ -2,11 +2,16 @@
 #define CORE_AUDIO_SPECTRAL_DELAY_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_spectral_kernels.h"
+#include "core/audio_stft.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频频谱延迟器类
+// 在STFT域中每个频点独立延迟并反馈，filter_freq以上的频点回声逐次衰减；
+// 延迟以跳跃长度为单位量化，输出相对输入另有getLatency()帧的固定延迟
 class AudioSpectralDelay {
 public:
     // 构造函数
@@ -21,27 +26,59 @@ public:
     // 关闭频谱延迟器
     void shutdown();
     
-    // 应用频谱延迟效果
+    // 应用频谱延迟效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置频谱延迟参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+    
+    // 设置频谱延迟参数：delay_time（毫秒，1-2000），feedback（-0.95-0.95），mix（0-1），filter_freq（Hz）
     bool setParameters(float delay_time, float feedback, float mix, float filter_freq);
     
     // 获取频谱延迟参数
     void getParameters(float& delay_time, float& feedback, float& mix, float& filter_freq) const;
     
+    // 设置频点延迟倾斜（-1-1）：正值高频延迟更长，负值低频延迟更长
+    bool setSpread(float spread);
+    
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
+    // 设置STFT帧长（2的幂）与跳跃长度
+    bool setResolution(size_t frame_size, size_t hop_size);
+    
+    // 处理延迟（帧）
+    size_t getLatency() const;
+    
     // 重置频谱延迟器
     void reset();
     
 private:
+    // 按当前格式与分辨率分配STFT与延迟核
+    bool configure();
+    
+    // 更新延迟核的延迟与增益
+    void updateKernel();
+    
+    // 最大延迟时间（毫秒）
+    static constexpr float kMaxDelay = 2000.0f;
+    
     // 私有成员变量
     bool initialized_;
     float delay_time_;     // 延迟时间
     float feedback_;       // 反馈量
     float mix_;            // 混合比例
     float filter_freq_;    // 滤波频率
+    float spread_;         // 频点延迟倾斜
+    int sample_rate_;
+    int channels_;
+    size_t frame_size_;
+    size_t hop_size_;
+    
+    StftEngine stft_;
+    spectral::DelayKernel kernel_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_SPECTRAL_DELAY_H
\ No newline at end of file
+#endif // CORE_AUDIO_SPECTRAL_DELAY_H
@@ -2,11 +2,16 @@
 #define CORE_AUDIO_SPECTRAL_DELAY_MODULATED_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_modulated_effect.h"
+#include "core/audio_spectral_kernels.h"
+#include "core/audio_stft.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频调制频谱延迟器类
+// 频谱延迟的所有频点延迟随LFO（每个STFT帧更新一次）在0.5到1.5倍之间按深度缩放
 class AudioSpectralDelayModulated {
 public:
     // 构造函数
@@ -21,29 +26,68 @@ public:
     // 关闭调制频谱延迟器
     void shutdown();
     
-    // 应用调制频谱延迟效果
+    // 应用调制频谱延迟效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置调制频谱延迟参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+    
+    // 设置调制频谱延迟参数（modulation_rate/modulation_depth为LFO速率与深度）
     bool setParameters(float delay_time, float feedback, float mix, float filter_freq, float modulation_rate, float modulation_depth);
     
     // 获取调制频谱延迟参数
     void getParameters(float& delay_time, float& feedback, float& mix, float& filter_freq, float& modulation_rate, float& modulation_depth) const;
     
+    // 设置调制参数（版本2/3接口，含义同modulation::ModulatedEffectBase，延迟时间与滤波频率保持不变）
+    bool setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth, float lfo_waveform);
+    
+    // 获取调制参数（版本2/3接口）
+    void getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth, float& lfo_waveform) const;
+    
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
+    // 设置STFT帧长（2的幂）与跳跃长度
+    bool setResolution(size_t frame_size, size_t hop_size);
+    
+    // 处理延迟（帧）
+    size_t getLatency() const;
+    
     // 重置调制频谱延迟器
     void reset();
     
 private:
+    // 原地处理交错帧
+    void processFrames(float* data, size_t frames);
+    
+    // 按当前格式与分辨率分配STFT与延迟核
+    bool configure();
+    
+    // 更新延迟核的延迟与增益
+    void updateKernel();
+    
+    // 最大延迟时间（毫秒，调制前）
+    static constexpr float kMaxDelay = 2000.0f;
+    
     // 私有成员变量
     bool initialized_;
     float delay_time_;        // 延迟时间
-    float feedback_;          // 反馈量
-    float mix_;               // 混合比例
     float filter_freq_;       // 滤波频率
-    float modulation_rate_;  // 调制速率
-    float modulation_depth_; // 调制深度
+    modulation::ModulationParameters params_;  // LFO与反馈/混合参数
+    int sample_rate_;
+    int channels_;
+    size_t frame_size_;
+    size_t hop_size_;
+    
+    StftEngine stft_;
+    spectral::DelayKernel kernel_;
+    spectral::FrameLfo lfo_;
 };
 
+// 版本2/3已合并，保留类名以兼容旧代码
+using AudioSpectralDelayModulated2 = AudioSpectralDelayModulated;
+using AudioSpectralDelayModulated3 = AudioSpectralDelayModulated;
+
 } // namespace core
 
-#endif // CORE_AUDIO_SPECTRAL_DELAY_MODULATED_H
\ No newline at end of file
+#endif // CORE_AUDIO_SPECTRAL_DELAY_MODULATED_H
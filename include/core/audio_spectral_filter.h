@@ -2,11 +2,15 @@
 #define CORE_AUDIO_SPECTRAL_FILTER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_spectral_kernels.h"
+#include "core/audio_stft.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频频谱滤波器类
+// 在STFT域中以零相位掩码逐频点加权，输出相对输入有getLatency()帧的固定延迟
 class AudioSpectralFilter {
 public:
     // 构造函数
@@ -21,26 +25,48 @@ public:
     // 关闭频谱滤波器
     void shutdown();
     
-    // 应用频谱滤波效果
+    // 应用频谱滤波效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置频谱滤波参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+    
+    // 设置频谱滤波参数：frequency（Hz），q_factor（0.1-20），filter_type（0-2）
     bool setParameters(float frequency, float q_factor, int filter_type);
     
     // 获取频谱滤波参数
     void getParameters(float& frequency, float& q_factor, int& filter_type) const;
     
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
+    // 设置STFT帧长（2的幂）与跳跃长度
+    bool setResolution(size_t frame_size, size_t hop_size);
+    
+    // 处理延迟（帧）
+    size_t getLatency() const;
+    
     // 重置频谱滤波器
     void reset();
     
 private:
+    // 按当前格式与分辨率分配STFT与掩码
+    bool configure();
+    
     // 私有成员变量
     bool initialized_;
     float frequency_;     // 截止频率
     float q_factor_;      // Q因子
     int filter_type_;     // 滤波类型 (0: lowpass, 1: highpass, 2: bandpass)
+    int sample_rate_;
+    int channels_;
+    size_t frame_size_;
+    size_t hop_size_;
+    
+    StftEngine stft_;
+    spectral::FilterKernel kernel_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_SPECTRAL_FILTER_H
\ No newline at end of file
+#endif // CORE_AUDIO_SPECTRAL_FILTER_H
@@ -2,11 +2,16 @@
 #define CORE_AUDIO_SPECTRAL_FILTER_MODULATED_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_modulated_effect.h"
+#include "core/audio_spectral_kernels.h"
+#include "core/audio_stft.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频调制频谱滤波器类
+// 截止频率随LFO（每个STFT帧更新一次）在上下两个八度乘以深度的范围内扫动，每帧重算掩码
 class AudioSpectralFilterModulated {
 public:
     // 构造函数
@@ -21,28 +26,64 @@ public:
     // 关闭调制频谱滤波器
     void shutdown();
     
-    // 应用调制频谱滤波效果
+    // 应用调制频谱滤波效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
     
-    // 设置调制频谱滤波参数
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+    
+    // 设置调制频谱滤波参数（modulation_rate/modulation_depth为LFO速率与深度）
     bool setParameters(float frequency, float q_factor, int filter_type, float modulation_rate, float modulation_depth);
     
     // 获取调制频谱滤波参数
     void getParameters(float& frequency, float& q_factor, int& filter_type, float& modulation_rate, float& modulation_depth) const;
     
+    // 设置调制参数（版本2/3接口，含义同modulation::ModulatedEffectBase；
+    // feedback映射为谐振 Q = 0.707 / (1 - |feedback|)，截止频率与滤波类型保持不变）
+    bool setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth, float lfo_waveform);
+    
+    // 获取调制参数（版本2/3接口）
+    void getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth, float& lfo_waveform) const;
+    
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+    
+    // 设置STFT帧长（2的幂）与跳跃长度
+    bool setResolution(size_t frame_size, size_t hop_size);
+    
+    // 处理延迟（帧）
+    size_t getLatency() const;
+    
     // 重置调制频谱滤波器
     void reset();
     
 private:
+    // 原地处理交错帧
+    void processFrames(float* data, size_t frames);
+    
+    // 按当前格式与分辨率分配STFT与掩码
+    bool configure();
+    
     // 私有成员变量
     bool initialized_;
     float frequency_;        // 截止频率
     float q_factor_;         // Q因子
     int filter_type_;        // 滤波类型 (0: lowpass, 1: highpass, 2: bandpass)
-    float modulation_rate_;   // 调制速率
-    float modulation_depth_; // 调制深度
+    modulation::ModulationParameters params_;  // LFO与混合参数
+    int sample_rate_;
+    int channels_;
+    size_t frame_size_;
+    size_t hop_size_;
+    
+    StftEngine stft_;
+    spectral::FilterKernel kernel_;
+    spectral::FrameLfo lfo_;
 };
 
+// 版本2/3已合并，保留类名以兼容旧代码
+using AudioSpectralFilterModulated2 = AudioSpectralFilterModulated;
+using AudioSpectralFilterModulated3 = AudioSpectralFilterModulated;
+
 } // namespace core
 
-#endif // CORE_AUDIO_SPECTRAL_FILTER_MODULATED_H
\ No newline at end of file
+#endif // CORE_AUDIO_SPECTRAL_FILTER_MODULATED_H
@@ -0,0 +1,130 @@
+#ifndef CORE_AUDIO_SPECTRAL_KERNELS_H
+#define CORE_AUDIO_SPECTRAL_KERNELS_H
+
+#include "core/audio_modulated_effect.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+namespace spectral {
+
+// 逐STFT帧更新的LFO（波形与速率二次调制的含义同modulation::ModulatedEffectBase）
+class FrameLfo {
+public:
+    // 构造函数
+    FrameLfo();
+
+    // 返回当前LFO值（-1到1）并前进seconds秒
+    float advance(const modulation::ModulationParameters& params, float seconds);
+
+    // 相位归零
+    void reset();
+
+private:
+    float phase_;
+    uint32_t cycle_;
+    float rate_phase_;
+};
+
+// 频谱滤波核：每个频点乘以实数掩码（零相位），掩码取二阶模拟原型的幅频响应
+class FilterKernel {
+public:
+    // 滤波类型（与旧接口的filter_type取值一致）
+    enum Type {
+        LOWPASS = 0,
+        HIGHPASS = 1,
+        BANDPASS = 2
+    };
+
+    // 构造函数
+    FilterKernel();
+
+    // 分配掩码（不在音频线程上调用）
+    void prepare(int sample_rate, size_t frame_size);
+
+    // 计算掩码：mix为湿声比例（掩码 = 1 - mix + mix * |H|）
+    void design(int type, float frequency, float q, float mix);
+
+    // StftEngine回调
+    void beginFrame() {}
+
+    inline void processBins(size_t, float* __restrict re, float* __restrict im, size_t bins) {
+        const float* __restrict mask = mask_.data();
+        for (size_t k = 0; k < bins; ++k) {
+            re[k] *= mask[k];
+            im[k] *= mask[k];
+        }
+    }
+
+private:
+    std::vector<float> mask_;
+    float bin_hz_;
+};
+
+// 频谱延迟核：每个频点有独立的整数帧延迟（以STFT跳跃为单位）与反馈，
+// 历史频谱按[声道][槽][频点]存放，延迟相同的相邻频点合并为一段连续循环
+class DelayKernel {
+public:
+    // 构造函数
+    DelayKernel();
+
+    // 分配历史缓冲区：最大延迟max_delay帧（不在音频线程上调用）
+    void prepare(size_t channels, size_t bins, size_t max_delay);
+
+    // 设置延迟（帧）与频点延迟倾斜：频点k的延迟为delay * (1 + spread * (2k / (bins - 1) - 1))
+    void setDelay(float delay, float spread);
+
+    // 调制时缩放所有频点的延迟（1为不缩放）
+    void setScale(float scale);
+
+    // 设置反馈与湿声比例，cutoff_bin以上的频点反馈与湿声按二阶低通衰减
+    void setGains(float feedback, float mix, float cutoff_bin);
+
+    // 清空历史
+    void clear();
+
+    // StftEngine回调
+    void beginFrame() { ++frame_; }
+
+    void processBins(size_t channel, float* re, float* im, size_t bins);
+
+private:
+    // 由基础延迟与缩放计算每个频点的延迟并划分等延迟段
+    void updateDelays();
+
+    // 一段等延迟频点：hist_out = X + fb * D，X = dry * X + wet * D
+    static void processRun(float* __restrict re, float* __restrict im,
+                           const float* __restrict delayed_re, const float* __restrict delayed_im,
+                           float* __restrict hist_re, float* __restrict hist_im,
+                           const float* __restrict feedback, const float* __restrict wet,
+                           float dry, size_t count);
+
+    // 等延迟段
+    struct Run {
+        size_t begin;
+        size_t end;
+        size_t delay;
+    };
+
+    size_t channels_;
+    size_t bins_;
+    size_t slots_;
+    size_t max_delay_;
+    size_t frame_;
+    float delay_;
+    float spread_;
+    float scale_;
+    float dry_;
+
+    std::vector<float> feedback_;   // 每频点反馈增益
+    std::vector<float> wet_;        // 每频点湿声增益
+    std::vector<Run> runs_;
+    std::vector<float> history_re_;
+    std::vector<float> history_im_;
+};
+
+} // namespace spectral
+} // namespace core
+
+#endif // CORE_AUDIO_SPECTRAL_KERNELS_H
@@ -2,45 +2,78 @@
 #define CORE_AUDIO_STEREO_ENHANCER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_mid_side.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频立体声增强器类
+// M/S矩阵调整宽度与左右平衡，哈斯延迟把中间信号去相关后加入侧边信号，
+// 低频部分保持单声道。交错立体声原地处理，apply中不分配内存
 class AudioStereoEnhancer {
 public:
     // 构造函数
     AudioStereoEnhancer();
-    
+
     // 析构函数
     ~AudioStereoEnhancer();
-    
+
     // 初始化立体声增强器
     bool initialize();
-    
+
     // 关闭立体声增强器
     void shutdown();
-    
-    // 应用立体声增强效果
+
+    // 应用立体声增强效果（交错立体声，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置增强参数
+
+    // 原地处理（视图必须为双声道）
+    bool process(AudioView view);
+
+    // 设置增强参数：stereo_width范围0-2，stereo_imbalance范围-1（偏左）到1（偏右），mix范围0-1
     bool setParameters(float stereo_width, float stereo_imbalance, float mix);
-    
+
     // 获取增强参数
     void getParameters(float& stereo_width, float& stereo_imbalance, float& mix) const;
-    
+
+    // 设置采样率
+    void setSampleRate(int sample_rate);
+
+    // 设置哈斯延迟（1-30毫秒）与去相关量（0-1）
+    bool setDecorrelation(float delay_ms, float amount);
+
+    // 获取哈斯延迟与去相关量
+    void getDecorrelation(float& delay_ms, float& amount) const;
+
+    // 设置低频单声道化的分频频率（Hz），0为关闭
+    bool setBassMonoFrequency(float frequency);
+
     // 重置立体声增强器
     void reset();
-    
+
 private:
+    // 原地处理交错立体声帧
+    void processFrames(float* data, size_t frames);
+
+    // 哈斯延迟上限（毫秒）
+    static constexpr float kMaxHaasDelay = 30.0f;
+
     // 私有成员变量
     bool initialized_;
     float stereo_width_;       // 立体声宽度
     float stereo_imbalance_;   // 立体声不平衡度
     float mix_;                // 混合比例
+    int sample_rate_;
+    float haas_delay_;         // 哈斯延迟（毫秒）
+    float decorrelation_;      // 去相关量
+    float bass_mono_freq_;
+
+    stereo::StereoMatrix current_;
+    stereo::HaasDecorrelator haas_;
+    stereo::BassMonoFilter bass_mono_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_STEREO_ENHANCER_H
\ No newline at end of file
+#endif // CORE_AUDIO_STEREO_ENHANCER_H
@@ -2,44 +2,68 @@
 #define CORE_AUDIO_STEREO_WIDENER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_mid_side.h"
+#include "core/audio_view.h"
 #include <memory>
 
 namespace core {
 
 // 音频立体声扩展器类
+// 在交错立体声上原地做M/S矩阵：width为侧边信号增益（0为单声道，1为原样，2为两倍宽度），
+// 可选的低频单声道化把分频点以下的声像收拢到中间
 class AudioStereoWidener {
 public:
     // 构造函数
     AudioStereoWidener();
-    
+
     // 析构函数
     ~AudioStereoWidener();
-    
+
     // 初始化立体声扩展器
     bool initialize();
-    
+
     // 关闭立体声扩展器
     void shutdown();
-    
-    // 应用立体声扩展效果
+
+    // 应用立体声扩展效果（交错立体声，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置立体声扩展参数
+
+    // 原地处理（视图必须为双声道）
+    bool process(AudioView view);
+
+    // 设置立体声扩展参数：width范围0-2，mix范围0-1
     bool setParameters(float width, float mix);
-    
+
     // 获取立体声扩展参数
     void getParameters(float& width, float& mix) const;
-    
+
+    // 设置采样率
+    void setSampleRate(int sample_rate);
+
+    // 设置低频单声道化的分频频率（Hz），0为关闭
+    bool setBassMonoFrequency(float frequency);
+
+    // 获取低频单声道化的分频频率
+    float getBassMonoFrequency() const;
+
     // 重置立体声扩展器
     void reset();
-    
+
 private:
+    // 原地处理交错立体声帧
+    void processFrames(float* data, size_t frames);
+
     // 私有成员变量
     bool initialized_;
     float width_;   // 立体声宽度
     float mix_;     // 混合比例
+    int sample_rate_;
+    float bass_mono_freq_;
+
+    stereo::StereoMatrix current_;   // 上一块结束时的矩阵，参数变化时在下一块内平滑过渡
+    stereo::BassMonoFilter bass_mono_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_STEREO_WIDENER_H
\ No newline at end of file
+#endif // CORE_AUDIO_STEREO_WIDENER_H
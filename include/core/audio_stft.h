@@ -0,0 +1,132 @@
+#ifndef CORE_AUDIO_STFT_H
+#define CORE_AUDIO_STFT_H
+
+#include "core/audio_fft.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+// 分析/合成窗
+enum class StftWindow {
+    HANN,
+    HAMMING,
+    BLACKMAN
+};
+
+// 流式短时傅里叶变换：分析加窗 -> FFT -> 逐频点处理 -> IFFT -> 合成加窗叠加。
+// 两个声道打包为一次复数FFT（x1 + i*x2）后再拆分，立体声每帧只需一次正变换与一次逆变换。
+// 频谱以实部/虚部分离数组存放（bins = frame_size / 2 + 1），逐频点循环可向量化。
+// 频点处理由模板参数Kernel在编译期内联，需实现：
+//   void beginFrame();                                                   // 每帧所有声道之前调用一次
+//   void processBins(size_t channel, float* re, float* im, size_t bins); // 原地修改频谱
+// 处理延迟为frame_size帧；所有缓冲区在configure中分配
+class StftEngine {
+public:
+    // 构造函数
+    StftEngine();
+
+    // 配置声道数、帧长（2的幂）、跳跃长度（整除帧长，不超过帧长一半）与窗函数（会分配内存）
+    bool configure(size_t channels, size_t frame_size, size_t hop_size, StftWindow window = StftWindow::HANN);
+
+    // 获取配置
+    size_t getChannels() const;
+    size_t getFrameSize() const;
+    size_t getHopSize() const;
+    size_t getBinCount() const;
+
+    // 处理延迟（帧）
+    size_t getLatency() const;
+
+    // 清空输入/输出历史
+    void reset();
+
+    // 原地处理交错帧
+    template <typename Kernel>
+    void process(float* data, size_t frames, Kernel& kernel);
+
+private:
+    // 一帧：分析所有声道、调用Kernel、合成所有声道
+    template <typename Kernel>
+    void processFrame(Kernel& kernel);
+
+    // 分析从first开始的count个声道（1或2个，打包为一次FFT）
+    void analyze(size_t first, size_t count);
+
+    // 合成从first开始的count个声道并叠加到输出累加器
+    void synthesize(size_t first, size_t count);
+
+    // 帧结束：输出一个跳跃长度的样本，移动输入与累加器
+    void advance();
+
+    size_t channels_;
+    size_t frame_size_;
+    size_t hop_size_;
+    size_t bins_;
+    size_t rover_;
+
+    AudioFFT fft_;
+    std::vector<float> window_;
+    std::vector<float> synthesis_window_;  // 合成窗（除以窗平方的叠加和，任意窗均可完全重建）
+    std::vector<float> input_;        // 每声道frame_size个输入样本
+    std::vector<float> output_;       // 每声道hop_size个待输出样本
+    std::vector<float> accumulator_;  // 每声道frame_size个叠加样本
+    std::vector<float> fft_re_;
+    std::vector<float> fft_im_;
+    std::vector<float> spectrum_re_;  // 每声道bins个频点
+    std::vector<float> spectrum_im_;
+};
+
+template <typename Kernel>
+void StftEngine::process(float* data, size_t frames, Kernel& kernel) {
+    if (frame_size_ == 0) {
+        return;
+    }
+
+    const size_t channels = channels_;
+    // 输入FIFO在帧之间保留frame_size - hop_size个旧样本
+    const size_t overlap = frame_size_ - hop_size_;
+    size_t done = 0;
+    while (done < frames) {
+        // 到下一帧边界为止的一段：写入输入FIFO，同时取出上一帧输出的对应样本
+        const size_t count = std::min(frames - done, frame_size_ - rover_);
+        float* x = data + done * channels;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            float* in = input_.data() + ch * frame_size_ + rover_;
+            const float* out = output_.data() + ch * hop_size_ + (rover_ - overlap);
+            for (size_t i = 0; i < count; ++i) {
+                in[i] = x[i * channels + ch];
+                x[i * channels + ch] = out[i];
+            }
+        }
+
+        rover_ += count;
+        done += count;
+        if (rover_ == frame_size_) {
+            processFrame(kernel);
+            rover_ = overlap;
+        }
+    }
+}
+
+template <typename Kernel>
+void StftEngine::processFrame(Kernel& kernel) {
+    for (size_t ch = 0; ch < channels_; ch += 2) {
+        analyze(ch, std::min<size_t>(2, channels_ - ch));
+    }
+
+    kernel.beginFrame();
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        kernel.processBins(ch, spectrum_re_.data() + ch * bins_, spectrum_im_.data() + ch * bins_, bins_);
+    }
+
+    for (size_t ch = 0; ch < channels_; ch += 2) {
+        synthesize(ch, std::min<size_t>(2, channels_ - ch));
+    }
+    advance();
+}
+
+} // namespace core
+
+#endif // CORE_AUDIO_STFT_H
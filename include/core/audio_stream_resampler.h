@@ -0,0 +1,61 @@
+#ifndef CORE_AUDIO_STREAM_RESAMPLER_H
+#define CORE_AUDIO_STREAM_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+// 流式多相重采样器：采样率之比约分为L/M（输出/输入），原型为Kaiser窗sinc低通，
+// 按L个相位各T个系数存储，每个输出样本是一次T点点积（SSE2可用时4路并行）。
+// 拉取式接口：调用者先用getInputFrames查询下一块需要的输入帧数，再提供恰好这么多帧，
+// 因此输出块长固定、不需要内部FIFO。样本为交错格式，内部按声道平面存放历史
+class StreamResampler {
+public:
+    // 构造函数
+    StreamResampler();
+
+    // 设计滤波器并分配缓冲区：每次最多输出max_output_frames帧（不在音频线程上调用）
+    bool configure(int input_rate, int output_rate, size_t channels, size_t max_output_frames);
+
+    // 输入/输出采样率
+    int getInputRate() const;
+    int getOutputRate() const;
+
+    // 声道数
+    size_t getChannels() const;
+
+    // 产生下一块output_frames帧所需的输入帧数
+    size_t getInputFrames(size_t output_frames) const;
+
+    // 每块最多需要的输入帧数（用于分配输入缓冲区）
+    size_t getMaxInputFrames() const;
+
+    // 重采样：input须恰好为getInputFrames(output_frames)帧
+    void process(const float* input, float* output, size_t output_frames);
+
+    // 滤波器群延迟（输出采样率下的帧数）
+    size_t getLatency() const;
+
+    // 清空历史与相位
+    void reset();
+
+private:
+    int input_rate_;
+    int output_rate_;
+    size_t channels_;
+    size_t up_;                         // L
+    size_t down_;                       // M
+    size_t taps_;                       // 每相位系数数T（8的倍数）
+    size_t max_output_frames_;
+    size_t max_input_frames_;
+    std::vector<float> table_;          // [相位][T]，按输入时间正序存放
+    std::vector<std::vector<float>> work_;  // [声道]：T帧历史 + 一块输入
+    int64_t index_;                     // 下一输出对应的输入下标（相对下一块输入开头，可为-1）
+    size_t phase_;                      // 下一输出的相位
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_STREAM_RESAMPLER_H
@@ -1,47 +1,370 @@
 #ifndef CORE_AUDIO_THREAD_POOL_H
 #define CORE_AUDIO_THREAD_POOL_H
 
-#include <thread>
-#include <queue>
+#include "platform/thread_manager.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <memory>
-#include <functional>
-#include <vector>
 #include <mutex>
-#include <condition_variable>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace core {
 
-// 音频线程池类
+// 任务优先级：工作线程总是先取高优先级的任务
+enum class TaskPriority {
+    HIGH = 0,       // 音频处理的扇出（效果图、混音总线）
+    NORMAL = 1,     // 解码等一般任务
+    LOW = 2         // 后台分析（响度扫描等）
+};
+
+// 可移动的无参任务：不超过kInlineSize字节的闭包直接存放在对象内部，不分配堆内存
+class AudioTask {
+public:
+    static constexpr size_t kInlineSize = 48;
+
+    AudioTask() noexcept : ops_(nullptr) {}
+
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, AudioTask>::value>>
+    AudioTask(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (storage_) Fn(std::forward<F>(f));
+            ops_ = &kInlineOps<Fn>;
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(f));
+            ops_ = &kHeapOps<Fn>;
+        }
+    }
+
+    AudioTask(AudioTask&& other) noexcept : ops_(other.ops_) {
+        if (ops_ != nullptr) {
+            ops_->move(other.storage_, storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    AudioTask& operator=(AudioTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            ops_ = other.ops_;
+            if (ops_ != nullptr) {
+                ops_->move(other.storage_, storage_);
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    AudioTask(const AudioTask&) = delete;
+    AudioTask& operator=(const AudioTask&) = delete;
+
+    ~AudioTask() {
+        reset();
+    }
+
+    // 执行任务
+    void operator()() {
+        ops_->invoke(storage_);
+    }
+
+    // 释放闭包
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template<typename Fn>
+    static void invokeInline(void* storage) {
+        (*static_cast<Fn*>(storage))();
+    }
+
+    template<typename Fn>
+    static void moveInline(void* from, void* to) noexcept {
+        new (to) Fn(std::move(*static_cast<Fn*>(from)));
+        static_cast<Fn*>(from)->~Fn();
+    }
+
+    template<typename Fn>
+    static void destroyInline(void* storage) noexcept {
+        static_cast<Fn*>(storage)->~Fn();
+    }
+
+    template<typename Fn>
+    static void invokeHeap(void* storage) {
+        (**static_cast<Fn**>(storage))();
+    }
+
+    static void moveHeap(void* from, void* to) noexcept {
+        *static_cast<void**>(to) = *static_cast<void**>(from);
+    }
+
+    template<typename Fn>
+    static void destroyHeap(void* storage) noexcept {
+        delete *static_cast<Fn**>(storage);
+    }
+
+    template<typename Fn>
+    static inline const Ops kInlineOps{&invokeInline<Fn>, &moveInline<Fn>, &destroyInline<Fn>};
+
+    template<typename Fn>
+    static inline const Ops kHeapOps{&invokeHeap<Fn>, &moveHeap, &destroyHeap<Fn>};
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    const Ops* ops_;
+};
+
+// 音频线程池类：工作窃取调度器。
+// 每个工作线程对每个优先级有一个Chase-Lev双端队列，工作线程内提交的任务压入自己的队列（LIFO），
+// 空闲线程从其他线程的队列顶端窃取（FIFO）；池外线程（如音频回调线程）提交到无锁的多生产者注入队列。
+// 任务节点取自预分配的无锁空闲链表，小闭包不分配堆内存；仅在有线程休眠时唤醒才会短暂加锁。
+// dispatch与TaskGroup执行的任务不得抛出异常
 class AudioThreadPool {
 public:
-    // 构造函数
-    explicit AudioThreadPool(size_t num_threads);
-    
+    // 构造函数：工作线程启动时应用role的调度策略（优先级与CPU绑定，见platform::ThreadManager）
+    explicit AudioThreadPool(size_t num_threads, platform::ThreadRole role = platform::ThreadRole::WORKER);
+
     // 析构函数
     ~AudioThreadPool();
-    
-    // 提交任务到线程池
+
+    // 提交任务到线程池，返回结果的future（future的共享状态需要一次堆分配）
     template<typename F>
-    auto submit(F&& f) -> std::future<decltype(f())>;
-    
+    auto submit(F&& f, TaskPriority priority = TaskPriority::NORMAL) -> std::future<decltype(f())>;
+
+    // 提交不需要结果的任务（无future，小闭包不分配堆内存）
+    template<typename F>
+    void dispatch(F&& f, TaskPriority priority = TaskPriority::NORMAL);
+
+    // 并行执行body(chunk_begin, chunk_end)，区间按grain切块；调用线程参与执行，全部完成后返回
+    template<typename F>
+    void parallelFor(size_t begin, size_t end, size_t grain, F&& body,
+                     TaskPriority priority = TaskPriority::HIGH);
+
+    // 在调用线程上执行一个优先级不低于lowest的等待中任务，没有任务时返回false（用于等待时帮忙）
+    bool runPendingTask(TaskPriority lowest = TaskPriority::LOW);
+
     // 获取线程数量
     size_t getThreadCount() const;
-    
+
     // 启动线程池
     void start();
-    
+
     // 停止线程池
     void stop();
-    
+
 private:
+    static constexpr size_t kPriorities = 3;
+
+    // 任务节点：预分配节点用next链成空闲链表，预分配用尽时临时分配（index为kHeapNode）
+    struct TaskNode {
+        AudioTask task;
+        std::atomic<uint32_t> next;
+        uint32_t index;
+    };
+
+    // Chase-Lev双端队列（定长，满时提交方改用注入队列）
+    class WorkDeque {
+    public:
+        explicit WorkDeque(size_t capacity);
+
+        // 所有者压入底端
+        bool push(TaskNode* node);
+
+        // 所有者从底端弹出
+        TaskNode* pop();
+
+        // 其他线程从顶端窃取
+        TaskNode* steal();
+
+    private:
+        alignas(64) std::atomic<int64_t> top_;
+        alignas(64) std::atomic<int64_t> bottom_;
+        std::unique_ptr<std::atomic<TaskNode*>[]> buffer_;
+        int64_t mask_;
+    };
+
+    // 有界多生产者多消费者队列（按序号交接单元）
+    class InjectionQueue {
+    public:
+        explicit InjectionQueue(size_t capacity);
+
+        bool push(TaskNode* node);
+        TaskNode* pop();
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            TaskNode* node;
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> head_;
+        alignas(64) std::atomic<size_t> tail_;
+    };
+
+    // 工作线程
+    struct Worker {
+        explicit Worker(size_t capacity);
+
+        std::vector<std::unique_ptr<WorkDeque>> deques;     // 每个优先级一个
+        std::thread thread;
+    };
+
+    // 调度任务（非模板部分）
+    void schedule(AudioTask&& task, TaskPriority priority);
+
+    // 按优先级查找任务：自己的队列、注入队列、窃取其他线程
+    TaskNode* findTask(int self, size_t lowest);
+
+    // 执行并回收节点
+    void runNode(TaskNode* node);
+
+    // 节点分配/回收
+    TaskNode* allocateNode();
+    void releaseNode(TaskNode* node);
+
+    // 工作线程主循环
+    void workerLoop(size_t index);
+
     // 私有成员变量
-    std::vector<std::thread> threads_;
-    std::queue<std::function<void()>> tasks_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::unique_ptr<InjectionQueue>> injection_;   // 每个优先级一个
+    std::unique_ptr<TaskNode[]> nodes_;
+    alignas(64) std::atomic<uint64_t> free_head_;              // 高32位为标记（防ABA），低32位为节点序号+1
+    alignas(64) std::atomic<uint64_t> epoch_;                  // 每次提交递增，休眠的线程据此判断是否有新任务
+    std::atomic<size_t> sleepers_;
+    std::atomic<size_t> steal_start_;
+    std::atomic<bool> stop_;
     std::mutex mutex_;
     std::condition_variable condition_;
-    bool stop_;
 };
 
+// 任务组（fork-join）：run提交任务，wait等待全部完成，等待期间帮忙执行不低于本组优先级的任务。
+// 线程池为空时任务在调用线程上直接执行
+class TaskGroup {
+public:
+    explicit TaskGroup(AudioThreadPool* pool, TaskPriority priority = TaskPriority::NORMAL)
+        : pool_(pool), priority_(priority), pending_(0) {}
+
+    ~TaskGroup() {
+        wait();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // 提交任务
+    template<typename F>
+    void run(F&& f) {
+        if (pool_ == nullptr || pool_->getThreadCount() == 0) {
+            f();
+            return;
+        }
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_->dispatch([this, f = std::forward<F>(f)]() mutable {
+            f();
+            pending_.fetch_sub(1, std::memory_order_release);
+        }, priority_);
+    }
+
+    // 等待全部任务完成
+    void wait() {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_->runPendingTask(priority_)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    AudioThreadPool* pool_;
+    TaskPriority priority_;
+    std::atomic<size_t> pending_;
+};
+
+template<typename F>
+auto AudioThreadPool::submit(F&& f, TaskPriority priority) -> std::future<decltype(f())> {
+    using return_type = decltype(f());
+
+    std::packaged_task<return_type()> task(std::forward<F>(f));
+    std::future<return_type> res = task.get_future();
+    schedule(AudioTask(std::move(task)), priority);
+    return res;
+}
+
+template<typename F>
+void AudioThreadPool::dispatch(F&& f, TaskPriority priority) {
+    schedule(AudioTask(std::forward<F>(f)), priority);
+}
+
+template<typename F>
+void AudioThreadPool::parallelFor(size_t begin, size_t end, size_t grain, F&& body, TaskPriority priority) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (end - begin + grain - 1) / grain;
+    if (chunks < 2 || workers_.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    // 各线程以原子计数认领块，辅助任务启动时若已无剩余块则直接结束；
+    // 闭包只捕获一个指针，可以存放在任务内部
+    struct State {
+        std::atomic<size_t> next;
+        size_t begin;
+        size_t end;
+        size_t grain;
+        size_t chunks;
+        std::remove_reference_t<F>* body;
+    } state{{0}, begin, end, grain, chunks, &body};
+
+    auto drain = [&state] {
+        for (size_t chunk = state.next.fetch_add(1, std::memory_order_relaxed); chunk < state.chunks;
+             chunk = state.next.fetch_add(1, std::memory_order_relaxed)) {
+            const size_t first = state.begin + chunk * state.grain;
+            (*state.body)(first, std::min(state.end, first + state.grain));
+        }
+    };
+
+    TaskGroup group(this, priority);
+    const size_t helpers = std::min(chunks - 1, workers_.size());
+    for (size_t i = 0; i < helpers; ++i) {
+        group.run(drain);
+    }
+    drain();
+    group.wait();
+}
+
 } // namespace core
 
-#endif // CORE_AUDIO_THREAD_POOL_H
\ No newline at end of file
+#endif // CORE_AUDIO_THREAD_POOL_H
@@ -0,0 +1,63 @@
+#ifndef CORE_AUDIO_VIEW_H
+#define CORE_AUDIO_VIEW_H
+
+#include "core/audio_buffer.h"
+#include <cstddef>
+
+namespace core {
+
+// 音频视图类：不持有数据的交错格式样本窗口，用于原地处理
+class AudioView {
+public:
+    // 构造函数
+    AudioView() : data_(nullptr), frames_(0), channels_(1) {}
+
+    // 从原始指针构造
+    AudioView(float* data, size_t frames, size_t channels)
+        : data_(data), frames_(frames), channels_(channels == 0 ? 1 : channels) {}
+
+    // 从缓冲区构造（帧数由缓冲区大小和声道数决定）
+    AudioView(AudioBuffer& buffer, size_t channels)
+        : data_(buffer.data()), frames_(0), channels_(channels == 0 ? 1 : channels) {
+        frames_ = buffer.size() / channels_;
+    }
+
+    // 获取数据指针
+    float* data() const { return data_; }
+
+    // 获取帧数
+    size_t frames() const { return frames_; }
+
+    // 获取声道数
+    size_t channels() const { return channels_; }
+
+    // 获取样本总数
+    size_t size() const { return frames_ * channels_; }
+
+    // 检查视图是否为空
+    bool empty() const { return frames_ == 0; }
+
+    // 获取指定帧的首个样本
+    float* frame(size_t index) const { return data_ + index * channels_; }
+
+    // 获取指定索引的样本值
+    float& operator[](size_t index) const { return data_[index]; }
+
+    // 获取子视图（帧范围）
+    AudioView subView(size_t start, size_t count) const {
+        if (start >= frames_) {
+            return AudioView(data_ + size(), 0, channels_);
+        }
+        const size_t available = frames_ - start;
+        return AudioView(frame(start), count < available ? count : available, channels_);
+    }
+
+private:
+    float* data_;
+    size_t frames_;
+    size_t channels_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_VIEW_H
@@ -2,45 +2,140 @@
 #define CORE_AUDIO_VOCODER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_fft.h"
+#include "core/audio_oscillator_bank.h"
 #include <memory>
+#include <vector>
 
 namespace core {
 
 // 音频声码器类
+// N频带通道声码器：输入（各声道之和）为调制信号，载波来自内部锯齿波振荡器或外部信号。
+// 滤波器组模式在每个样本上对所有频带做向量化的带通分析/合成；FFT模式按频带汇总频谱能量，
+// 适合大量频带。所有状态在initialize/setFormat/setBandCount时预分配，apply中不分配内存。
 class AudioVocoder {
 public:
+    // 处理模式
+    enum class Mode {
+        FILTERBANK,     // 时域带通滤波器组（无延迟）
+        FFT,            // 短时傅里叶变换（延迟为getLatency()帧）
+        AUTO            // 频带数大于32时使用FFT，否则使用滤波器组
+    };
+
     // 构造函数
     AudioVocoder();
-    
+
     // 析构函数
     ~AudioVocoder();
-    
+
     // 初始化声码器
     bool initialize();
-    
+
     // 关闭声码器
     void shutdown();
-    
-    // 应用声码效果
+
+    // 应用声码效果（载波为内部振荡器，交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置声码参数
+
+    // 应用声码效果（使用外部载波，carrier与input格式相同）
+    bool apply(const AudioBuffer& input, const AudioBuffer& carrier, AudioBuffer& output);
+
+    // 设置声码参数：carrier_freq为内部振荡器频率，modulator_freq为包络跟随器的截止频率
     bool setParameters(float carrier_freq, float modulator_freq, float mix);
-    
+
     // 获取声码参数
     void getParameters(float& carrier_freq, float& modulator_freq, float& mix) const;
-    
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置/获取频带数（4-64）
+    bool setBandCount(size_t bands);
+    size_t getBandCount() const;
+
+    // 设置/获取处理模式
+    void setMode(Mode mode);
+    Mode getMode() const;
+
+    // 获取处理延迟（帧）
+    size_t getLatency() const;
+
     // 重置声码器
     void reset();
-    
+
 private:
+    // 实际使用的模式
+    bool useFft() const;
+
+    // 处理一个块（carrier为单声道载波）
+    void process(const float* input, const float* carrier, float* output, size_t frames);
+
+    // 滤波器组：处理一个样本
+    float processFilterbank(float modulator, float carrier);
+
+    // FFT：处理一个分析帧
+    void processFrame();
+
+    // 计算滤波器系数、频带划分与包络系数
+    void updateCoefficients();
+
+    // 分配并清零所有状态
+    void allocateState();
+
+    // 清零流式状态（保留分配）
+    void clearState();
+
+    // FFT模式帧长与跳跃长度
+    static constexpr size_t kFrameSize = 1024;
+    static constexpr size_t kHopSize = kFrameSize / 4;
+    static constexpr size_t kFifoLatency = kFrameSize - kHopSize;
+
     // 私有成员变量
     bool initialized_;
     float carrier_freq_;     // 载波频率
-    float modulator_freq_;   // 调制频率
+    float modulator_freq_;   // 调制频率（包络跟随器截止频率）
     float mix_;              // 混合比例
+    int sample_rate_;
+    int channels_;
+    size_t band_count_;
+    Mode mode_;
+
+    AudioOscillatorBank oscillator_;
+    std::vector<float> carrier_block_;
+
+    // 滤波器组状态（按频带存放，二阶带通级联两级，b1 = 0、b2 = -b0）
+    std::vector<float> band_b0_;
+    std::vector<float> band_a1_;
+    std::vector<float> band_a2_;
+    std::vector<float> analysis_state_;     // 4 * band_count_：两级的z1/z2
+    std::vector<float> synthesis_state_;    // 4 * band_count_
+    std::vector<float> modulator_envelope_;
+    std::vector<float> carrier_envelope_;
+    std::vector<float> band_output_;
+    float attack_;
+    float release_;
+    float output_gain_;
+
+    // FFT模式状态
+    AudioFFT fft_;
+    std::vector<float> window_;
+    std::vector<float> modulator_fifo_;
+    std::vector<float> carrier_fifo_;
+    std::vector<float> out_fifo_;
+    std::vector<float> output_accum_;
+    std::vector<float> dry_delay_;         // 干信号延迟（kFrameSize帧）
+    std::vector<float> modulator_re_;
+    std::vector<float> modulator_im_;
+    std::vector<float> carrier_re_;
+    std::vector<float> carrier_im_;
+    std::vector<size_t> band_edges_;
+    std::vector<float> spectral_gain_;
+    float frame_attack_;
+    float frame_release_;
+    size_t rover_;
+    size_t dry_index_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_VOCODER_H
\ No newline at end of file
+#endif // CORE_AUDIO_VOCODER_H
@@ -1,48 +1,41 @@
 #ifndef CORE_AUDIO_VOCODER_MODULATED_H
 #define CORE_AUDIO_VOCODER_MODULATED_H
 
-#include "core/audio_buffer.h"
-#include <memory>
+#include "core/audio_modulation_cores.h"
 
 namespace core {
 
-// 音频调制声码器类
-class AudioVocoderModulated {
+// 音频调制声码器类（LFO波形由lfo_waveform参数选择）
+class AudioVocoderModulated : public modulation::AudioModulatedEffect<modulation::VocoderCore> {
 public:
-    // 构造函数
-    AudioVocoderModulated();
-    
-    // 析构函数
-    ~AudioVocoderModulated();
-    
-    // 初始化调制声码器
-    bool initialize();
-    
-    // 关闭调制声码器
-    void shutdown();
-    
-    // 应用调制声码效果
-    bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置调制声码参数
-    bool setParameters(float carrier_freq, float modulator_freq, float mix, float modulation_rate, float modulation_depth);
-    
-    // 获取调制声码参数
-    void getParameters(float& carrier_freq, float& modulator_freq, float& mix, float& modulation_rate, float& modulation_depth) const;
-    
-    // 重置调制声码器
-    void reset();
-    
+    using AudioModulatedEffect::setParameters;
+    using AudioModulatedEffect::getParameters;
+
+    // 设置调制声码器参数：LFO以modulation_rate/modulation_depth扫动载波；
+    // 调制信号即输入信号，modulator_freq仅为兼容旧接口而保留
+    bool setParameters(float carrier_freq, float modulator_freq, float mix, float modulation_rate, float modulation_depth) {
+        modulator_freq_ = modulator_freq;
+        core().setCarrierFrequency(carrier_freq);
+        return setParameters(modulation_rate, modulation_depth, 0.0f, mix, 0.0f, 0.0f);
+    }
+
+    // 获取调制声码器参数
+    void getParameters(float& carrier_freq, float& modulator_freq, float& mix, float& modulation_rate, float& modulation_depth) const {
+        carrier_freq = core().getCarrierFrequency();
+        modulator_freq = modulator_freq_;
+        mix = params_.mix;
+        modulation_rate = params_.rate;
+        modulation_depth = params_.depth;
+    }
+
 private:
-    // 私有成员变量
-    bool initialized_;
-    float carrier_freq_;      // 载波频率
-    float modulator_freq_;   // 调制频率
-    float mix_;              // 混合比例
-    float modulation_rate_;  // 调制速率
-    float modulation_depth_; // 调制深度
+    float modulator_freq_ = 0.0f;
 };
 
+// 版本2/3已合并，保留类名以兼容旧代码
+using AudioVocoderModulated2 = AudioVocoderModulated;
+using AudioVocoderModulated3 = AudioVocoderModulated;
+
 } // namespace core
 
-#endif // CORE_AUDIO_VOCODER_MODULATED_H
\ No newline at end of file
+#endif // CORE_AUDIO_VOCODER_MODULATED_H
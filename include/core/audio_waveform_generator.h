@@ -2,6 +2,7 @@
 #define CORE_AUDIO_WAVEFORM_GENERATOR_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_oscillator_bank.h"
 #include <vector>
 
 namespace core {
@@ -36,6 +37,12 @@ public:
     // 生成白噪声
     AudioBuffer generateWhiteNoise(float duration, float amplitude = 1.0f);
     
+    // 获取流式振荡器组（配置振荡器后通过generateBlock按块渲染）
+    AudioOscillatorBank& getOscillatorBank();
+    
+    // 渲染一个块：振荡器组之和复制到各声道（交错格式）
+    bool generateBlock(AudioBuffer& output, size_t frames);
+    
     // 设置生成参数
     bool setParameters(int sample_rate, int channels);
     
@@ -43,10 +50,16 @@ public:
     void getParameters(int& sample_rate, int& channels) const;
     
 private:
+    // 使用单个抗混叠振荡器生成整段波形
+    AudioBuffer generateWaveform(AudioOscillatorBank::Waveform waveform, float frequency,
+                                 float duration, float amplitude);
+    
     // 私有成员变量
     bool initialized_;
     int sample_rate_;
     int channels_;
+    AudioOscillatorBank bank_;
+    std::vector<float> block_;
 };
 
 } // namespace core
@@ -2,45 +2,69 @@
 #define CORE_AUDIO_WAVESHAPER_H
 
 #include "core/audio_buffer.h"
+#include "core/audio_view.h"
+#include "core/audio_waveshaping.h"
 #include <memory>
 
 namespace core {
 
 // 音频波形整形器类
+// 在1/2/4/8倍过采样下经过查表的传递函数（tanh/硬削波/非对称），干信号按延迟补偿后混合
 class AudioWaveshaper {
 public:
     // 构造函数
     AudioWaveshaper();
-    
+
     // 析构函数
     ~AudioWaveshaper();
-    
+
     // 初始化波形整形器
     bool initialize();
-    
+
     // 关闭波形整形器
     void shutdown();
-    
-    // 应用波形整形效果
+
+    // 应用波形整形效果（交错格式，可原地处理）
     bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置波形整形参数
+
+    // 原地处理（视图声道数须与setFormat一致）
+    bool process(AudioView view);
+
+    // 设置波形整形参数：drive范围0-1（输入增益0-36dB），shape范围0-1（向硬削波过渡），mix范围0-1
     bool setParameters(float drive, float shape, float mix);
-    
+
     // 获取波形整形参数
     void getParameters(float& drive, float& shape, float& mix) const;
-    
+
+    // 设置音频格式
+    bool setFormat(int sample_rate, int channels);
+
+    // 设置/获取传递函数
+    void setCurve(TransferCurve curve);
+    TransferCurve getCurve() const;
+
+    // 设置/获取过采样倍数（1、2、4或8）
+    bool setOversampling(size_t factor);
+    size_t getOversampling() const;
+
+    // 获取处理延迟（帧）
+    size_t getLatency() const;
+
     // 重置波形整形器
     void reset();
-    
+
 private:
     // 私有成员变量
     bool initialized_;
     float drive_;   // 驱动强度
     float shape_;   // 形状参数
     float mix_;     // 混合比例
+    int sample_rate_;
+    int channels_;
+
+    WaveshapingStage stage_;
 };
 
 } // namespace core
 
-#endif // CORE_AUDIO_WAVESHAPER_H
\ No newline at end of file
+#endif // CORE_AUDIO_WAVESHAPER_H
@@ -1,48 +1,37 @@
 #ifndef CORE_AUDIO_WAVESHAPER_MODULATED_H
 #define CORE_AUDIO_WAVESHAPER_MODULATED_H
 
-#include "core/audio_buffer.h"
-#include <memory>
+#include "core/audio_modulation_cores.h"
 
 namespace core {
 
-// 音频调制波形整形器类
-class AudioWaveshaperModulated {
+// 音频调制波形整形器类（LFO波形由lfo_waveform参数选择）
+class AudioWaveshaperModulated : public modulation::AudioModulatedEffect<modulation::WaveshaperCore> {
 public:
-    // 构造函数
-    AudioWaveshaperModulated();
-    
-    // 析构函数
-    ~AudioWaveshaperModulated();
-    
-    // 初始化调制波形整形器
-    bool initialize();
-    
-    // 关闭调制波形整形器
-    void shutdown();
-    
-    // 应用调制波形整形效果
-    bool apply(const AudioBuffer& input, AudioBuffer& output);
-    
-    // 设置调制波形整形参数
-    bool setParameters(float drive, float shape, float mix, float modulation_rate, float modulation_depth);
-    
+    using AudioModulatedEffect::setParameters;
+    using AudioModulatedEffect::getParameters;
+
+    // 设置调制波形整形参数：LFO以modulation_rate/modulation_depth调制驱动量
+    bool setParameters(float drive, float shape, float mix, float modulation_rate, float modulation_depth) {
+        core().setDrive(drive);
+        core().setShape(shape);
+        return setParameters(modulation_rate, modulation_depth, 0.0f, mix, 0.0f, 0.0f);
+    }
+
     // 获取调制波形整形参数
-    void getParameters(float& drive, float& shape, float& mix, float& modulation_rate, float& modulation_depth) const;
-    
-    // 重置调制波形整形器
-    void reset();
-    
-private:
-    // 私有成员变量
-    bool initialized_;
-    float drive_;             // 驱动强度
-    float shape_;             // 形状参数
-    float mix_;               // 混合比例
-    float modulation_rate_;  // 调制速率
-    float modulation_depth_; // 调制深度
+    void getParameters(float& drive, float& shape, float& mix, float& modulation_rate, float& modulation_depth) const {
+        drive = core().getDrive();
+        shape = core().getShape();
+        mix = params_.mix;
+        modulation_rate = params_.rate;
+        modulation_depth = params_.depth;
+    }
 };
 
+// 版本2/3已合并，保留类名以兼容旧代码
+using AudioWaveshaperModulated2 = AudioWaveshaperModulated;
+using AudioWaveshaperModulated3 = AudioWaveshaperModulated;
+
 } // namespace core
 
-#endif // CORE_AUDIO_WAVESHAPER_MODULATED_H
\ No newline at end of file
+#endif // CORE_AUDIO_WAVESHAPER_MODULATED_H
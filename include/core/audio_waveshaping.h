@@ -0,0 +1,111 @@
+#ifndef CORE_AUDIO_WAVESHAPING_H
+#define CORE_AUDIO_WAVESHAPING_H
+
+#include "core/audio_oversampler.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace core {
+
+// 传递函数类型
+enum class TransferCurve {
+    TANH,           // 双曲正切软削波
+    HARD_CLIP,      // 硬削波（±1）
+    ASYMMETRIC      // 非对称软削波：正半周饱和于1，负半周更早饱和，产生偶次谐波
+};
+
+// 传递函数表：在[-kRange, kRange]上等距预计算，运行时线性插值（超出范围时取端点值）。
+// 每个样本只有一次截断和一次查表插值，不调用超越函数
+class TransferTable {
+public:
+    // 表的输入范围与分段数
+    static constexpr float kRange = 8.0f;
+    static constexpr size_t kSegments = 4096;
+
+    // 构造函数
+    TransferTable();
+
+    // 按曲线类型构建表：hardness在所选曲线与硬削波之间插值（0为原曲线，1为硬削波）
+    void build(TransferCurve curve, float hardness);
+
+    // 获取曲线类型
+    TransferCurve getCurve() const { return curve_; }
+
+    // 单点求值
+    float evaluate(float x) const;
+
+    // 原地整形：data[i] = f(gain * data[i])
+    void process(float* data, size_t count, float gain) const;
+
+    // 计算曲线在x处的原始值（不查表，用于构建表和测试）
+    static float compute(TransferCurve curve, float x);
+
+private:
+    TransferCurve curve_;
+    std::vector<float> entries_;   // kSegments + 1个端点，每个端点存放（数值，到下一端点的斜率），末尾斜率为0
+};
+
+// 过采样整形级：升采样 -> 查表整形 -> 降采样，干信号按过采样延迟补偿后混合，
+// 非对称曲线的输出经过隔直滤波。非线性产生的高次谐波在降采样时被滤除，不会折叠回可听频段。
+// 传递函数表在编辑线程上构建到新表后原子发布，音频线程每块取一次当前表，旧表在音频线程确认使用新表后释放
+class WaveshapingStage {
+public:
+    // 构造函数
+    WaveshapingStage();
+
+    // 按格式与最大块长分配状态（不在音频线程上调用）
+    void prepare(int sample_rate, size_t channels, size_t max_frames);
+
+    // 设置传递函数与硬度（构建新表并发布，可与process同时调用）
+    void setCurve(TransferCurve curve, float hardness);
+
+    // 获取传递函数
+    TransferCurve getCurve() const { return published_.load(std::memory_order_acquire)->table.getCurve(); }
+
+    // 设置/获取过采样倍数（1、2、4或8）
+    bool setOversampling(size_t factor);
+    size_t getOversampling() const { return oversampler_.getFactor(); }
+
+    // 获取处理延迟（帧）
+    size_t getLatency() const { return oversampler_.getLatency(); }
+
+    // 原地处理交错帧：gain为整形前的输入增益，mix为湿信号比例（超过预分配块长的块分段处理）
+    void process(float* data, size_t frames, float gain, float mix);
+
+    // 清空滤波器与延迟线
+    void reset();
+
+private:
+    // 已发布的传递函数表
+    struct CurveTable {
+        uint64_t version;
+        TransferTable table;
+    };
+
+    // 重新分配干信号延迟线与隔直状态
+    void allocateState();
+
+    // 处理不超过预分配块长的一块
+    void processBlock(const TransferTable& table, float* data, size_t frames, float gain, float mix);
+
+    // 释放音频线程已不再使用的表
+    void reclaim();
+
+    std::vector<std::unique_ptr<CurveTable>> tables_;   // 已发布且可能仍在使用的表（仅编辑线程访问）
+    std::atomic<const CurveTable*> published_;
+    std::atomic<uint64_t> acknowledged_;
+    uint64_t version_;
+    AudioOversampler oversampler_;
+    size_t channels_;
+    std::vector<float> dry_history_;   // 每声道getLatency()帧
+    std::vector<float> dry_work_;      // 延迟线工作区（历史 + 当前块）
+    std::vector<float> dc_state_;      // 隔直滤波器状态（每声道x1/y1）
+    float dc_coefficient_;
+};
+
+} // namespace core
+
+#endif // CORE_AUDIO_WAVESHAPING_H
@@ -0,0 +1,55 @@
+#ifndef CORE_METADATA_CACHE_H
+#define CORE_METADATA_CACHE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace core {
+
+// 元数据缓存：按文件路径保存键值对（如响度分析结果），线程安全，
+// 以制表符分隔的文本文件持久化（每行：路径\t键\t值）
+class MetadataCache {
+public:
+    // 构造函数
+    MetadataCache();
+
+    // 从文件加载（合并到现有条目）
+    bool load(const std::string& filename);
+
+    // 保存到文件
+    bool save(const std::string& filename) const;
+
+    // 获取值
+    bool get(const std::string& path, const std::string& key, std::string& value) const;
+
+    // 获取某路径的全部键值
+    std::map<std::string, std::string> getAll(const std::string& path) const;
+
+    // 设置值
+    void set(const std::string& path, const std::string& key, const std::string& value);
+
+    // 一次设置多个值（与已有键合并）
+    void setAll(const std::string& path, const std::map<std::string, std::string>& values);
+
+    // 是否存在某键
+    bool contains(const std::string& path, const std::string& key) const;
+
+    // 删除某路径的全部条目
+    bool remove(const std::string& path);
+
+    // 路径数
+    size_t size() const;
+
+    // 清空
+    void clear();
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::map<std::string, std::string>> entries_;
+};
+
+} // namespace core
+
+#endif // CORE_METADATA_CACHE_H
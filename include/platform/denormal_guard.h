@@ -0,0 +1,65 @@
+#ifndef PLATFORM_DENORMAL_GUARD_H
+#define PLATFORM_DENORMAL_GUARD_H
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PLATFORM_DENORMAL_GUARD_SSE 1
+#elif defined(__aarch64__)
+#define PLATFORM_DENORMAL_GUARD_ARM64 1
+#endif
+
+namespace platform {
+
+// 作用域内把非规格化浮点数当作0处理（FTZ/DAZ），析构时恢复原来的浮点控制状态。
+// 滤波器尾音与混响衰减进入非规格化范围后，运算会慢几十到上百倍；
+// 音频线程与线程池工作线程在整个生命周期内持有一个，效果链在每次处理时持有一个。
+// 浮点控制寄存器是线程私有的，守卫只影响构造它的线程
+class DenormalGuard {
+public:
+    DenormalGuard() {
+#if defined(PLATFORM_DENORMAL_GUARD_SSE)
+        // MXCSR: FTZ为第15位，DAZ为第6位
+        saved_ = _mm_getcsr();
+        _mm_setcsr(saved_ | 0x8040u);
+#elif defined(PLATFORM_DENORMAL_GUARD_ARM64)
+        // FPCR: FZ为第24位（AArch64上同时作用于输入与输出）
+        uint64_t fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        saved_ = fpcr;
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (uint64_t(1) << 24)));
+#endif
+    }
+
+    ~DenormalGuard() {
+#if defined(PLATFORM_DENORMAL_GUARD_SSE)
+        _mm_setcsr(saved_);
+#elif defined(PLATFORM_DENORMAL_GUARD_ARM64)
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(saved_));
+#endif
+    }
+
+    DenormalGuard(const DenormalGuard&) = delete;
+    DenormalGuard& operator=(const DenormalGuard&) = delete;
+
+    // 当前平台是否支持（不支持时守卫为空操作）
+    static constexpr bool isSupported() {
+#if defined(PLATFORM_DENORMAL_GUARD_SSE) || defined(PLATFORM_DENORMAL_GUARD_ARM64)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+#if defined(PLATFORM_DENORMAL_GUARD_SSE)
+    unsigned int saved_;
+#elif defined(PLATFORM_DENORMAL_GUARD_ARM64)
+    uint64_t saved_;
+#endif
+};
+
+} // namespace platform
+
+#endif // PLATFORM_DENORMAL_GUARD_H
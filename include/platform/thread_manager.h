@@ -4,19 +4,69 @@
 #include <thread>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace platform {
 
+// 线程角色：每个角色有各自的调度优先级与CPU绑定
+enum class ThreadRole {
+    AUDIO,          // 音频回调/输出线程
+    WORKER,         // 线程池工作线程（效果图、混音总线的扇出）
+    BACKGROUND      // 后台分析、预读等
+};
+
+// 线程优先级约定：>0为实时优先级（SCHED_FIFO，1-99），0为普通，-1为SCHED_BATCH，-2为SCHED_IDLE
+const int kThreadPriorityIdle = -2;
+const int kThreadPriorityLow = -1;
+const int kThreadPriorityNormal = 0;
+const int kThreadPriorityHigh = 10;
+const int kThreadPriorityRealtime = 80;
+
+// 角色的调度策略
+struct ThreadPolicy {
+    int priority = kThreadPriorityNormal;
+    bool round_robin = false;           // 实时优先级使用SCHED_RR而不是SCHED_FIFO
+    std::vector<unsigned int> cpus;     // 绑定的CPU，空表示不绑定
+};
+
 class ThreadManager {
 public:
-    // 创建并启动线程
+    // 创建并启动线程（线程在整个生命周期内把非规格化浮点数当作0处理）
     static std::thread create_thread(std::function<void()> func);
 
-    // 设置线程优先级（如果支持）
-    static bool set_thread_priority(std::thread& thread, int priority);
+    // 设置线程优先级（如果支持）。实时优先级权限不足时先把RLIMIT_RTPRIO软限制提到硬限制，
+    // 再按限制内的最高优先级重试（不依赖rtkit），仍失败则保持原调度策略并返回false
+    static bool set_thread_priority(std::thread& thread, int priority, bool round_robin = false);
 
     // 设置线程亲和性（如果支持）
     static bool set_thread_affinity(std::thread& thread, unsigned int cpu_id);
+    static bool set_thread_affinity(std::thread& thread, const std::vector<unsigned int>& cpus);
+
+    // 对调用线程设置优先级与亲和性
+    static bool set_current_thread_priority(int priority, bool round_robin = false);
+    static bool set_current_thread_affinity(const std::vector<unsigned int>& cpus);
+
+    // 进程允许运行的CPU
+    static std::vector<unsigned int> available_cpus();
+
+    // 设置/获取角色的调度策略
+    static void set_role_policy(ThreadRole role, const ThreadPolicy& policy);
+    static ThreadPolicy get_role_policy(ThreadRole role);
+
+    // 角色实际生效的策略：音频线程绑定了CPU而其他角色未指定时，其他角色避开音频线程的CPU
+    static ThreadPolicy effective_role_policy(ThreadRole role);
+
+    // 对调用线程应用角色策略（在线程启动时调用，不在音频回调中调用）
+    static bool apply_role_policy(ThreadRole role);
+
+    // 从配置文件的performance段读取各角色策略：
+    // cpu_priority（音频线程）、worker_priority、background_priority，以及audio_cpus、worker_cpus、background_cpus
+    static bool load_config(const std::string& filename);
+
+    // 解析优先级（idle/low/normal/high/realtime或整数）与CPU列表（如"0,2-3"）
+    static bool parse_priority(const std::string& text, int& priority);
+    static bool parse_cpu_list(const std::string& text, std::vector<unsigned int>& cpus);
 
     // 获取硬件线程数
     static size_t hardware_concurrency();
@@ -24,4 +74,4 @@ public:
 
 } // namespace platform
 
-#endif // PLATFORM_THREAD_MANAGER_H
\ No newline at end of file
+#endif // PLATFORM_THREAD_MANAGER_H
@@ -1,11 +1,41 @@
 #include "audio/audio_engine.h"
 #include "audio/device_manager.h"
+#include "audio/simd/sample_convert.h"
+#include "core/audio_automation.h"
+#include "core/audio_loudness_scanner.h"
 #include "core/equalizer_config.h"
+#include "platform/denormal_guard.h"
+#include "platform/thread_manager.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 namespace audio {
 
+namespace {
+
+// 声道布局对应的声道数
+size_t channel_count(ChannelLayout layout) {
+    switch (layout) {
+        case ChannelLayout::MONO:
+            return 1;
+        case ChannelLayout::STEREO:
+            return 2;
+        case ChannelLayout::QUAD:
+            return 4;
+        case ChannelLayout::FIVE_POINT_ONE:
+            return 6;
+        case ChannelLayout::SEVEN_POINT_ONE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
 std::shared_ptr<AudioEngine> AudioEngine::instance() {
     static std::shared_ptr<AudioEngine> engine =
         std::make_shared<AudioEngine>();
@@ -14,13 +44,24 @@ std::shared_ptr<AudioEngine> AudioEngine::instance() {
 
 AudioEngine::AudioEngine()
     : state_(EngineState::STOPPED),
-      volume_(0.5f) {
+      volume_(0.5f),
+      config_file_("config/default.json"),
+      replay_gain_(1.0f),
+      album_gain_(false),
+      volume_parameter_(0),
+      position_(0) {
+    volume_control_.setVolume(volume_);
 }
 
 bool AudioEngine::initialize() {
     // 初始化音频设备和驱动
     std::cout << "Initializing audio engine..." << std::endl;
 
+    // 线程池与音频线程启动时按角色应用调度策略，配置文件缺失或有误时保持默认策略
+    if (!platform::ThreadManager::load_config(config_file_)) {
+        std::cerr << "Failed to load thread policies from " << config_file_ << ", using defaults" << std::endl;
+    }
+
     // 这里应该调用平台特定的初始化代码
     // 例如：WASAPI, ALSA, CoreAudio等
 
@@ -40,6 +81,10 @@ bool AudioEngine::initialize() {
     return true;
 }
 
+void AudioEngine::set_config_file(const std::string& filename) {
+    config_file_ = filename;
+}
+
 void AudioEngine::cleanup() {
     // 清理资源
     state_ = EngineState::STOPPED;
@@ -54,6 +99,22 @@ bool AudioEngine::play_audio(const AudioBuffer& buffer, const AudioFormat& forma
         return false;
     }
 
+    const size_t channels = channel_count(format.channels);
+    if (channels == 0 || buffer.size() % channels != 0) {
+        return false;
+    }
+    const size_t frames = buffer.size() / channels;
+
+    // 调用线程不一定启用了FTZ/DAZ，音量斜坡与噪声整形滤波器处理期间临时启用
+    platform::DenormalGuard denormal_guard;
+
+    // 输出线程第一次进入时应用音频角色的调度策略，之后不再调用系统接口
+    static thread_local bool audio_role_applied = false;
+    if (!audio_role_applied) {
+        platform::ThreadManager::apply_role_policy(platform::ThreadRole::AUDIO);
+        audio_role_applied = true;
+    }
+
     // 应用均衡器处理
     if (equalizer_config_) {
         auto params = equalizer_config_->getAllGains();
@@ -61,6 +122,37 @@ bool AudioEngine::play_audio(const AudioBuffer& buffer, const AudioFormat& forma
         std::cout << "Applying equalizer with " << params.size() << " bands" << std::endl;
     }
 
+    // 在浮点域应用输出音量
+    if (output_buffer_.size() != buffer.size()) {
+        output_buffer_.resize(buffer.size());
+    }
+    std::copy(buffer.data(), buffer.data() + buffer.size(), output_buffer_.data());
+
+    // 音量自动化按时间线位置渲染为逐帧增益，与音量斜坡在同一遍内相乘
+    const core::AutomationSnapshot* snapshot = volume_automation_ ? volume_automation_->acquire() : nullptr;
+    const core::AutomationLane* lane = snapshot ? snapshot->lane(volume_parameter_) : nullptr;
+    if (lane != nullptr) {
+        if (automation_gains_.size() < frames) {
+            automation_gains_.resize(frames);
+        }
+        lane->render(position_, frames, automation_gains_.data());
+        volume_control_.applyVolume(output_buffer_.data(), frames, channels, automation_gains_.data());
+    } else {
+        volume_control_.applyVolume(output_buffer_.data(), frames, channels);
+    }
+    position_ += frames;
+
+    // 浮点以外的设备格式在同一遍内抖动（16/24位）并经由SIMD转换内核输出
+    if (format.format != SampleFormat::PCM_FLOAT) {
+        const size_t bytes = simd::bytesPerSample(format.format) * buffer.size();
+        if (device_buffer_.size() < bytes) {
+            device_buffer_.resize(bytes);
+        }
+        if (!dither_.process(output_buffer_.data(), format.format, device_buffer_.data(), frames, channels)) {
+            return false;
+        }
+    }
+
     // 实际播放音频数据
     // 这里应该调用平台特定的音频输出API
     std::cout << "Playing audio: " << buffer.size()
@@ -73,6 +165,7 @@ bool AudioEngine::play_audio(const AudioBuffer& buffer, const AudioFormat& forma
 
 bool AudioEngine::stop_playback() {
     state_ = EngineState::STOPPED;
+    position_ = 0;
     std::cout << "Playback stopped" << std::endl;
     return true;
 }
@@ -83,10 +176,98 @@ bool AudioEngine::set_volume(float volume) {
     if (volume > 1.0f) volume = 1.0f;
 
     volume_ = volume;
+    // 下一个输出块内平滑过渡到新音量
+    volume_control_.setVolume(volume_ * replay_gain_);
     std::cout << "Volume set to: " << volume_ << std::endl;
     return true;
 }
 
+bool AudioEngine::set_replay_gain(float gain_db, float peak) {
+    if (!std::isfinite(gain_db) || !(peak >= 0.0f)) {
+        return false;
+    }
+
+    // 预先计算好的增益与音量合并，播放时没有额外开销
+    float gain = std::pow(10.0f, gain_db / 20.0f);
+    if (peak > 0.0f) {
+        gain = std::min(gain, 1.0f / peak);
+    }
+
+    replay_gain_ = gain;
+    volume_control_.setVolume(volume_ * replay_gain_);
+    std::cout << "Replay gain set to: " << gain_db << " dB (linear " << replay_gain_ << ")" << std::endl;
+    return true;
+}
+
+void AudioEngine::clear_replay_gain() {
+    replay_gain_ = 1.0f;
+    volume_control_.setVolume(volume_);
+}
+
+float AudioEngine::get_replay_gain() const {
+    return replay_gain_;
+}
+
+bool AudioEngine::load_replay_gain(const core::MetadataCache& cache, const std::string& path, bool album) {
+    float gain_db = 0.0f;
+    float peak = 0.0f;
+    if (!core::LoudnessScanner::lookup(cache, path, album, gain_db, peak) || !set_replay_gain(gain_db, peak)) {
+        // 未扫描的曲目不沿用上一首的增益
+        clear_replay_gain();
+        return false;
+    }
+    return true;
+}
+
+void AudioEngine::set_metadata_cache(std::shared_ptr<const core::MetadataCache> cache, bool album) {
+    metadata_cache_ = std::move(cache);
+    album_gain_ = album;
+}
+
+bool AudioEngine::load_track(const std::string& path) {
+    if (path.empty()) {
+        return false;
+    }
+
+    std::cout << "Loading track: " << path << std::endl;
+
+    // 新曲目从时间线起点开始，回放增益取自扫描结果（未扫描时清除上一首的增益）
+    position_ = 0;
+    if (metadata_cache_) {
+        load_replay_gain(*metadata_cache_, path, album_gain_);
+    } else {
+        clear_replay_gain();
+    }
+    return true;
+}
+
+void AudioEngine::set_volume_automation(std::shared_ptr<core::AudioAutomation> automation, size_t parameter) {
+    volume_automation_ = std::move(automation);
+    volume_parameter_ = parameter;
+}
+
+uint64_t AudioEngine::get_position() const {
+    return position_;
+}
+
+const AudioBuffer& AudioEngine::get_output() const {
+    return output_buffer_;
+}
+
+const std::vector<uint8_t>& AudioEngine::get_device_buffer() const {
+    return device_buffer_;
+}
+
+bool AudioEngine::set_dither(bool enabled, dsp::Dither::NoiseShaping shaping) {
+    dither_.setEnabled(enabled);
+    if (dither_.getNoiseShaping() != shaping) {
+        dither_.setNoiseShaping(shaping);
+    }
+    std::cout << "Dither " << (enabled ? "enabled" : "disabled")
+              << ", noise shaping: " << static_cast<int>(shaping) << std::endl;
+    return true;
+}
+
 std::string AudioEngine::get_status() const {
     switch (state_) {
         case EngineState::STOPPED:
@@ -0,0 +1,203 @@
+#include "audio/dsp/dither.h"
+#include "audio/simd/sample_convert.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace audio {
+namespace dsp {
+
+namespace {
+
+// 栈上临时缓冲的样本数
+const size_t kChunkSamples = 512;
+
+// 噪声发生器路数
+const size_t kNoiseLanes = 8;
+
+// 误差反馈系数：噪声传递函数为 1 - sum(h[k] * z^-(k+1))
+const float kFirstOrder[] = {1.0f};
+const float kEWeighted5[] = {2.033f, -2.165f, 1.959f, -1.590f, 0.6149f};
+const float kFWeighted9[] = {2.412f, -3.370f, 3.937f, -4.174f, 3.353f, -2.205f, 1.281f, -0.569f, 0.0847f};
+
+inline uint32_t xorshift(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// 两个均匀分布[-0.5, 0.5) LSB之和即三角分布
+inline float tpdf(uint32_t a, uint32_t b) {
+    const float scale = 1.0f / 4294967296.0f;
+    return (static_cast<float>(static_cast<int32_t>(a)) + static_cast<float>(static_cast<int32_t>(b))) * scale;
+}
+
+// 饱和到limit以内（NaN落到下限），超出满刻度的部分由转换内核饱和
+inline float clampSample(float value, float limit) {
+    value = value > -limit ? value : -limit;
+    return value < limit ? value : limit;
+}
+
+// 就近偶数取整（值已限制在int32范围内）
+inline float roundSample(float value) {
+#if defined(__SSE2__)
+    return static_cast<float>(_mm_cvtss_si32(_mm_set_ss(value)));
+#else
+    return static_cast<float>(std::lrint(value));
+#endif
+}
+
+// 误差反馈整形：从输入中减去滤波后的历史量化误差再量化。
+// 反馈的误差不含削波部分，削波时环路不会发散，NaN输入也不会污染历史。
+// 阶数为编译期常量；同一帧的各声道互不依赖，交错处理使各声道的依赖链重叠执行
+template <const float* Coefficients, size_t Taps>
+void shapeFrames(const float* input, const float* noise, float* output,
+                 size_t frames, size_t channels, float scale, float (*history)[Dither::kMaxTaps]) {
+    const float lsb = 1.0f / scale;
+    const float limit = 2.0f * scale;
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            float* errors = history[ch];
+            // 从最旧的误差开始累加，最新误差只在依赖链末端参与一次乘加
+            float feedback = 0.0f;
+            for (size_t k = Taps; k-- > 0;) {
+                feedback += Coefficients[k] * errors[k];
+            }
+            const size_t index = i * channels + ch;
+            const float dithered = clampSample(input[index] * scale - feedback + noise[index], limit);
+            const float quantized = roundSample(dithered);
+            for (size_t k = Taps - 1; k > 0; --k) {
+                errors[k] = errors[k - 1];
+            }
+            errors[0] = quantized - dithered + noise[index];
+            output[index] = quantized * lsb;
+        }
+    }
+}
+
+} // namespace
+
+Dither::Dither()
+    : enabled_(true), shaping_(NoiseShaping::NONE), shape_(nullptr) {
+    for (size_t l = 0; l < kNoiseLanes; ++l) {
+        // xorshift状态不能为0
+        noise_state_[l] = 0x9E3779B9u * static_cast<uint32_t>(l + 1);
+    }
+    reset();
+}
+
+void Dither::setEnabled(bool enabled) {
+    enabled_ = enabled;
+}
+
+bool Dither::isEnabled() const {
+    return enabled_;
+}
+
+void Dither::setNoiseShaping(NoiseShaping shaping) {
+    shaping_ = shaping;
+    switch (shaping) {
+        case NoiseShaping::FIRST_ORDER:
+            shape_ = &shapeFrames<kFirstOrder, sizeof(kFirstOrder) / sizeof(kFirstOrder[0])>;
+            break;
+        case NoiseShaping::E_WEIGHTED_5:
+            shape_ = &shapeFrames<kEWeighted5, sizeof(kEWeighted5) / sizeof(kEWeighted5[0])>;
+            break;
+        case NoiseShaping::F_WEIGHTED_9:
+            shape_ = &shapeFrames<kFWeighted9, sizeof(kFWeighted9) / sizeof(kFWeighted9[0])>;
+            break;
+        default:
+            shape_ = nullptr;
+            break;
+    }
+    reset();
+}
+
+Dither::NoiseShaping Dither::getNoiseShaping() const {
+    return shaping_;
+}
+
+void Dither::reset() {
+    for (auto& history : errors_) {
+        std::fill(history, history + kMaxTaps, 0.0f);
+    }
+}
+
+bool Dither::process(const float* input, SampleFormat format, void* output, size_t frames, size_t channels) {
+    if (input == nullptr || output == nullptr || channels == 0) {
+        return false;
+    }
+
+    float scale;
+    if (format == SampleFormat::PCM_S16LE) {
+        scale = 32768.0f;
+    } else if (format == SampleFormat::PCM_S24LE) {
+        scale = 8388608.0f;
+    } else {
+        return simd::fromFloat(input, format, output, frames * channels);
+    }
+    if (!enabled_ || channels > kMaxChannels) {
+        // 超过kMaxChannels的声道布局没有误差历史，不抖动直接转换
+        return simd::fromFloat(input, format, output, frames * channels);
+    }
+
+    const simd::ConversionKernels& kernels = simd::getKernels();
+    const size_t bytes = simd::bytesPerSample(format);
+    const float lsb = 1.0f / scale;
+    uint8_t* out = static_cast<uint8_t*>(output);
+
+    float noise[kChunkSamples];
+    float dithered[kChunkSamples];
+    const size_t chunk = kChunkSamples / channels;
+    for (size_t offset = 0; offset < frames; offset += chunk) {
+        const size_t count = std::min(chunk, frames - offset);
+        const size_t n = count * channels;
+        const float* in = input + offset * channels;
+        generateNoise(noise, n);
+
+        if (shape_ == nullptr) {
+            for (size_t i = 0; i < n; ++i) {
+                dithered[i] = in[i] + noise[i] * lsb;
+            }
+        } else {
+            shape_(in, noise, dithered, count, channels, scale, errors_);
+        }
+
+        uint8_t* dst = out + offset * channels * bytes;
+        if (format == SampleFormat::PCM_S16LE) {
+            kernels.floatToS16(dithered, reinterpret_cast<int16_t*>(dst), n);
+        } else {
+            kernels.floatToS24(dithered, dst, n);
+        }
+    }
+    return true;
+}
+
+void Dither::generateNoise(float* noise, size_t count) {
+    // 各路状态互相独立，内层循环可向量化
+    uint32_t state[kNoiseLanes];
+    std::copy(noise_state_, noise_state_ + kNoiseLanes, state);
+    size_t i = 0;
+    for (; i + kNoiseLanes <= count; i += kNoiseLanes) {
+        for (size_t l = 0; l < kNoiseLanes; ++l) {
+            const uint32_t a = xorshift(state[l]);
+            const uint32_t b = xorshift(a);
+            state[l] = b;
+            noise[i + l] = tpdf(a, b);
+        }
+    }
+    for (size_t l = 0; i + l < count; ++l) {
+        const uint32_t a = xorshift(state[l]);
+        const uint32_t b = xorshift(a);
+        state[l] = b;
+        noise[i + l] = tpdf(a, b);
+    }
+    std::copy(state, state + kNoiseLanes, noise_state_);
+}
+
+} // namespace dsp
+} // namespace audio
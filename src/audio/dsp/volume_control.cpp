@@ -1,10 +1,155 @@
 #include "audio/dsp/volume_control.h"
 #include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace audio {
 namespace dsp {
 
-VolumeControl::VolumeControl() : volume_(1.0f), muted_(false) {}
+namespace {
+
+// 栈上临时缓冲的样本数
+const size_t kChunkSamples = 512;
+
+// 指数斜坡的增益下限（-90dB），斜坡到0时在最后一帧归零
+const float kGainFloor = 3.1622777e-5f;
+
+// float到16位整型的满刻度
+const float kInt16Scale = 32767.0f;
+
+// 增益斜坡：在一个处理块内从start过渡到end，分段生成逐帧增益
+class GainRamp {
+public:
+    GainRamp(float start, float end, size_t frames, bool exponential)
+        : gain_(start), end_(end), step_(0.0f), remaining_(frames),
+          constant_(start == end || frames == 0), exponential_(exponential) {
+        if (constant_) {
+            return;
+        }
+        if (exponential_) {
+            gain_ = std::max(start, kGainFloor);
+            step_ = std::pow(std::max(end, kGainFloor) / gain_, 1.0f / static_cast<float>(frames));
+        } else {
+            step_ = (end - start) / static_cast<float>(frames);
+        }
+    }
+
+    bool isConstant() const { return constant_; }
+    float value() const { return gain_; }
+
+    // 生成接下来count帧的增益
+    void next(float* gains, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (constant_) {
+            std::fill(gains, gains + count, gain_);
+            return;
+        }
+
+        if (exponential_) {
+            // 分成kLanes路独立的等比数列，使循环可以向量化
+            float lanes[kLanes];
+            float power = 1.0f;
+            for (size_t l = 0; l < kLanes; ++l) {
+                power *= step_;
+                lanes[l] = gain_ * power;
+            }
+            size_t i = 0;
+            for (; i + kLanes <= count; i += kLanes) {
+                for (size_t l = 0; l < kLanes; ++l) {
+                    gains[i + l] = lanes[l];
+                    lanes[l] *= power;
+                }
+            }
+            for (size_t l = 0; i + l < count; ++l) {
+                gains[i + l] = lanes[l];
+            }
+        } else {
+            const float base = gain_;
+            const float step = step_;
+            for (size_t i = 0; i < count; ++i) {
+                gains[i] = base + step * static_cast<float>(i + 1);
+            }
+        }
+
+        gain_ = gains[count - 1];
+        remaining_ -= std::min(count, remaining_);
+        if (remaining_ == 0) {
+            // 最后一帧精确落在目标增益上
+            gains[count - 1] = end_;
+            gain_ = end_;
+        }
+    }
+
+private:
+    static constexpr size_t kLanes = 8;
+
+    float gain_;
+    float end_;
+    float step_;
+    size_t remaining_;
+    bool constant_;
+    bool exponential_;
+};
+
+// 每块处理的帧数（暂存缓冲按样本计，至少一帧）
+inline size_t framesPerChunk(size_t channels) {
+    return std::max<size_t>(1, kChunkSamples / channels);
+}
+
+// 常数增益
+inline void scaleConstant(float* buffer, size_t count, float gain) {
+    if (gain == 1.0f) {
+        return;
+    }
+    if (gain == 0.0f) {
+        std::fill(buffer, buffer + count, 0.0f);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+// 逐帧增益作用于交错数据
+inline void scaleFrames(float* buffer, size_t frames, size_t channels, const float* gains) {
+    if (channels == 1) {
+        for (size_t i = 0; i < frames; ++i) {
+            buffer[i] *= gains[i];
+        }
+        return;
+    }
+    if (channels == 2) {
+        for (size_t i = 0; i < frames; ++i) {
+            buffer[2 * i] *= gains[i];
+            buffer[2 * i + 1] *= gains[i];
+        }
+        return;
+    }
+    for (size_t i = 0; i < frames; ++i) {
+        const float gain = gains[i];
+        for (size_t ch = 0; ch < channels; ++ch) {
+            buffer[i * channels + ch] *= gain;
+        }
+    }
+}
+
+// 饱和到16位范围（NaN落到下限）
+inline float saturateInt16(float value) {
+    value = value > -32768.0f ? value : -32768.0f;
+    return value < 32767.0f ? value : 32767.0f;
+}
+
+} // namespace
+
+VolumeControl::VolumeControl()
+    : volume_(1.0f), muted_(false), current_gain_(1.0f),
+      ramp_shape_(RampShape::LINEAR) {
+}
 
 void VolumeControl::setVolume(float volume) {
     // 限制音量范围在0.0到2.0之间
@@ -15,17 +160,157 @@ float VolumeControl::getVolume() const {
     return volume_;
 }
 
+void VolumeControl::setRampShape(RampShape shape) {
+    ramp_shape_ = shape;
+}
+
+VolumeControl::RampShape VolumeControl::getRampShape() const {
+    return ramp_shape_;
+}
+
+void VolumeControl::beginBlock(float& start, float& end) {
+    start = current_gain_;
+    end = muted_ ? 0.0f : volume_;
+    current_gain_ = end;
+}
+
 void VolumeControl::applyVolume(float* buffer, size_t frames) const {
-    if (muted_) {
-        // 如果静音，将所有样本设为0
-        for (size_t i = 0; i < frames; ++i) {
-            buffer[i] = 0.0f;
+    if (buffer == nullptr) {
+        return;
+    }
+
+    // 直接使用目标增益，不推进斜坡
+    scaleConstant(buffer, frames, muted_ ? 0.0f : volume_);
+}
+
+void VolumeControl::applyVolume(float* buffer, size_t frames, size_t channels) {
+    if (buffer == nullptr || frames == 0 || channels == 0) {
+        return;
+    }
+
+    float start, end;
+    beginBlock(start, end);
+    GainRamp ramp(start, end, frames, ramp_shape_ == RampShape::EXPONENTIAL);
+    if (ramp.isConstant()) {
+        scaleConstant(buffer, frames * channels, ramp.value());
+        return;
+    }
+
+    float gains[kChunkSamples];
+    const size_t chunk = framesPerChunk(channels);
+    for (size_t offset = 0; offset < frames; offset += chunk) {
+        const size_t count = std::min(chunk, frames - offset);
+        ramp.next(gains, count);
+        scaleFrames(buffer + offset * channels, count, channels, gains);
+    }
+}
+
+void VolumeControl::applyVolume(float* buffer, size_t frames, size_t channels, const float* gains) {
+    if (buffer == nullptr || gains == nullptr || frames == 0 || channels == 0) {
+        return;
+    }
+
+    float start, end;
+    beginBlock(start, end);
+    GainRamp ramp(start, end, frames, ramp_shape_ == RampShape::EXPONENTIAL);
+
+    // 逐帧增益，同一帧的所有声道使用相同增益
+    float block_gains[kChunkSamples];
+    const size_t chunk = framesPerChunk(channels);
+    for (size_t offset = 0; offset < frames; offset += chunk) {
+        const size_t count = std::min(chunk, frames - offset);
+        ramp.next(block_gains, count);
+        for (size_t i = 0; i < count; ++i) {
+            block_gains[i] *= gains[offset + i];
         }
-    } else {
-        // 应用音量控制
-        for (size_t i = 0; i < frames; ++i) {
-            buffer[i] *= volume_;
+        scaleFrames(buffer + offset * channels, count, channels, block_gains);
+    }
+}
+
+void VolumeControl::applyVolume(int16_t* buffer, size_t frames, size_t channels) {
+    if (buffer == nullptr || frames == 0 || channels == 0) {
+        return;
+    }
+
+    float start, end;
+    beginBlock(start, end);
+    GainRamp ramp(start, end, frames, ramp_shape_ == RampShape::EXPONENTIAL);
+    if (ramp.isConstant() && ramp.value() == 1.0f) {
+        // 单位增益不重新量化，保持比特精确
+        return;
+    }
+
+    float gains[kChunkSamples];
+    float samples[kChunkSamples];
+    const size_t chunk = framesPerChunk(channels);
+    for (size_t offset = 0; offset < frames; offset += chunk) {
+        const size_t count = std::min(chunk, frames - offset);
+        int16_t* data = buffer + offset * channels;
+        ramp.next(gains, count);
+        // 声道数超过暂存缓冲时每块只有一帧，按声道分段转换
+        for (size_t done = 0, n = count * channels; done < n; done += kChunkSamples) {
+            const size_t part = std::min(kChunkSamples, n - done);
+            for (size_t i = 0; i < part; ++i) {
+                samples[i] = static_cast<float>(data[done + i]);
+            }
+            if (count == 1) {
+                scaleConstant(samples, part, gains[0]);
+            } else {
+                scaleFrames(samples, count, channels, gains);
+            }
+            storeInt16(samples, data + done, part);
+        }
+    }
+}
+
+void VolumeControl::applyVolume(const float* input, int16_t* output, size_t frames, size_t channels) {
+    if (input == nullptr || output == nullptr || frames == 0 || channels == 0) {
+        return;
+    }
+
+    float start, end;
+    beginBlock(start, end);
+    GainRamp ramp(start, end, frames, ramp_shape_ == RampShape::EXPONENTIAL);
+
+    float gains[kChunkSamples];
+    float samples[kChunkSamples];
+    const size_t chunk = framesPerChunk(channels);
+    for (size_t offset = 0; offset < frames; offset += chunk) {
+        const size_t count = std::min(chunk, frames - offset);
+        const float* in = input + offset * channels;
+        ramp.next(gains, count);
+        for (size_t i = 0; i < count; ++i) {
+            gains[i] *= kInt16Scale;
         }
+        // 声道数超过暂存缓冲时每块只有一帧，按声道分段转换
+        for (size_t done = 0, n = count * channels; done < n; done += kChunkSamples) {
+            const size_t part = std::min(kChunkSamples, n - done);
+            std::copy(in + done, in + done + part, samples);
+            if (count == 1) {
+                scaleConstant(samples, part, gains[0]);
+            } else {
+                scaleFrames(samples, count, channels, gains);
+            }
+            storeInt16(samples, output + offset * channels + done, part);
+        }
+    }
+}
+
+void VolumeControl::storeInt16(const float* samples, int16_t* output, size_t count) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // 先钳位再舍入，最后用有符号饱和打包成16位
+    const __m128 lo = _mm_set1_ps(-32768.0f);
+    const __m128 hi = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= count; i += 8) {
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), lo), hi);
+        const __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i + 4), lo), hi);
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i] = static_cast<int16_t>(std::lrint(saturateInt16(samples[i])));
     }
 }
 
@@ -42,4 +327,4 @@ bool VolumeControl::isMuted() const {
 }
 
 } // namespace dsp
-} // namespace audio
\ No newline at end of file
+} // namespace audio
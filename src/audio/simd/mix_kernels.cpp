@@ -0,0 +1,67 @@
+#include "audio/simd/mix_kernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace audio {
+namespace simd {
+
+namespace {
+
+void accumulate(const float* __restrict input, float* __restrict output, size_t samples, float gain) {
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] += gain * input[i];
+    }
+}
+
+void accumulateRamp(const float* __restrict input, float* __restrict output, size_t frames, size_t channels,
+                    float start, float step) {
+    for (size_t f = 0; f < frames; ++f) {
+        const float gain = start + step * static_cast<float>(f + 1);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            output[f * channels + ch] += gain * input[f * channels + ch];
+        }
+    }
+}
+
+const MixKernels kScalarMixKernels = {accumulate, accumulateRamp};
+
+bool cpuSupportsFma() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 12)) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+namespace detail {
+
+const MixKernels& scalarMixKernels() {
+    return kScalarMixKernels;
+}
+
+} // namespace detail
+
+const MixKernels& getMixKernels(SimdLevel level) {
+    static const bool fma = detail::avx2FmaMixKernels() != nullptr && cpuSupportsFma();
+    if (level == SimdLevel::AVX2 && detectSimdLevel() == SimdLevel::AVX2 && fma) {
+        return *detail::avx2FmaMixKernels();
+    }
+    return detail::scalarMixKernels();
+}
+
+const MixKernels& getMixKernels() {
+    static const MixKernels& kernels = getMixKernels(detectSimdLevel());
+    return kernels;
+}
+
+} // namespace simd
+} // namespace audio
@@ -0,0 +1,95 @@
+#include "audio/simd/mix_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define AUDIO_SIMD_AVX2_FMA 1
+#endif
+#endif
+
+// 按函数启用目标指令集，由运行时检测选择，不影响其余代码的编译选项
+#if defined(AUDIO_SIMD_AVX2_FMA)
+#if defined(__GNUC__)
+#define AUDIO_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+#define AUDIO_TARGET_AVX2_FMA
+#endif
+#endif
+
+namespace audio {
+namespace simd {
+
+#if defined(AUDIO_SIMD_AVX2_FMA)
+
+namespace {
+
+// 尾部样本交给标量内核
+inline const MixKernels& scalar() {
+    return detail::scalarMixKernels();
+}
+
+AUDIO_TARGET_AVX2_FMA
+void accumulateAvx2(const float* input, float* output, size_t samples, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    // 两路独立累加，隐藏FMA延迟
+    for (; i + 16 <= samples; i += 16) {
+        const __m256 a = _mm256_fmadd_ps(g, _mm256_loadu_ps(input + i), _mm256_loadu_ps(output + i));
+        const __m256 b = _mm256_fmadd_ps(g, _mm256_loadu_ps(input + i + 8), _mm256_loadu_ps(output + i + 8));
+        _mm256_storeu_ps(output + i, a);
+        _mm256_storeu_ps(output + i + 8, b);
+    }
+    for (; i + 8 <= samples; i += 8) {
+        _mm256_storeu_ps(output + i, _mm256_fmadd_ps(g, _mm256_loadu_ps(input + i), _mm256_loadu_ps(output + i)));
+    }
+    scalar().accumulate(input + i, output + i, samples - i, gain);
+}
+
+AUDIO_TARGET_AVX2_FMA
+void accumulateRampAvx2(const float* input, float* output, size_t frames, size_t channels,
+                        float start, float step) {
+    // 声道数整除8时，一个向量恰好覆盖8 / channels个整帧，向量各元素的帧偏移固定
+    if (channels == 0 || 8 % channels != 0) {
+        scalar().accumulateRamp(input, output, frames, channels, start, step);
+        return;
+    }
+    alignas(32) float offsets[8];
+    for (size_t j = 0; j < 8; ++j) {
+        offsets[j] = static_cast<float>(j / channels + 1);
+    }
+    const __m256 lane_frames = _mm256_load_ps(offsets);
+    const __m256 steps = _mm256_set1_ps(step);
+
+    const size_t samples = frames * channels;
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const float base = static_cast<float>(i / channels);
+        const __m256 gain = _mm256_fmadd_ps(_mm256_add_ps(_mm256_set1_ps(base), lane_frames), steps,
+                                            _mm256_set1_ps(start));
+        _mm256_storeu_ps(output + i, _mm256_fmadd_ps(gain, _mm256_loadu_ps(input + i), _mm256_loadu_ps(output + i)));
+    }
+    const size_t done = i / channels;
+    scalar().accumulateRamp(input + i, output + i, frames - done, channels,
+                            start + step * static_cast<float>(done), step);
+}
+
+const MixKernels kAvx2FmaMixKernels = {accumulateAvx2, accumulateRampAvx2};
+
+} // namespace
+
+#endif
+
+namespace detail {
+
+const MixKernels* avx2FmaMixKernels() {
+#if defined(AUDIO_SIMD_AVX2_FMA)
+    return &kAvx2FmaMixKernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace detail
+
+} // namespace simd
+} // namespace audio
@@ -0,0 +1,276 @@
+#include "audio/simd/sample_convert.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace audio {
+namespace simd {
+
+namespace {
+
+const float kScale16 = 32768.0f;
+const float kScale24 = 8388608.0f;
+const float kScale32 = 2147483648.0f;
+
+// 饱和截断（NaN截断到下限，与SIMD的max/min语义一致）
+inline float clampSample(float x, float lo, float hi) {
+    x = x > lo ? x : lo;
+    return x < hi ? x : hi;
+}
+
+void s16ToFloat(const int16_t* input, float* output, size_t samples) {
+    const float scale = 1.0f / kScale16;
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] = static_cast<float>(input[i]) * scale;
+    }
+}
+
+void floatToS16(const float* input, int16_t* output, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] = static_cast<int16_t>(std::lrint(clampSample(input[i] * kScale16, -32768.0f, 32767.0f)));
+    }
+}
+
+void s24ToFloat(const uint8_t* input, float* output, size_t samples) {
+    const float scale = 1.0f / kScale24;
+    for (size_t i = 0; i < samples; ++i) {
+        const uint8_t* p = input + i * 3;
+        const uint32_t bits = (static_cast<uint32_t>(p[0]) << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+                              (static_cast<uint32_t>(p[2]) << 24);
+        output[i] = static_cast<float>(static_cast<int32_t>(bits) >> 8) * scale;
+    }
+}
+
+void floatToS24(const float* input, uint8_t* output, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        const int32_t value = static_cast<int32_t>(std::lrint(clampSample(input[i] * kScale24, -8388608.0f, 8388607.0f)));
+        uint8_t* p = output + i * 3;
+        p[0] = static_cast<uint8_t>(value);
+        p[1] = static_cast<uint8_t>(value >> 8);
+        p[2] = static_cast<uint8_t>(value >> 16);
+    }
+}
+
+void s32ToFloat(const int32_t* input, float* output, size_t samples) {
+    const float scale = 1.0f / kScale32;
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] = static_cast<float>(input[i]) * scale;
+    }
+}
+
+void floatToS32(const float* input, int32_t* output, size_t samples) {
+    // 2147483520为小于2^31的最大单精度数
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] = static_cast<int32_t>(std::lrint(clampSample(input[i] * kScale32, -2147483648.0f, 2147483520.0f)));
+    }
+}
+
+void doubleToFloat(const double* input, float* output, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] = static_cast<float>(input[i]);
+    }
+}
+
+void floatToDouble(const float* input, double* output, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        output[i] = static_cast<double>(input[i]);
+    }
+}
+
+void swap16(uint16_t* data, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        data[i] = static_cast<uint16_t>((data[i] << 8) | (data[i] >> 8));
+    }
+}
+
+void swap24(uint8_t* data, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        uint8_t* p = data + i * 3;
+        const uint8_t first = p[0];
+        p[0] = p[2];
+        p[2] = first;
+    }
+}
+
+void swap32(uint32_t* data, size_t samples) {
+    for (size_t i = 0; i < samples; ++i) {
+        const uint32_t v = data[i];
+        data[i] = (v << 24) | ((v << 8) & 0x00FF0000u) | ((v >> 8) & 0x0000FF00u) | (v >> 24);
+    }
+}
+
+void interleave(const float* const* planes, float* output, size_t frames, size_t channels) {
+    for (size_t ch = 0; ch < channels; ++ch) {
+        const float* plane = planes[ch];
+        for (size_t i = 0; i < frames; ++i) {
+            output[i * channels + ch] = plane[i];
+        }
+    }
+}
+
+void deinterleave(const float* input, float* const* planes, size_t frames, size_t channels) {
+    for (size_t ch = 0; ch < channels; ++ch) {
+        float* plane = planes[ch];
+        for (size_t i = 0; i < frames; ++i) {
+            plane[i] = input[i * channels + ch];
+        }
+    }
+}
+
+const ConversionKernels kScalarKernels = {
+    s16ToFloat, floatToS16, s24ToFloat, floatToS24, s32ToFloat, floatToS32,
+    doubleToFloat, floatToDouble, swap16, swap24, swap32, interleave, deinterleave
+};
+
+bool cpuSupportsAvx2() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    // 需要CPU支持AVX2且操作系统保存YMM寄存器
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+namespace detail {
+
+const ConversionKernels& scalarKernels() {
+    return kScalarKernels;
+}
+
+} // namespace detail
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = [] {
+        if (detail::avx2Kernels() != nullptr && cpuSupportsAvx2()) {
+            return SimdLevel::AVX2;
+        }
+        // SSE2是x86-64的基线指令集
+        if (detail::sse2Kernels() != nullptr) {
+            return SimdLevel::SSE2;
+        }
+        return SimdLevel::SCALAR;
+    }();
+    return level;
+}
+
+const ConversionKernels& getKernels(SimdLevel level) {
+    const SimdLevel supported = detectSimdLevel();
+    if (level == SimdLevel::AVX2 && supported == SimdLevel::AVX2) {
+        return *detail::avx2Kernels();
+    }
+    if (level != SimdLevel::SCALAR && supported != SimdLevel::SCALAR) {
+        return *detail::sse2Kernels();
+    }
+    return detail::scalarKernels();
+}
+
+const ConversionKernels& getKernels() {
+    static const ConversionKernels& kernels = getKernels(detectSimdLevel());
+    return kernels;
+}
+
+size_t bytesPerSample(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::PCM_S16LE: return 2;
+        case SampleFormat::PCM_S24LE: return 3;
+        case SampleFormat::PCM_S32LE: return 4;
+        case SampleFormat::PCM_FLOAT: return 4;
+        case SampleFormat::PCM_DOUBLE: return 8;
+        default: return 0;
+    }
+}
+
+bool toFloat(const void* input, SampleFormat format, float* output, size_t samples) {
+    const ConversionKernels& kernels = getKernels();
+    switch (format) {
+        case SampleFormat::PCM_S16LE:
+            kernels.s16ToFloat(static_cast<const int16_t*>(input), output, samples);
+            return true;
+        case SampleFormat::PCM_S24LE:
+            kernels.s24ToFloat(static_cast<const uint8_t*>(input), output, samples);
+            return true;
+        case SampleFormat::PCM_S32LE:
+            kernels.s32ToFloat(static_cast<const int32_t*>(input), output, samples);
+            return true;
+        case SampleFormat::PCM_FLOAT:
+            if (static_cast<const void*>(output) != input) {
+                std::memmove(output, input, samples * sizeof(float));
+            }
+            return true;
+        case SampleFormat::PCM_DOUBLE:
+            kernels.doubleToFloat(static_cast<const double*>(input), output, samples);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool fromFloat(const float* input, SampleFormat format, void* output, size_t samples) {
+    const ConversionKernels& kernels = getKernels();
+    switch (format) {
+        case SampleFormat::PCM_S16LE:
+            kernels.floatToS16(input, static_cast<int16_t*>(output), samples);
+            return true;
+        case SampleFormat::PCM_S24LE:
+            kernels.floatToS24(input, static_cast<uint8_t*>(output), samples);
+            return true;
+        case SampleFormat::PCM_S32LE:
+            kernels.floatToS32(input, static_cast<int32_t*>(output), samples);
+            return true;
+        case SampleFormat::PCM_FLOAT:
+            if (output != static_cast<const void*>(input)) {
+                std::memmove(output, input, samples * sizeof(float));
+            }
+            return true;
+        case SampleFormat::PCM_DOUBLE:
+            kernels.floatToDouble(input, static_cast<double*>(output), samples);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool convert(const void* input, SampleFormat input_format,
+             void* output, SampleFormat output_format,
+             float* scratch, size_t samples) {
+    if (input_format == output_format) {
+        const size_t bytes = bytesPerSample(input_format);
+        if (bytes == 0) {
+            return false;
+        }
+        if (output != input) {
+            std::memmove(output, input, samples * bytes);
+        }
+        return true;
+    }
+
+    // 一端为浮点时直接转换，不经过scratch
+    if (input_format == SampleFormat::PCM_FLOAT) {
+        return fromFloat(static_cast<const float*>(input), output_format, output, samples);
+    }
+    if (output_format == SampleFormat::PCM_FLOAT) {
+        return toFloat(input, input_format, static_cast<float*>(output), samples);
+    }
+    return scratch != nullptr &&
+           toFloat(input, input_format, scratch, samples) &&
+           fromFloat(scratch, output_format, output, samples);
+}
+
+} // namespace simd
+} // namespace audio
@@ -0,0 +1,444 @@
+#include "audio/simd/sample_convert.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AUDIO_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// SSE2为x86-64基线，32位x86需编译器启用SSE2
+#if defined(AUDIO_SIMD_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define AUDIO_SIMD_SSE2 1
+#endif
+
+// AVX2内核按函数启用目标指令集，由运行时检测选择，不影响其余代码的编译选项
+#if defined(AUDIO_SIMD_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define AUDIO_SIMD_AVX2 1
+#if defined(__GNUC__)
+#define AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIO_TARGET_AVX2
+#endif
+#endif
+
+namespace audio {
+namespace simd {
+
+#if defined(AUDIO_SIMD_SSE2)
+
+namespace {
+
+const float kScale16 = 32768.0f;
+const float kScale24 = 8388608.0f;
+const float kScale32 = 2147483648.0f;
+
+// 尾部样本交给标量内核
+inline const ConversionKernels& scalar() {
+    return detail::scalarKernels();
+}
+
+// ---------------------------------------------------------------- SSE2
+
+inline __m128 clampSse2(__m128 x, __m128 lo, __m128 hi) {
+    return _mm_min_ps(_mm_max_ps(x, lo), hi);
+}
+
+void s16ToFloatSse2(const int16_t* input, float* output, size_t samples) {
+    const __m128 scale = _mm_set1_ps(1.0f / kScale16);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        // 16位复制到32位的高半部分后算术右移，得到符号扩展
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    scalar().s16ToFloat(input + i, output + i, samples - i);
+}
+
+void floatToS16Sse2(const float* input, int16_t* output, size_t samples) {
+    const __m128 scale = _mm_set1_ps(kScale16);
+    const __m128 lo = _mm_set1_ps(-32768.0f);
+    const __m128 hi = _mm_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128i a = _mm_cvtps_epi32(clampSse2(_mm_mul_ps(_mm_loadu_ps(input + i), scale), lo, hi));
+        const __m128i b = _mm_cvtps_epi32(clampSse2(_mm_mul_ps(_mm_loadu_ps(input + i + 4), scale), lo, hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(a, b));
+    }
+    scalar().floatToS16(input + i, output + i, samples - i);
+}
+
+void s24ToFloatSse2(const uint8_t* input, float* output, size_t samples) {
+    const __m128 scale = _mm_set1_ps(1.0f / kScale24);
+    size_t i = 0;
+    // 每次读取16字节（4个样本占12字节）
+    for (; (i + 4) * 3 + 4 <= samples * 3; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 3));
+        const __m128i ab = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+        const __m128i cd = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+        const __m128i x = _mm_srai_epi32(_mm_slli_epi32(_mm_unpacklo_epi64(ab, cd), 8), 8);
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+    }
+    scalar().s24ToFloat(input + i * 3, output + i, samples - i);
+}
+
+void floatToS24Sse2(const float* input, uint8_t* output, size_t samples) {
+    const __m128 scale = _mm_set1_ps(kScale24);
+    const __m128 lo = _mm_set1_ps(-8388608.0f);
+    const __m128 hi = _mm_set1_ps(8388607.0f);
+    const __m128i mask24 = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i even = _mm_set_epi32(0, -1, 0, -1);
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128i v = _mm_cvtps_epi32(clampSse2(_mm_mul_ps(_mm_loadu_ps(input + i), scale), lo, hi));
+        const __m128i m = _mm_and_si128(v, mask24);
+        // 每个64位通道拼成6字节：s0 | s1 << 24，s2 | s3 << 24
+        const __m128i pairs = _mm_or_si128(_mm_and_si128(m, even), _mm_slli_epi64(_mm_srli_epi64(m, 32), 24));
+        const __m128i packed = _mm_or_si128(_mm_move_epi64(pairs), _mm_slli_si128(_mm_srli_si128(pairs, 8), 6));
+        uint8_t* p = output + i * 3;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), packed);
+        const int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+        std::memcpy(p + 8, &tail, 4);
+    }
+    scalar().floatToS24(input + i, output + i * 3, samples - i);
+}
+
+void s32ToFloatSse2(const int32_t* input, float* output, size_t samples) {
+    const __m128 scale = _mm_set1_ps(1.0f / kScale32);
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+    scalar().s32ToFloat(input + i, output + i, samples - i);
+}
+
+void floatToS32Sse2(const float* input, int32_t* output, size_t samples) {
+    const __m128 scale = _mm_set1_ps(kScale32);
+    const __m128 lo = _mm_set1_ps(-2147483648.0f);
+    const __m128 hi = _mm_set1_ps(2147483520.0f);
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 x = clampSse2(_mm_mul_ps(_mm_loadu_ps(input + i), scale), lo, hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_cvtps_epi32(x));
+    }
+    scalar().floatToS32(input + i, output + i, samples - i);
+}
+
+void doubleToFloatSse2(const double* input, float* output, size_t samples) {
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(input + i));
+        const __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(input + i + 2));
+        _mm_storeu_ps(output + i, _mm_movelh_ps(a, b));
+    }
+    scalar().doubleToFloat(input + i, output + i, samples - i);
+}
+
+void floatToDoubleSse2(const float* input, double* output, size_t samples) {
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 v = _mm_loadu_ps(input + i);
+        _mm_storeu_pd(output + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(output + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    scalar().floatToDouble(input + i, output + i, samples - i);
+}
+
+void swap16Sse2(uint16_t* data, size_t samples) {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i);
+        const __m128i v = _mm_loadu_si128(p);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+    scalar().swap16(data + i, samples - i);
+}
+
+void swap24Sse2(uint8_t* data, size_t samples) {
+    // 16字节含5个完整样本：字节3k与3k+2互换（移位2字节后按掩码合并），第16字节原样写回
+    const __m128i keep = _mm_setr_epi8(0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, -1);
+    const __m128i first = _mm_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, 0);
+    const __m128i last = _mm_setr_epi8(0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0);
+    size_t i = 0;
+    for (; (i + 5) * 3 + 1 <= samples * 3; i += 5) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i * 3);
+        const __m128i v = _mm_loadu_si128(p);
+        const __m128i swapped = _mm_or_si128(
+            _mm_and_si128(v, keep),
+            _mm_or_si128(_mm_and_si128(_mm_srli_si128(v, 2), first), _mm_and_si128(_mm_slli_si128(v, 2), last)));
+        _mm_storeu_si128(p, swapped);
+    }
+    scalar().swap24(data + i * 3, samples - i);
+}
+
+void swap32Sse2(uint32_t* data, size_t samples) {
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i);
+        __m128i v = _mm_loadu_si128(p);
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+        _mm_storeu_si128(p, v);
+    }
+    scalar().swap32(data + i, samples - i);
+}
+
+void interleaveSse2(const float* const* planes, float* output, size_t frames, size_t channels) {
+    if (channels != 2) {
+        scalar().interleave(planes, output, frames, channels);
+        return;
+    }
+
+    const float* left = planes[0];
+    const float* right = planes[1];
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 l = _mm_loadu_ps(left + i);
+        const __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(output + i * 2, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(output + i * 2 + 4, _mm_unpackhi_ps(l, r));
+    }
+    const float* rest[2] = {left + i, right + i};
+    scalar().interleave(rest, output + i * 2, frames - i, 2);
+}
+
+void deinterleaveSse2(const float* input, float* const* planes, size_t frames, size_t channels) {
+    if (channels != 2) {
+        scalar().deinterleave(input, planes, frames, channels);
+        return;
+    }
+
+    float* left = planes[0];
+    float* right = planes[1];
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 a = _mm_loadu_ps(input + i * 2);
+        const __m128 b = _mm_loadu_ps(input + i * 2 + 4);
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    float* rest[2] = {left + i, right + i};
+    scalar().deinterleave(input + i * 2, rest, frames - i, 2);
+}
+
+const ConversionKernels kSse2Kernels = {
+    s16ToFloatSse2, floatToS16Sse2, s24ToFloatSse2, floatToS24Sse2, s32ToFloatSse2, floatToS32Sse2,
+    doubleToFloatSse2, floatToDoubleSse2, swap16Sse2, swap24Sse2, swap32Sse2, interleaveSse2, deinterleaveSse2
+};
+
+// ---------------------------------------------------------------- AVX2
+
+#if defined(AUDIO_SIMD_AVX2)
+
+AUDIO_TARGET_AVX2 inline __m256 clampAvx2(__m256 x, __m256 lo, __m256 hi) {
+    return _mm256_min_ps(_mm256_max_ps(x, lo), hi);
+}
+
+AUDIO_TARGET_AVX2 void s16ToFloatAvx2(const int16_t* input, float* output, size_t samples) {
+    const __m256 scale = _mm256_set1_ps(1.0f / kScale16);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        const __m256i a = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+        const __m256i b = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 8)));
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(a), scale));
+        _mm256_storeu_ps(output + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), scale));
+    }
+    s16ToFloatSse2(input + i, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void floatToS16Avx2(const float* input, int16_t* output, size_t samples) {
+    const __m256 scale = _mm256_set1_ps(kScale16);
+    const __m256 lo = _mm256_set1_ps(-32768.0f);
+    const __m256 hi = _mm256_set1_ps(32767.0f);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        const __m256i a = _mm256_cvtps_epi32(clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(input + i), scale), lo, hi));
+        const __m256i b = _mm256_cvtps_epi32(clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(input + i + 8), scale), lo, hi));
+        // packs按128位通道交错，再按64位重排回顺序
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+    }
+    floatToS16Sse2(input + i, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void s24ToFloatAvx2(const uint8_t* input, float* output, size_t samples) {
+    const __m256 scale = _mm256_set1_ps(1.0f / kScale24);
+    // 每个128位通道的4个样本放到32位的高3字节，算术右移完成符号扩展
+    const __m256i shuffle = _mm256_setr_epi8(
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    size_t i = 0;
+    // 两次16字节读取覆盖8个样本（24字节）之后的4字节
+    for (; (i + 8) * 3 + 4 <= samples * 3; i += 8) {
+        const uint8_t* p = input + i * 3;
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+        const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        const __m256i x = _mm256_srai_epi32(_mm256_shuffle_epi8(v, shuffle), 8);
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+    }
+    s24ToFloatSse2(input + i * 3, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void floatToS24Avx2(const float* input, uint8_t* output, size_t samples) {
+    const __m256 scale = _mm256_set1_ps(kScale24);
+    const __m256 lo = _mm256_set1_ps(-8388608.0f);
+    const __m256 hi = _mm256_set1_ps(8388607.0f);
+    // 每个128位通道取4个样本的低3字节拼成12字节，再跨通道合并为连续24字节
+    const __m256i shuffle = _mm256_setr_epi8(
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m256i v = _mm256_cvtps_epi32(clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(input + i), scale), lo, hi));
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle), compact);
+        uint8_t* p = output + i * 3;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p + 16), _mm256_extracti128_si256(packed, 1));
+    }
+    floatToS24Sse2(input + i, output + i * 3, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void s32ToFloatAvx2(const int32_t* input, float* output, size_t samples) {
+    const __m256 scale = _mm256_set1_ps(1.0f / kScale32);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    s32ToFloatSse2(input + i, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void floatToS32Avx2(const float* input, int32_t* output, size_t samples) {
+    const __m256 scale = _mm256_set1_ps(kScale32);
+    const __m256 lo = _mm256_set1_ps(-2147483648.0f);
+    const __m256 hi = _mm256_set1_ps(2147483520.0f);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m256 x = clampAvx2(_mm256_mul_ps(_mm256_loadu_ps(input + i), scale), lo, hi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_cvtps_epi32(x));
+    }
+    floatToS32Sse2(input + i, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void doubleToFloatAvx2(const double* input, float* output, size_t samples) {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128 a = _mm256_cvtpd_ps(_mm256_loadu_pd(input + i));
+        const __m128 b = _mm256_cvtpd_ps(_mm256_loadu_pd(input + i + 4));
+        _mm256_storeu_ps(output + i, _mm256_insertf128_ps(_mm256_castps128_ps256(a), b, 1));
+    }
+    doubleToFloatSse2(input + i, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void floatToDoubleAvx2(const float* input, double* output, size_t samples) {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        _mm256_storeu_pd(output + i, _mm256_cvtps_pd(_mm_loadu_ps(input + i)));
+        _mm256_storeu_pd(output + i + 4, _mm256_cvtps_pd(_mm_loadu_ps(input + i + 4)));
+    }
+    floatToDoubleSse2(input + i, output + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void swap16Avx2(uint16_t* data, size_t samples) {
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        __m256i* p = reinterpret_cast<__m256i*>(data + i);
+        const __m256i v = _mm256_loadu_si256(p);
+        _mm256_storeu_si256(p, _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8)));
+    }
+    swap16Sse2(data + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void swap32Avx2(uint32_t* data, size_t samples) {
+    const __m256i shuffle = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), shuffle));
+    }
+    swap32Sse2(data + i, samples - i);
+}
+
+AUDIO_TARGET_AVX2 void interleaveAvx2(const float* const* planes, float* output, size_t frames, size_t channels) {
+    if (channels != 2) {
+        scalar().interleave(planes, output, frames, channels);
+        return;
+    }
+
+    const float* left = planes[0];
+    const float* right = planes[1];
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 l = _mm256_loadu_ps(left + i);
+        const __m256 r = _mm256_loadu_ps(right + i);
+        const __m256 lo = _mm256_unpacklo_ps(l, r);
+        const __m256 hi = _mm256_unpackhi_ps(l, r);
+        _mm256_storeu_ps(output + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(output + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    const float* rest[2] = {left + i, right + i};
+    interleaveSse2(rest, output + i * 2, frames - i, 2);
+}
+
+AUDIO_TARGET_AVX2 void deinterleaveAvx2(const float* input, float* const* planes, size_t frames, size_t channels) {
+    if (channels != 2) {
+        scalar().deinterleave(input, planes, frames, channels);
+        return;
+    }
+
+    float* left = planes[0];
+    float* right = planes[1];
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 a = _mm256_loadu_ps(input + i * 2);
+        const __m256 b = _mm256_loadu_ps(input + i * 2 + 8);
+        const __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+        const __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+        _mm256_storeu_ps(left + i, _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm256_storeu_ps(right + i, _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    float* rest[2] = {left + i, right + i};
+    deinterleaveSse2(input + i * 2, rest, frames - i, 2);
+}
+
+// 24位字节序交换没有跨通道的收益，沿用SSE2版本
+const ConversionKernels kAvx2Kernels = {
+    s16ToFloatAvx2, floatToS16Avx2, s24ToFloatAvx2, floatToS24Avx2, s32ToFloatAvx2, floatToS32Avx2,
+    doubleToFloatAvx2, floatToDoubleAvx2, swap16Avx2, swap24Sse2, swap32Avx2, interleaveAvx2, deinterleaveAvx2
+};
+
+#endif // AUDIO_SIMD_AVX2
+
+} // namespace
+
+#endif // AUDIO_SIMD_SSE2
+
+namespace detail {
+
+const ConversionKernels* sse2Kernels() {
+#if defined(AUDIO_SIMD_SSE2)
+    return &kSse2Kernels;
+#else
+    return nullptr;
+#endif
+}
+
+const ConversionKernels* avx2Kernels() {
+#if defined(AUDIO_SIMD_AVX2)
+    return &kAvx2Kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace detail
+
+} // namespace simd
+} // namespace audio
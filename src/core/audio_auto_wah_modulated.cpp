@@ -1,94 +0,0 @@
-#include "core/audio_auto_wah_modulated.h"
-#include <iostream>
-
-namespace core {
-
-AudioAutoWahModulated::AudioAutoWahModulated() 
-    : initialized_(false), rate_(2.0f), depth_(0.5f), feedback_(0.3f), mix_(0.5f), 
-      modulation_rate_(1.0f), modulation_depth_(0.2f) {
-    // 初始化音频调制自动哇音器
-}
-
-AudioAutoWahModulated::~AudioAutoWahModulated() {
-    // 析构函数
-    shutdown();
-}
-
-bool AudioAutoWahModulated::initialize() {
-    std::cout << "Initializing audio auto wah modulated" << std::endl;
-    
-    // 在实际实现中，这里会初始化调制自动哇音器
-    
-    initialized_ = true;
-    return true;
-}
-
-void AudioAutoWahModulated::shutdown() {
-    if (initialized_) {
-        std::cout << "Shutting down audio auto wah modulated" << std::endl;
-        
-        // 在实际实现中，这里会关闭调制自动哇音器
-        
-        initialized_ = false;
-    }
-}
-
-bool AudioAutoWahModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Applying audio auto wah modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制自动哇音效果
-    
-    output = input;  // 模拟处理
-    return true;
-}
-
-bool AudioAutoWahModulated::setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Setting auto wah modulated parameters - Rate: " << rate 
-              << " Hz, Depth: " << depth << ", Feedback: " << feedback 
-              << ", Mix: " << mix << ", Modulation rate: " << modulation_rate 
-              << " Hz, Modulation depth: " << modulation_depth << std::endl;
-    
-    // 在实际实现中，这里会设置调制自动哇音参数
-    
-    rate_ = rate;
-    depth_ = depth;
-    feedback_ = feedback;
-    mix_ = mix;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
-    return true;
-}
-
-void AudioAutoWahModulated::getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth) const {
-    rate = rate_;
-    depth = depth_;
-    feedback = feedback_;
-    mix = mix_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
-}
-
-void AudioAutoWahModulated::reset() {
-    if (initialized_) {
-        std::cout << "Resetting audio auto wah modulated" << std::endl;
-        
-        // 在实际实现中，这里会重置调制自动哇音器
-        
-        rate_ = 2.0f;
-        depth_ = 0.5f;
-        feedback_ = 0.3f;
-        mix_ = 0.5f;
-        modulation_rate_ = 1.0f;
-        modulation_depth_ = 0.2f;
-    }
-}
-
-} // namespace core
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "core/audio_automation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+namespace {
+
+// 指数斜坡按块展开的长度：段内每kUnroll帧乘一次步进幂
+const size_t kUnroll = 8;
+
+// 检查两端是否可以使用指数斜坡
+inline bool canUseExponential(float from, float to) {
+    return from * to > 0.0f;
+}
+
+// 按帧位置插入断点（同一帧已有断点时替换）
+void insertPoint(std::vector<AutomationPoint>& points, const AutomationPoint& point) {
+    auto it = std::lower_bound(points.begin(), points.end(), point.frame,
+                               [](const AutomationPoint& p, uint64_t frame) { return p.frame < frame; });
+    if (it != points.end() && it->frame == point.frame) {
+        *it = point;
+    } else {
+        points.insert(it, point);
+    }
+}
+
+} // namespace
+
+// AutomationLane implementation
+AutomationLane::AutomationLane() : default_value_(0.0f) {}
+
+AutomationLane::AutomationLane(float default_value) : default_value_(default_value) {}
+
+size_t AutomationLane::segmentEnd(uint64_t frame) const {
+    auto it = std::upper_bound(points_.begin(), points_.end(), frame,
+                               [](uint64_t f, const AutomationPoint& p) { return f < p.frame; });
+    return static_cast<size_t>(it - points_.begin());
+}
+
+float AutomationLane::segmentValue(size_t end, uint64_t frame) const {
+    const AutomationPoint& a = points_[end - 1];
+    const AutomationPoint& b = points_[end];
+    const double t = static_cast<double>(frame - a.frame) / static_cast<double>(b.frame - a.frame);
+
+    if (b.curve == AutomationCurve::STEP) {
+        return a.value;
+    }
+    if (b.curve == AutomationCurve::EXPONENTIAL && canUseExponential(a.value, b.value)) {
+        return static_cast<float>(a.value * std::pow(static_cast<double>(b.value) / a.value, t));
+    }
+    return static_cast<float>(a.value + (static_cast<double>(b.value) - a.value) * t);
+}
+
+float AutomationLane::valueAt(uint64_t frame) const {
+    if (points_.empty()) {
+        return default_value_;
+    }
+
+    const size_t end = segmentEnd(frame);
+    if (end == 0) {
+        return points_.front().value;
+    }
+    if (end == points_.size()) {
+        return points_.back().value;
+    }
+    return segmentValue(end, frame);
+}
+
+size_t AutomationLane::nextEvent(uint64_t start, size_t frames) const {
+    const size_t end = segmentEnd(start);
+    if (end == points_.size()) {
+        return frames;
+    }
+
+    const uint64_t distance = points_[end].frame - start;
+    return distance < frames ? static_cast<size_t>(distance) : frames;
+}
+
+bool AutomationLane::isConstant(uint64_t start, size_t frames) const {
+    const size_t end = segmentEnd(start);
+    if (end == points_.size()) {
+        return true;
+    }
+    if (points_[end].frame < start + frames) {
+        return false;
+    }
+    return end == 0 || points_[end].curve == AutomationCurve::STEP ||
+           points_[end - 1].value == points_[end].value;
+}
+
+void AutomationLane::render(uint64_t start, size_t frames, float* output) const {
+    size_t offset = 0;
+    while (offset < frames) {
+        const uint64_t frame = start + offset;
+        const size_t end = segmentEnd(frame);
+        const size_t count = end == points_.size()
+            ? frames - offset
+            : static_cast<size_t>(std::min<uint64_t>(frames - offset, points_[end].frame - frame));
+        float* out = output + offset;
+
+        if (end == 0 || end == points_.size() || points_[end].curve == AutomationCurve::STEP) {
+            // 常数段
+            std::fill(out, out + count, valueAt(frame));
+        } else {
+            const AutomationPoint& a = points_[end - 1];
+            const AutomationPoint& b = points_[end];
+            const double span = static_cast<double>(b.frame - a.frame);
+            const double position = static_cast<double>(frame - a.frame);
+
+            if (b.curve == AutomationCurve::EXPONENTIAL && canUseExponential(a.value, b.value)) {
+                // 指数段：每帧乘以固定比例，按kUnroll帧展开以便向量化
+                const double ratio = static_cast<double>(b.value) / a.value;
+                const double step = std::pow(ratio, 1.0 / span);
+                float powers[kUnroll];
+                for (size_t k = 0; k < kUnroll; ++k) {
+                    powers[k] = static_cast<float>(std::pow(step, static_cast<double>(k)));
+                }
+                const float stride = static_cast<float>(std::pow(step, static_cast<double>(kUnroll)));
+
+                float base = static_cast<float>(a.value * std::pow(ratio, position / span));
+                size_t i = 0;
+                for (; i + kUnroll <= count; i += kUnroll) {
+                    for (size_t k = 0; k < kUnroll; ++k) {
+                        out[i + k] = base * powers[k];
+                    }
+                    base *= stride;
+                }
+                for (size_t k = 0; i < count; ++i, ++k) {
+                    out[i] = base * powers[k];
+                }
+            } else {
+                // 线性段
+                const double slope = (static_cast<double>(b.value) - a.value) / span;
+                const float origin = static_cast<float>(a.value + slope * position);
+                const float increment = static_cast<float>(slope);
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = origin + increment * static_cast<float>(i);
+                }
+            }
+        }
+
+        offset += count;
+    }
+}
+
+// AudioAutomation implementation
+AudioAutomation::AudioAutomation()
+    : version_(0), published_(nullptr), acknowledged_(0) {
+    // 发布初始的空快照，保证acquire()总能返回有效指针
+    auto snapshot = std::make_unique<AutomationSnapshot>();
+    snapshot->version = version_;
+    published_.store(snapshot.get(), std::memory_order_release);
+    history_.push_back(std::move(snapshot));
+}
+
+AudioAutomation::~AudioAutomation() {
+    // 析构函数
+}
+
+AudioAutomation::ParameterId AudioAutomation::addParameter(const std::string& name, float default_value) {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    names_.push_back(name);
+    working_.emplace_back(default_value);
+    return working_.size() - 1;
+}
+
+bool AudioAutomation::findParameter(const std::string& name, ParameterId& parameter) const {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    const auto it = std::find(names_.begin(), names_.end(), name);
+    if (it == names_.end()) {
+        return false;
+    }
+
+    parameter = static_cast<ParameterId>(it - names_.begin());
+    return true;
+}
+
+size_t AudioAutomation::getParameterCount() const {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    return working_.size();
+}
+
+bool AudioAutomation::addPoint(ParameterId parameter, uint64_t frame, float value, AutomationCurve curve) {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    if (parameter >= working_.size()) {
+        return false;
+    }
+
+    insertPoint(working_[parameter].points_, AutomationPoint{frame, value, curve});
+    return true;
+}
+
+bool AudioAutomation::addRamp(ParameterId parameter, uint64_t start_frame, uint64_t end_frame,
+                              float from, float to, AutomationCurve curve) {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    if (parameter >= working_.size() || end_frame <= start_frame) {
+        return false;
+    }
+
+    // 斜坡内原有的断点被替换；起点处跳变到from，之前的值保持到起点为止
+    auto& points = working_[parameter].points_;
+    points.erase(std::remove_if(points.begin(), points.end(),
+                                [start_frame, end_frame](const AutomationPoint& p) {
+                                    return p.frame > start_frame && p.frame < end_frame;
+                                }),
+                 points.end());
+    insertPoint(points, AutomationPoint{start_frame, from, AutomationCurve::STEP});
+    insertPoint(points, AutomationPoint{end_frame, to, curve});
+    return true;
+}
+
+bool AudioAutomation::clearRange(ParameterId parameter, uint64_t start_frame, uint64_t end_frame) {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    if (parameter >= working_.size()) {
+        return false;
+    }
+
+    auto& points = working_[parameter].points_;
+    points.erase(std::remove_if(points.begin(), points.end(),
+                                [start_frame, end_frame](const AutomationPoint& p) {
+                                    return p.frame >= start_frame && p.frame < end_frame;
+                                }),
+                 points.end());
+    return true;
+}
+
+bool AudioAutomation::clearParameter(ParameterId parameter) {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+    if (parameter >= working_.size()) {
+        return false;
+    }
+
+    working_[parameter].points_.clear();
+    return true;
+}
+
+void AudioAutomation::commit() {
+    std::lock_guard<std::mutex> lock(edit_mutex_);
+
+    auto snapshot = std::make_unique<AutomationSnapshot>();
+    snapshot->version = ++version_;
+    snapshot->lanes = working_;
+    published_.store(snapshot.get(), std::memory_order_release);
+    history_.push_back(std::move(snapshot));
+
+    reclaim();
+}
+
+const AutomationSnapshot* AudioAutomation::acquire() {
+    const AutomationSnapshot* snapshot = published_.load(std::memory_order_acquire);
+    acknowledged_.store(snapshot->version, std::memory_order_release);
+    return snapshot;
+}
+
+void AudioAutomation::reclaim() {
+    // 音频线程正在使用的快照版本不低于其最后确认的版本
+    const uint64_t acknowledged = acknowledged_.load(std::memory_order_acquire);
+    history_.erase(std::remove_if(history_.begin(), history_.end(),
+                                  [acknowledged](const std::unique_ptr<AutomationSnapshot>& snapshot) {
+                                      return snapshot->version < acknowledged;
+                                  }),
+                   history_.end());
+}
+
+} // namespace core
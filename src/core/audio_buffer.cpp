@@ -71,7 +71,9 @@ AudioBuffer AudioBuffer::subBuffer(size_t start, size_t length) const {
     }
     
     size_t end = std::min(start + length, buffer_.size());
-    return AudioBuffer(buffer_.data() + start, buffer_.data() + end);
+    AudioBuffer result(end - start);
+    std::copy(buffer_.begin() + start, buffer_.begin() + end, result.buffer_.begin());
+    return result;
 }
 
 } // namespace core
\ No newline at end of file
@@ -0,0 +1,336 @@
+#include "core/audio_channel_mixer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace core {
+
+namespace {
+
+// 扬声器位置
+enum Speaker {
+    SPEAKER_L,
+    SPEAKER_R,
+    SPEAKER_C,
+    SPEAKER_LFE,
+    SPEAKER_LS,
+    SPEAKER_RS,
+    SPEAKER_LB,
+    SPEAKER_RB,
+    SPEAKER_NONE
+};
+
+const Speaker kMono[] = {SPEAKER_C};
+const Speaker kStereo[] = {SPEAKER_L, SPEAKER_R};
+const Speaker kQuad[] = {SPEAKER_L, SPEAKER_R, SPEAKER_LS, SPEAKER_RS};
+const Speaker kFivePointOne[] = {SPEAKER_L, SPEAKER_R, SPEAKER_C, SPEAKER_LFE, SPEAKER_LS, SPEAKER_RS};
+const Speaker kSevenPointOne[] = {SPEAKER_L, SPEAKER_R, SPEAKER_C, SPEAKER_LFE,
+                                  SPEAKER_LB, SPEAKER_RB, SPEAKER_LS, SPEAKER_RS};
+
+// -3dB
+const float kMinus3dB = 0.70710678f;
+
+// 逐块处理的帧数（平面缓冲区放在栈上）
+const size_t kBlockFrames = 256;
+
+const Speaker* layoutSpeakers(audio::ChannelLayout layout) {
+    switch (layout) {
+        case audio::ChannelLayout::MONO: return kMono;
+        case audio::ChannelLayout::STEREO: return kStereo;
+        case audio::ChannelLayout::QUAD: return kQuad;
+        case audio::ChannelLayout::FIVE_POINT_ONE: return kFivePointOne;
+        case audio::ChannelLayout::SEVEN_POINT_ONE: return kSevenPointOne;
+        default: return nullptr;
+    }
+}
+
+// 输出布局中扬声器的声道序号（不存在为-1）
+int findSpeaker(const Speaker* speakers, size_t count, Speaker speaker) {
+    for (size_t i = 0; i < count; ++i) {
+        if (speakers[i] == speaker) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+using Kernel = void (*)(const float* input, float* output, size_t frames,
+                        const ChannelMixer::Tap* taps, const size_t* counts);
+
+// 特化内核：声道数为编译期常量，交错/平面转换的跨步固定，
+// 混合部分每个输出声道只遍历非零系数，内层为连续内存上的乘加
+template <size_t In, size_t Out>
+void mixKernel(const float* input, float* output, size_t frames,
+               const ChannelMixer::Tap* taps, const size_t* counts) {
+    float planes[In][kBlockFrames];
+    float mixed[Out][kBlockFrames];
+
+    for (size_t offset = 0; offset < frames; offset += kBlockFrames) {
+        const size_t count = std::min(kBlockFrames, frames - offset);
+
+        const float* in = input + offset * In;
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t c = 0; c < In; ++c) {
+                planes[c][i] = in[i * In + c];
+            }
+        }
+
+        for (size_t o = 0; o < Out; ++o) {
+            float* __restrict dst = mixed[o];
+            const ChannelMixer::Tap* tap = taps + o * ChannelMixer::kMaxChannels;
+            if (counts[o] == 0) {
+                std::fill(dst, dst + count, 0.0f);
+                continue;
+            }
+
+            const float* __restrict first = planes[tap[0].channel];
+            const float first_gain = tap[0].gain;
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = first_gain * first[i];
+            }
+            for (size_t t = 1; t < counts[o]; ++t) {
+                const float* __restrict src = planes[tap[t].channel];
+                const float gain = tap[t].gain;
+                for (size_t i = 0; i < count; ++i) {
+                    dst[i] += gain * src[i];
+                }
+            }
+        }
+
+        float* out = output + offset * Out;
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t o = 0; o < Out; ++o) {
+                out[i * Out + o] = mixed[o][i];
+            }
+        }
+    }
+}
+
+template <size_t In>
+Kernel selectKernel(size_t output_channels) {
+    switch (output_channels) {
+        case 1: return &mixKernel<In, 1>;
+        case 2: return &mixKernel<In, 2>;
+        case 4: return &mixKernel<In, 4>;
+        case 6: return &mixKernel<In, 6>;
+        case 8: return &mixKernel<In, 8>;
+        default: return nullptr;
+    }
+}
+
+Kernel selectKernel(size_t input_channels, size_t output_channels) {
+    switch (input_channels) {
+        case 1: return selectKernel<1>(output_channels);
+        case 2: return selectKernel<2>(output_channels);
+        case 4: return selectKernel<4>(output_channels);
+        case 6: return selectKernel<6>(output_channels);
+        case 8: return selectKernel<8>(output_channels);
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+ChannelMixer::ChannelMixer()
+    : input_layout_(audio::ChannelLayout::STEREO), output_layout_(audio::ChannelLayout::STEREO),
+      input_channels_(2), output_channels_(2), lfe_gain_(0.0f), normalize_(true), identity_(true),
+      matrix_{}, taps_{}, tap_counts_{}, kernel_(nullptr) {
+    resetCoefficients();
+}
+
+size_t ChannelMixer::channelCount(audio::ChannelLayout layout) {
+    switch (layout) {
+        case audio::ChannelLayout::MONO: return 1;
+        case audio::ChannelLayout::STEREO: return 2;
+        case audio::ChannelLayout::QUAD: return 4;
+        case audio::ChannelLayout::FIVE_POINT_ONE: return 6;
+        case audio::ChannelLayout::SEVEN_POINT_ONE: return 8;
+        default: return 0;
+    }
+}
+
+bool ChannelMixer::setLayouts(audio::ChannelLayout input, audio::ChannelLayout output) {
+    if (channelCount(input) == 0 || channelCount(output) == 0) {
+        return false;
+    }
+
+    input_layout_ = input;
+    output_layout_ = output;
+    input_channels_ = channelCount(input);
+    output_channels_ = channelCount(output);
+    resetCoefficients();
+    return true;
+}
+
+audio::ChannelLayout ChannelMixer::getInputLayout() const {
+    return input_layout_;
+}
+
+audio::ChannelLayout ChannelMixer::getOutputLayout() const {
+    return output_layout_;
+}
+
+bool ChannelMixer::setCoefficient(size_t output, size_t input, float gain) {
+    if (output >= output_channels_ || input >= input_channels_ || !std::isfinite(gain)) {
+        return false;
+    }
+
+    overrides_[output][input] = gain;
+    rebuild();
+    return true;
+}
+
+float ChannelMixer::getCoefficient(size_t output, size_t input) const {
+    if (output >= output_channels_ || input >= input_channels_) {
+        return 0.0f;
+    }
+    return matrix_[output][input];
+}
+
+void ChannelMixer::resetCoefficients() {
+    for (auto& row : overrides_) {
+        std::fill(std::begin(row), std::end(row), std::numeric_limits<float>::quiet_NaN());
+    }
+    rebuild();
+}
+
+void ChannelMixer::setLfeGain(float gain) {
+    lfe_gain_ = std::max(gain, 0.0f);
+    rebuild();
+}
+
+void ChannelMixer::setNormalize(bool enabled) {
+    normalize_ = enabled;
+    rebuild();
+}
+
+bool ChannelMixer::process(const float* input, float* output, size_t frames) const {
+    if (input == nullptr || output == nullptr) {
+        return false;
+    }
+    // 输出比输入宽时原地处理会覆盖尚未读取的输入
+    if (input == output && output_channels_ > input_channels_) {
+        return false;
+    }
+
+    if (identity_) {
+        if (input != output) {
+            std::memcpy(output, input, frames * input_channels_ * sizeof(float));
+        }
+        return true;
+    }
+
+    kernel_(input, output, frames, taps_, tap_counts_);
+    return true;
+}
+
+void ChannelMixer::rebuild() {
+    const Speaker* inputs = layoutSpeakers(input_layout_);
+    const Speaker* outputs = layoutSpeakers(output_layout_);
+    const size_t out_count = output_channels_;
+    for (auto& row : matrix_) {
+        std::fill(std::begin(row), std::end(row), 0.0f);
+    }
+
+    // 向输出扬声器speaker累加；扬声器不存在时返回false
+    auto add = [&](Speaker speaker, size_t input, float gain) {
+        const int index = findSpeaker(outputs, out_count, speaker);
+        if (index < 0) {
+            return false;
+        }
+        matrix_[index][input] += gain;
+        return true;
+    };
+
+    for (size_t in = 0; in < input_channels_; ++in) {
+        const Speaker speaker = inputs[in];
+        if (add(speaker, in, 1.0f)) {
+            continue;
+        }
+
+        switch (speaker) {
+            case SPEAKER_C:
+                // 中置（含单声道上混）以-3dB分到左右
+                add(SPEAKER_L, in, kMinus3dB);
+                add(SPEAKER_R, in, kMinus3dB);
+                break;
+            case SPEAKER_L:
+            case SPEAKER_R:
+                add(SPEAKER_C, in, kMinus3dB);
+                break;
+            case SPEAKER_LFE:
+                if (lfe_gain_ > 0.0f && !add(SPEAKER_C, in, lfe_gain_)) {
+                    add(SPEAKER_L, in, lfe_gain_ * kMinus3dB);
+                    add(SPEAKER_R, in, lfe_gain_ * kMinus3dB);
+                }
+                break;
+            case SPEAKER_LS:
+            case SPEAKER_RS:
+                if (!add(speaker == SPEAKER_LS ? SPEAKER_L : SPEAKER_R, in, kMinus3dB)) {
+                    add(SPEAKER_C, in, 0.5f);
+                }
+                break;
+            case SPEAKER_LB:
+            case SPEAKER_RB: {
+                const bool left = speaker == SPEAKER_LB;
+                if (!add(left ? SPEAKER_LS : SPEAKER_RS, in, 1.0f) &&
+                    !add(left ? SPEAKER_L : SPEAKER_R, in, kMinus3dB)) {
+                    add(SPEAKER_C, in, 0.5f);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // 按系数绝对值之和最大的输出声道统一缩放，保持声道间平衡（7.1到立体声约-9.9 dB，见setNormalize）
+    if (normalize_) {
+        float peak = 0.0f;
+        for (size_t out = 0; out < out_count; ++out) {
+            float sum = 0.0f;
+            for (size_t in = 0; in < input_channels_; ++in) {
+                sum += std::fabs(matrix_[out][in]);
+            }
+            peak = std::max(peak, sum);
+        }
+        if (peak > 1.0f) {
+            for (size_t out = 0; out < out_count; ++out) {
+                for (size_t in = 0; in < input_channels_; ++in) {
+                    matrix_[out][in] /= peak;
+                }
+            }
+        }
+    }
+
+    for (size_t out = 0; out < out_count; ++out) {
+        for (size_t in = 0; in < input_channels_; ++in) {
+            if (!std::isnan(overrides_[out][in])) {
+                matrix_[out][in] = overrides_[out][in];
+            }
+        }
+    }
+
+    compile();
+}
+
+void ChannelMixer::compile() {
+    identity_ = input_channels_ == output_channels_;
+    for (size_t out = 0; out < output_channels_; ++out) {
+        size_t count = 0;
+        for (size_t in = 0; in < input_channels_; ++in) {
+            const float gain = matrix_[out][in];
+            if (gain != 0.0f) {
+                taps_[out * kMaxChannels + count] = {in, gain};
+                ++count;
+            }
+            identity_ = identity_ && gain == (in == out ? 1.0f : 0.0f);
+        }
+        tap_counts_[out] = count;
+    }
+    kernel_ = selectKernel(input_channels_, output_channels_);
+}
+
+} // namespace core
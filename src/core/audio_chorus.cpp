@@ -16,7 +16,8 @@ AudioChorus::~AudioChorus() {
 bool AudioChorus::initialize() {
     std::cout << "Initializing audio chorus" << std::endl;
     
-    // 在实际实现中，这里会初始化合唱器
+    effect_.initialize();
+    effect_.setParameters(rate_, depth_, feedback_, mix_, 0.0f, 0.0f);
     
     initialized_ = true;
     return true;
@@ -26,7 +27,7 @@ void AudioChorus::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio chorus" << std::endl;
         
-        // 在实际实现中，这里会关闭合唱器
+        effect_.shutdown();
         
         initialized_ = false;
     }
@@ -37,12 +38,7 @@ bool AudioChorus::apply(const AudioBuffer& input, AudioBuffer& output) {
         return false;
     }
     
-    std::cout << "Applying audio chorus effect" << std::endl;
-    
-    // 在实际实现中，这里会应用合唱效果
-    
-    output = input;  // 模拟处理
-    return true;
+    return effect_.apply(input, output);
 }
 
 bool AudioChorus::setParameters(float rate, float depth, float feedback, float mix) {
@@ -54,7 +50,7 @@ bool AudioChorus::setParameters(float rate, float depth, float feedback, float m
               << " Hz, Depth: " << depth << ", Feedback: " << feedback 
               << ", Mix: " << mix << std::endl;
     
-    // 在实际实现中，这里会设置合唱参数
+    effect_.setParameters(rate, depth, feedback, mix, 0.0f, 0.0f);
     
     rate_ = rate;
     depth_ = depth;
@@ -70,17 +66,21 @@ void AudioChorus::getParameters(float& rate, float& depth, float& feedback, floa
     mix = mix_;
 }
 
+bool AudioChorus::setFormat(int sample_rate, int channels) {
+    return effect_.setFormat(sample_rate, channels);
+}
+
 void AudioChorus::reset() {
     if (initialized_) {
         std::cout << "Resetting audio chorus" << std::endl;
         
-        // 在实际实现中，这里会重置合唱器
-        
         rate_ = 1.0f;
         depth_ = 0.5f;
         feedback_ = 0.2f;
         mix_ = 0.3f;
+        effect_.reset();
+        effect_.setParameters(rate_, depth_, feedback_, mix_, 0.0f, 0.0f);
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -4,7 +4,8 @@
 namespace core {
 
 AudioCompressor::AudioCompressor() 
-    : initialized_(false), threshold_(-20.0f), ratio_(4.0f), attack_(10.0f), release_(100.0f) {
+    : initialized_(false), threshold_(-20.0f), ratio_(4.0f), attack_(10.0f), release_(100.0f),
+      sample_rate_(44100), channels_(2) {
     // 初始化音频压缩器
 }
 
@@ -16,7 +17,15 @@ AudioCompressor::~AudioCompressor() {
 bool AudioCompressor::initialize() {
     std::cout << "Initializing audio compressor" << std::endl;
     
-    // 在实际实现中，这里会初始化压缩器
+    dynamics_.prepare(sample_rate_, static_cast<size_t>(channels_));
+    dynamics_.setBandCount(1);
+
+    MultibandDynamics::BandSettings settings;
+    settings.threshold = threshold_;
+    settings.ratio = ratio_;
+    settings.attack = attack_;
+    settings.release = release_;
+    dynamics_.setBand(0, settings);
     
     initialized_ = true;
     return true;
@@ -26,22 +35,28 @@ void AudioCompressor::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio compressor" << std::endl;
         
-        // 在实际实现中，这里会关闭压缩器
-        
         initialized_ = false;
     }
 }
 
 bool AudioCompressor::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio compressor effect" << std::endl;
+    if (&output != &input) {
+        output = input;
+    }
+    dynamics_.process(output.data(), output.size() / static_cast<size_t>(channels_));
+    return true;
+}
     
-    // 在实际实现中，这里会应用压缩效果
+bool AudioCompressor::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    dynamics_.process(view.data(), view.frames());
     return true;
 }
 
@@ -50,12 +65,19 @@ bool AudioCompressor::setParameters(float threshold, float ratio, float attack,
         return false;
     }
     
+    MultibandDynamics::BandSettings settings;
+    settings.threshold = threshold;
+    settings.ratio = ratio;
+    settings.attack = attack;
+    settings.release = release;
+    if (!dynamics_.setBand(0, settings)) {
+        return false;
+    }
+
     std::cout << "Setting compressor parameters - Threshold: " << threshold 
               << " dB, Ratio: " << ratio << ", Attack: " << attack 
               << " ms, Release: " << release << " ms" << std::endl;
     
-    // 在实际实现中，这里会设置压缩参数
-    
     threshold_ = threshold;
     ratio_ = ratio;
     attack_ = attack;
@@ -70,17 +92,40 @@ void AudioCompressor::getParameters(float& threshold, float& ratio, float& attac
     release = release_;
 }
 
+bool AudioCompressor::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    dynamics_.prepare(sample_rate_, static_cast<size_t>(channels_));
+    return true;
+}
+
+bool AudioCompressor::setKnee(float knee_db) {
+    return dynamics_.setKnee(knee_db);
+}
+
+void AudioCompressor::setDetectionMode(DetectionMode mode) {
+    dynamics_.setDetectionMode(mode);
+}
+
+float AudioCompressor::getGainReduction() const {
+    return dynamics_.getGainReduction(0);
+}
+
 void AudioCompressor::reset() {
     if (initialized_) {
         std::cout << "Resetting audio compressor" << std::endl;
         
-        // 在实际实现中，这里会重置压缩器
-        
         threshold_ = -20.0f;
         ratio_ = 4.0f;
         attack_ = 10.0f;
         release_ = 100.0f;
+        dynamics_.setBand(0, MultibandDynamics::BandSettings());
+        dynamics_.reset();
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -76,6 +76,45 @@ bool AudioConverter::convertChannels(const std::string& input_file,
     return true;
 }
 
+bool AudioConverter::convertChannels(const AudioBuffer& input,
+                                    audio::ChannelLayout input_layout,
+                                    AudioBuffer& output,
+                                    audio::ChannelLayout output_layout) {
+    if (!initialized_) {
+        return false;
+    }
+    
+    const size_t input_channels = ChannelMixer::channelCount(input_layout);
+    const size_t output_channels = ChannelMixer::channelCount(output_layout);
+    if (input_channels == 0 || output_channels == 0 || input.size() % input_channels != 0) {
+        return false;
+    }
+    
+    // 布局不变时保留用户覆盖的系数
+    if (channel_mixer_.getInputLayout() != input_layout ||
+        channel_mixer_.getOutputLayout() != output_layout) {
+        channel_mixer_.setLayouts(input_layout, output_layout);
+    }
+    
+    const size_t frames = input.size() / input_channels;
+    
+    // 同一缓冲区只支持下混：先原地混合再截断
+    if (&input == &output) {
+        if (!channel_mixer_.process(output.data(), output.data(), frames)) {
+            return false;
+        }
+        output.resize(frames * output_channels);
+        return true;
+    }
+    
+    output.resize(frames * output_channels);
+    return channel_mixer_.process(input.data(), output.data(), frames);
+}
+
+ChannelMixer& AudioConverter::getChannelMixer() {
+    return channel_mixer_;
+}
+
 bool AudioConverter::convertBitDepth(const std::string& input_file,
                                     const std::string& output_file,
                                     int target_bit_depth) {
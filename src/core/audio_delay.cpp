@@ -1,10 +1,12 @@
 #include "core/audio_delay.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
 AudioDelay::AudioDelay() 
-    : initialized_(false), delay_time_(100.0f), feedback_(0.3f), mix_(0.5f) {
+    : initialized_(false), delay_time_(100.0f), feedback_(0.3f), mix_(0.5f), sample_rate_(44100), channels_(2) {
     // 初始化音频延迟器
 }
 
@@ -16,7 +18,7 @@ AudioDelay::~AudioDelay() {
 bool AudioDelay::initialize() {
     std::cout << "Initializing audio delay" << std::endl;
     
-    // 在实际实现中，这里会初始化延迟器
+    allocateLines();
     
     initialized_ = true;
     return true;
@@ -26,35 +28,40 @@ void AudioDelay::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio delay" << std::endl;
         
-        // 在实际实现中，这里会关闭延迟器
-        
         initialized_ = false;
     }
 }
 
 bool AudioDelay::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio delay effect" << std::endl;
-    
-    // 在实际实现中，这里会应用延迟效果
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / static_cast<size_t>(channels_));
+    return true;
+}
+
+bool AudioDelay::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    processFrames(view.data(), view.frames());
     return true;
 }
 
 bool AudioDelay::setParameters(float delay_time, float feedback, float mix) {
-    if (!initialized_) {
+    if (!initialized_ || delay_time < 1.0f || delay_time > kMaxDelay ||
+        std::fabs(feedback) > 0.95f || mix < 0.0f || mix > 1.0f) {
         return false;
     }
     
     std::cout << "Setting delay parameters - Delay time: " << delay_time 
               << " ms, Feedback: " << feedback << ", Mix: " << mix << std::endl;
     
-    // 在实际实现中，这里会设置延迟参数
-    
     delay_time_ = delay_time;
     feedback_ = feedback;
     mix_ = mix;
@@ -67,16 +74,65 @@ void AudioDelay::getParameters(float& delay_time, float& feedback, float& mix) c
     mix = mix_;
 }
 
+bool AudioDelay::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    allocateLines();
+    return true;
+}
+
+void AudioDelay::processFrames(float* data, size_t frames) {
+    const size_t channels = static_cast<size_t>(channels_);
+    const float delay = std::max(1.0f, delay_time_ * static_cast<float>(sample_rate_) / 1000.0f);
+    const size_t block = std::min(kBlockFrames, static_cast<size_t>(delay));
+    const float feedback = feedback_;
+    const float wet = mix_;
+    const float dry = 1.0f - mix_;
+    
+    float delayed[kBlockFrames];
+    float input[kBlockFrames];
+    for (size_t ch = 0; ch < channels; ++ch) {
+        DelayLine& line = lines_[ch];
+        for (size_t done = 0; done < frames; done += block) {
+            const size_t count = std::min(block, frames - done);
+            float* x = data + done * channels + ch;
+            
+            // 块长不超过延迟，本块要读的样本都已写入：相对上一块写入的count帧读取
+            line.read(delay - static_cast<float>(count), delayed, count);
+            for (size_t i = 0; i < count; ++i) {
+                input[i] = x[i * channels] + feedback * delayed[i];
+            }
+            line.write(input, count);
+            for (size_t i = 0; i < count; ++i) {
+                x[i * channels] = dry * x[i * channels] + wet * delayed[i];
+            }
+        }
+    }
+}
+
+void AudioDelay::allocateLines() {
+    const size_t max_delay = static_cast<size_t>(std::ceil(kMaxDelay * static_cast<float>(sample_rate_) / 1000.0f));
+    lines_.resize(static_cast<size_t>(channels_));
+    for (DelayLine& line : lines_) {
+        line.allocate(max_delay, kBlockFrames);
+    }
+}
+
 void AudioDelay::reset() {
     if (initialized_) {
         std::cout << "Resetting audio delay" << std::endl;
         
-        // 在实际实现中，这里会重置延迟器
-        
         delay_time_ = 100.0f;
         feedback_ = 0.3f;
         mix_ = 0.5f;
+        for (DelayLine& line : lines_) {
+            line.clear();
+        }
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
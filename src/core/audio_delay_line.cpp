@@ -0,0 +1,173 @@
+#include "core/audio_delay_line.h"
+#include <algorithm>
+
+namespace core {
+
+DelayLine::DelayLine()
+    : mask_(0), write_index_(0), max_delay_(0), interpolation_(Interpolation::LINEAR), allpass_state_(0.0f) {
+    allocate(0);
+}
+
+void DelayLine::allocate(size_t max_delay, size_t max_block) {
+    // 插值最多再向前读两个样本，块读取时最早一帧还要再早max_block帧
+    size_t size = 1;
+    while (size < max_delay + max_block + 3) {
+        size <<= 1;
+    }
+    samples_.assign(size + kGuard, 0.0f);
+    mask_ = size - 1;
+    write_index_ = 0;
+    max_delay_ = max_delay;
+    allpass_state_ = 0.0f;
+}
+
+void DelayLine::clear() {
+    std::fill(samples_.begin(), samples_.end(), 0.0f);
+    write_index_ = 0;
+    allpass_state_ = 0.0f;
+}
+
+size_t DelayLine::getMaxDelay() const {
+    return max_delay_;
+}
+
+void DelayLine::setInterpolation(Interpolation interpolation) {
+    interpolation_ = interpolation;
+    allpass_state_ = 0.0f;
+}
+
+DelayLine::Interpolation DelayLine::getInterpolation() const {
+    return interpolation_;
+}
+
+void DelayLine::write(const float* input, size_t frames, size_t stride) {
+    float* samples = samples_.data();
+    const size_t size = mask_ + 1;
+    size_t done = 0;
+    while (done < frames) {
+        // 按环形缓冲区末尾分段，段内连续写入
+        const size_t start = (write_index_ + 1) & mask_;
+        const size_t count = std::min(frames - done, size - start);
+        const float* src = input + done * stride;
+        float* dst = samples + start;
+        if (stride == 1) {
+            std::copy(src, src + count, dst);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = src[i * stride];
+            }
+        }
+        for (size_t i = start; i < std::min(start + count, kGuard); ++i) {
+            samples[i + size] = samples[i];
+        }
+        write_index_ = (start + count - 1) & mask_;
+        done += count;
+    }
+}
+
+void DelayLine::read(float delay, float* output, size_t frames) {
+    if (interpolation_ == Interpolation::ALLPASS) {
+        // 全通插值有状态，逐帧递推
+        const size_t end = write_index_;
+        write_index_ = (end - frames) & mask_;
+        for (size_t i = 0; i < frames; ++i) {
+            write_index_ = (write_index_ + 1) & mask_;
+            output[i] = readAllpass(delay);
+        }
+        write_index_ = end;
+        return;
+    }
+    readFixed(delay, 1.0f, output, frames, false);
+}
+
+void DelayLine::readModulated(const float* delays, float* output, size_t frames) {
+    // 把写位置回退到块首帧，逐帧前进读取（与逐样本接口同一插值内核）
+    const size_t end = write_index_;
+    write_index_ = (end - frames) & mask_;
+    switch (interpolation_) {
+        case Interpolation::LAGRANGE:
+            for (size_t i = 0; i < frames; ++i) {
+                write_index_ = (write_index_ + 1) & mask_;
+                output[i] = readLagrange(delays[i]);
+            }
+            break;
+        case Interpolation::ALLPASS:
+            for (size_t i = 0; i < frames; ++i) {
+                write_index_ = (write_index_ + 1) & mask_;
+                output[i] = readAllpass(delays[i]);
+            }
+            break;
+        default:
+            for (size_t i = 0; i < frames; ++i) {
+                write_index_ = (write_index_ + 1) & mask_;
+                output[i] = readLinear(delays[i]);
+            }
+            break;
+    }
+    write_index_ = end;
+}
+
+void DelayLine::readTaps(const float* delays, const float* gains, size_t taps, float* output, size_t frames) const {
+    if (taps == 0) {
+        std::fill(output, output + frames, 0.0f);
+        return;
+    }
+
+    // 全通插值有状态，多抽头时按线性插值读取
+    for (size_t t = 0; t < taps; ++t) {
+        readFixed(delays[t], gains[t], output, frames, t > 0);
+    }
+}
+
+void DelayLine::readFixed(float delay, float gain, float* output, size_t frames, bool accumulate) const {
+    const size_t whole = static_cast<size_t>(delay);
+    const float frac = delay - static_cast<float>(whole);
+    const bool lagrange = interpolation_ == Interpolation::LAGRANGE;
+    const size_t size = mask_ + 1;
+
+    // 延迟固定时插值系数对整块相同，块内是对连续样本的定长FIR
+    // 线性插值只用前两个系数，其余置零
+    float h[4] = {1.0f - frac, frac, 0.0f, 0.0f};
+    if (lagrange) {
+        lagrangeCoefficients(frac, h);
+    }
+    for (float& coefficient : h) {
+        coefficient *= gain;
+    }
+
+    // 块首帧最早用到的样本位置（线性两点、Lagrange四点）
+    size_t index = (write_index_ - (frames - 1) - whole - (lagrange ? 2 : 1)) & mask_;
+    size_t done = 0;
+    while (done < frames) {
+        const size_t count = std::min(frames - done, size - index);
+        const float* s = samples_.data() + index;
+        float* out = output + done;
+        if (lagrange) {
+            const float h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3];
+            if (accumulate) {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] += h0 * s[i + 3] + h1 * s[i + 2] + h2 * s[i + 1] + h3 * s[i];
+                }
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = h0 * s[i + 3] + h1 * s[i + 2] + h2 * s[i + 1] + h3 * s[i];
+                }
+            }
+        } else {
+            const float near = h[0], far = h[1];
+            if (accumulate) {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] += near * s[i + 1] + far * s[i];
+                }
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = near * s[i + 1] + far * s[i];
+                }
+            }
+        }
+        index = (index + count) & mask_;
+        done += count;
+    }
+}
+
+} // namespace core
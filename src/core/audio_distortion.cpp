@@ -1,11 +1,31 @@
 #include "core/audio_distortion.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
-AudioDistortion::AudioDistortion() 
-    : initialized_(false), drive_(0.5f), tone_(0.5f), mix_(0.5f) {
+namespace {
+
+// 默认预分配的块长（更长的块在首次出现时扩容）
+const size_t kDefaultMaxFrames = 4096;
+
+// 默认过采样倍数
+const size_t kDefaultOversampling = 4;
+
+// 驱动量到输入增益：0-40dB
+inline float driveGain(float drive) {
+    return std::pow(10.0f, 2.0f * drive);
+}
+
+} // namespace
+
+AudioDistortion::AudioDistortion()
+    : initialized_(false), drive_(0.5f), tone_(0.5f), mix_(1.0f),
+      sample_rate_(44100), channels_(2), tone_coefficient_(1.0f) {
     // 初始化音频失真器
+    stage_.setOversampling(kDefaultOversampling);
+    stage_.setCurve(TransferCurve::ASYMMETRIC, 0.0f);
 }
 
 AudioDistortion::~AudioDistortion() {
@@ -15,9 +35,11 @@ AudioDistortion::~AudioDistortion() {
 
 bool AudioDistortion::initialize() {
     std::cout << "Initializing audio distortion" << std::endl;
-    
-    // 在实际实现中，这里会初始化失真器
-    
+
+    stage_.prepare(sample_rate_, static_cast<size_t>(channels_), kDefaultMaxFrames);
+    tone_state_.assign(static_cast<size_t>(channels_), 0.0f);
+    updateTone();
+
     initialized_ = true;
     return true;
 }
@@ -25,39 +47,70 @@ bool AudioDistortion::initialize() {
 void AudioDistortion::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio distortion" << std::endl;
-        
-        // 在实际实现中，这里会关闭失真器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioDistortion::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
-    
-    std::cout << "Applying audio distortion effect" << std::endl;
-    
-    // 在实际实现中，这里会应用失真效果
-    
-    output = input;  // 模拟处理
+
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / static_cast<size_t>(channels_));
     return true;
 }
 
+bool AudioDistortion::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
+
+    processFrames(view.data(), view.frames());
+    return true;
+}
+
+void AudioDistortion::processFrames(float* data, size_t frames) {
+    stage_.process(data, frames, driveGain(drive_), mix_);
+
+    // 音色：一阶低通，tone为1时截止频率接近上限，基本不染色
+    const size_t channels = static_cast<size_t>(channels_);
+    const float coefficient = tone_coefficient_;
+    for (size_t ch = 0; ch < channels; ++ch) {
+        float state = tone_state_[ch];
+        for (size_t i = 0; i < frames; ++i) {
+            float& sample = data[i * channels + ch];
+            state += coefficient * (sample - state);
+            sample = state;
+        }
+        tone_state_[ch] = state;
+    }
+}
+
+void AudioDistortion::updateTone() {
+    const float nyquist_limit = 0.45f * static_cast<float>(sample_rate_);
+    const float cutoff = std::min(500.0f * std::pow(40.0f, tone_), nyquist_limit);
+    tone_coefficient_ = 1.0f - std::exp(-6.28318530717959f * cutoff / static_cast<float>(sample_rate_));
+}
+
 bool AudioDistortion::setParameters(float drive, float tone, float mix) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting distortion parameters - Drive: " << drive 
+    if (drive < 0.0f || drive > 1.0f || tone < 0.0f || tone > 1.0f || mix < 0.0f || mix > 1.0f) {
+        return false;
+    }
+
+    std::cout << "Setting distortion parameters - Drive: " << drive
               << ", Tone: " << tone << ", Mix: " << mix << std::endl;
-    
-    // 在实际实现中，这里会设置失真参数
-    
+
     drive_ = drive;
     tone_ = tone;
     mix_ = mix;
+    updateTone();
     return true;
 }
 
@@ -67,16 +120,50 @@ void AudioDistortion::getParameters(float& drive, float& tone, float& mix) const
     mix = mix_;
 }
 
+bool AudioDistortion::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    stage_.prepare(sample_rate_, static_cast<size_t>(channels_), kDefaultMaxFrames);
+    tone_state_.assign(static_cast<size_t>(channels_), 0.0f);
+    updateTone();
+    return true;
+}
+
+void AudioDistortion::setCurve(TransferCurve curve) {
+    stage_.setCurve(curve, 0.0f);
+}
+
+TransferCurve AudioDistortion::getCurve() const {
+    return stage_.getCurve();
+}
+
+bool AudioDistortion::setOversampling(size_t factor) {
+    return stage_.setOversampling(factor);
+}
+
+size_t AudioDistortion::getOversampling() const {
+    return stage_.getOversampling();
+}
+
+size_t AudioDistortion::getLatency() const {
+    return stage_.getLatency();
+}
+
 void AudioDistortion::reset() {
     if (initialized_) {
         std::cout << "Resetting audio distortion" << std::endl;
-        
-        // 在实际实现中，这里会重置失真器
-        
+
         drive_ = 0.5f;
         tone_ = 0.5f;
-        mix_ = 0.5f;
+        mix_ = 1.0f;
+        updateTone();
+        stage_.reset();
+        std::fill(tone_state_.begin(), tone_state_.end(), 0.0f);
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
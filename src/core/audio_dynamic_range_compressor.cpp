@@ -3,9 +3,18 @@
 
 namespace core {
 
+namespace {
+
+// 默认频段数
+const size_t kDefaultBands = 5;
+
+} // namespace
+
 AudioDynamicRangeCompressor::AudioDynamicRangeCompressor() 
-    : initialized_(false), threshold_(-20.0f), ratio_(4.0f), attack_(10.0f), release_(100.0f), makeup_gain_(0.0f) {
+    : initialized_(false), threshold_(-20.0f), ratio_(4.0f), attack_(10.0f), release_(100.0f), makeup_gain_(0.0f),
+      sample_rate_(44100), channels_(2) {
     // 初始化音频动态范围压缩器
+    dynamics_.setBandCount(kDefaultBands);
 }
 
 AudioDynamicRangeCompressor::~AudioDynamicRangeCompressor() {
@@ -16,7 +25,17 @@ AudioDynamicRangeCompressor::~AudioDynamicRangeCompressor() {
 bool AudioDynamicRangeCompressor::initialize() {
     std::cout << "Initializing audio dynamic range compressor" << std::endl;
     
-    // 在实际实现中，这里会初始化动态范围压缩器
+    dynamics_.prepare(sample_rate_, static_cast<size_t>(channels_));
+
+    MultibandDynamics::BandSettings settings;
+    settings.threshold = threshold_;
+    settings.ratio = ratio_;
+    settings.attack = attack_;
+    settings.release = release_;
+    settings.makeup = makeup_gain_;
+    for (size_t band = 0; band < MultibandDynamics::kMaxBands; ++band) {
+        dynamics_.setBand(band, settings);
+    }
     
     initialized_ = true;
     return true;
@@ -26,22 +45,28 @@ void AudioDynamicRangeCompressor::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio dynamic range compressor" << std::endl;
         
-        // 在实际实现中，这里会关闭动态范围压缩器
-        
         initialized_ = false;
     }
 }
 
 bool AudioDynamicRangeCompressor::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio dynamic range compressor effect" << std::endl;
+    if (&output != &input) {
+        output = input;
+    }
+    dynamics_.process(output.data(), output.size() / static_cast<size_t>(channels_));
+    return true;
+}
     
-    // 在实际实现中，这里会应用动态范围压缩效果
+bool AudioDynamicRangeCompressor::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    dynamics_.process(view.data(), view.frames());
     return true;
 }
 
@@ -50,12 +75,22 @@ bool AudioDynamicRangeCompressor::setParameters(float threshold, float ratio, fl
         return false;
     }
     
+    MultibandDynamics::BandSettings settings;
+    settings.threshold = threshold;
+    settings.ratio = ratio;
+    settings.attack = attack;
+    settings.release = release;
+    settings.makeup = makeup_gain;
+    for (size_t band = 0; band < MultibandDynamics::kMaxBands; ++band) {
+        if (!dynamics_.setBand(band, settings)) {
+            return false;
+        }
+    }
+
     std::cout << "Setting dynamic range compressor parameters - Threshold: " << threshold 
               << " dB, Ratio: " << ratio << ", Attack: " << attack 
               << " ms, Release: " << release << " ms, Makeup gain: " << makeup_gain << " dB" << std::endl;
     
-    // 在实际实现中，这里会设置压缩参数
-    
     threshold_ = threshold;
     ratio_ = ratio;
     attack_ = attack;
@@ -72,18 +107,100 @@ void AudioDynamicRangeCompressor::getParameters(float& threshold, float& ratio,
     makeup_gain = makeup_gain_;
 }
 
+bool AudioDynamicRangeCompressor::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    dynamics_.prepare(sample_rate_, static_cast<size_t>(channels_));
+    return true;
+}
+
+bool AudioDynamicRangeCompressor::setBandCount(int bands) {
+    if (bands < 1) {
+        return false;
+    }
+
+    std::cout << "Setting dynamic range compressor band count: " << bands << std::endl;
+    return dynamics_.setBandCount(static_cast<size_t>(bands));
+}
+
+int AudioDynamicRangeCompressor::getBandCount() const {
+    return static_cast<int>(dynamics_.getBandCount());
+}
+
+bool AudioDynamicRangeCompressor::setCrossover(int index, float frequency) {
+    if (index < 0) {
+        return false;
+    }
+
+    return dynamics_.setCrossover(static_cast<size_t>(index), frequency);
+}
+
+float AudioDynamicRangeCompressor::getCrossover(int index) const {
+    return index < 0 ? 0.0f : dynamics_.getCrossover(static_cast<size_t>(index));
+}
+
+bool AudioDynamicRangeCompressor::setBandParameters(int band, float threshold, float ratio, float attack, float release, float makeup_gain) {
+    if (band < 0) {
+        return false;
+    }
+
+    MultibandDynamics::BandSettings settings;
+    settings.threshold = threshold;
+    settings.ratio = ratio;
+    settings.attack = attack;
+    settings.release = release;
+    settings.makeup = makeup_gain;
+    return dynamics_.setBand(static_cast<size_t>(band), settings);
+}
+
+bool AudioDynamicRangeCompressor::getBandParameters(int band, float& threshold, float& ratio, float& attack, float& release, float& makeup_gain) const {
+    if (band < 0 || static_cast<size_t>(band) >= MultibandDynamics::kMaxBands) {
+        return false;
+    }
+
+    const MultibandDynamics::BandSettings& settings = dynamics_.getBand(static_cast<size_t>(band));
+    threshold = settings.threshold;
+    ratio = settings.ratio;
+    attack = settings.attack;
+    release = settings.release;
+    makeup_gain = settings.makeup;
+    return true;
+}
+
+bool AudioDynamicRangeCompressor::setKnee(float knee_db) {
+    return dynamics_.setKnee(knee_db);
+}
+
+void AudioDynamicRangeCompressor::setDetectionMode(DetectionMode mode) {
+    dynamics_.setDetectionMode(mode);
+}
+
+void AudioDynamicRangeCompressor::setLinked(bool linked) {
+    dynamics_.setLinked(linked);
+}
+
+float AudioDynamicRangeCompressor::getGainReduction(int band) const {
+    return band < 0 ? 0.0f : dynamics_.getGainReduction(static_cast<size_t>(band));
+}
+
 void AudioDynamicRangeCompressor::reset() {
     if (initialized_) {
         std::cout << "Resetting audio dynamic range compressor" << std::endl;
         
-        // 在实际实现中，这里会重置动态范围压缩器
-        
         threshold_ = -20.0f;
         ratio_ = 4.0f;
         attack_ = 10.0f;
         release_ = 100.0f;
         makeup_gain_ = 0.0f;
+        for (size_t band = 0; band < MultibandDynamics::kMaxBands; ++band) {
+            dynamics_.setBand(band, MultibandDynamics::BandSettings());
+        }
+        dynamics_.reset();
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -0,0 +1,408 @@
+#include "core/audio_dynamics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace core {
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+// 1个log2单位对应的dB数（20*log10(2)）
+const float kDbPerLog2 = 6.0205999f;
+
+// 检测器时间常数（毫秒）：RMS窗口/峰值衰减
+const float kDetectorTime = 10.0f;
+
+// 默认分频点（Hz）
+const float kDefaultCrossovers[] = {120.0f, 500.0f, 2000.0f, 6000.0f};
+
+// 软拐点的最小宽度（log2单位），避免除零
+const float kMinKnee = 1e-3f;
+
+// 一阶平滑系数（时间常数为milliseconds）
+inline float timeCoefficient(float milliseconds, int sample_rate) {
+    const float frames = std::max(milliseconds, 0.01f) * 0.001f * static_cast<float>(sample_rate);
+    return 1.0f - std::exp(-1.0f / frames);
+}
+
+// 快速log2：指数位 + 尾数的atanh级数（误差约1e-5）
+inline float fastLog2(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+    const float y = (mantissa - 1.0f) / (mantissa + 1.0f);
+    const float y2 = y * y;
+    const float ln = y * (2.0f + y2 * (0.6666667f + y2 * (0.4f + y2 * 0.2857143f)));
+    return exponent + ln * 1.4426950f;
+}
+
+// 快速exp2：整数部分写入指数位，小数部分用6阶泰勒多项式（相对误差约1.5e-5）
+// 调用方保证x在(-126, 127)内（增益衰减受检测电平的浮点范围限制），不做钳位以便循环向量化
+inline float fastExp2(float x) {
+    int32_t whole = static_cast<int32_t>(x);
+    whole -= static_cast<int32_t>(x < static_cast<float>(whole));
+    const float f = x - static_cast<float>(whole);
+    const float p = 1.0f + f * (0.6931472f + f * (0.2402265f + f * (0.05550411f +
+                    f * (0.009618129f + f * (0.001333356f + f * 0.0001540353f)))));
+
+    const uint32_t bits = static_cast<uint32_t>(whole + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// 二阶节系数
+struct Section {
+    float b0, b1, b2, a1, a2;
+};
+
+// 巴特沃斯低通/高通与对应的二阶全通（两个巴特沃斯节之和，即LR4低通+高通）
+Section lowpassSection(float k) {
+    const float norm = 1.0f / (1.0f + std::sqrt(2.0f) * k + k * k);
+    return {k * k * norm, 2.0f * k * k * norm, k * k * norm,
+            2.0f * (k * k - 1.0f) * norm, (1.0f - std::sqrt(2.0f) * k + k * k) * norm};
+}
+
+Section highpassSection(float k) {
+    const float norm = 1.0f / (1.0f + std::sqrt(2.0f) * k + k * k);
+    return {norm, -2.0f * norm, norm,
+            2.0f * (k * k - 1.0f) * norm, (1.0f - std::sqrt(2.0f) * k + k * k) * norm};
+}
+
+Section allpassSection(float k) {
+    const float norm = 1.0f / (1.0f + std::sqrt(2.0f) * k + k * k);
+    const float a1 = 2.0f * (k * k - 1.0f) * norm;
+    const float a2 = (1.0f - std::sqrt(2.0f) * k + k * k) * norm;
+    return {a2, a1, 1.0f, a1, a2};
+}
+
+const Section kIdentity = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+// 一个二阶节在所有通道上的单帧更新（转置直接II型）；各数组互不重叠，restrict使循环可以向量化
+inline void processSection(float* __restrict signal,
+                           const float* __restrict b0, const float* __restrict b1, const float* __restrict b2,
+                           const float* __restrict a1, const float* __restrict a2,
+                           float* __restrict z1, float* __restrict z2, size_t lanes) {
+    for (size_t l = 0; l < lanes; ++l) {
+        const float in = signal[l];
+        const float y = b0[l] * in + z1[l];
+        z1[l] = b1[l] * in - a1[l] * y + z2[l];
+        z2[l] = b2[l] * in - a2[l] * y;
+        signal[l] = y;
+    }
+}
+
+} // namespace
+
+MultibandDynamics::MultibandDynamics()
+    : sample_rate_(44100), channels_(2), bands_(1), stride_(0), knee_(6.0f),
+      detection_(DetectionMode::RMS), linked_(true), detector_coef_(1.0f) {
+    std::copy(std::begin(kDefaultCrossovers), std::end(kDefaultCrossovers), crossovers_);
+    allocateState();
+}
+
+void MultibandDynamics::prepare(int sample_rate, size_t channels) {
+    if (sample_rate <= 0 || channels == 0) {
+        return;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    allocateState();
+}
+
+bool MultibandDynamics::setBandCount(size_t bands) {
+    if (bands < 1 || bands > kMaxBands) {
+        return false;
+    }
+
+    bands_ = bands;
+    std::sort(crossovers_, crossovers_ + bands_ - 1);
+    allocateState();
+    return true;
+}
+
+size_t MultibandDynamics::getBandCount() const {
+    return bands_;
+}
+
+bool MultibandDynamics::setCrossover(size_t index, float frequency) {
+    if (index + 1 >= bands_ || frequency < 20.0f || frequency > 20000.0f) {
+        return false;
+    }
+    // 分频点须严格递增
+    if ((index > 0 && frequency <= crossovers_[index - 1]) ||
+        (index + 2 < bands_ && frequency >= crossovers_[index + 1])) {
+        return false;
+    }
+
+    crossovers_[index] = frequency;
+    updateFilters();
+    return true;
+}
+
+float MultibandDynamics::getCrossover(size_t index) const {
+    return index < kMaxBands - 1 ? crossovers_[index] : 0.0f;
+}
+
+bool MultibandDynamics::setBand(size_t band, const BandSettings& settings) {
+    if (band >= kMaxBands) {
+        return false;
+    }
+    if (settings.threshold > 0.0f || settings.threshold < -80.0f ||
+        settings.ratio < 1.0f || settings.ratio > 100.0f ||
+        settings.attack <= 0.0f || settings.attack > 1000.0f ||
+        settings.release <= 0.0f || settings.release > 5000.0f ||
+        settings.makeup < -24.0f || settings.makeup > 24.0f) {
+        return false;
+    }
+
+    settings_[band] = settings;
+    updateBands();
+    return true;
+}
+
+const MultibandDynamics::BandSettings& MultibandDynamics::getBand(size_t band) const {
+    return settings_[std::min(band, kMaxBands - 1)];
+}
+
+bool MultibandDynamics::setKnee(float knee_db) {
+    if (knee_db < 0.0f || knee_db > 24.0f) {
+        return false;
+    }
+
+    knee_ = knee_db;
+    return true;
+}
+
+float MultibandDynamics::getKnee() const {
+    return knee_;
+}
+
+void MultibandDynamics::setDetectionMode(DetectionMode mode) {
+    detection_ = mode;
+    updateBands();
+}
+
+MultibandDynamics::DetectionMode MultibandDynamics::getDetectionMode() const {
+    return detection_;
+}
+
+void MultibandDynamics::setLinked(bool linked) {
+    linked_ = linked;
+}
+
+float MultibandDynamics::getGainReduction(size_t band) const {
+    if (band >= bands_) {
+        return 0.0f;
+    }
+
+    const float* reduction = reduction_.data() + band * channels_;
+    return *std::min_element(reduction, reduction + channels_) * kDbPerLog2;
+}
+
+void MultibandDynamics::process(float* data, size_t frames) {
+    for (size_t offset = 0; offset < frames; offset += kBlockFrames) {
+        processBlock(data + offset * channels_, std::min(kBlockFrames, frames - offset));
+    }
+}
+
+void MultibandDynamics::processBlock(float* data, size_t frames) {
+    const size_t channels = channels_;
+    const size_t bands = bands_;
+    const size_t lanes = stride_;
+    const size_t sections = 2 * (bands - 1);
+    const size_t samples = frames * lanes;
+
+    const bool peak = detection_ == DetectionMode::PEAK;
+    const float detector_coef = detector_coef_;
+    const float knee = std::max(knee_ / kDbPerLog2, kMinKnee);
+    const float half_knee = 0.5f * knee;
+    const float inv_knee = 0.5f / knee;
+
+    float* signal = signal_.data();
+    float* envelope = envelope_.data();
+    float* level = level_.data();
+    float* reduction = reduction_.data();
+    const float* attack = attack_coef_.data();
+    const float* release = release_coef_.data();
+
+    // 分频与电平检测：递归依赖在时间方向，逐帧在所有通道（频段×声道）上向量化
+    for (size_t i = 0; i < frames; ++i) {
+        const float* x = data + i * channels;
+        float* s = signal + i * lanes;
+        for (size_t b = 0; b < bands; ++b) {
+            std::copy(x, x + channels, s + b * channels);
+        }
+
+        for (size_t q = 0; q < sections; ++q) {
+            const size_t offset = q * lanes;
+            processSection(s, b0_.data() + offset, b1_.data() + offset, b2_.data() + offset,
+                           a1_.data() + offset, a2_.data() + offset,
+                           z1_.data() + offset, z2_.data() + offset, lanes);
+        }
+
+        float* e = envelope + i * lanes;
+        if (peak) {
+            for (size_t l = 0; l < lanes; ++l) {
+                level[l] = std::max(s[l] * s[l], level[l] * detector_coef);
+                e[l] = level[l];
+            }
+        } else {
+            for (size_t l = 0; l < lanes; ++l) {
+                level[l] += detector_coef * (s[l] * s[l] - level[l]);
+                e[l] = level[l];
+            }
+        }
+
+        // 联动模式下同一频段的检测器取各声道的最大值
+        if (linked_ && channels > 1) {
+            for (size_t b = 0; b < bands; ++b) {
+                float* band = e + b * channels;
+                std::fill(band + 1, band + channels, *std::max_element(band, band + channels));
+                band[0] = band[1];
+            }
+        }
+    }
+
+    // 对数域静态曲线：软拐点二次曲线 + 拐点以上按(1 - 1/ratio)衰减；整块连续计算，可向量化
+    const float* threshold = threshold_.data();
+    const float* slope = slope_.data();
+    for (size_t k = 0; k < samples; ++k) {
+        const float over = 0.5f * fastLog2(envelope[k] + 1e-20f) - threshold[k];
+        const float position = std::min(std::max(over + half_knee, 0.0f), knee);
+        const float excess = position * position * inv_knee + std::max(over - half_knee, 0.0f);
+        envelope[k] = -slope[k] * excess;
+    }
+
+    // 攻击/释放平滑（log2域）
+    for (size_t i = 0; i < frames; ++i) {
+        float* target = envelope + i * lanes;
+        for (size_t l = 0; l < lanes; ++l) {
+            const float a = attack[l];
+            const float r = release[l];
+            const float coef = target[l] < reduction[l] ? a : r;
+            reduction[l] += coef * (target[l] - reduction[l]);
+            target[l] = reduction[l];
+        }
+    }
+
+    // 转回线性增益并作用于各频段
+    const float* makeup = makeup_.data();
+    for (size_t k = 0; k < samples; ++k) {
+        signal[k] *= fastExp2(envelope[k] + makeup[k]);
+    }
+
+    // 各频段求和
+    for (size_t i = 0; i < frames; ++i) {
+        const float* s = signal + i * lanes;
+        float* x = data + i * channels;
+        std::copy(s, s + channels, x);
+        for (size_t b = 1; b < bands; ++b) {
+            for (size_t ch = 0; ch < channels; ++ch) {
+                x[ch] += s[b * channels + ch];
+            }
+        }
+    }
+}
+
+void MultibandDynamics::reset() {
+    std::fill(z1_.begin(), z1_.end(), 0.0f);
+    std::fill(z2_.begin(), z2_.end(), 0.0f);
+    std::fill(level_.begin(), level_.end(), 0.0f);
+    std::fill(reduction_.begin(), reduction_.end(), 0.0f);
+}
+
+void MultibandDynamics::updateFilters() {
+    const size_t lanes = stride_;
+    const float sample_rate = static_cast<float>(sample_rate_);
+
+    // 频段b的滤波链：分频点s < b为高通，s == b为低通，s > b为全通补偿
+    for (size_t s = 0; s + 1 < bands_; ++s) {
+        const float frequency = std::min(crossovers_[s], 0.45f * sample_rate);
+        const float k = std::tan(kPi * frequency / sample_rate);
+        const Section lowpass = lowpassSection(k);
+        const Section highpass = highpassSection(k);
+        const Section allpass = allpassSection(k);
+
+        for (size_t b = 0; b < bands_; ++b) {
+            const Section& first = b > s ? highpass : (b == s ? lowpass : allpass);
+            const Section& second = b > s ? highpass : (b == s ? lowpass : kIdentity);
+            for (size_t j = 0; j < 2; ++j) {
+                const Section& section = j == 0 ? first : second;
+                const size_t offset = (2 * s + j) * lanes + b * channels_;
+                std::fill(b0_.begin() + offset, b0_.begin() + offset + channels_, section.b0);
+                std::fill(b1_.begin() + offset, b1_.begin() + offset + channels_, section.b1);
+                std::fill(b2_.begin() + offset, b2_.begin() + offset + channels_, section.b2);
+                std::fill(a1_.begin() + offset, a1_.begin() + offset + channels_, section.a1);
+                std::fill(a2_.begin() + offset, a2_.begin() + offset + channels_, section.a2);
+            }
+        }
+    }
+}
+
+void MultibandDynamics::updateBands() {
+    const size_t lanes = stride_;
+    detector_coef_ = detection_ == DetectionMode::PEAK
+        ? std::exp(-1.0f / (kDetectorTime * 0.001f * static_cast<float>(sample_rate_)))
+        : timeCoefficient(kDetectorTime, sample_rate_);
+
+    for (size_t b = 0; b < bands_; ++b) {
+        const BandSettings& settings = settings_[b];
+        const size_t begin = b * channels_;
+        const size_t end = begin + channels_;
+        std::fill(attack_coef_.begin() + begin, attack_coef_.begin() + end,
+                  timeCoefficient(settings.attack, sample_rate_));
+        std::fill(release_coef_.begin() + begin, release_coef_.begin() + end,
+                  timeCoefficient(settings.release, sample_rate_));
+
+        // 静态曲线参数按块长平铺，使整块计算时无需取模
+        for (size_t i = 0; i < kBlockFrames; ++i) {
+            const size_t offset = i * lanes;
+            std::fill(threshold_.begin() + offset + begin, threshold_.begin() + offset + end,
+                      settings.threshold / kDbPerLog2);
+            std::fill(slope_.begin() + offset + begin, slope_.begin() + offset + end,
+                      1.0f - 1.0f / settings.ratio);
+            std::fill(makeup_.begin() + offset + begin, makeup_.begin() + offset + end,
+                      settings.makeup / kDbPerLog2);
+        }
+    }
+}
+
+void MultibandDynamics::allocateState() {
+    // 通道数补齐到4的倍数，逐帧的通道循环没有标量尾部（补齐的通道为直通的零信号）
+    stride_ = (bands_ * channels_ + 3) & ~static_cast<size_t>(3);
+    const size_t lanes = stride_;
+    const size_t coefficients = 2 * (bands_ - 1) * lanes;
+
+    b0_.assign(coefficients, 1.0f);
+    b1_.assign(coefficients, 0.0f);
+    b2_.assign(coefficients, 0.0f);
+    a1_.assign(coefficients, 0.0f);
+    a2_.assign(coefficients, 0.0f);
+    z1_.assign(coefficients, 0.0f);
+    z2_.assign(coefficients, 0.0f);
+
+    threshold_.assign(kBlockFrames * lanes, 0.0f);
+    slope_.assign(kBlockFrames * lanes, 0.0f);
+    makeup_.assign(kBlockFrames * lanes, 0.0f);
+    attack_coef_.assign(lanes, 1.0f);
+    release_coef_.assign(lanes, 1.0f);
+    level_.assign(lanes, 0.0f);
+    reduction_.assign(lanes, 0.0f);
+
+    signal_.assign(kBlockFrames * lanes, 0.0f);
+    envelope_.assign(kBlockFrames * lanes, 0.0f);
+
+    updateFilters();
+    updateBands();
+}
+
+} // namespace core
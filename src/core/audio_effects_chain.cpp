@@ -1,11 +1,23 @@
 #include "core/audio_effects_chain.h"
+#include "platform/denormal_guard.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
+namespace {
+
+// 未调用prepare时的默认块长
+const size_t kDefaultMaxFrames = 1024;
+
+} // namespace
+
 AudioEffectsChain::AudioEffectsChain() 
-    : initialized_(false) {
+    : initialized_(false), sample_rate_(44100), channels_(2),
+      fade_ms_(10.0f), fade_step_(1.0f), max_frames_(kDefaultMaxFrames) {
     // 初始化音频效果链
+    updateFadeStep();
 }
 
 AudioEffectsChain::~AudioEffectsChain() {
@@ -16,7 +28,8 @@ AudioEffectsChain::~AudioEffectsChain() {
 bool AudioEffectsChain::initialize() {
     std::cout << "Initializing audio effects chain" << std::endl;
     
-    // 在实际实现中，这里会初始化效果链
+    // 预分配交叉淡化缓冲区
+    prepare(max_frames_);
     
     initialized_ = true;
     return true;
@@ -33,6 +46,39 @@ void AudioEffectsChain::shutdown() {
     }
 }
 
+bool AudioEffectsChain::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
+    std::cout << "Setting effects chain format - Sample rate: " << sample_rate 
+              << ", Channels: " << channels << std::endl;
+    
+    sample_rate_ = sample_rate;
+    channels_ = static_cast<size_t>(channels);
+    updateFadeStep();
+    
+    bool success = true;
+    for (auto& slot : effects_) {
+        success = slot.effect->setFormat(sample_rate_, channels) && success;
+    }
+    prepare(max_frames_);
+    return success;
+}
+
+void AudioEffectsChain::prepare(size_t max_frames) {
+    max_frames_ = std::max<size_t>(max_frames, 1);
+    dry_.resize(max_frames_ * channels_);
+    for (auto& slot : effects_) {
+        slot.effect->prepare(max_frames_, channels_);
+    }
+}
+
+void AudioEffectsChain::setBypassFadeTime(float fade_ms) {
+    fade_ms_ = std::max(fade_ms, 0.0f);
+    updateFadeStep();
+}
+
 bool AudioEffectsChain::addEffect(std::unique_ptr<AudioFilter> effect) {
     if (!initialized_) {
         return false;
@@ -44,10 +90,13 @@ bool AudioEffectsChain::addEffect(std::unique_ptr<AudioFilter> effect) {
     
     std::cout << "Adding effect to chain: " << effect->getName() << std::endl;
     
-    // 在实际实现中，这里会添加效果到链中
+    // 效果使用链的格式，缓冲区按链的块长预分配
+    if (!effect->setFormat(sample_rate_, static_cast<int>(channels_))) {
+        return false;
+    }
+    effect->prepare(max_frames_, channels_);
     
-    effects_.push_back(std::move(effect));
-    enabled_.push_back(true);
+    effects_.push_back(EffectSlot{std::move(effect), true, 1.0f});
     return true;
 }
 
@@ -61,30 +110,47 @@ bool AudioEffectsChain::removeEffect(size_t index) {
     // 在实际实现中，这里会移除效果
     
     effects_.erase(effects_.begin() + index);
-    enabled_.erase(enabled_.begin() + index);
     return true;
 }
 
 bool AudioEffectsChain::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % channels_ != 0) {
         return false;
     }
     
-    std::cout << "Applying audio effects chain" << std::endl;
+    // 整条链只复制一次，之后所有效果在output上原地处理
+    if (&input != &output) {
+        if (output.size() != input.size()) {
+            output.resize(input.size());
+        }
+        std::copy(input.data(), input.data() + input.size(), output.data());
+    }
     
-    // 在实际实现中，这里会应用效果链
+    return process(AudioView(output, channels_));
+}
+
+bool AudioEffectsChain::process(AudioView view) {
+    if (!initialized_ || view.channels() != channels_) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    // 调用线程不一定启用了FTZ/DAZ（如宿主或解码线程），处理期间临时启用
+    platform::DenormalGuard denormal_guard;
     
-    // 应用所有启用的效果
-    for (size_t i = 0; i < effects_.size(); ++i) {
-        if (enabled_[i]) {
-            std::cout << "Applying effect: " << effects_[i]->getName() << std::endl;
-            effects_[i]->apply(output, output);
+    bool success = true;
+    for (auto& slot : effects_) {
+        const float target = slot.enabled ? 1.0f : 0.0f;
+        if (slot.mix == target) {
+            // 稳态：启用的效果直接原地处理，禁用的效果完全跳过
+            if (slot.enabled) {
+                success = slot.effect->process(view) && success;
+            }
+        } else {
+            success = processCrossfade(slot, view) && success;
         }
     }
     
-    return true;
+    return success;
 }
 
 void AudioEffectsChain::clear() {
@@ -94,7 +160,6 @@ void AudioEffectsChain::clear() {
         // 在实际实现中，这里会清空效果链
         
         effects_.clear();
-        enabled_.clear();
     }
 }
 
@@ -102,34 +167,93 @@ size_t AudioEffectsChain::getEffectCount() const {
     return effects_.size();
 }
 
-std::unique_ptr<AudioFilter> AudioEffectsChain::getEffect(size_t index) const {
+AudioFilter* AudioEffectsChain::getEffect(size_t index) const {
     if (index >= effects_.size()) {
         return nullptr;
     }
     
-    return std::unique_ptr<AudioFilter>(effects_[index].release());
+    return effects_[index].effect.get();
 }
 
 bool AudioEffectsChain::enableEffect(size_t index, bool enabled) {
-    if (!initialized_ || index >= enabled_.size()) {
+    if (!initialized_ || index >= effects_.size()) {
         return false;
     }
     
     std::cout << "Setting effect at index " << index << " to " 
               << (enabled ? "enabled" : "disabled") << std::endl;
     
-    // 在实际实现中，这里会启用/禁用效果
-    
-    enabled_[index] = enabled;
+    // 状态切换在后续的块中交叉淡化完成
+    effects_[index].enabled = enabled;
     return true;
 }
 
 bool AudioEffectsChain::isEffectEnabled(size_t index) const {
-    if (index >= enabled_.size()) {
+    if (index >= effects_.size()) {
+        return false;
+    }
+    
+    return effects_[index].enabled;
+}
+
+size_t AudioEffectsChain::getLatency() const {
+    size_t latency = 0;
+    for (const auto& slot : effects_) {
+        if (slot.enabled) {
+            latency += slot.effect->getLatency();
+        }
+    }
+    return latency;
+}
+
+bool AudioEffectsChain::processCrossfade(EffectSlot& slot, AudioView view) {
+    // 干信号缓冲区在prepare中按块长分配，更长的块分段处理
+    const size_t channels = view.channels();
+    const size_t max_frames = dry_.size() / channels;
+    if (max_frames == 0) {
         return false;
     }
+    if (view.frames() > max_frames) {
+        bool success = true;
+        for (size_t offset = 0; offset < view.frames(); offset += max_frames) {
+            success = processCrossfade(slot, view.subView(offset, max_frames)) && success;
+        }
+        return success;
+    }
+    
+    // 保存干信号，效果原地处理后按逐帧斜坡混合
+    const size_t samples = view.size();
+    float* data = view.data();
+    float* dry = dry_.data();
+    std::copy(data, data + samples, dry);
+    const bool success = slot.effect->process(view);
+    
+    const float target = slot.enabled ? 1.0f : 0.0f;
+    const float step = slot.enabled ? fade_step_ : -fade_step_;
+    const size_t frames = view.frames();
+    const float start = slot.mix;
+    
+    // 斜坡到达目标所需帧数，之后的帧按目标值混合
+    const size_t remaining = static_cast<size_t>(std::ceil(std::fabs(target - start) / fade_step_));
+    const size_t ramp_frames = std::min(frames, remaining);
+    for (size_t i = 0; i < ramp_frames; ++i) {
+        const float mix = std::clamp(start + step * static_cast<float>(i + 1), 0.0f, 1.0f);
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const size_t index = i * channels + ch;
+            data[index] = dry[index] + mix * (data[index] - dry[index]);
+        }
+    }
+    if (target == 0.0f) {
+        std::copy(dry + ramp_frames * channels, dry + samples, data + ramp_frames * channels);
+    }
     
-    return enabled_[index];
+    slot.mix = ramp_frames == remaining ? target : start + step * static_cast<float>(ramp_frames);
+    return success;
+}
+
+void AudioEffectsChain::updateFadeStep() {
+    const float fade_frames = fade_ms_ * 0.001f * static_cast<float>(sample_rate_);
+    fade_step_ = fade_frames > 1.0f ? 1.0f / fade_frames : 1.0f;
 }
 
 } // namespace core
\ No newline at end of file
@@ -0,0 +1,424 @@
+#include "core/audio_effects_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+namespace core {
+
+namespace {
+
+const AudioEffectsGraph::NodeId kInputNode = 0;
+const AudioEffectsGraph::NodeId kOutputNode = 1;
+
+// 未调用prepare时的默认块长
+const size_t kDefaultMaxFrames = 1024;
+
+} // namespace
+
+AudioEffectsGraph::AudioEffectsGraph()
+    : initialized_(false), sample_rate_(44100), channels_(2), max_frames_(kDefaultMaxFrames),
+      pool_(nullptr) {
+    // 输入节点与输出节点始终存在，默认直通
+    addNode(nullptr, nullptr);
+    addNode(nullptr, nullptr);
+    connect(kInputNode, kOutputNode);
+}
+
+AudioEffectsGraph::~AudioEffectsGraph() {
+    // 析构函数
+    shutdown();
+}
+
+bool AudioEffectsGraph::initialize() {
+    std::cout << "Initializing audio effects graph" << std::endl;
+
+    initialized_ = true;
+    return true;
+}
+
+void AudioEffectsGraph::shutdown() {
+    if (initialized_) {
+        std::cout << "Shutting down audio effects graph" << std::endl;
+
+        initialized_ = false;
+    }
+}
+
+bool AudioEffectsGraph::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    std::cout << "Setting effects graph format - Sample rate: " << sample_rate
+              << ", Channels: " << channels << std::endl;
+
+    sample_rate_ = sample_rate;
+    channels_ = static_cast<size_t>(channels);
+    for (auto& node : nodes_) {
+        if (node.effect) {
+            node.effect->setFormat(sample_rate_, channels);
+        }
+        if (node.chain) {
+            node.chain->setFormat(sample_rate_, channels);
+        }
+    }
+    prepare(max_frames_);
+    return true;
+}
+
+void AudioEffectsGraph::prepare(size_t max_frames) {
+    max_frames_ = std::max<size_t>(max_frames, 1);
+    for (auto& node : nodes_) {
+        if (node.active) {
+            node.buffer.resize(max_frames_ * channels_);
+        }
+        if (node.effect) {
+            node.effect->prepare(max_frames_, channels_);
+        }
+        if (node.chain) {
+            node.chain->prepare(max_frames_);
+        }
+    }
+}
+
+void AudioEffectsGraph::setThreadPool(AudioThreadPool* pool) {
+    pool_ = pool;
+}
+
+AudioEffectsGraph::NodeId AudioEffectsGraph::getInputNode() const {
+    return kInputNode;
+}
+
+AudioEffectsGraph::NodeId AudioEffectsGraph::getOutputNode() const {
+    return kOutputNode;
+}
+
+AudioEffectsGraph::NodeId AudioEffectsGraph::addEffect(std::unique_ptr<AudioFilter> effect) {
+    if (!effect) {
+        return addBus();
+    }
+
+    std::cout << "Adding effect to graph: " << effect->getName() << std::endl;
+    effect->setFormat(sample_rate_, static_cast<int>(channels_));
+    effect->prepare(max_frames_, channels_);
+    return addNode(std::move(effect), nullptr);
+}
+
+AudioEffectsGraph::NodeId AudioEffectsGraph::addChain(std::unique_ptr<AudioEffectsChain> chain) {
+    if (!chain) {
+        return addBus();
+    }
+
+    chain->setFormat(sample_rate_, static_cast<int>(channels_));
+    chain->prepare(max_frames_);
+    return addNode(nullptr, std::move(chain));
+}
+
+AudioEffectsGraph::NodeId AudioEffectsGraph::addBus() {
+    return addNode(nullptr, nullptr);
+}
+
+bool AudioEffectsGraph::removeNode(NodeId node) {
+    if (node >= nodes_.size() || node == kInputNode || node == kOutputNode || !nodes_[node].active) {
+        return false;
+    }
+
+    std::cout << "Removing node from graph: " << node << std::endl;
+
+    Node& removed = nodes_[node];
+    removed.active = false;
+    removed.effect.reset();
+    removed.chain.reset();
+    removed.inputs.clear();
+    removed.buffer.resize(0);
+
+    for (auto& other : nodes_) {
+        auto& inputs = other.inputs;
+        inputs.erase(std::remove_if(inputs.begin(), inputs.end(),
+                                    [node](const Connection& c) { return c.source == node; }),
+                     inputs.end());
+    }
+    return compile();
+}
+
+bool AudioEffectsGraph::connect(NodeId source, NodeId destination, float gain) {
+    if (source >= nodes_.size() || destination >= nodes_.size() ||
+        !nodes_[source].active || !nodes_[destination].active ||
+        source == kOutputNode || destination == kInputNode || source == destination) {
+        return false;
+    }
+
+    auto& inputs = nodes_[destination].inputs;
+    for (auto& connection : inputs) {
+        if (connection.source == source) {
+            connection.gain = gain;
+            return true;
+        }
+    }
+
+    inputs.push_back(Connection{source, gain});
+    if (!compile()) {
+        // 形成环路，撤销连接
+        inputs.pop_back();
+        return false;
+    }
+    return true;
+}
+
+bool AudioEffectsGraph::disconnect(NodeId source, NodeId destination) {
+    if (destination >= nodes_.size()) {
+        return false;
+    }
+
+    auto& inputs = nodes_[destination].inputs;
+    const auto it = std::find_if(inputs.begin(), inputs.end(),
+                                 [source](const Connection& c) { return c.source == source; });
+    if (it == inputs.end()) {
+        return false;
+    }
+
+    inputs.erase(it);
+    return compile();
+}
+
+bool AudioEffectsGraph::setConnectionGain(NodeId source, NodeId destination, float gain) {
+    if (destination >= nodes_.size()) {
+        return false;
+    }
+
+    for (auto& connection : nodes_[destination].inputs) {
+        if (connection.source == source) {
+            connection.gain = gain;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AudioEffectsGraph::apply(const AudioBuffer& input, AudioBuffer& output) {
+    if (!initialized_ || input.size() % channels_ != 0) {
+        return false;
+    }
+
+    if (&input != &output) {
+        if (output.size() != input.size()) {
+            output.resize(input.size());
+        }
+        std::copy(input.data(), input.data() + input.size(), output.data());
+    }
+
+    return process(AudioView(output, channels_));
+}
+
+bool AudioEffectsGraph::process(AudioView view) {
+    if (!initialized_ || view.channels() != channels_) {
+        return false;
+    }
+
+    // 节点缓冲区在prepare中按块长分配，更长的块分段处理
+    if (view.frames() > max_frames_) {
+        bool success = true;
+        for (size_t offset = 0; offset < view.frames(); offset += max_frames_) {
+            success = processBlock(view.subView(offset, max_frames_)) && success;
+        }
+        return success;
+    }
+    return processBlock(view);
+}
+
+bool AudioEffectsGraph::processBlock(AudioView view) {
+    const size_t frames = view.frames();
+
+    // 输入节点直接引用视图；输出节点最后才写回视图，因此不会覆盖尚未读取的输入
+    for (auto& node : nodes_) {
+        node.data = node.buffer.data();
+    }
+    nodes_[kInputNode].data = view.data();
+
+    bool success = true;
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        success = runLevel(level, frames) && success;
+    }
+
+    const float* result = nodes_[kOutputNode].data;
+    std::copy(result, result + view.size(), view.data());
+    return success;
+}
+
+AudioFilter* AudioEffectsGraph::getEffect(NodeId node) const {
+    if (node >= nodes_.size()) {
+        return nullptr;
+    }
+
+    return nodes_[node].effect.get();
+}
+
+AudioEffectsChain* AudioEffectsGraph::getChain(NodeId node) const {
+    if (node >= nodes_.size()) {
+        return nullptr;
+    }
+
+    return nodes_[node].chain.get();
+}
+
+size_t AudioEffectsGraph::getNodeCount() const {
+    return static_cast<size_t>(std::count_if(nodes_.begin(), nodes_.end(),
+                                             [](const Node& node) { return node.active; }));
+}
+
+size_t AudioEffectsGraph::getLevelCount() const {
+    return levels_.size();
+}
+
+AudioEffectsGraph::NodeId AudioEffectsGraph::addNode(std::unique_ptr<AudioFilter> effect,
+                                                     std::unique_ptr<AudioEffectsChain> chain) {
+    Node node;
+    node.active = true;
+    node.effect = std::move(effect);
+    node.chain = std::move(chain);
+    node.buffer.resize(max_frames_ * channels_);
+    node.data = nullptr;
+
+    // 复用已移除节点的位置
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        if (!nodes_[id].active) {
+            nodes_[id] = std::move(node);
+            return id;
+        }
+    }
+
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+}
+
+bool AudioEffectsGraph::compile() {
+    const size_t count = nodes_.size();
+
+    // 只调度能到达输出节点的节点
+    std::vector<bool> live(count, false);
+    std::vector<NodeId> stack{kOutputNode};
+    live[kOutputNode] = true;
+    while (!stack.empty()) {
+        const NodeId id = stack.back();
+        stack.pop_back();
+        for (const auto& connection : nodes_[id].inputs) {
+            if (!live[connection.source]) {
+                live[connection.source] = true;
+                stack.push_back(connection.source);
+            }
+        }
+    }
+
+    // Kahn算法对全部节点分层（节点层号为其最长入路径长度），同时检测环路
+    std::vector<size_t> pending(count, 0);
+    std::vector<std::vector<NodeId>> outputs(count);
+    size_t active_count = 0;
+    for (NodeId id = 0; id < count; ++id) {
+        if (!nodes_[id].active) {
+            continue;
+        }
+        ++active_count;
+        for (const auto& connection : nodes_[id].inputs) {
+            ++pending[id];
+            outputs[connection.source].push_back(id);
+        }
+    }
+
+    std::vector<NodeId> ready;
+    for (NodeId id = 0; id < count; ++id) {
+        if (nodes_[id].active && pending[id] == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    std::vector<std::vector<NodeId>> levels;
+    size_t sorted = 0;
+    while (!ready.empty()) {
+        std::vector<NodeId> next;
+        std::vector<NodeId> level;
+        for (NodeId id : ready) {
+            for (NodeId target : outputs[id]) {
+                if (--pending[target] == 0) {
+                    next.push_back(target);
+                }
+            }
+            if (live[id]) {
+                level.push_back(id);
+            }
+        }
+        sorted += ready.size();
+        if (!level.empty()) {
+            levels.push_back(std::move(level));
+        }
+        ready = std::move(next);
+    }
+
+    if (sorted != active_count) {
+        return false;
+    }
+
+    levels_ = std::move(levels);
+    return true;
+}
+
+bool AudioEffectsGraph::processNode(NodeId id, size_t frames) {
+    Node& node = nodes_[id];
+    if (id == kInputNode) {
+        return true;
+    }
+
+    // 对入边求和：第一条入边直接写入，其余累加
+    const size_t samples = frames * channels_;
+    float* out = node.data;
+    if (node.inputs.empty()) {
+        std::fill(out, out + samples, 0.0f);
+    }
+    for (size_t i = 0; i < node.inputs.size(); ++i) {
+        const float* in = nodes_[node.inputs[i].source].data;
+        const float gain = node.inputs[i].gain;
+        if (i == 0) {
+            for (size_t s = 0; s < samples; ++s) {
+                out[s] = gain * in[s];
+            }
+        } else {
+            for (size_t s = 0; s < samples; ++s) {
+                out[s] += gain * in[s];
+            }
+        }
+    }
+
+    AudioView view(out, frames, channels_);
+    if (node.effect) {
+        return node.effect->process(view);
+    }
+    if (node.chain) {
+        return node.chain->process(view);
+    }
+    return true;
+}
+
+bool AudioEffectsGraph::runLevel(size_t level, size_t frames) {
+    const std::vector<NodeId>& nodes = levels_[level];
+
+    // 单节点层或无线程池时在调用线程上串行执行
+    if (pool_ == nullptr || nodes.size() < 2) {
+        bool success = true;
+        for (NodeId id : nodes) {
+            success = processNode(id, frames) && success;
+        }
+        return success;
+    }
+
+    // 每个节点为一块：调用线程参与执行，等待其余节点时帮忙执行线程池中的高优先级任务
+    std::atomic<bool> failed(false);
+    pool_->parallelFor(0, nodes.size(), 1, [this, &nodes, &failed, frames](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!processNode(nodes[i], frames)) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    }, TaskPriority::HIGH);
+    return !failed.load(std::memory_order_relaxed);
+}
+
+} // namespace core
@@ -1,11 +1,129 @@
 #include "core/audio_fade.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
 namespace core {
 
-AudioFade::AudioFade() 
-    : initialized_(false), fade_in_time_(0.0), fade_out_time_(0.0) {
+namespace {
+
+// 曲线表分段数（表长为分段数+1，查表时线性插值）
+const size_t kTableSize = 1024;
+
+// 每次计算增益的块长（帧）
+const size_t kChunkFrames = 256;
+
+const float kHalfPi = 1.57079632679489661923f;
+
+// 三种曲线的淡入/淡出表，首次使用时构建（线程安全的静态初始化）
+struct CurveTables {
+    float in[3][kTableSize + 1];
+    float out[3][kTableSize + 1];
+
+    CurveTables() {
+        for (size_t i = 0; i <= kTableSize; ++i) {
+            const float x = static_cast<float>(i) / static_cast<float>(kTableSize);
+            const float s = x * x * (3.0f - 2.0f * x);
+            in[0][i] = x;
+            out[0][i] = 1.0f - x;
+            in[1][i] = std::sin(x * kHalfPi);
+            out[1][i] = std::cos(x * kHalfPi);
+            in[2][i] = s;
+            out[2][i] = 1.0f - s;
+        }
+        // 端点精确为0/1，淡化结束时没有残留
+        out[1][kTableSize] = 0.0f;
+    }
+};
+
+const CurveTables& curveTables() {
+    static const CurveTables tables;
+    return tables;
+}
+
+// 按表计算从offset开始的frames个增益（位置按scale映射到表索引）
+inline void tableGains(const float* table, float scale, uint64_t offset, size_t frames, float* gains) {
+    for (size_t i = 0; i < frames; ++i) {
+        const float x = static_cast<float>(offset + i) * scale;
+        const size_t index = std::min(static_cast<size_t>(x), kTableSize - 1);
+        const float frac = x - static_cast<float>(index);
+        gains[i] = table[index] + frac * (table[index + 1] - table[index]);
+    }
+}
+
+// 同一位置同时查淡出与淡入表（两表共用索引计算）
+inline void tableGainPair(const float* out_table, const float* in_table, float scale, uint64_t offset, size_t frames,
+                          float* gain_out, float* gain_in) {
+    for (size_t i = 0; i < frames; ++i) {
+        const float x = static_cast<float>(offset + i) * scale;
+        const size_t index = std::min(static_cast<size_t>(x), kTableSize - 1);
+        const float frac = x - static_cast<float>(index);
+        gain_out[i] = out_table[index] + frac * (out_table[index + 1] - out_table[index]);
+        gain_in[i] = in_table[index] + frac * (in_table[index + 1] - in_table[index]);
+    }
+}
+
+// output = outgoing * gain_out + incoming * gain_in（交错，各声道同一增益）
+void mixInterleaved(const float* outgoing, const float* incoming, float* output,
+                    const float* gain_out, const float* gain_in, size_t frames, size_t channels) {
+    if (channels == 1) {
+        for (size_t i = 0; i < frames; ++i) {
+            output[i] = outgoing[i] * gain_out[i] + incoming[i] * gain_in[i];
+        }
+    } else if (channels == 2) {
+        for (size_t i = 0; i < frames; ++i) {
+            output[2 * i] = outgoing[2 * i] * gain_out[i] + incoming[2 * i] * gain_in[i];
+            output[2 * i + 1] = outgoing[2 * i + 1] * gain_out[i] + incoming[2 * i + 1] * gain_in[i];
+        }
+    } else {
+        for (size_t i = 0; i < frames; ++i) {
+            const size_t base = i * channels;
+            for (size_t ch = 0; ch < channels; ++ch) {
+                output[base + ch] = outgoing[base + ch] * gain_out[i] + incoming[base + ch] * gain_in[i];
+            }
+        }
+    }
+}
+
+// output = input * gain（交错，input可与output相同）
+void scaleInterleaved(const float* input, float* output, const float* gains, size_t frames, size_t channels) {
+    if (channels == 1) {
+        for (size_t i = 0; i < frames; ++i) {
+            output[i] = input[i] * gains[i];
+        }
+    } else if (channels == 2) {
+        for (size_t i = 0; i < frames; ++i) {
+            output[2 * i] = input[2 * i] * gains[i];
+            output[2 * i + 1] = input[2 * i + 1] * gains[i];
+        }
+    } else {
+        for (size_t i = 0; i < frames; ++i) {
+            const size_t base = i * channels;
+            for (size_t ch = 0; ch < channels; ++ch) {
+                output[base + ch] = input[base + ch] * gains[i];
+            }
+        }
+    }
+}
+
+// 拷贝一路流（为空时输出静音，原地时不做任何事）
+inline void copyStream(const float* input, float* output, size_t samples) {
+    if (input == nullptr) {
+        std::fill(output, output + samples, 0.0f);
+    } else if (input != output) {
+        std::memmove(output, input, samples * sizeof(float));
+    }
+}
+
+} // namespace
+
+AudioFade::AudioFade()
+    : initialized_(false), fade_in_time_(0.0), fade_out_time_(0.0), sample_rate_(44100), channels_(2),
+      curve_(Curve::EQUAL_POWER), in_table_(nullptr), out_table_(nullptr),
+      state_(State::IDLE), position_(0), start_(0), length_(0) {
     // 初始化音频淡入淡出器
+    setCurve(curve_);
 }
 
 AudioFade::~AudioFade() {
@@ -15,9 +133,10 @@ AudioFade::~AudioFade() {
 
 bool AudioFade::initialize() {
     std::cout << "Initializing audio fade" << std::endl;
-    
-    // 在实际实现中，这里会初始化淡入淡出器
-    
+
+    state_ = State::IDLE;
+    position_ = 0;
+
     initialized_ = true;
     return true;
 }
@@ -25,49 +144,54 @@ bool AudioFade::initialize() {
 void AudioFade::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio fade" << std::endl;
-        
-        // 在实际实现中，这里会关闭淡入淡出器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioFade::fadeIn(const AudioBuffer& input, AudioBuffer& output, double duration) {
-    if (!initialized_) {
+    if (!initialized_ || duration < 0.0) {
         return false;
     }
-    
-    std::cout << "Applying audio fade in effect with duration: " << duration << " seconds" << std::endl;
-    
-    // 在实际实现中，这里会应用淡入效果
-    
-    output = input;  // 模拟处理
+
+    if (&output != &input) {
+        output = input;
+    }
+
+    const size_t channels = static_cast<size_t>(channels_);
+    const size_t frames = output.size() / channels;
+    const size_t length = static_cast<size_t>(std::llround(duration * sample_rate_));
+    applyTable(output.data(), std::min(frames, length), length, 0, in_table_);
     return true;
 }
 
 bool AudioFade::fadeOut(const AudioBuffer& input, AudioBuffer& output, double duration) {
-    if (!initialized_) {
+    if (!initialized_ || duration < 0.0) {
         return false;
     }
-    
-    std::cout << "Applying audio fade out effect with duration: " << duration << " seconds" << std::endl;
-    
-    // 在实际实现中，这里会应用淡出效果
-    
-    output = input;  // 模拟处理
+
+    if (&output != &input) {
+        output = input;
+    }
+
+    // 淡出在缓冲区末尾结束；缓冲区短于淡化长度时从曲线中途开始。
+    // 曲线位置后移一帧，使最后一帧落在表的终点（增益为0），与淡入第一帧为0对称
+    const size_t channels = static_cast<size_t>(channels_);
+    const size_t frames = output.size() / channels;
+    const size_t length = static_cast<size_t>(std::llround(duration * sample_rate_));
+    const size_t count = std::min(frames, length);
+    applyTable(output.data() + (frames - count) * channels, count, length, length - count + 1, out_table_);
     return true;
 }
 
 bool AudioFade::setParameters(double fade_in_time, double fade_out_time) {
-    if (!initialized_) {
+    if (!initialized_ || fade_in_time < 0.0 || fade_out_time < 0.0) {
         return false;
     }
-    
-    std::cout << "Setting fade parameters - Fade in: " << fade_in_time 
+
+    std::cout << "Setting fade parameters - Fade in: " << fade_in_time
               << " seconds, Fade out: " << fade_out_time << " seconds" << std::endl;
-    
-    // 在实际实现中，这里会设置淡入淡出参数
-    
+
     fade_in_time_ = fade_in_time;
     fade_out_time_ = fade_out_time;
     return true;
@@ -78,4 +202,167 @@ void AudioFade::getParameters(double& fade_in_time, double& fade_out_time) const
     fade_out_time = fade_out_time_;
 }
 
-} // namespace core
\ No newline at end of file
+bool AudioFade::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    return true;
+}
+
+void AudioFade::setCurve(Curve curve) {
+    const CurveTables& tables = curveTables();
+    const size_t index = static_cast<size_t>(curve);
+    curve_ = curve;
+    in_table_ = tables.in[index];
+    out_table_ = tables.out[index];
+}
+
+AudioFade::Curve AudioFade::getCurve() const {
+    return curve_;
+}
+
+bool AudioFade::scheduleCrossfade(uint64_t position, double duration) {
+    if (duration < 0.0) {
+        return false;
+    }
+
+    start_ = position;
+    length_ = static_cast<uint64_t>(std::llround(duration * sample_rate_));
+    state_ = State::PENDING;
+    return true;
+}
+
+bool AudioFade::scheduleCrossfadeAtEnd(uint64_t end_position, double duration) {
+    if (duration < 0.0) {
+        return false;
+    }
+
+    // 剩余时间不足时立即开始（淡化相应缩短，仍在结束位置完成）
+    const uint64_t length = static_cast<uint64_t>(std::llround(duration * sample_rate_));
+    const uint64_t start = std::max(position_, end_position > length ? end_position - length : 0);
+    start_ = start;
+    length_ = end_position > start ? end_position - start : 0;
+    state_ = State::PENDING;
+    return true;
+}
+
+void AudioFade::cancelCrossfade() {
+    state_ = State::IDLE;
+}
+
+void AudioFade::finishCrossfade() {
+    if (state_ == State::COMPLETE) {
+        state_ = State::IDLE;
+    }
+}
+
+bool AudioFade::crossfade(const float* outgoing, const float* incoming, float* output, size_t frames) {
+    if (output == nullptr) {
+        return false;
+    }
+
+    const size_t channels = static_cast<size_t>(channels_);
+    size_t done = 0;
+    while (done < frames) {
+        const size_t remaining = frames - done;
+        const size_t sample_offset = done * channels;
+        const float* out_src = outgoing == nullptr ? nullptr : outgoing + sample_offset;
+        const float* in_src = incoming == nullptr ? nullptr : incoming + sample_offset;
+        float* dst = output + sample_offset;
+
+        size_t count = remaining;
+        if (state_ == State::IDLE) {
+            copyStream(out_src, dst, count * channels);
+        } else if (state_ == State::COMPLETE) {
+            copyStream(in_src, dst, count * channels);
+        } else if (position_ < start_) {
+            // 触发位置之前仍是淡出流
+            count = static_cast<size_t>(std::min<uint64_t>(remaining, start_ - position_));
+            copyStream(out_src, dst, count * channels);
+        } else {
+            state_ = State::ACTIVE;
+            const uint64_t offset = position_ - start_;
+            if (offset >= length_) {
+                state_ = State::COMPLETE;
+                continue;
+            }
+            count = static_cast<size_t>(std::min<uint64_t>(remaining, length_ - offset));
+            mixFrames(out_src, in_src, dst, count, offset);
+            if (offset + count == length_) {
+                state_ = State::COMPLETE;
+            }
+        }
+
+        position_ += count;
+        done += count;
+    }
+    return true;
+}
+
+void AudioFade::mixFrames(const float* outgoing, const float* incoming, float* output, size_t frames, uint64_t offset) {
+    const size_t channels = static_cast<size_t>(channels_);
+    const float scale = static_cast<float>(kTableSize) / static_cast<float>(length_);
+    float gain_out[kChunkFrames];
+    float gain_in[kChunkFrames];
+
+    for (size_t done = 0; done < frames; done += kChunkFrames) {
+        const size_t count = std::min(kChunkFrames, frames - done);
+        const size_t sample_offset = done * channels;
+        float* dst = output + sample_offset;
+
+        if (outgoing != nullptr && incoming != nullptr) {
+            tableGainPair(out_table_, in_table_, scale, offset + done, count, gain_out, gain_in);
+            mixInterleaved(outgoing + sample_offset, incoming + sample_offset, dst, gain_out, gain_in, count, channels);
+        } else if (outgoing != nullptr) {
+            tableGains(out_table_, scale, offset + done, count, gain_out);
+            scaleInterleaved(outgoing + sample_offset, dst, gain_out, count, channels);
+        } else if (incoming != nullptr) {
+            tableGains(in_table_, scale, offset + done, count, gain_in);
+            scaleInterleaved(incoming + sample_offset, dst, gain_in, count, channels);
+        } else {
+            std::fill(dst, dst + count * channels, 0.0f);
+        }
+    }
+}
+
+void AudioFade::applyTable(float* data, size_t frames, size_t length, size_t offset, const float* table) {
+    if (frames == 0 || length == 0) {
+        return;
+    }
+
+    const size_t channels = static_cast<size_t>(channels_);
+    const float scale = static_cast<float>(kTableSize) / static_cast<float>(length);
+    float gains[kChunkFrames];
+    for (size_t done = 0; done < frames; done += kChunkFrames) {
+        const size_t count = std::min(kChunkFrames, frames - done);
+        float* block = data + done * channels;
+        tableGains(table, scale, offset + done, count, gains);
+        scaleInterleaved(block, block, gains, count, channels);
+    }
+}
+
+bool AudioFade::isCrossfading() const {
+    return state_ == State::ACTIVE;
+}
+
+bool AudioFade::isComplete() const {
+    return state_ == State::COMPLETE;
+}
+
+uint64_t AudioFade::getPosition() const {
+    return position_;
+}
+
+void AudioFade::reset() {
+    std::cout << "Resetting audio fade" << std::endl;
+
+    state_ = State::IDLE;
+    position_ = 0;
+    start_ = 0;
+    length_ = 0;
+}
+
+} // namespace core
@@ -0,0 +1,102 @@
+#include "core/audio_fft.h"
+#include <cmath>
+#include <utility>
+
+namespace core {
+
+AudioFFT::AudioFFT() : size_(0) {}
+
+AudioFFT::AudioFFT(size_t size) : size_(0) {
+    setSize(size);
+}
+
+bool AudioFFT::setSize(size_t size) {
+    if (size < 2 || !isPowerOfTwo(size)) {
+        return false;
+    }
+
+    size_ = size;
+
+    // 位反转索引表
+    size_t bits = 0;
+    while ((static_cast<size_t>(1) << bits) < size) {
+        ++bits;
+    }
+    bit_reverse_.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bit_reverse_[i] = reversed;
+    }
+
+    // 旋转因子表（半周期）
+    const double two_pi = 6.283185307179586;
+    cos_table_.resize(size / 2);
+    sin_table_.resize(size / 2);
+    for (size_t i = 0; i < size / 2; ++i) {
+        double angle = two_pi * static_cast<double>(i) / static_cast<double>(size);
+        cos_table_[i] = static_cast<float>(std::cos(angle));
+        sin_table_[i] = static_cast<float>(std::sin(angle));
+    }
+
+    return true;
+}
+
+size_t AudioFFT::getSize() const {
+    return size_;
+}
+
+void AudioFFT::forward(float* re, float* im) const {
+    transform(re, im, -1.0f);
+}
+
+void AudioFFT::inverse(float* re, float* im) const {
+    transform(re, im, 1.0f);
+
+    const float scale = 1.0f / static_cast<float>(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        re[i] *= scale;
+        im[i] *= scale;
+    }
+}
+
+bool AudioFFT::isPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+void AudioFFT::transform(float* re, float* im, float sign) const {
+    if (size_ == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < size_; ++i) {
+        size_t j = bit_reverse_[i];
+        if (j > i) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    for (size_t length = 2; length <= size_; length <<= 1) {
+        const size_t half = length >> 1;
+        const size_t stride = size_ / length;
+        for (size_t start = 0; start < size_; start += length) {
+            for (size_t k = 0; k < half; ++k) {
+                const float wr = cos_table_[k * stride];
+                const float wi = sign * sin_table_[k * stride];
+                const size_t a = start + k;
+                const size_t b = a + half;
+                const float tr = re[b] * wr - im[b] * wi;
+                const float ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+} // namespace core
@@ -1,94 +0,0 @@
-#include "core/audio_flanger_modulated.h"
-#include <iostream>
-
-namespace core {
-
-AudioFlangerModulated::AudioFlangerModulated() 
-    : initialized_(false), rate_(1.0f), depth_(0.5f), feedback_(0.2f), mix_(0.3f), 
-      modulation_rate_(0.5f), modulation_depth_(0.3f) {
-    // 初始化音频调制镶边器
-}
-
-AudioFlangerModulated::~AudioFlangerModulated() {
-    // 析构函数
-    shutdown();
-}
-
-bool AudioFlangerModulated::initialize() {
-    std::cout << "Initializing audio flanger modulated" << std::endl;
-    
-    // 在实际实现中，这里会初始化调制镶边器
-    
-    initialized_ = true;
-    return true;
-}
-
-void AudioFlangerModulated::shutdown() {
-    if (initialized_) {
-        std::cout << "Shutting down audio flanger modulated" << std::endl;
-        
-        // 在实际实现中，这里会关闭调制镶边器
-        
-        initialized_ = false;
-    }
-}
-
-bool AudioFlangerModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Applying audio flanger modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制镶边效果
-    
-    output = input;  // 模拟处理
-    return true;
-}
-
-bool AudioFlangerModulated::setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Setting flanger modulated parameters - Rate: " << rate 
-              << " Hz, Depth: " << depth << ", Feedback: " << feedback 
-              << ", Mix: " << mix << ", Modulation rate: " << modulation_rate 
-              << " Hz, Modulation depth: " << modulation_depth << std::endl;
-    
-    // 在实际实现中，这里会设置调制镶边参数
-    
-    rate_ = rate;
-    depth_ = depth;
-    feedback_ = feedback;
-    mix_ = mix;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
-    return true;
-}
-
-void AudioFlangerModulated::getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth) const {
-    rate = rate_;
-    depth = depth_;
-    feedback = feedback_;
-    mix = mix_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
-}
-
-void AudioFlangerModulated::reset() {
-    if (initialized_) {
-        std::cout << "Resetting audio flanger modulated" << std::endl;
-        
-        // 在实际实现中，这里会重置调制镶边器
-        
-        rate_ = 1.0f;
-        depth_ = 0.5f;
-        feedback_ = 0.2f;
-        mix_ = 0.3f;
-        modulation_rate_ = 0.5f;
-        modulation_depth_ = 0.3f;
-    }
-}
-
-} // namespace core
\ No newline at end of file
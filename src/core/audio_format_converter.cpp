@@ -1,4 +1,5 @@
 #include "core/audio_format_converter.h"
+#include "audio/simd/sample_convert.h"
 #include <iostream>
 #include <vector>
 
@@ -7,6 +8,7 @@ namespace core {
 AudioFormatConverter::AudioFormatConverter() 
     : initialized_(false), sample_rate_(44100), channels_(2), bit_depth_(16) {
     // 初始化音频格式转换器
+    dither_.setEnabled(false);
 }
 
 AudioFormatConverter::~AudioFormatConverter() {
@@ -48,6 +50,78 @@ bool AudioFormatConverter::convert(const AudioBuffer& input,
     return true;
 }
 
+bool AudioFormatConverter::convert(const void* input, audio::SampleFormat input_format,
+                                   void* output, audio::SampleFormat output_format,
+                                   size_t samples) {
+    if (!initialized_ || input == nullptr || output == nullptr) {
+        return false;
+    }
+    
+    // 降到更低位深的16/24位时抖动与转换在同一遍内完成（升位深不抖动）
+    const bool reduces_depth = (output_format == audio::SampleFormat::PCM_S16LE ||
+                                output_format == audio::SampleFormat::PCM_S24LE) &&
+                               audio::simd::bytesPerSample(output_format) < audio::simd::bytesPerSample(input_format);
+    if (dither_.isEnabled() && reduces_depth) {
+        const size_t channels = static_cast<size_t>(channels_);
+        if (channels == 0 || samples % channels != 0) {
+            return false;
+        }
+        const float* source = static_cast<const float*>(input);
+        if (input_format != audio::SampleFormat::PCM_FLOAT) {
+            if (scratch_.size() < samples) {
+                scratch_.resize(samples);
+            }
+            if (!audio::simd::toFloat(input, input_format, scratch_.data(), samples)) {
+                return false;
+            }
+            source = scratch_.data();
+        }
+        return dither_.process(source, output_format, output, samples / channels, channels);
+    }
+    
+    // 只有两端都不是浮点时才需要中间缓冲区
+    float* scratch = nullptr;
+    if (input_format != output_format && input_format != audio::SampleFormat::PCM_FLOAT &&
+        output_format != audio::SampleFormat::PCM_FLOAT) {
+        if (scratch_.size() < samples) {
+            scratch_.resize(samples);
+        }
+        scratch = scratch_.data();
+    }
+    return audio::simd::convert(input, input_format, output, output_format, scratch, samples);
+}
+
+bool AudioFormatConverter::interleave(const float* const* planes, float* output, size_t frames, size_t channels) {
+    if (!initialized_ || planes == nullptr || output == nullptr || channels == 0) {
+        return false;
+    }
+    
+    audio::simd::getKernels().interleave(planes, output, frames, channels);
+    return true;
+}
+
+bool AudioFormatConverter::deinterleave(const float* input, float* const* planes, size_t frames, size_t channels) {
+    if (!initialized_ || input == nullptr || planes == nullptr || channels == 0) {
+        return false;
+    }
+    
+    audio::simd::getKernels().deinterleave(input, planes, frames, channels);
+    return true;
+}
+
+bool AudioFormatConverter::setDither(bool enabled, audio::dsp::Dither::NoiseShaping shaping) {
+    if (!initialized_) {
+        return false;
+    }
+    
+    std::cout << "Setting converter dither: " << (enabled ? "on" : "off")
+              << ", noise shaping: " << static_cast<int>(shaping) << std::endl;
+    
+    dither_.setEnabled(enabled);
+    dither_.setNoiseShaping(shaping);
+    return true;
+}
+
 bool AudioFormatConverter::setParameters(int sample_rate, int channels, int bit_depth) {
     if (!initialized_) {
         return false;
@@ -61,6 +135,7 @@ bool AudioFormatConverter::setParameters(int sample_rate, int channels, int bit_
     sample_rate_ = sample_rate;
     channels_ = channels;
     bit_depth_ = bit_depth;
+    dither_.reset();
     return true;
 }
 
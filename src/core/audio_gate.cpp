@@ -1,10 +1,47 @@
 #include "core/audio_gate.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
-AudioGate::AudioGate() 
-    : initialized_(false), threshold_(-40.0f), attack_(5.0f), release_(50.0f) {
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+// 检测器时间常数（毫秒）：RMS窗口/峰值衰减
+const float kDetectorTime = 10.0f;
+
+// 关闭时扩展增益的更新间隔（帧）
+const size_t kControlInterval = 32;
+
+// 扩展比达到该值时按硬门限处理
+const float kHardGateRatio = 50.0f;
+
+inline float dbToPower(float db) {
+    return std::pow(10.0f, db / 10.0f);
+}
+
+inline float dbToGain(float db) {
+    return std::pow(10.0f, db / 20.0f);
+}
+
+// 一阶平滑系数（时间常数为milliseconds）
+inline float timeCoefficient(float milliseconds, int sample_rate) {
+    const float frames = std::max(milliseconds, 0.01f) * 0.001f * static_cast<float>(sample_rate);
+    return 1.0f - std::exp(-1.0f / frames);
+}
+
+} // namespace
+
+AudioGate::AudioGate()
+    : initialized_(false), threshold_(-40.0f), attack_(5.0f), release_(50.0f),
+      hold_(20.0f), hysteresis_(6.0f), range_(-80.0f), ratio_(kHardGateRatio), lookahead_(0.0f),
+      sidechain_freq_(0.0f), detection_(DetectionMode::PEAK), linked_(true),
+      sample_rate_(44100), channels_(2),
+      open_power_(0.0f), close_power_(0.0f), range_gain_(0.0f), attack_coef_(1.0f), release_coef_(1.0f),
+      detector_coef_(1.0f), hold_frames_(0.0f), lookahead_frames_(0),
+      hp_b0_(1.0f), hp_b1_(0.0f), hp_b2_(0.0f), hp_a1_(0.0f), hp_a2_(0.0f), control_counter_(0) {
     // 初始化音频门控器
 }
 
@@ -15,9 +52,10 @@ AudioGate::~AudioGate() {
 
 bool AudioGate::initialize() {
     std::cout << "Initializing audio gate" << std::endl;
-    
-    // 在实际实现中，这里会初始化门控器
-    
+
+    updateCoefficients();
+    allocateState();
+
     initialized_ = true;
     return true;
 }
@@ -25,39 +63,213 @@ bool AudioGate::initialize() {
 void AudioGate::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio gate" << std::endl;
-        
-        // 在实际实现中，这里会关闭门控器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioGate::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
-    
-    std::cout << "Applying audio gate effect" << std::endl;
-    
-    // 在实际实现中，这里会应用门控效果
-    
-    output = input;  // 模拟处理
+
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / static_cast<size_t>(channels_));
     return true;
 }
 
+bool AudioGate::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
+
+    processFrames(view.data(), view.frames());
+    return true;
+}
+
+void AudioGate::processFrames(float* data, size_t frames) {
+    const size_t channels = static_cast<size_t>(channels_);
+    const size_t detectors = linked_ ? 1 : channels;
+    const size_t samples = frames * channels;
+    const size_t delay = lookahead_frames_ * channels;
+
+    // 更长的块在首次出现时扩容
+    if (gain_block_.size() < samples) {
+        gain_block_.resize(samples);
+    }
+    if (delay_work_.size() < delay + samples) {
+        delay_work_.resize(delay + samples);
+    }
+
+    const float b0 = hp_b0_, b1 = hp_b1_, b2 = hp_b2_, a1 = hp_a1_, a2 = hp_a2_;
+    const float detector_coef = detector_coef_;
+    const bool peak = detection_ == DetectionMode::PEAK;
+    const float open_power = open_power_;
+    const float close_power = close_power_;
+    const float hold_frames = hold_frames_;
+    const float attack = attack_coef_;
+    const float release = release_coef_;
+    float* z1 = hp_z1_.data();
+    float* z2 = hp_z2_.data();
+    float* level = level_.data();
+    float* hold = hold_count_.data();
+    float* open = open_.data();
+    const float* closed_gain = closed_gain_.data();
+    float* gain = gain_.data();
+    float* gains = gain_block_.data();
+
+    for (size_t i = 0; i < frames; ++i) {
+        const float* x = data + i * channels;
+
+        // 侧链高通与电平检测：各声道互不依赖，按声道向量化（关闭高通时系数为直通）
+        if (peak) {
+            for (size_t ch = 0; ch < channels; ++ch) {
+                const float y = b0 * x[ch] + z1[ch];
+                z1[ch] = b1 * x[ch] - a1 * y + z2[ch];
+                z2[ch] = b2 * x[ch] - a2 * y;
+                level[ch] = std::max(y * y, level[ch] * detector_coef);
+            }
+        } else {
+            for (size_t ch = 0; ch < channels; ++ch) {
+                const float y = b0 * x[ch] + z1[ch];
+                z1[ch] = b1 * x[ch] - a1 * y + z2[ch];
+                z2[ch] = b2 * x[ch] - a2 * y;
+                level[ch] += detector_coef * (y * y - level[ch]);
+            }
+        }
+
+        // 联动模式下取各声道电平的最大值作为唯一检测器的电平
+        const float* detector_level = level;
+        float linked_level = 0.0f;
+        if (linked_) {
+            for (size_t ch = 0; ch < channels; ++ch) {
+                linked_level = std::max(linked_level, level[ch]);
+            }
+            detector_level = &linked_level;
+        }
+
+        // 门状态机（迟滞 + 保持）与增益平滑，写成选择运算以便向量化
+        for (size_t d = 0; d < detectors; ++d) {
+            const float l = detector_level[d];
+            const bool above_open = l > open_power;
+            const bool above_close = l > close_power;
+            const bool is_open = above_open || (open[d] > 0.5f && (above_close || hold[d] > 0.0f));
+            hold[d] = above_close ? hold_frames : std::max(hold[d] - 1.0f, 0.0f);
+            open[d] = is_open ? 1.0f : 0.0f;
+
+            const float target = is_open ? 1.0f : closed_gain[d];
+            const float coef = target > gain[d] ? attack : release;
+            gain[d] += coef * (target - gain[d]);
+        }
+
+        float* frame_gains = gains + i * channels;
+        if (linked_) {
+            std::fill(frame_gains, frame_gains + channels, gain[0]);
+        } else {
+            std::copy(gain, gain + channels, frame_gains);
+        }
+
+        // 扩展增益按控制速率更新
+        if (++control_counter_ >= kControlInterval) {
+            control_counter_ = 0;
+            for (size_t d = 0; d < detectors; ++d) {
+                updateClosedGain(d, detector_level[d]);
+            }
+        }
+    }
+
+    // 音频延迟lookahead帧后乘以增益：逐样本无依赖，可向量化
+    if (delay == 0) {
+        for (size_t k = 0; k < samples; ++k) {
+            data[k] *= gains[k];
+        }
+        return;
+    }
+
+    float* work = delay_work_.data();
+    std::copy(delay_history_.begin(), delay_history_.end(), work);
+    std::copy(data, data + samples, work + delay);
+    for (size_t k = 0; k < samples; ++k) {
+        data[k] = work[k] * gains[k];
+    }
+    std::copy(work + samples, work + samples + delay, delay_history_.begin());
+}
+
+void AudioGate::updateClosedGain(size_t detector, float level) {
+    if (ratio_ >= kHardGateRatio) {
+        closed_gain_[detector] = range_gain_;
+        return;
+    }
+
+    // 关门阈值以下每降低1dB，增益降低(ratio - 1)dB
+    const float expanded = std::pow(std::max(level, 1e-20f) / close_power_, 0.5f * (ratio_ - 1.0f));
+    closed_gain_[detector] = std::clamp(expanded, range_gain_, 1.0f);
+}
+
+void AudioGate::updateCoefficients() {
+    const float sample_rate = static_cast<float>(sample_rate_);
+
+    open_power_ = dbToPower(threshold_);
+    close_power_ = dbToPower(threshold_ - hysteresis_);
+    range_gain_ = dbToGain(range_);
+    attack_coef_ = timeCoefficient(attack_, sample_rate_);
+    release_coef_ = timeCoefficient(release_, sample_rate_);
+    hold_frames_ = std::round(hold_ * 0.001f * sample_rate);
+    lookahead_frames_ = static_cast<size_t>(std::lround(lookahead_ * 0.001f * sample_rate));
+
+    // RMS窗口；峰值模式下为每帧衰减系数
+    detector_coef_ = detection_ == DetectionMode::PEAK
+        ? std::exp(-1.0f / (kDetectorTime * 0.001f * sample_rate))
+        : timeCoefficient(kDetectorTime, sample_rate_);
+
+    // 侧链二阶巴特沃斯高通（关闭时为直通）
+    if (sidechain_freq_ > 0.0f) {
+        const float k = std::tan(kPi * std::min(sidechain_freq_, 0.45f * sample_rate) / sample_rate);
+        const float norm = 1.0f / (1.0f + std::sqrt(2.0f) * k + k * k);
+        hp_b0_ = norm;
+        hp_b1_ = -2.0f * norm;
+        hp_b2_ = norm;
+        hp_a1_ = 2.0f * (k * k - 1.0f) * norm;
+        hp_a2_ = (1.0f - std::sqrt(2.0f) * k + k * k) * norm;
+    } else {
+        hp_b0_ = 1.0f;
+        hp_b1_ = 0.0f;
+        hp_b2_ = 0.0f;
+        hp_a1_ = 0.0f;
+        hp_a2_ = 0.0f;
+    }
+}
+
+void AudioGate::allocateState() {
+    const size_t channels = static_cast<size_t>(channels_);
+    hp_z1_.assign(channels, 0.0f);
+    hp_z2_.assign(channels, 0.0f);
+    level_.assign(channels, 0.0f);
+    hold_count_.assign(channels, 0.0f);
+    open_.assign(channels, 0.0f);
+    closed_gain_.assign(channels, range_gain_);
+    gain_.assign(channels, range_gain_);
+    delay_history_.assign(lookahead_frames_ * channels, 0.0f);
+    control_counter_ = 0;
+}
+
 bool AudioGate::setParameters(float threshold, float attack, float release) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting gate parameters - Threshold: " << threshold 
+    if (threshold > 0.0f || threshold < -120.0f || attack <= 0.0f || release <= 0.0f) {
+        return false;
+    }
+
+    std::cout << "Setting gate parameters - Threshold: " << threshold
               << " dB, Attack: " << attack << " ms, Release: " << release << " ms" << std::endl;
-    
-    // 在实际实现中，这里会设置门控参数
-    
+
     threshold_ = threshold;
     attack_ = attack;
     release_ = release;
+    updateCoefficients();
     return true;
 }
 
@@ -67,16 +279,98 @@ void AudioGate::getParameters(float& threshold, float& attack, float& release) c
     release = release_;
 }
 
+bool AudioGate::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    updateCoefficients();
+    allocateState();
+    return true;
+}
+
+bool AudioGate::setHold(float hold_ms) {
+    if (hold_ms < 0.0f || hold_ms > 2000.0f) {
+        return false;
+    }
+
+    hold_ = hold_ms;
+    updateCoefficients();
+    return true;
+}
+
+bool AudioGate::setHysteresis(float hysteresis_db) {
+    if (hysteresis_db < 0.0f || hysteresis_db > 24.0f) {
+        return false;
+    }
+
+    hysteresis_ = hysteresis_db;
+    updateCoefficients();
+    return true;
+}
+
+bool AudioGate::setRange(float range_db, float ratio) {
+    if (range_db > 0.0f || range_db < -120.0f || ratio < 1.0f) {
+        return false;
+    }
+
+    range_ = range_db;
+    ratio_ = ratio;
+    updateCoefficients();
+    return true;
+}
+
+bool AudioGate::setLookahead(float lookahead_ms) {
+    if (lookahead_ms < 0.0f || lookahead_ms > kMaxLookahead) {
+        return false;
+    }
+
+    lookahead_ = lookahead_ms;
+    updateCoefficients();
+    delay_history_.assign(lookahead_frames_ * static_cast<size_t>(channels_), 0.0f);
+    return true;
+}
+
+bool AudioGate::setSidechainHighpass(float frequency) {
+    if (frequency < 0.0f || frequency > 2000.0f) {
+        return false;
+    }
+
+    sidechain_freq_ = frequency;
+    updateCoefficients();
+    return true;
+}
+
+void AudioGate::setDetectionMode(DetectionMode mode) {
+    detection_ = mode;
+    updateCoefficients();
+}
+
+void AudioGate::setLinked(bool linked) {
+    linked_ = linked;
+}
+
+size_t AudioGate::getLatency() const {
+    return lookahead_frames_;
+}
+
+bool AudioGate::isOpen(size_t channel) const {
+    const size_t detector = linked_ ? 0 : channel;
+    return detector < open_.size() && open_[detector] > 0.5f;
+}
+
 void AudioGate::reset() {
     if (initialized_) {
         std::cout << "Resetting audio gate" << std::endl;
-        
-        // 在实际实现中，这里会重置门控器
-        
+
         threshold_ = -40.0f;
         attack_ = 5.0f;
         release_ = 50.0f;
+        updateCoefficients();
+        allocateState();
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -0,0 +1,309 @@
+#include "core/audio_loudness.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace core {
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 绝对门限（LUFS）与相对门限（LU）
+const double kAbsoluteGate = -70.0;
+const double kRelativeGate = -10.0;
+const double kRangeRelativeGate = -20.0;
+
+// 响度范围取值的百分位
+const double kRangeLow = 0.10;
+const double kRangeHigh = 0.95;
+
+// 瞬时块与短时块包含的子块数（子块为100ms），短时块每10个子块（1s）取一次
+const size_t kMomentarySubBlocks = 4;
+const size_t kShortTermSubBlocks = 30;
+const size_t kShortTermHop = 10;
+
+inline double energyToLoudness(double energy) {
+    return energy > 0.0 ? -0.691 + 10.0 * std::log10(energy) : -std::numeric_limits<double>::infinity();
+}
+
+inline double loudnessToEnergy(double loudness) {
+    return std::pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+// 门限以上块的平均能量（threshold为能量）
+double gatedMean(const std::vector<double>& blocks, double threshold, size_t& count) {
+    double sum = 0.0;
+    count = 0;
+    for (double energy : blocks) {
+        if (energy > threshold) {
+            sum += energy;
+            ++count;
+        }
+    }
+    return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+} // namespace
+
+LoudnessMeter::LoudnessMeter()
+    : sample_rate_(0), channels_(0), true_peak_enabled_(true), sub_block_frames_(0),
+      pre_b_{1.0, 0.0, 0.0}, pre_a_{1.0, 0.0, 0.0}, rlb_b_{1.0, 0.0, 0.0}, rlb_a_{1.0, 0.0, 0.0},
+      sub_energy_(0.0), sub_frames_(0), sub_count_(0), sub_history_{},
+      sample_peak_(0.0f), true_peak_(0.0f), frames_(0) {
+    setFormat(44100, 2);
+}
+
+bool LoudnessMeter::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    sub_block_frames_ = static_cast<size_t>(std::max(1L, std::lround(sample_rate / 10.0)));
+
+    // K加权：高架预滤波（+4dB，约1.68kHz）与RLB高通（约38Hz），按采样率由模拟原型经双线性变换得到
+    const double fs = static_cast<double>(sample_rate);
+    double k = std::tan(kPi * 1681.974450955533 / fs);
+    double q = 0.7071752369554196;
+    const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    pre_b_[0] = (vh + vb * k / q + k * k) / a0;
+    pre_b_[1] = 2.0 * (k * k - vh) / a0;
+    pre_b_[2] = (vh - vb * k / q + k * k) / a0;
+    pre_a_[0] = 1.0;
+    pre_a_[1] = 2.0 * (k * k - 1.0) / a0;
+    pre_a_[2] = (1.0 - k / q + k * k) / a0;
+
+    k = std::tan(kPi * 38.13547087602444 / fs);
+    q = 0.5003270373238773;
+    a0 = 1.0 + k / q + k * k;
+    rlb_b_[0] = 1.0;
+    rlb_b_[1] = -2.0;
+    rlb_b_[2] = 1.0;
+    rlb_a_[0] = 1.0;
+    rlb_a_[1] = 2.0 * (k * k - 1.0) / a0;
+    rlb_a_[2] = (1.0 - k / q + k * k) / a0;
+
+    // 默认声道权重：5.1（L R C LFE Ls Rs）排除LFE并提升环绕声道
+    weights_.assign(static_cast<size_t>(channels), 1.0f);
+    if (channels == 6) {
+        weights_[3] = 0.0f;
+        weights_[4] = 1.41f;
+        weights_[5] = 1.41f;
+    }
+
+    // 真峰值过采样倍数：使过采样后的采样率不低于约192kHz
+    oversampler_.setFactor(sample_rate < 96000 ? 4 : (sample_rate < 192000 ? 2 : 1));
+    oversampler_.prepare(static_cast<size_t>(channels), kChunkFrames);
+
+    state_.assign(static_cast<size_t>(channels) * 4, 0.0);
+    reset();
+    return true;
+}
+
+bool LoudnessMeter::setChannelWeight(int channel, float weight) {
+    if (channel < 0 || channel >= channels_ || weight < 0.0f) {
+        return false;
+    }
+
+    weights_[static_cast<size_t>(channel)] = weight;
+    return true;
+}
+
+int LoudnessMeter::getSampleRate() const {
+    return sample_rate_;
+}
+
+int LoudnessMeter::getChannels() const {
+    return channels_;
+}
+
+void LoudnessMeter::setTruePeakEnabled(bool enabled) {
+    true_peak_enabled_ = enabled;
+}
+
+void LoudnessMeter::process(const float* data, size_t frames) {
+    if (data == nullptr) {
+        return;
+    }
+
+    const size_t channels = static_cast<size_t>(channels_);
+    const double pb0 = pre_b_[0], pb1 = pre_b_[1], pb2 = pre_b_[2], pa1 = pre_a_[1], pa2 = pre_a_[2];
+    const double rb0 = rlb_b_[0], rb1 = rlb_b_[1], rb2 = rlb_b_[2], ra1 = rlb_a_[1], ra2 = rlb_a_[2];
+
+    size_t offset = 0;
+    while (offset < frames) {
+        // 分段不跨越子块边界
+        const size_t count = std::min({frames - offset, kChunkFrames, sub_block_frames_ - sub_frames_});
+        const float* x = data + offset * channels;
+
+        double energy = 0.0;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            double* z = state_.data() + ch * 4;
+            double z1 = z[0], z2 = z[1], z3 = z[2], z4 = z[3];
+            double sum = 0.0;
+            float peak = 0.0f;
+            for (size_t i = 0; i < count; ++i) {
+                const float sample = x[i * channels + ch];
+                const double in = sample;
+                const double y = pb0 * in + z1;
+                z1 = pb1 * in - pa1 * y + z2;
+                z2 = pb2 * in - pa2 * y;
+                const double w = rb0 * y + z3;
+                z3 = rb1 * y - ra1 * w + z4;
+                z4 = rb2 * y - ra2 * w;
+                sum += w * w;
+                peak = std::max(peak, std::fabs(sample));
+            }
+            z[0] = z1;
+            z[1] = z2;
+            z[2] = z3;
+            z[3] = z4;
+            energy += static_cast<double>(weights_[ch]) * sum;
+            sample_peak_ = std::max(sample_peak_, peak);
+
+            if (true_peak_enabled_) {
+                const float* upsampled = oversampler_.upsample(ch, x + ch, count, channels);
+                const size_t samples = count * oversampler_.getFactor();
+                float true_peak = 0.0f;
+                for (size_t i = 0; i < samples; ++i) {
+                    true_peak = std::max(true_peak, std::fabs(upsampled[i]));
+                }
+                true_peak_ = std::max(true_peak_, true_peak);
+            }
+        }
+
+        sub_energy_ += energy;
+        sub_frames_ += count;
+        frames_ += count;
+        if (sub_frames_ == sub_block_frames_) {
+            finishSubBlock();
+        }
+        offset += count;
+    }
+}
+
+void LoudnessMeter::finishSubBlock() {
+    sub_history_[sub_count_ % kSubBlockHistory] = sub_energy_ / static_cast<double>(sub_frames_);
+    ++sub_count_;
+    sub_energy_ = 0.0;
+    sub_frames_ = 0;
+
+    const double absolute_gate = loudnessToEnergy(kAbsoluteGate);
+    if (sub_count_ >= kMomentarySubBlocks) {
+        const double energy = recentEnergy(kMomentarySubBlocks);
+        if (energy > absolute_gate) {
+            momentary_blocks_.push_back(energy);
+        }
+    }
+    if (sub_count_ >= kShortTermSubBlocks && (sub_count_ - kShortTermSubBlocks) % kShortTermHop == 0) {
+        const double energy = recentEnergy(kShortTermSubBlocks);
+        if (energy > absolute_gate) {
+            short_term_blocks_.push_back(energy);
+        }
+    }
+}
+
+double LoudnessMeter::recentEnergy(size_t count) const {
+    count = std::min(count, sub_count_);
+    if (count == 0) {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += sub_history_[(sub_count_ - 1 - i) % kSubBlockHistory];
+    }
+    return sum / static_cast<double>(count);
+}
+
+bool LoudnessMeter::merge(const LoudnessMeter& other) {
+    if (&other == this) {
+        return false;
+    }
+
+    momentary_blocks_.insert(momentary_blocks_.end(), other.momentary_blocks_.begin(), other.momentary_blocks_.end());
+    short_term_blocks_.insert(short_term_blocks_.end(), other.short_term_blocks_.begin(), other.short_term_blocks_.end());
+    sample_peak_ = std::max(sample_peak_, other.sample_peak_);
+    true_peak_ = std::max(true_peak_, other.true_peak_);
+    frames_ += other.frames_;
+    return true;
+}
+
+double LoudnessMeter::getMomentaryLoudness() const {
+    return energyToLoudness(recentEnergy(kMomentarySubBlocks));
+}
+
+double LoudnessMeter::getShortTermLoudness() const {
+    return energyToLoudness(recentEnergy(kShortTermSubBlocks));
+}
+
+double LoudnessMeter::getIntegratedLoudness() const {
+    // 绝对门限在入块时已应用；相对门限为绝对门限后平均响度以下10LU
+    size_t count = 0;
+    const double mean = gatedMean(momentary_blocks_, 0.0, count);
+    if (count == 0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    const double relative_gate = mean * std::pow(10.0, kRelativeGate / 10.0);
+    return energyToLoudness(gatedMean(momentary_blocks_, relative_gate, count));
+}
+
+double LoudnessMeter::getLoudnessRange() const {
+    size_t count = 0;
+    const double mean = gatedMean(short_term_blocks_, 0.0, count);
+    if (count == 0) {
+        return 0.0;
+    }
+
+    // 相对门限以上短时响度分布的10%到95%百分位之差（EBU Tech 3342）
+    const double relative_gate = mean * std::pow(10.0, kRangeRelativeGate / 10.0);
+    std::vector<double> loudness;
+    loudness.reserve(short_term_blocks_.size());
+    for (double energy : short_term_blocks_) {
+        if (energy > relative_gate) {
+            loudness.push_back(energyToLoudness(energy));
+        }
+    }
+    if (loudness.empty()) {
+        return 0.0;
+    }
+
+    std::sort(loudness.begin(), loudness.end());
+    const double last = static_cast<double>(loudness.size() - 1);
+    const double low = loudness[static_cast<size_t>(last * kRangeLow + 0.5)];
+    const double high = loudness[static_cast<size_t>(last * kRangeHigh + 0.5)];
+    return high - low;
+}
+
+float LoudnessMeter::getTruePeak() const {
+    return std::max(true_peak_, sample_peak_);
+}
+
+float LoudnessMeter::getSamplePeak() const {
+    return sample_peak_;
+}
+
+size_t LoudnessMeter::getFrameCount() const {
+    return frames_;
+}
+
+void LoudnessMeter::reset() {
+    std::fill(state_.begin(), state_.end(), 0.0);
+    std::fill(std::begin(sub_history_), std::end(sub_history_), 0.0);
+    sub_energy_ = 0.0;
+    sub_frames_ = 0;
+    sub_count_ = 0;
+    momentary_blocks_.clear();
+    short_term_blocks_.clear();
+    oversampler_.reset();
+    sample_peak_ = 0.0f;
+    true_peak_ = 0.0f;
+    frames_ = 0;
+}
+
+} // namespace core
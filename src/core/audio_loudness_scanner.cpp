@@ -0,0 +1,276 @@
+#include "core/audio_loudness_scanner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace core {
+
+namespace {
+
+// 每次读取的帧数
+const size_t kReadFrames = 4096;
+
+std::string formatValue(const char* format, double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), format, value);
+    return text;
+}
+
+} // namespace
+
+const char* const LoudnessScanner::kTrackGainKey = "REPLAYGAIN_TRACK_GAIN";
+const char* const LoudnessScanner::kTrackPeakKey = "REPLAYGAIN_TRACK_PEAK";
+const char* const LoudnessScanner::kAlbumGainKey = "REPLAYGAIN_ALBUM_GAIN";
+const char* const LoudnessScanner::kAlbumPeakKey = "REPLAYGAIN_ALBUM_PEAK";
+const char* const LoudnessScanner::kIntegratedKey = "R128_INTEGRATED_LOUDNESS";
+const char* const LoudnessScanner::kRangeKey = "R128_LOUDNESS_RANGE";
+
+// 工作线程的可复用状态
+struct LoudnessScanner::Worker {
+    std::unique_ptr<PcmSource> source;
+    LoudnessMeter meter;
+    std::vector<float> buffer;
+};
+
+LoudnessScanner::LoudnessScanner()
+    : pool_(nullptr), cache_(nullptr), true_peak_enabled_(true), progress_(0), cancelled_(false) {
+}
+
+void LoudnessScanner::setSourceFactory(SourceFactory factory) {
+    factory_ = std::move(factory);
+}
+
+void LoudnessScanner::setThreadPool(AudioThreadPool* pool) {
+    if (pool != background_pool_.get()) {
+        background_pool_.reset();
+    }
+    pool_ = pool;
+}
+
+void LoudnessScanner::setThreadCount(size_t num_threads) {
+    pool_ = nullptr;
+    background_pool_.reset();
+    if (num_threads > 0) {
+        background_pool_ = std::make_unique<AudioThreadPool>(num_threads, platform::ThreadRole::BACKGROUND);
+        pool_ = background_pool_.get();
+    }
+}
+
+void LoudnessScanner::setMetadataCache(MetadataCache* cache) {
+    cache_ = cache;
+}
+
+void LoudnessScanner::setTruePeakEnabled(bool enabled) {
+    true_peak_enabled_ = enabled;
+}
+
+size_t LoudnessScanner::scanLibrary(const std::vector<std::string>& paths, bool skip_cached) {
+    // 先筛掉已有结果的曲目，避免工作线程空转
+    std::vector<const std::string*> pending;
+    pending.reserve(paths.size());
+    for (const std::string& path : paths) {
+        if (!skip_cached || cache_ == nullptr || !cache_->contains(path, kTrackGainKey)) {
+            pending.push_back(&path);
+        }
+    }
+
+    progress_.store(paths.size() - pending.size(), std::memory_order_relaxed);
+    cancelled_.store(false, std::memory_order_relaxed);
+
+    std::atomic<size_t> analyzed(0);
+    runParallel(pending.size(), [this, &pending, &analyzed](Worker& worker, size_t index) {
+        const std::string& path = *pending[index];
+        if (analyzeFile(worker, path, worker.meter)) {
+            storeTrack(path, makeInfo(worker.meter));
+            analyzed.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    return analyzed.load(std::memory_order_relaxed);
+}
+
+bool LoudnessScanner::scanAlbum(const std::vector<std::string>& paths, LoudnessInfo* album) {
+    progress_.store(0, std::memory_order_relaxed);
+    cancelled_.store(false, std::memory_order_relaxed);
+
+    // 专辑需要各曲目的块能量，因此每首曲目使用独立的测量器
+    std::vector<LoudnessMeter> meters(paths.size());
+    std::vector<char> succeeded(paths.size(), 0);
+    runParallel(paths.size(), [this, &paths, &meters, &succeeded](Worker& worker, size_t index) {
+        if (analyzeFile(worker, paths[index], meters[index])) {
+            storeTrack(paths[index], makeInfo(meters[index]));
+            succeeded[index] = 1;
+        }
+    });
+
+    // 专辑响度按全部曲目的块统一门限计算（而非曲目响度的平均）
+    LoudnessMeter merged;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (succeeded[i]) {
+            merged.merge(meters[i]);
+        }
+    }
+
+    const LoudnessInfo info = makeInfo(merged);
+    if (album != nullptr) {
+        *album = info;
+    }
+    if (!info.valid) {
+        return false;
+    }
+
+    if (cache_ != nullptr) {
+        std::map<std::string, std::string> values;
+        values[kAlbumGainKey] = formatValue("%.2f dB", info.gain);
+        values[kAlbumPeakKey] = formatValue("%.6f", info.true_peak);
+        for (size_t i = 0; i < paths.size(); ++i) {
+            if (succeeded[i]) {
+                cache_->setAll(paths[i], values);
+            }
+        }
+    }
+    return true;
+}
+
+LoudnessInfo LoudnessScanner::analyzeDecoded(const std::string& path, const float* pcm, size_t frames, int sample_rate, int channels) {
+    LoudnessMeter meter;
+    if (pcm == nullptr || !meter.setFormat(sample_rate, channels)) {
+        return LoudnessInfo();
+    }
+
+    meter.setTruePeakEnabled(true_peak_enabled_);
+    meter.process(pcm, frames);
+
+    const LoudnessInfo info = makeInfo(meter);
+    if (info.valid) {
+        storeTrack(path, info);
+    }
+    return info;
+}
+
+size_t LoudnessScanner::getProgress() const {
+    return progress_.load(std::memory_order_relaxed);
+}
+
+void LoudnessScanner::cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool LoudnessScanner::lookup(const MetadataCache& cache, const std::string& path, bool album, float& gain_db, float& peak) {
+    std::string gain_text;
+    std::string peak_text;
+    const bool found = (album && cache.get(path, kAlbumGainKey, gain_text) && cache.get(path, kAlbumPeakKey, peak_text)) ||
+                       (cache.get(path, kTrackGainKey, gain_text) && cache.get(path, kTrackPeakKey, peak_text));
+    if (!found) {
+        return false;
+    }
+
+    gain_db = std::strtof(gain_text.c_str(), nullptr);
+    peak = std::strtof(peak_text.c_str(), nullptr);
+    return true;
+}
+
+void LoudnessScanner::runParallel(size_t count, const std::function<void(Worker&, size_t)>& task) {
+    // 每个执行者一份可复用状态，调用线程使用第0份
+    const size_t helper_count = pool_ != nullptr && count > 1 ? std::min(count - 1, pool_->getThreadCount()) : 0;
+    std::vector<Worker> workers(helper_count + 1);
+    if (factory_) {
+        for (Worker& worker : workers) {
+            worker.source = factory_();
+        }
+    }
+
+    // 认领并分析一首曲目，没有剩余曲目或已取消时返回false
+    std::atomic<size_t> next(0);
+    auto step = [this, count, &task, &next](Worker& worker) {
+        if (cancelled_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) {
+            return false;
+        }
+        task(worker, index);
+        progress_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    // 辅助任务每次只分析一首曲目，完成后重新提交自身（后台分析使用低优先级）：
+    // 工作线程在曲目之间回到调度器，高优先级的扇出任务不会被整个扫描挡住
+    TaskGroup helpers(pool_, TaskPriority::LOW);
+    std::function<void(size_t)> helper = [&step, &workers, &helpers, &helper](size_t slot) {
+        if (step(workers[slot])) {
+            helpers.run([&helper, slot] { helper(slot); });
+        }
+    };
+    for (size_t slot = 1; slot <= helper_count; ++slot) {
+        helpers.run([&helper, slot] { helper(slot); });
+    }
+
+    while (step(workers[0])) {
+    }
+    helpers.wait();
+}
+
+bool LoudnessScanner::analyzeFile(Worker& worker, const std::string& path, LoudnessMeter& meter) {
+    if (!worker.source) {
+        return false;
+    }
+
+    int sample_rate = 0;
+    int channels = 0;
+    if (!worker.source->open(path, sample_rate, channels)) {
+        return false;
+    }
+
+    // 格式不变时只清空测量，避免逐曲目重新分配
+    bool ready = true;
+    if (meter.getSampleRate() != sample_rate || meter.getChannels() != channels) {
+        ready = meter.setFormat(sample_rate, channels);
+    } else {
+        meter.reset();
+    }
+
+    if (ready) {
+        meter.setTruePeakEnabled(true_peak_enabled_);
+        const size_t samples = kReadFrames * static_cast<size_t>(channels);
+        if (worker.buffer.size() < samples) {
+            worker.buffer.resize(samples);
+        }
+
+        size_t frames = 0;
+        while (!cancelled_.load(std::memory_order_relaxed) &&
+               (frames = worker.source->read(worker.buffer.data(), kReadFrames)) > 0) {
+            meter.process(worker.buffer.data(), std::min(frames, kReadFrames));
+        }
+        ready = !cancelled_.load(std::memory_order_relaxed) && meter.getFrameCount() > 0;
+    }
+
+    worker.source->close();
+    return ready;
+}
+
+LoudnessInfo LoudnessScanner::makeInfo(const LoudnessMeter& meter) {
+    LoudnessInfo info;
+    info.integrated = meter.getIntegratedLoudness();
+    info.range = meter.getLoudnessRange();
+    info.true_peak = meter.getTruePeak();
+    info.valid = std::isfinite(info.integrated);
+    info.gain = info.valid ? static_cast<float>(kReferenceLoudness - info.integrated) : 0.0f;
+    return info;
+}
+
+void LoudnessScanner::storeTrack(const std::string& path, const LoudnessInfo& info) {
+    if (cache_ == nullptr || !info.valid) {
+        return;
+    }
+
+    std::map<std::string, std::string> values;
+    values[kTrackGainKey] = formatValue("%.2f dB", info.gain);
+    values[kTrackPeakKey] = formatValue("%.6f", info.true_peak);
+    values[kIntegratedKey] = formatValue("%.2f", info.integrated);
+    values[kRangeKey] = formatValue("%.2f", info.range);
+    cache_->setAll(path, values);
+}
+
+} // namespace core
@@ -0,0 +1,165 @@
+#include "core/audio_mid_side.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace core {
+namespace stereo {
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+} // namespace
+
+StereoMatrix makeMidSideMatrix(float mid_gain, float side_gain, float balance, float mix) {
+    // M = (L + R) / 2，S = (L - R) / 2；L' = m * M + s * S，R' = m * M - s * S
+    const float direct = 0.5f * (mid_gain + side_gain);
+    const float cross = 0.5f * (mid_gain - side_gain);
+
+    // 平衡：衰减另一侧，居中时两侧均为1
+    const float left = std::min(1.0f, 1.0f - balance);
+    const float right = std::min(1.0f, 1.0f + balance);
+
+    StereoMatrix matrix;
+    matrix.ll = mix * left * direct + (1.0f - mix);
+    matrix.rl = mix * left * cross;
+    matrix.lr = mix * right * cross;
+    matrix.rr = mix * right * direct + (1.0f - mix);
+    return matrix;
+}
+
+void applyStereoMatrix(float* data, size_t frames, const StereoMatrix& from, const StereoMatrix& to) {
+    if (frames == 0) {
+        return;
+    }
+
+    if (from == to) {
+        const float ll = to.ll, rl = to.rl, lr = to.lr, rr = to.rr;
+        for (size_t i = 0; i < frames; ++i) {
+            const float l = data[2 * i];
+            const float r = data[2 * i + 1];
+            data[2 * i] = ll * l + rl * r;
+            data[2 * i + 1] = lr * l + rr * r;
+        }
+        return;
+    }
+
+    // 系数按帧线性插值，块末尾到达目标值
+    const float scale = 1.0f / static_cast<float>(frames);
+    const float dll = (to.ll - from.ll) * scale;
+    const float drl = (to.rl - from.rl) * scale;
+    const float dlr = (to.lr - from.lr) * scale;
+    const float drr = (to.rr - from.rr) * scale;
+    for (size_t i = 0; i < frames; ++i) {
+        const float t = static_cast<float>(i + 1);
+        const float l = data[2 * i];
+        const float r = data[2 * i + 1];
+        data[2 * i] = (from.ll + dll * t) * l + (from.rl + drl * t) * r;
+        data[2 * i + 1] = (from.lr + dlr * t) * l + (from.rr + drr * t) * r;
+    }
+}
+
+// BassMonoFilter implementation
+void BassMonoFilter::setCutoff(float cutoff, int sample_rate) {
+    enabled_ = cutoff > 0.0f && sample_rate > 0;
+    if (!enabled_) {
+        return;
+    }
+
+    // 二阶巴特沃斯高通（双线性变换），两级级联为4阶Linkwitz-Riley
+    const float nyquist_limit = 0.45f * static_cast<float>(sample_rate);
+    const float k = std::tan(kPi * std::min(cutoff, nyquist_limit) / static_cast<float>(sample_rate));
+    const float norm = 1.0f / (1.0f + std::sqrt(2.0f) * k + k * k);
+    b0_ = norm;
+    b1_ = -2.0f * norm;
+    b2_ = norm;
+    a1_ = 2.0f * (k * k - 1.0f) * norm;
+    a2_ = (1.0f - std::sqrt(2.0f) * k + k * k) * norm;
+}
+
+void BassMonoFilter::process(float* data, size_t frames, float amount) {
+    if (!enabled_ || amount <= 0.0f) {
+        return;
+    }
+
+    // 递归滤波只作用于侧边信号一路：侧边信号替换为其高通部分，
+    // 被去除的低频部分 side - high 从左右声道中扣除
+    float s1 = state_[0], s2 = state_[1], s3 = state_[2], s4 = state_[3];
+    for (size_t i = 0; i < frames; ++i) {
+        const float side = 0.5f * (data[2 * i] - data[2 * i + 1]);
+
+        const float y1 = b0_ * side + s1;
+        s1 = b1_ * side - a1_ * y1 + s2;
+        s2 = b2_ * side - a2_ * y1;
+        const float y2 = b0_ * y1 + s3;
+        s3 = b1_ * y1 - a1_ * y2 + s4;
+        s4 = b2_ * y1 - a2_ * y2;
+
+        const float removed = amount * (side - y2);
+        data[2 * i] -= removed;
+        data[2 * i + 1] += removed;
+    }
+    state_[0] = s1;
+    state_[1] = s2;
+    state_[2] = s3;
+    state_[3] = s4;
+}
+
+void BassMonoFilter::reset() {
+    std::fill(std::begin(state_), std::end(state_), 0.0f);
+}
+
+// HaasDecorrelator implementation
+void HaasDecorrelator::prepare(float max_delay_ms, int sample_rate) {
+    // 缓冲区为最大延迟的两倍，使每段读写区间互不重叠
+    const size_t max_delay = std::max<size_t>(
+        1, static_cast<size_t>(std::ceil(max_delay_ms * 0.001f * static_cast<float>(sample_rate))));
+    history_.assign(2 * max_delay, 0.0f);
+    delay_ = std::min(delay_, max_delay);
+    write_index_ = 0;
+}
+
+void HaasDecorrelator::setDelay(float delay_ms, int sample_rate) {
+    const size_t max_delay = std::max<size_t>(1, history_.size() / 2);
+    const float frames = std::max(0.0f, delay_ms * 0.001f * static_cast<float>(sample_rate));
+    delay_ = std::clamp<size_t>(static_cast<size_t>(std::lround(frames)), 1, max_delay);
+}
+
+void HaasDecorrelator::process(float* data, size_t frames, float amount) {
+    if (history_.empty() || amount == 0.0f) {
+        return;
+    }
+
+    // 按连续段处理：段长不超过延迟，读（write - delay）与写区间不重叠，也不跨越缓冲区末尾，
+    // 段内循环无依赖，可向量化
+    const size_t size = history_.size();
+    size_t offset = 0;
+    while (offset < frames) {
+        const size_t read_index = (write_index_ + size - delay_) % size;
+        const size_t count = std::min({frames - offset, delay_, size - read_index, size - write_index_});
+        const float* delayed = history_.data() + read_index;
+        float* mid = history_.data() + write_index_;
+        float* frame = data + 2 * offset;
+
+        for (size_t i = 0; i < count; ++i) {
+            const float l = frame[2 * i];
+            const float r = frame[2 * i + 1];
+            const float d = amount * delayed[i];
+            mid[i] = 0.5f * (l + r);
+            frame[2 * i] = l + d;
+            frame[2 * i + 1] = r - d;
+        }
+
+        write_index_ = (write_index_ + count) % size;
+        offset += count;
+    }
+}
+
+void HaasDecorrelator::reset() {
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    write_index_ = 0;
+}
+
+} // namespace stereo
+} // namespace core
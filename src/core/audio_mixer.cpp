@@ -1,11 +1,130 @@
 #include "core/audio_mixer.h"
+#include "audio/simd/mix_kernels.h"
 #include <iostream>
 #include <algorithm>
 
 namespace core {
 
-AudioMixer::AudioMixer() : initialized_(false) {
-    // 初始化音频混音器
+namespace {
+
+// 句柄：高16位为槽位代数，低16位为槽位序号
+const size_t kMaxTracks = 0x10000;
+
+inline AudioMixer::TrackHandle makeHandle(uint32_t index, uint16_t generation) {
+    return (static_cast<uint32_t>(generation) << 16) | index;
+}
+
+inline float clampVolume(float volume) {
+    // 限制音量范围在0.0到1.0之间
+    return (volume < 0.0f) ? 0.0f : (volume > 1.0f) ? 1.0f : volume;
+}
+
+inline uint16_t nextGeneration(uint16_t generation) {
+    // 代数跳过0，保证句柄永远不等于无效句柄
+    return static_cast<uint16_t>(generation + 1 == 0x10000 ? 1 : generation + 1);
+}
+
+// 声道数对应的默认布局
+bool layoutForChannels(size_t channels, audio::ChannelLayout& layout) {
+    switch (channels) {
+        case 1: layout = audio::ChannelLayout::MONO; return true;
+        case 2: layout = audio::ChannelLayout::STEREO; return true;
+        case 4: layout = audio::ChannelLayout::QUAD; return true;
+        case 6: layout = audio::ChannelLayout::FIVE_POINT_ONE; return true;
+        case 8: layout = audio::ChannelLayout::SEVEN_POINT_ONE; return true;
+        default: return false;
+    }
+}
+
+// 以gain累加read帧；增益变化时按完整块长frames做线性斜坡，来源提前结束时只累加已读取的部分
+inline void accumulateGain(const audio::simd::MixKernels& kernels, const float* input, float* output,
+                           size_t read, size_t frames, size_t channels, float& gain, float target) {
+    if (gain == target) {
+        if (target != 0.0f) {
+            kernels.accumulate(input, output, read * channels, target);
+        }
+    } else {
+        const float step = (target - gain) / static_cast<float>(frames);
+        kernels.accumulateRamp(input, output, read, channels, gain, step);
+        gain = target;
+    }
+}
+
+} // namespace
+
+BufferMixerSource::BufferMixerSource(std::shared_ptr<const AudioBuffer> buffer, size_t channels)
+    : buffer_(std::move(buffer)), channels_(channels == 0 ? 1 : channels), position_(0) {
+    // 记录构造时的交错声道数，混音器之后改变声道数时按此转换
+    format_.channels = static_cast<int>(channels_);
+}
+
+BufferMixerSource::BufferMixerSource(std::shared_ptr<const AudioBuffer> buffer, const AudioFormat& format)
+    : buffer_(std::move(buffer)), format_(format),
+      channels_(format.channels > 0 ? static_cast<size_t>(format.channels) : 1), position_(0) {
+    format_.channels = static_cast<int>(channels_);
+}
+
+size_t BufferMixerSource::read(float* buffer, size_t frames) {
+    if (!buffer_) {
+        return 0;
+    }
+
+    // 缓冲区末尾不足一帧的样本补零
+    const size_t available = buffer_->size() - position_;
+    const size_t samples = std::min(frames * channels_, available);
+    const float* data = buffer_->data() + position_;
+    std::copy(data, data + samples, buffer);
+    const size_t read_frames = (samples + channels_ - 1) / channels_;
+    std::fill(buffer + samples, buffer + read_frames * channels_, 0.0f);
+    position_ += samples;
+    return read_frames;
+}
+
+size_t BufferMixerSource::remainingFrames() const {
+    if (!buffer_) {
+        return 0;
+    }
+    return (buffer_->size() - position_ + channels_ - 1) / channels_;
+}
+
+AudioFormat BufferMixerSource::getFormat() const {
+    return format_;
+}
+
+void AudioMixer::CompensationDelay::setLength(size_t frames, size_t channels) {
+    if (ring.size() != frames * channels) {
+        ring.assign(frames * channels, 0.0f);
+        position = 0;
+    }
+}
+
+void AudioMixer::CompensationDelay::process(float* samples, size_t count) {
+    // 与环形缓冲区逐段交换：写入新样本的同时取出ring.size()个样本之前写入的样本
+    const size_t size = ring.size();
+    size_t done = 0;
+    while (size != 0 && done < count) {
+        const size_t segment = std::min(count - done, size - position);
+        std::swap_ranges(samples + done, samples + done + segment, ring.data() + position);
+        done += segment;
+        position += segment;
+        if (position == size) {
+            position = 0;
+        }
+    }
+}
+
+AudioMixer::AudioMixer()
+    : initialized_(false), sample_rate_(44100), channels_(2), pool_(nullptr) {
+    // 主总线占用槽位0，始终存在
+    buses_.push_back(BusSlot{Bus{}, 1, true});
+    Bus& master = buses_[0].bus;
+    master.output = 0;
+    master.volume = 1.0f;
+    master.mute = false;
+    master.gain = 1.0f;
+    master.latency = 0;
+    prepareBus(master);
+    compileBuses();
 }
 
 AudioMixer::~AudioMixer() {
@@ -15,9 +134,9 @@ AudioMixer::~AudioMixer() {
 
 bool AudioMixer::initialize() {
     std::cout << "Initializing audio mixer" << std::endl;
-    
+
     // 在实际实现中，这里会初始化混音器
-    
+
     initialized_ = true;
     return true;
 }
@@ -25,24 +144,573 @@ bool AudioMixer::initialize() {
 void AudioMixer::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio mixer" << std::endl;
-        
+
         // 在实际实现中，这里会关闭混音器
-        
+
         clear();
+        for (uint32_t index = 1; index < buses_.size(); ++index) {
+            if (buses_[index].used) {
+                removeBus(makeHandle(index, buses_[index].generation));
+            }
+        }
         initialized_ = false;
     }
 }
 
+bool AudioMixer::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    std::cout << "Setting mixer format - Sample rate: " << sample_rate
+              << ", Channels: " << channels << std::endl;
+
+    sample_rate_ = sample_rate;
+    channels_ = static_cast<size_t>(channels);
+    for (auto& slot : buses_) {
+        if (slot.used) {
+            prepareBus(slot.bus);
+        }
+    }
+    for (uint32_t index : active_) {
+        Track& track = slots_[index].track;
+        if (!prepareTrack(track)) {
+            // 新格式下无法转换的轨道静音结束
+            std::cout << "Mixer track " << index << " cannot be converted to the new format" << std::endl;
+            track.finished = true;
+        }
+    }
+    updateLatencies();
+    return true;
+}
+
+AudioMixer::TrackHandle AudioMixer::addTrack(std::unique_ptr<MixerSource> source, float volume) {
+    if (!initialized_ || !source) {
+        return kInvalidTrack;
+    }
+
+    const float clamped = clampVolume(volume);
+    Track track;
+    track.source = std::move(source);
+    track.volume = clamped;
+    track.mute = false;
+    track.gain = clamped;
+    track.finished = false;
+    track.bus = 0;
+    track.channels = channels_;
+    track.latency = 0;
+    track.tail = 0;
+    track.source_done = false;
+    if (!prepareTrack(track)) {
+        return kInvalidTrack;
+    }
+
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        if (slots_.size() >= kMaxTracks) {
+            return kInvalidTrack;
+        }
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(Slot{Track{}, 1, false});
+    }
+
+    Slot& slot = slots_[index];
+    slot.track = std::move(track);
+    slot.used = true;
+    active_.push_back(index);
+    buses_[0].bus.tracks.push_back(index);
+    updateLatencies();
+    return makeHandle(index, slot.generation);
+}
+
+AudioMixer::TrackHandle AudioMixer::addTrack(std::shared_ptr<const AudioBuffer> buffer, float volume) {
+    if (!buffer) {
+        return kInvalidTrack;
+    }
+    return addTrack(std::make_unique<BufferMixerSource>(std::move(buffer), channels_), volume);
+}
+
+bool AudioMixer::removeTrack(TrackHandle track) {
+    if (!initialized_ || findSlot(track) == nullptr) {
+        return false;
+    }
+
+    const uint32_t index = track & 0xFFFFu;
+    Slot& slot = slots_[index];
+    if (!slot.track.name.empty()) {
+        names_.erase(slot.track.name);
+    }
+    detachTrack(index);
+    slot.track = Track{};
+    slot.used = false;
+    slot.generation = nextGeneration(slot.generation);
+    free_slots_.push_back(index);
+
+    // 混音顺序无关，与末尾交换后删除
+    auto it = std::find(active_.begin(), active_.end(), index);
+    if (it != active_.end()) {
+        *it = active_.back();
+        active_.pop_back();
+    }
+    updateLatencies();
+    return true;
+}
+
+bool AudioMixer::setTrackVolume(TrackHandle track, float volume) {
+    Track* entry = findSlot(track);
+    if (!initialized_ || entry == nullptr) {
+        return false;
+    }
+
+    // 下一个块内过渡到新音量
+    entry->volume = clampVolume(volume);
+    return true;
+}
+
+float AudioMixer::getTrackVolume(TrackHandle track) const {
+    const Track* entry = findSlot(track);
+    return entry != nullptr ? entry->volume : 0.0f;
+}
+
+bool AudioMixer::setTrackMute(TrackHandle track, bool mute) {
+    Track* entry = findSlot(track);
+    if (!initialized_ || entry == nullptr) {
+        return false;
+    }
+
+    entry->mute = mute;
+    return true;
+}
+
+bool AudioMixer::getTrackMute(TrackHandle track) const {
+    const Track* entry = findSlot(track);
+    return entry != nullptr && entry->mute;
+}
+
+bool AudioMixer::isTrackFinished(TrackHandle track) const {
+    const Track* entry = findSlot(track);
+    return entry == nullptr || entry->finished;
+}
+
+bool AudioMixer::setTrackEffects(TrackHandle track, std::unique_ptr<AudioEffectsChain> effects) {
+    Track* entry = findSlot(track);
+    if (!initialized_ || entry == nullptr) {
+        return false;
+    }
+
+    std::cout << "Setting effects chain on mixer track: " << (track & 0xFFFFu) << std::endl;
+
+    if (effects) {
+        effects->setFormat(sample_rate_, static_cast<int>(channels_));
+        effects->prepare(kBlockFrames);
+    }
+    entry->effects = std::move(effects);
+    updateLatencies();
+    return true;
+}
+
+AudioEffectsChain* AudioMixer::getTrackEffects(TrackHandle track) const {
+    const Track* entry = findSlot(track);
+    return entry != nullptr ? entry->effects.get() : nullptr;
+}
+
+size_t AudioMixer::getTrackLatency(TrackHandle track) const {
+    const Track* entry = findSlot(track);
+    return entry != nullptr ? entry->latency : 0;
+}
+
+bool AudioMixer::setTrackBus(TrackHandle track, BusHandle bus) {
+    Track* entry = findSlot(track);
+    const int index = findBus(bus);
+    if (!initialized_ || entry == nullptr || index < 0) {
+        return false;
+    }
+
+    detachTrack(track & 0xFFFFu);
+    entry->bus = static_cast<uint32_t>(index);
+    buses_[index].bus.tracks.push_back(track & 0xFFFFu);
+    updateLatencies();
+    return true;
+}
+
+AudioMixer::BusHandle AudioMixer::getTrackBus(TrackHandle track) const {
+    const Track* entry = findSlot(track);
+    return entry != nullptr ? makeHandle(entry->bus, buses_[entry->bus].generation) : kInvalidBus;
+}
+
+AudioMixer::BusHandle AudioMixer::addBus(BusHandle output, float volume) {
+    const int parent = findBus(output);
+    if (!initialized_ || parent < 0) {
+        return kInvalidBus;
+    }
+
+    uint32_t index;
+    if (!free_buses_.empty()) {
+        index = free_buses_.back();
+        free_buses_.pop_back();
+    } else {
+        if (buses_.size() >= kMaxTracks) {
+            return kInvalidBus;
+        }
+        index = static_cast<uint32_t>(buses_.size());
+        buses_.push_back(BusSlot{Bus{}, 1, false});
+    }
+
+    std::cout << "Adding mixer bus: " << index << std::endl;
+
+    BusSlot& slot = buses_[index];
+    const float clamped = clampVolume(volume);
+    slot.bus = Bus{};
+    slot.bus.output = static_cast<uint32_t>(parent);
+    slot.bus.volume = clamped;
+    slot.bus.mute = false;
+    slot.bus.gain = clamped;
+    slot.bus.latency = 0;
+    slot.used = true;
+    prepareBus(slot.bus);
+
+    // 新总线没有输入，不会形成环路
+    compileBuses();
+    return makeHandle(index, slot.generation);
+}
+
+bool AudioMixer::removeBus(BusHandle bus) {
+    const int found = findBus(bus);
+    if (!initialized_ || found <= 0) {
+        return false;
+    }
+
+    std::cout << "Removing mixer bus: " << found << std::endl;
+
+    const uint32_t index = static_cast<uint32_t>(found);
+    Bus& removed = buses_[index].bus;
+    const uint32_t parent = removed.output;
+
+    // 轨道与子总线改为输出到上一级总线（路径收缩，不会形成环路）
+    for (uint32_t track : removed.tracks) {
+        slots_[track].track.bus = parent;
+        buses_[parent].bus.tracks.push_back(track);
+    }
+    for (auto& slot : buses_) {
+        if (!slot.used) {
+            continue;
+        }
+        if (slot.bus.output == index) {
+            slot.bus.output = parent;
+        }
+        auto& sends = slot.bus.sends;
+        sends.erase(std::remove_if(sends.begin(), sends.end(),
+                                   [index](const Send& send) { return send.destination == index; }),
+                    sends.end());
+    }
+
+    BusSlot& slot = buses_[index];
+    slot.bus = Bus{};
+    slot.used = false;
+    slot.generation = nextGeneration(slot.generation);
+    free_buses_.push_back(index);
+    return compileBuses();
+}
+
+bool AudioMixer::setBusOutput(BusHandle bus, BusHandle output) {
+    const int index = findBus(bus);
+    const int parent = findBus(output);
+    if (!initialized_ || index <= 0 || parent < 0 || index == parent) {
+        return false;
+    }
+
+    Bus& entry = buses_[index].bus;
+    const uint32_t previous = entry.output;
+    entry.output = static_cast<uint32_t>(parent);
+    if (!compileBuses()) {
+        // 形成环路，撤销路由
+        entry.output = previous;
+        return false;
+    }
+    return true;
+}
+
+AudioMixer::BusHandle AudioMixer::getBusOutput(BusHandle bus) const {
+    const int index = findBus(bus);
+    if (index <= 0) {
+        return kInvalidBus;
+    }
+    const uint32_t output = buses_[index].bus.output;
+    return makeHandle(output, buses_[output].generation);
+}
+
+bool AudioMixer::setBusVolume(BusHandle bus, float volume) {
+    const int index = findBus(bus);
+    if (!initialized_ || index < 0) {
+        return false;
+    }
+
+    // 下一个块内过渡到新音量
+    buses_[index].bus.volume = clampVolume(volume);
+    return true;
+}
+
+float AudioMixer::getBusVolume(BusHandle bus) const {
+    const int index = findBus(bus);
+    return index >= 0 ? buses_[index].bus.volume : 0.0f;
+}
+
+bool AudioMixer::setBusMute(BusHandle bus, bool mute) {
+    const int index = findBus(bus);
+    if (!initialized_ || index < 0) {
+        return false;
+    }
+
+    buses_[index].bus.mute = mute;
+    return true;
+}
+
+bool AudioMixer::getBusMute(BusHandle bus) const {
+    const int index = findBus(bus);
+    return index >= 0 && buses_[index].bus.mute;
+}
+
+bool AudioMixer::setBusEffects(BusHandle bus, std::unique_ptr<AudioEffectsChain> effects) {
+    const int index = findBus(bus);
+    if (!initialized_ || index < 0) {
+        return false;
+    }
+
+    std::cout << "Setting effects chain on mixer bus: " << index << std::endl;
+
+    Bus& entry = buses_[index].bus;
+    entry.effects = std::move(effects);
+    prepareBus(entry);
+    updateLatencies();
+    return true;
+}
+
+AudioEffectsChain* AudioMixer::getBusEffects(BusHandle bus) const {
+    const int index = findBus(bus);
+    return index >= 0 ? buses_[index].bus.effects.get() : nullptr;
+}
+
+bool AudioMixer::setBusSend(BusHandle source, BusHandle destination, float gain) {
+    const int from = findBus(source);
+    const int to = findBus(destination);
+    if (!initialized_ || from < 0 || to < 0 || from == to) {
+        return false;
+    }
+
+    auto& sends = buses_[from].bus.sends;
+    for (auto& send : sends) {
+        if (send.destination == static_cast<uint32_t>(to)) {
+            send.gain = clampVolume(gain);
+            return true;
+        }
+    }
+
+    // 新发送从0开始过渡，避免在播放中产生咔嗒声
+    sends.push_back(Send{static_cast<uint32_t>(to), clampVolume(gain), 0.0f});
+    if (!compileBuses()) {
+        // 形成环路，撤销发送
+        sends.pop_back();
+        return false;
+    }
+    return true;
+}
+
+bool AudioMixer::removeBusSend(BusHandle source, BusHandle destination) {
+    const int from = findBus(source);
+    const int to = findBus(destination);
+    if (!initialized_ || from < 0 || to < 0) {
+        return false;
+    }
+
+    auto& sends = buses_[from].bus.sends;
+    const auto it = std::find_if(sends.begin(), sends.end(),
+                                 [to](const Send& send) { return send.destination == static_cast<uint32_t>(to); });
+    if (it == sends.end()) {
+        return false;
+    }
+
+    sends.erase(it);
+    return compileBuses();
+}
+
+size_t AudioMixer::getBusLatency(BusHandle bus) const {
+    const int index = findBus(bus);
+    return index >= 0 ? buses_[index].bus.latency : 0;
+}
+
+size_t AudioMixer::getLatency() const {
+    return buses_[0].bus.latency;
+}
+
+void AudioMixer::updateLatencies() {
+    // 按拓扑层从下往上：各路输入延迟到本总线的最大输入延迟
+    for (const auto& level : bus_levels_) {
+        for (uint32_t id : level) {
+            Bus& bus = buses_[id].bus;
+            size_t aligned = 0;
+            for (uint32_t index : bus.tracks) {
+                Track& track = slots_[index].track;
+                track.latency = (track.resampler ? track.resampler->getLatency() : 0) +
+                                (track.effects ? track.effects->getLatency() : 0);
+                aligned = std::max(aligned, track.latency);
+            }
+            for (const BusInput& input : bus.inputs) {
+                aligned = std::max(aligned, buses_[input.source].bus.latency);
+            }
+
+            for (uint32_t index : bus.tracks) {
+                Track& track = slots_[index].track;
+                track.delay.setLength(aligned - track.latency, channels_);
+                if (!track.source_done) {
+                    track.tail = aligned;
+                }
+            }
+            for (BusInput& input : bus.inputs) {
+                input.delay.setLength(aligned - buses_[input.source].bus.latency, channels_);
+            }
+            bus.latency = aligned + (bus.effects ? bus.effects->getLatency() : 0);
+        }
+    }
+}
+
+size_t AudioMixer::getBusCount() const {
+    return static_cast<size_t>(std::count_if(buses_.begin(), buses_.end(),
+                                             [](const BusSlot& slot) { return slot.used; }));
+}
+
+size_t AudioMixer::getBusLevelCount() const {
+    return bus_levels_.size();
+}
+
+void AudioMixer::setThreadPool(AudioThreadPool* pool) {
+    pool_ = pool;
+}
+
+bool AudioMixer::mix(AudioView output) {
+    if (!initialized_ || output.channels() != channels_) {
+        return false;
+    }
+
+    float* data = output.data();
+    const size_t frames = output.frames();
+    for (size_t offset = 0; offset < frames; offset += kBlockFrames) {
+        const size_t count = std::min(kBlockFrames, frames - offset);
+        float* block = data + offset * channels_;
+        std::fill(block, block + count * channels_, 0.0f);
+        mixBlock(block, count);
+    }
+    return true;
+}
+
+void AudioMixer::mixBlock(float* output, size_t frames) {
+    // 主总线单独为最后一层，前面各层渲染完成后它的输入均已就绪
+    for (size_t level = 0; level < bus_levels_.size(); ++level) {
+        runBusLevel(level, frames);
+    }
+
+    // 主总线推子
+    Bus& master = buses_[0].bus;
+    const float target = master.mute ? 0.0f : master.volume;
+    accumulateGain(audio::simd::getMixKernels(), master.buffer.data(), output,
+                   frames, frames, channels_, master.gain, target);
+}
+
+void AudioMixer::renderBus(uint32_t index, size_t frames) {
+    const audio::simd::MixKernels& kernels = audio::simd::getMixKernels();
+    Bus& bus = buses_[index].bus;
+    float* out = bus.buffer.data();
+    float* pull = bus.pull.data();
+    std::fill(out, out + frames * channels_, 0.0f);
+
+    for (uint32_t track_index : bus.tracks) {
+        Track& track = slots_[track_index].track;
+        if (track.finished) {
+            continue;
+        }
+
+        // 静音的轨道照常拉取，保持与其他轨道同步；来源结束后再输出延迟尾部
+        const size_t read = readTrack(track, pull, frames);
+        size_t produced = read;
+        if (read < frames) {
+            const size_t extra = std::min(frames - read, track.tail);
+            track.tail -= extra;
+            produced += extra;
+            if (produced < frames) {
+                track.finished = true;
+            }
+        }
+
+        if (track.effects) {
+            track.effects->process(AudioView(pull, frames, channels_));
+        }
+        track.delay.process(pull, frames * channels_);
+
+        const float target = track.mute ? 0.0f : track.volume;
+        accumulateGain(kernels, pull, out, produced, frames, channels_, track.gain, target);
+    }
+
+    // 下层总线已在前面的层中渲染完成；每路输入的增益状态只由本总线更新
+    for (BusInput& input : bus.inputs) {
+        Bus& source = buses_[input.source].bus;
+        const float fader = source.mute ? 0.0f : source.volume;
+
+        // 需要延迟补偿的输入先复制到拉取缓冲区（来源输出可能还被其他总线读取）
+        const float* samples = source.buffer.data();
+        if (!input.delay.ring.empty()) {
+            std::copy(samples, samples + frames * channels_, pull);
+            input.delay.process(pull, frames * channels_);
+            samples = pull;
+        }
+
+        if (input.send < 0) {
+            accumulateGain(kernels, samples, out, frames, frames, channels_, source.gain, fader);
+        } else {
+            Send& send = source.sends[static_cast<size_t>(input.send)];
+            accumulateGain(kernels, samples, out, frames, frames, channels_,
+                           send.current, fader * send.gain);
+        }
+    }
+
+    if (bus.effects) {
+        bus.effects->process(AudioView(out, frames, channels_));
+    }
+}
+
+void AudioMixer::runBusLevel(size_t level, size_t frames) {
+    const std::vector<uint32_t>& buses = bus_levels_[level];
+
+    // 单总线层或无线程池时在调用线程上串行渲染
+    if (pool_ == nullptr || pool_->getThreadCount() == 0 || buses.size() < 2) {
+        for (uint32_t index : buses) {
+            renderBus(index, frames);
+        }
+        return;
+    }
+
+    // 每条总线为一块：调用线程参与渲染，等待其余总线时帮忙执行线程池中的高优先级任务
+    pool_->parallelFor(0, buses.size(), 1, [this, &buses, frames](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            renderBus(buses[i], frames);
+        }
+    }, TaskPriority::HIGH);
+}
+
 bool AudioMixer::addTrack(const std::string& name, const AudioBuffer& buffer) {
-    if (!initialized_) {
+    if (!initialized_ || names_.count(name) != 0) {
         return false;
     }
-    
+
     std::cout << "Adding audio track: " << name << std::endl;
-    
-    // 在实际实现中，这里会添加音频轨道
-    
-    tracks_.emplace_back(name, buffer);
+
+    const TrackHandle track = addTrack(std::make_shared<const AudioBuffer>(buffer));
+    if (track == kInvalidTrack) {
+        return false;
+    }
+    slots_[track & 0xFFFFu].track.name = name;
+    names_[name] = track;
     return true;
 }
 
@@ -50,156 +718,272 @@ bool AudioMixer::removeTrack(const std::string& name) {
     if (!initialized_) {
         return false;
     }
-    
+
     std::cout << "Removing audio track: " << name << std::endl;
-    
-    // 在实际实现中，这里会移除音频轨道
-    
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                          [&name](const Track& track) {
-                              return track.name == name;
-                          });
-    
-    if (it != tracks_.end()) {
-        tracks_.erase(it);
-        return true;
-    }
-    
-    return false;
+
+    return removeTrack(findTrack(name));
 }
 
 bool AudioMixer::setTrackVolume(const std::string& name, float volume) {
     if (!initialized_) {
         return false;
     }
-    
-    // 限制音量范围在0.0到1.0之间
-    volume = (volume < 0.0f) ? 0.0f : (volume > 1.0f) ? 1.0f : volume;
-    
-    std::cout << "Setting track " << name << " volume to: " << volume << std::endl;
-    
-    // 在实际实现中，这里会设置轨道音量
-    
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                          [&name](const Track& track) {
-                              return track.name == name;
-                          });
-    
-    if (it != tracks_.end()) {
-        it->volume = volume;
-        return true;
-    }
-    
-    return false;
+
+    std::cout << "Setting track " << name << " volume to: " << clampVolume(volume) << std::endl;
+
+    return setTrackVolume(findTrack(name), volume);
 }
 
 float AudioMixer::getTrackVolume(const std::string& name) const {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                          [&name](const Track& track) {
-                              return track.name == name;
-                          });
-    
-    if (it != tracks_.end()) {
-        return it->volume;
-    }
-    
-    return 0.0f;
+    return getTrackVolume(findTrack(name));
 }
 
 bool AudioMixer::setTrackMute(const std::string& name, bool mute) {
     if (!initialized_) {
         return false;
     }
-    
+
     std::cout << "Setting track " << name << " mute to: " << (mute ? "true" : "false") << std::endl;
-    
-    // 在实际实现中，这里会设置轨道静音状态
-    
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                          [&name](const Track& track) {
-                              return track.name == name;
-                          });
-    
-    if (it != tracks_.end()) {
-        it->mute = mute;
-        return true;
-    }
-    
-    return false;
+
+    return setTrackMute(findTrack(name), mute);
 }
 
 bool AudioMixer::getTrackMute(const std::string& name) const {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                          [&name](const Track& track) {
-                              return track.name == name;
-                          });
-    
-    if (it != tracks_.end()) {
-        return it->mute;
-    }
-    
-    return false;
+    return getTrackMute(findTrack(name));
+}
+
+AudioMixer::TrackHandle AudioMixer::findTrack(const std::string& name) const {
+    auto it = names_.find(name);
+    return it != names_.end() ? it->second : kInvalidTrack;
 }
 
 bool AudioMixer::mix(AudioBuffer& output) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Mixing audio tracks" << std::endl;
-    
-    // 在实际实现中，这里会混音所有轨道
-    
-    if (tracks_.empty()) {
-        output.clear();
-        return true;
-    }
-    
-    // 获取最大缓冲区大小
-    size_t max_size = 0;
-    for (const auto& track : tracks_) {
-        max_size = std::max(max_size, track.buffer.size());
-    }
-    
-    // 初始化输出缓冲区
-    output.resize(max_size);
-    
-    // 混音所有轨道
-    for (size_t i = 0; i < max_size; ++i) {
-        float sample = 0.0f;
-        
-        for (const auto& track : tracks_) {
-            if (!track.mute && i < track.buffer.size()) {
-                sample += track.buffer[i] * track.volume;
+
+    if (output.size() == 0) {
+        size_t max_frames = 0;
+        for (uint32_t index : active_) {
+            const Track& track = slots_[index].track;
+            if (!track.finished) {
+                // 来源剩余帧数换算到混音器采样率，再加上延迟尾部
+                size_t remaining = track.source->remainingFrames();
+                if (track.resampler) {
+                    const size_t rate = static_cast<size_t>(track.resampler->getInputRate());
+                    remaining = (remaining * static_cast<size_t>(sample_rate_) + rate - 1) / rate;
+                }
+                max_frames = std::max(max_frames, remaining + track.tail);
             }
         }
-        
-        output[i] = sample;
+        output.resize(max_frames * channels_);
     }
-    
-    return true;
+
+    return mix(AudioView(output, channels_));
 }
 
 void AudioMixer::clear() {
     if (initialized_) {
         std::cout << "Clearing audio mixer tracks" << std::endl;
-        
-        // 在实际实现中，这里会清空所有轨道
-        
-        tracks_.clear();
+
+        // 逐个移除，使已发出的句柄全部失效
+        while (!active_.empty()) {
+            const uint32_t index = active_.back();
+            removeTrack(makeHandle(index, slots_[index].generation));
+        }
     }
 }
 
 size_t AudioMixer::getTrackCount() const {
-    return tracks_.size();
+    return active_.size();
 }
 
 std::vector<std::string> AudioMixer::getTrackNames() const {
     std::vector<std::string> names;
-    for (const auto& track : tracks_) {
-        names.push_back(track.name);
+    for (uint32_t index : active_) {
+        const std::string& name = slots_[index].track.name;
+        if (!name.empty()) {
+            names.push_back(name);
+        }
     }
     return names;
 }
 
-} // namespace core
\ No newline at end of file
+int AudioMixer::findBus(BusHandle bus) const {
+    const uint32_t index = bus & 0xFFFFu;
+    if (index >= buses_.size() || !buses_[index].used || buses_[index].generation != (bus >> 16)) {
+        return -1;
+    }
+    return static_cast<int>(index);
+}
+
+void AudioMixer::detachTrack(uint32_t index) {
+    auto& tracks = buses_[slots_[index].track.bus].bus.tracks;
+    auto it = std::find(tracks.begin(), tracks.end(), index);
+    if (it != tracks.end()) {
+        *it = tracks.back();
+        tracks.pop_back();
+    }
+}
+
+bool AudioMixer::prepareTrack(Track& track) {
+    const AudioFormat format = track.source->getFormat();
+    const int rate = format.sample_rate > 0 ? format.sample_rate : sample_rate_;
+    const size_t channels = format.channels > 0 ? static_cast<size_t>(format.channels) : channels_;
+
+    std::unique_ptr<ChannelMixer> channel_mixer;
+    if (channels != channels_) {
+        audio::ChannelLayout input;
+        audio::ChannelLayout output;
+        channel_mixer = std::make_unique<ChannelMixer>();
+        if (!layoutForChannels(channels, input) || !layoutForChannels(channels_, output) ||
+            !channel_mixer->setLayouts(input, output)) {
+            return false;
+        }
+    }
+
+    std::unique_ptr<StreamResampler> resampler;
+    if (rate != sample_rate_) {
+        resampler = std::make_unique<StreamResampler>();
+        if (!resampler->configure(rate, sample_rate_, channels_, kBlockFrames)) {
+            return false;
+        }
+    }
+
+    const size_t input_frames = resampler ? resampler->getMaxInputFrames() : kBlockFrames;
+    track.channels = channels;
+    track.channel_mixer = std::move(channel_mixer);
+    track.resampler = std::move(resampler);
+    track.input.assign((track.channel_mixer || track.resampler) ? input_frames * channels : 0, 0.0f);
+    track.converted.assign((track.channel_mixer && track.resampler) ? input_frames * channels_ : 0, 0.0f);
+    if (track.effects) {
+        track.effects->setFormat(sample_rate_, static_cast<int>(channels_));
+        track.effects->prepare(kBlockFrames);
+    }
+    return true;
+}
+
+size_t AudioMixer::readTrack(Track& track, float* output, size_t frames) {
+    // 格式一致时直接读入输出
+    if (!track.channel_mixer && !track.resampler) {
+        const size_t read = track.source_done ? 0 : track.source->read(output, frames);
+        if (read < frames) {
+            track.source_done = true;
+        }
+        std::fill(output + read * channels_, output + frames * channels_, 0.0f);
+        return read;
+    }
+
+    // 来源结束后继续以静音驱动重采样器，输出滤波器中剩余的样本
+    const size_t needed = track.resampler ? track.resampler->getInputFrames(frames) : frames;
+    float* input = track.input.data();
+    const size_t read = track.source_done ? 0 : track.source->read(input, needed);
+    if (read < needed) {
+        track.source_done = true;
+    }
+    std::fill(input + read * track.channels, input + needed * track.channels, 0.0f);
+
+    const float* mixed = input;
+    if (track.channel_mixer) {
+        float* target = track.resampler ? track.converted.data() : output;
+        track.channel_mixer->process(input, target, needed);
+        mixed = target;
+    }
+    if (track.resampler) {
+        track.resampler->process(mixed, output, frames);
+    }
+
+    if (read == needed) {
+        return (needed == 0 && track.source_done) ? 0 : frames;
+    }
+    return std::min(frames, read * frames / needed);
+}
+
+void AudioMixer::prepareBus(Bus& bus) {
+    bus.buffer.assign(kBlockFrames * channels_, 0.0f);
+    bus.pull.assign(kBlockFrames * channels_, 0.0f);
+    if (bus.effects) {
+        bus.effects->setFormat(sample_rate_, static_cast<int>(channels_));
+        bus.effects->prepare(kBlockFrames);
+    }
+}
+
+bool AudioMixer::compileBuses() {
+    const size_t count = buses_.size();
+
+    // 边：总线 → 输出总线（主输出）与总线 → 发送目标；主总线是唯一没有出边的总线
+    std::vector<size_t> pending(count, 0);
+    std::vector<std::vector<uint32_t>> outputs(count);
+    std::vector<std::vector<BusInput>> inputs(count);
+    size_t used_count = 0;
+    for (uint32_t id = 0; id < count; ++id) {
+        if (!buses_[id].used) {
+            continue;
+        }
+        ++used_count;
+        const Bus& bus = buses_[id].bus;
+        if (id != 0) {
+            ++pending[bus.output];
+            outputs[id].push_back(bus.output);
+            inputs[bus.output].push_back(BusInput{id, -1, {}});
+        }
+        for (size_t s = 0; s < bus.sends.size(); ++s) {
+            ++pending[bus.sends[s].destination];
+            outputs[id].push_back(bus.sends[s].destination);
+            inputs[bus.sends[s].destination].push_back(BusInput{id, static_cast<int>(s), {}});
+        }
+    }
+
+    // Kahn算法分层（总线层号为其最长入路径长度），同时检测环路
+    std::vector<uint32_t> ready;
+    for (uint32_t id = 0; id < count; ++id) {
+        if (buses_[id].used && pending[id] == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> levels;
+    size_t sorted = 0;
+    while (!ready.empty()) {
+        std::vector<uint32_t> next;
+        for (uint32_t id : ready) {
+            for (uint32_t target : outputs[id]) {
+                if (--pending[target] == 0) {
+                    next.push_back(target);
+                }
+            }
+        }
+        sorted += ready.size();
+        levels.push_back(std::move(ready));
+        ready = std::move(next);
+    }
+
+    if (sorted != used_count) {
+        return false;
+    }
+
+    for (uint32_t id = 0; id < count; ++id) {
+        buses_[id].bus.inputs = std::move(inputs[id]);
+    }
+    bus_levels_ = std::move(levels);
+    updateLatencies();
+    return true;
+}
+
+AudioMixer::Track* AudioMixer::findSlot(TrackHandle track) {
+    const uint32_t index = track & 0xFFFFu;
+    if (index >= slots_.size() || !slots_[index].used || slots_[index].generation != (track >> 16)) {
+        return nullptr;
+    }
+    return &slots_[index].track;
+}
+
+const AudioMixer::Track* AudioMixer::findSlot(TrackHandle track) const {
+    const uint32_t index = track & 0xFFFFu;
+    if (index >= slots_.size() || !slots_[index].used || slots_[index].generation != (track >> 16)) {
+        return nullptr;
+    }
+    return &slots_[index].track;
+}
+
+} // namespace core
@@ -0,0 +1,163 @@
+#include "core/audio_modulation_cores.h"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+namespace modulation {
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+// 毫秒转换为帧
+inline float msToFrames(float ms, int sample_rate) {
+    return ms * 0.001f * static_cast<float>(sample_rate);
+}
+
+} // namespace
+
+// ChorusCore implementation
+void ChorusCore::prepare(int sample_rate, size_t channels) {
+    lines_.resize(channels);
+    for (auto& line : lines_) {
+        line.allocate(static_cast<size_t>(msToFrames(30.0f, sample_rate)));
+        line.setInterpolation(DelayLine::Interpolation::LAGRANGE);
+    }
+}
+
+void ChorusCore::reset() {
+    for (auto& line : lines_) {
+        line.clear();
+    }
+}
+
+void ChorusCore::update(const ModulationParameters& params, int sample_rate) {
+    base_delay_ = msToFrames(20.0f, sample_rate);
+    sweep_ = msToFrames(8.0f, sample_rate) * params.depth;
+    feedback_ = params.feedback;
+    dry_ = 1.0f - params.mix;
+    wet_ = params.mix;
+}
+
+// FlangerCore implementation
+void FlangerCore::prepare(int sample_rate, size_t channels) {
+    lines_.resize(channels);
+    for (auto& line : lines_) {
+        line.allocate(static_cast<size_t>(msToFrames(6.0f, sample_rate)));
+        line.setInterpolation(DelayLine::Interpolation::LAGRANGE);
+    }
+}
+
+void FlangerCore::reset() {
+    for (auto& line : lines_) {
+        line.clear();
+    }
+}
+
+void FlangerCore::update(const ModulationParameters& params, int sample_rate) {
+    base_delay_ = msToFrames(3.0f, sample_rate);
+    sweep_ = msToFrames(2.5f, sample_rate) * params.depth;
+    feedback_ = params.feedback;
+    dry_ = 1.0f - params.mix;
+    wet_ = params.mix;
+}
+
+// PhaserCore implementation
+void PhaserCore::prepare(int, size_t channels) {
+    state_.assign(channels * (kStages + 1), 0.0f);
+}
+
+void PhaserCore::reset() {
+    std::fill(state_.begin(), state_.end(), 0.0f);
+}
+
+void PhaserCore::update(const ModulationParameters& params, int sample_rate) {
+    center_ = kPi * 1000.0f / static_cast<float>(sample_rate);
+    sweep_ = 0.9f * params.depth;
+    feedback_ = params.feedback;
+    dry_ = 1.0f - params.mix;
+    wet_ = params.mix;
+}
+
+// TremoloCore implementation
+void TremoloCore::prepare(int, size_t) {}
+
+void TremoloCore::reset() {}
+
+void TremoloCore::update(const ModulationParameters& params, int) {
+    // 湿信号增益 1 - depth * (0.5 - 0.5 * lfo)，再与干信号混合
+    const float wet_offset = 1.0f - 0.5f * params.depth;
+    const float wet_scale = 0.5f * params.depth;
+    offset_ = (1.0f - params.mix) + params.mix * wet_offset;
+    scale_ = params.mix * wet_scale;
+}
+
+// AutoWahCore implementation
+void AutoWahCore::prepare(int, size_t channels) {
+    low_.assign(channels, 0.0f);
+    band_.assign(channels, 0.0f);
+}
+
+void AutoWahCore::reset() {
+    std::fill(low_.begin(), low_.end(), 0.0f);
+    std::fill(band_.begin(), band_.end(), 0.0f);
+}
+
+void AutoWahCore::update(const ModulationParameters& params, int sample_rate) {
+    const float nyquist_limit = 0.45f * static_cast<float>(sample_rate);
+    const float low_frequency = std::min(300.0f, nyquist_limit);
+    const float high_frequency = std::min(300.0f + 2700.0f * params.depth, nyquist_limit);
+    min_coefficient_ = 2.0f * std::sin(kPi * low_frequency / static_cast<float>(sample_rate));
+    range_ = 2.0f * std::sin(kPi * high_frequency / static_cast<float>(sample_rate)) - min_coefficient_;
+    damping_ = 1.4f * (1.0f - std::fabs(params.feedback)) + 0.1f;
+    dry_ = 1.0f - params.mix;
+    wet_ = params.mix;
+}
+
+// WaveshaperCore implementation
+void WaveshaperCore::prepare(int, size_t) {}
+
+void WaveshaperCore::reset() {}
+
+void WaveshaperCore::update(const ModulationParameters& params, int) {
+    depth_ = params.depth;
+    bias_ = 0.5f * params.feedback;
+    bias_shaped_ = shapeSample(bias_);
+    dry_ = 1.0f - params.mix;
+    wet_ = params.mix;
+}
+
+void WaveshaperCore::setDrive(float drive) {
+    drive_ = std::clamp(drive, 0.1f, 20.0f);
+}
+
+void WaveshaperCore::setShape(float shape) {
+    shape_ = std::clamp(shape, 0.0f, 1.0f);
+    bias_shaped_ = shapeSample(bias_);
+}
+
+// VocoderCore implementation
+void VocoderCore::prepare(int sample_rate, size_t) {
+    sample_rate_ = sample_rate;
+    carrier_increment_ = carrier_frequency_ / static_cast<float>(sample_rate_);
+}
+
+void VocoderCore::reset() {
+    carrier_phase_ = 0.0f;
+}
+
+void VocoderCore::update(const ModulationParameters& params, int sample_rate) {
+    sample_rate_ = sample_rate;
+    carrier_increment_ = carrier_frequency_ / static_cast<float>(sample_rate_);
+    sweep_ = 0.5f * params.depth;
+    dry_ = 1.0f - params.mix;
+    wet_ = params.mix;
+}
+
+void VocoderCore::setCarrierFrequency(float frequency) {
+    carrier_frequency_ = std::clamp(frequency, 1.0f, 0.45f * static_cast<float>(sample_rate_));
+    carrier_increment_ = carrier_frequency_ / static_cast<float>(sample_rate_);
+}
+
+} // namespace modulation
+} // namespace core
@@ -0,0 +1,239 @@
+#include "core/audio_oscillator_bank.h"
+#include "core/audio_modulated_effect.h"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+namespace {
+
+// 分段长度：每段重新折叠相位，保证 phase + i * increment 的单精度误差足够小
+const size_t kChunkSize = 64;
+
+// PolyBLEP残差（阶跃高度2归一化为1），inv_dt为1/dt
+inline float polyBlep(float t, float dt, float inv_dt) {
+    const float head = t * inv_dt;
+    const float tail = (t - 1.0f) * inv_dt;
+    const float head_value = 2.0f * head - head * head - 1.0f;
+    const float tail_value = tail * tail + 2.0f * tail + 1.0f;
+    return modulation::maskIf(t < dt, head_value) + modulation::maskIf(t > 1.0f - dt, tail_value);
+}
+
+// PolyBLAMP残差（每样本斜率变化2归一化为1），inv_dt为1/dt
+inline float polyBlamp(float t, float dt, float inv_dt) {
+    const float head = t * inv_dt - 1.0f;
+    const float tail = (t - 1.0f) * inv_dt + 1.0f;
+    const float head_value = -head * head * head * (1.0f / 3.0f);
+    const float tail_value = tail * tail * tail * (1.0f / 3.0f);
+    return modulation::maskIf(t < dt, head_value) + modulation::maskIf(t > 1.0f - dt, tail_value);
+}
+
+inline float wrapUnit(float value) {
+    return value - modulation::fastFloor(value);
+}
+
+// 各波形的单样本核，BandLimited在编译期决定是否加入校正项
+template <AudioOscillatorBank::Waveform W, bool BandLimited>
+struct OscillatorKernel;
+
+template <bool BandLimited>
+struct OscillatorKernel<AudioOscillatorBank::Waveform::SINE, BandLimited> {
+    static inline float value(float t, float, float) { return modulation::fastSine(t); }
+};
+
+template <bool BandLimited>
+struct OscillatorKernel<AudioOscillatorBank::Waveform::SAWTOOTH, BandLimited> {
+    static inline float value(float t, float dt, float inv_dt) {
+        float y = 2.0f * t - 1.0f;
+        if (BandLimited) {
+            y -= polyBlep(t, dt, inv_dt);
+        }
+        return y;
+    }
+};
+
+template <bool BandLimited>
+struct OscillatorKernel<AudioOscillatorBank::Waveform::SQUARE, BandLimited> {
+    static inline float value(float t, float dt, float inv_dt) {
+        float y = t < 0.5f ? 1.0f : -1.0f;
+        if (BandLimited) {
+            y += polyBlep(t, dt, inv_dt) - polyBlep(wrapUnit(t + 0.5f), dt, inv_dt);
+        }
+        return y;
+    }
+};
+
+template <bool BandLimited>
+struct OscillatorKernel<AudioOscillatorBank::Waveform::TRIANGLE, BandLimited> {
+    static inline float value(float t, float dt, float inv_dt) {
+        float y = 4.0f * std::fabs(t - 0.5f) - 1.0f;
+        if (BandLimited) {
+            // 谷值处斜率变化+8、峰值处-8（每周期），即每样本 ±8 * dt；
+            // 残差在不连续点两侧各取一次，且已按每样本斜率变化2归一化，因此乘以8 * dt / 4
+            y += 2.0f * dt * (polyBlamp(wrapUnit(t + 0.5f), dt, inv_dt) - polyBlamp(t, dt, inv_dt));
+        }
+        return y;
+    }
+};
+
+template <typename Kernel>
+void renderKernel(float& phase, float increment, float amplitude,
+                  float* output, size_t frames, bool accumulate) {
+    const float dt = std::min(increment, 0.5f);
+    // 倒数在块外计算：块内只有乘法与选择，循环可以无分支地向量化
+    const float inv_dt = dt > 0.0f ? 1.0f / dt : 0.0f;
+    size_t offset = 0;
+    while (offset < frames) {
+        const size_t count = std::min(kChunkSize, frames - offset);
+        const float start = phase;
+        float* out = output + offset;
+
+        // 32位下标：64位整数到浮点的转换在SSE/AVX2上没有向量指令，会阻止循环向量化
+        const int32_t length = static_cast<int32_t>(count);
+        if (accumulate) {
+            for (int32_t i = 0; i < length; ++i) {
+                const float t = wrapUnit(start + static_cast<float>(i) * increment);
+                out[i] += amplitude * Kernel::value(t, dt, inv_dt);
+            }
+        } else {
+            for (int32_t i = 0; i < length; ++i) {
+                const float t = wrapUnit(start + static_cast<float>(i) * increment);
+                out[i] = amplitude * Kernel::value(t, dt, inv_dt);
+            }
+        }
+
+        phase = wrapUnit(start + static_cast<float>(count) * increment);
+        offset += count;
+    }
+}
+
+template <AudioOscillatorBank::Waveform W>
+void renderWaveform(bool band_limited, float& phase, float increment, float amplitude,
+                    float* output, size_t frames, bool accumulate) {
+    if (band_limited) {
+        renderKernel<OscillatorKernel<W, true>>(phase, increment, amplitude, output, frames, accumulate);
+    } else {
+        renderKernel<OscillatorKernel<W, false>>(phase, increment, amplitude, output, frames, accumulate);
+    }
+}
+
+} // namespace
+
+AudioOscillatorBank::AudioOscillatorBank()
+    : sample_rate_(44100), anti_aliasing_(AntiAliasing::POLYBLEP) {
+}
+
+bool AudioOscillatorBank::setSampleRate(int sample_rate) {
+    if (sample_rate <= 0) {
+        return false;
+    }
+
+    // 保持各振荡器频率不变
+    const float scale = static_cast<float>(sample_rate_) / static_cast<float>(sample_rate);
+    for (auto& increment : increments_) {
+        increment *= scale;
+    }
+    sample_rate_ = sample_rate;
+    return true;
+}
+
+int AudioOscillatorBank::getSampleRate() const {
+    return sample_rate_;
+}
+
+void AudioOscillatorBank::setOscillatorCount(size_t count) {
+    phases_.resize(count, 0.0f);
+    increments_.resize(count, 0.0f);
+    amplitudes_.resize(count, 0.0f);
+    waveforms_.resize(count, Waveform::SINE);
+}
+
+size_t AudioOscillatorBank::getOscillatorCount() const {
+    return phases_.size();
+}
+
+bool AudioOscillatorBank::setOscillator(size_t index, Waveform waveform, float frequency, float amplitude) {
+    if (index >= phases_.size()) {
+        return false;
+    }
+
+    waveforms_[index] = waveform;
+    amplitudes_[index] = amplitude;
+    return setFrequency(index, frequency);
+}
+
+bool AudioOscillatorBank::setFrequency(size_t index, float frequency) {
+    if (index >= phases_.size()) {
+        return false;
+    }
+
+    // 限制在奈奎斯特频率以内
+    const float nyquist = 0.5f * static_cast<float>(sample_rate_);
+    increments_[index] = std::clamp(frequency, 0.0f, nyquist) / static_cast<float>(sample_rate_);
+    return true;
+}
+
+bool AudioOscillatorBank::setAmplitude(size_t index, float amplitude) {
+    if (index >= phases_.size()) {
+        return false;
+    }
+
+    amplitudes_[index] = amplitude;
+    return true;
+}
+
+void AudioOscillatorBank::setAntiAliasing(AntiAliasing mode) {
+    anti_aliasing_ = mode;
+}
+
+AudioOscillatorBank::AntiAliasing AudioOscillatorBank::getAntiAliasing() const {
+    return anti_aliasing_;
+}
+
+void AudioOscillatorBank::render(float* output, size_t frames) {
+    if (phases_.empty()) {
+        std::fill(output, output + frames, 0.0f);
+        return;
+    }
+
+    for (size_t index = 0; index < phases_.size(); ++index) {
+        renderInto(index, output, frames, index > 0);
+    }
+}
+
+void AudioOscillatorBank::renderOscillator(size_t index, float* output, size_t frames) {
+    if (index >= phases_.size()) {
+        std::fill(output, output + frames, 0.0f);
+        return;
+    }
+
+    renderInto(index, output, frames, false);
+}
+
+void AudioOscillatorBank::resetPhases() {
+    std::fill(phases_.begin(), phases_.end(), 0.0f);
+}
+
+void AudioOscillatorBank::renderInto(size_t index, float* output, size_t frames, bool accumulate) {
+    const bool band_limited = anti_aliasing_ == AntiAliasing::POLYBLEP;
+    float& phase = phases_[index];
+    const float increment = increments_[index];
+    const float amplitude = amplitudes_[index];
+
+    switch (waveforms_[index]) {
+    case Waveform::SINE:
+        renderWaveform<Waveform::SINE>(band_limited, phase, increment, amplitude, output, frames, accumulate);
+        break;
+    case Waveform::SQUARE:
+        renderWaveform<Waveform::SQUARE>(band_limited, phase, increment, amplitude, output, frames, accumulate);
+        break;
+    case Waveform::TRIANGLE:
+        renderWaveform<Waveform::TRIANGLE>(band_limited, phase, increment, amplitude, output, frames, accumulate);
+        break;
+    case Waveform::SAWTOOTH:
+        renderWaveform<Waveform::SAWTOOTH>(band_limited, phase, increment, amplitude, output, frames, accumulate);
+        break;
+    }
+}
+
+} // namespace core
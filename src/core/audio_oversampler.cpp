@@ -0,0 +1,223 @@
+#include "core/audio_oversampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+namespace {
+
+// 各级半长：首级过渡带最窄，后级只需抑制远处的镜像
+const size_t kStageHalfLengths[] = {12, 6, 4};
+const size_t kMaxStages = 3;
+
+// Kaiser窗参数（约-90dB阻带）
+const double kKaiserBeta = 8.0;
+
+// 零阶修正贝塞尔函数（级数展开）
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double half = 0.5 * x;
+    for (int k = 1; k < 32; ++k) {
+        term *= (half / k) * (half / k);
+        sum += term;
+        if (term < 1e-12 * sum) {
+            break;
+        }
+    }
+    return sum;
+}
+
+} // namespace
+
+// HalfbandStage implementation
+void HalfbandStage::design(size_t half_length) {
+    half_length_ = half_length;
+    const size_t center = 2 * half_length;
+    const double pi = 3.14159265358979323846;
+
+    // h[i] = 0.5 * sinc((i - c) / 2) * kaiser(i)，只保留奇数下标（偶数下标除中心外为零）
+    taps_.resize(2 * half_length);
+    double sum = 0.0;
+    for (size_t j = 0; j < taps_.size(); ++j) {
+        const double offset = static_cast<double>(2 * j + 1) - static_cast<double>(center);
+        const double sinc = std::sin(0.5 * pi * offset) / (0.5 * pi * offset);
+        const double ratio = offset / static_cast<double>(center);
+        const double window = besselI0(kKaiserBeta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) /
+                              besselI0(kKaiserBeta);
+        taps_[j] = static_cast<float>(0.5 * sinc * window);
+        sum += 0.5 * sinc * window;
+    }
+
+    // 归一化直流增益：中心系数0.5加上奇数系数之和为1
+    for (float& tap : taps_) {
+        tap = static_cast<float>(tap * 0.5 / sum);
+    }
+}
+
+void HalfbandStage::prepare(size_t max_frames) {
+    const size_t history = 2 * half_length_;
+    up_work_.assign(history + max_frames, 0.0f);
+    up_odd_.assign(max_frames, 0.0f);
+    down_even_.assign(history + max_frames, 0.0f);
+    down_odd_.assign(history + max_frames, 0.0f);
+}
+
+void HalfbandStage::reset() {
+    std::fill(up_work_.begin(), up_work_.end(), 0.0f);
+    std::fill(down_even_.begin(), down_even_.end(), 0.0f);
+    std::fill(down_odd_.begin(), down_odd_.end(), 0.0f);
+}
+
+void HalfbandStage::upsample(const float* input, size_t frames, float* output) {
+    const size_t history = 2 * half_length_;
+    float* work = up_work_.data();
+    std::copy(input, input + frames, work + history);
+    const float* x = work + history;
+
+    // 奇数相位：y[2m + 1] = 2 * sum_j h[2j + 1] * x[m - j]
+    float* odd = up_odd_.data();
+    std::fill(odd, odd + frames, 0.0f);
+    for (size_t j = 0; j < taps_.size(); ++j) {
+        const float tap = 2.0f * taps_[j];
+        const float* source = x - j;
+        for (size_t m = 0; m < frames; ++m) {
+            odd[m] += tap * source[m];
+        }
+    }
+
+    // 偶数相位为延迟K个样本的输入（中心系数0.5乘以插值增益2）
+    const float* delayed = x - half_length_;
+    for (size_t m = 0; m < frames; ++m) {
+        output[2 * m] = delayed[m];
+        output[2 * m + 1] = odd[m];
+    }
+
+    std::copy(work + frames, work + frames + history, work);
+}
+
+void HalfbandStage::downsample(const float* input, size_t frames, float* output) {
+    const size_t history = 2 * half_length_;
+    float* even = down_even_.data();
+    float* odd = down_odd_.data();
+    for (size_t m = 0; m < frames; ++m) {
+        even[history + m] = input[2 * m];
+        odd[history + m] = input[2 * m + 1];
+    }
+
+    // z[m] = 0.5 * e[m - K] + sum_j h[2j + 1] * o[m - j - 1]
+    const float* e = even + history - half_length_;
+    for (size_t m = 0; m < frames; ++m) {
+        output[m] = 0.5f * e[m];
+    }
+    for (size_t j = 0; j < taps_.size(); ++j) {
+        const float tap = taps_[j];
+        const float* source = odd + history - j - 1;
+        for (size_t m = 0; m < frames; ++m) {
+            output[m] += tap * source[m];
+        }
+    }
+
+    std::copy(even + frames, even + frames + history, even);
+    std::copy(odd + frames, odd + frames + history, odd);
+}
+
+// AudioOversampler implementation
+AudioOversampler::AudioOversampler()
+    : factor_(1), stage_count_(0), channels_(0), max_frames_(0), result_(nullptr) {
+    // 构造函数
+}
+
+bool AudioOversampler::setFactor(size_t factor) {
+    if (factor != 1 && factor != 2 && factor != 4 && factor != 8) {
+        return false;
+    }
+
+    factor_ = factor;
+    stage_count_ = 0;
+    while ((static_cast<size_t>(1) << stage_count_) < factor_) {
+        ++stage_count_;
+    }
+    rebuild();
+    return true;
+}
+
+size_t AudioOversampler::getFactor() const {
+    return factor_;
+}
+
+void AudioOversampler::prepare(size_t channels, size_t max_frames) {
+    channels_ = channels;
+    max_frames_ = max_frames;
+    rebuild();
+}
+
+size_t AudioOversampler::getMaxFrames() const {
+    return max_frames_;
+}
+
+void AudioOversampler::rebuild() {
+    stages_.assign(channels_, std::vector<HalfbandStage>(stage_count_));
+    for (auto& chain : stages_) {
+        for (size_t s = 0; s < stage_count_; ++s) {
+            chain[s].design(kStageHalfLengths[std::min(s, kMaxStages - 1)]);
+            chain[s].prepare(max_frames_ << s);
+        }
+    }
+    buffer_a_.assign(max_frames_ * factor_, 0.0f);
+    buffer_b_.assign(max_frames_ * factor_, 0.0f);
+    result_ = buffer_b_.data();
+}
+
+float* AudioOversampler::upsample(size_t channel, const float* input, size_t frames, size_t stride) {
+    float* source = buffer_b_.data();
+    float* target = buffer_a_.data();
+    for (size_t i = 0; i < frames; ++i) {
+        source[i] = input[i * stride];
+    }
+
+    size_t length = frames;
+    for (size_t s = 0; s < stage_count_; ++s) {
+        stages_[channel][s].upsample(source, length, target);
+        std::swap(source, target);
+        length *= 2;
+    }
+
+    result_ = source;
+    return result_;
+}
+
+void AudioOversampler::downsample(size_t channel, float* output, size_t frames, size_t stride) {
+    float* source = result_;
+    float* target = source == buffer_a_.data() ? buffer_b_.data() : buffer_a_.data();
+
+    size_t length = frames << stage_count_;
+    for (size_t s = stage_count_; s-- > 0;) {
+        length /= 2;
+        stages_[channel][s].downsample(source, length, target);
+        std::swap(source, target);
+    }
+
+    for (size_t i = 0; i < frames; ++i) {
+        output[i * stride] = source[i];
+    }
+}
+
+size_t AudioOversampler::getLatency() const {
+    // 第s级的往返延迟在 2^s 倍采样率下计算
+    size_t latency = 0;
+    for (size_t s = 0; s < stage_count_; ++s) {
+        latency += (2 * kStageHalfLengths[std::min(s, kMaxStages - 1)]) >> s;
+    }
+    return latency;
+}
+
+void AudioOversampler::reset() {
+    for (auto& chain : stages_) {
+        for (auto& stage : chain) {
+            stage.reset();
+        }
+    }
+}
+
+} // namespace core
@@ -1,10 +1,39 @@
 #include "core/audio_pitch_shifter.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
-AudioPitchShifter::AudioPitchShifter() 
-    : initialized_(false), pitch_shift_(1.0f), mix_(0.5f) {
+namespace {
+
+const float kPi = 3.14159265358979f;
+const float kTwoPi = 6.28318530717959f;
+
+// 音高比例范围（±2个八度）
+const float kMinPitchShift = 0.25f;
+const float kMaxPitchShift = 4.0f;
+
+// 倒谱提升器截止（毫秒），低于此倒频率的分量视为共振峰包络
+const float kFormantLifterMs = 1.5f;
+
+// 将相位差折叠到[-pi, pi]
+inline float wrapPhase(float phase) {
+    long qpd = static_cast<long>(phase / kPi);
+    if (qpd >= 0) {
+        qpd += qpd & 1;
+    } else {
+        qpd -= qpd & 1;
+    }
+    return phase - kPi * static_cast<float>(qpd);
+}
+
+} // namespace
+
+AudioPitchShifter::AudioPitchShifter()
+    : initialized_(false), pitch_shift_(1.0f), mix_(0.5f),
+      sample_rate_(44100), channels_(2), preserve_formants_(false),
+      fft_(kFrameSize) {
     // 初始化音频音高变换器
 }
 
@@ -15,9 +44,9 @@ AudioPitchShifter::~AudioPitchShifter() {
 
 bool AudioPitchShifter::initialize() {
     std::cout << "Initializing audio pitch shifter" << std::endl;
-    
-    // 在实际实现中，这里会初始化音高变换器
-    
+
+    allocateState();
+
     initialized_ = true;
     return true;
 }
@@ -25,23 +54,55 @@ bool AudioPitchShifter::initialize() {
 void AudioPitchShifter::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio pitch shifter" << std::endl;
-        
-        // 在实际实现中，这里会关闭音高变换器
-        
+
+        states_.clear();
+
         initialized_ = false;
     }
 }
 
 bool AudioPitchShifter::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || channels_ <= 0) {
         return false;
     }
-    
-    std::cout << "Applying audio pitch shifter effect" << std::endl;
-    
-    // 在实际实现中，这里会应用音高变换效果
-    
-    output = input;  // 模拟处理
+
+    const size_t channels = static_cast<size_t>(channels_);
+    const size_t frames = input.size() / channels;
+
+    // 预留容量后resize不会重新分配
+    if (output.size() != input.size()) {
+        output.resize(input.size());
+    }
+
+    const float* in = input.data();
+    float* out = output.data();
+    const float wet = mix_;
+    const float dry = 1.0f - mix_;
+
+    for (size_t ch = 0; ch < channels; ++ch) {
+        ChannelState& state = states_[ch];
+
+        for (size_t i = 0; i < frames; ++i) {
+            const size_t index = i * channels + ch;
+
+            // 先读取输入，允许原地处理
+            state.in_fifo[state.rover] = in[index];
+
+            // 干信号按处理延迟（一帧）对齐，避免与湿信号叠加时产生梳状滤波：
+            // 输入FIFO提供kFifoLatency帧延迟，dry_delay再延迟一跳
+            const size_t slot = state.rover - kFifoLatency;
+            const float delayed_dry = state.dry_delay[slot];
+            state.dry_delay[slot] = state.in_fifo[slot];
+            out[index] = dry * delayed_dry + wet * state.out_fifo[slot];
+
+            ++state.rover;
+            if (state.rover >= kFrameSize) {
+                state.rover = kFifoLatency;
+                processFrame(state);
+            }
+        }
+    }
+
     return true;
 }
 
@@ -49,14 +110,12 @@ bool AudioPitchShifter::setParameters(float pitch_shift, float mix) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting pitch shifter parameters - Pitch shift: " << pitch_shift 
+
+    std::cout << "Setting pitch shifter parameters - Pitch shift: " << pitch_shift
               << ", Mix: " << mix << std::endl;
-    
-    // 在实际实现中，这里会设置音高变换参数
-    
-    pitch_shift_ = pitch_shift;
-    mix_ = mix;
+
+    pitch_shift_ = std::clamp(pitch_shift, kMinPitchShift, kMaxPitchShift);
+    mix_ = std::clamp(mix, 0.0f, 1.0f);
     return true;
 }
 
@@ -65,15 +124,238 @@ void AudioPitchShifter::getParameters(float& pitch_shift, float& mix) const {
     mix = mix_;
 }
 
+bool AudioPitchShifter::setSemitones(float semitones) {
+    return setParameters(std::pow(2.0f, semitones / 12.0f), mix_);
+}
+
+bool AudioPitchShifter::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+
+    if (initialized_) {
+        allocateState();
+    }
+    return true;
+}
+
+void AudioPitchShifter::setFormantPreservation(bool enabled) {
+    preserve_formants_ = enabled;
+}
+
+bool AudioPitchShifter::isFormantPreservationEnabled() const {
+    return preserve_formants_;
+}
+
+size_t AudioPitchShifter::getLatency() const {
+    // 输入FIFO填满一帧才分析，合成结果的第一跳在随后的一跳内输出
+    return kFrameSize;
+}
+
 void AudioPitchShifter::reset() {
     if (initialized_) {
         std::cout << "Resetting audio pitch shifter" << std::endl;
-        
-        // 在实际实现中，这里会重置音高变换器
-        
+
+        clearState();
+
         pitch_shift_ = 1.0f;
         mix_ = 0.5f;
     }
 }
 
-} // namespace core
\ No newline at end of file
+void AudioPitchShifter::processFrame(ChannelState& state) {
+    const size_t half = kFrameSize / 2;
+    const float bin_hop_phase = kTwoPi * static_cast<float>(kHopSize) / static_cast<float>(kFrameSize);
+    const float oversampling = static_cast<float>(kOversampling);
+
+    // 加窗并正变换
+    for (size_t k = 0; k < kFrameSize; ++k) {
+        fft_re_[k] = state.in_fifo[k] * window_[k];
+        fft_im_[k] = 0.0f;
+    }
+    fft_.forward(fft_re_.data(), fft_im_.data());
+
+    // 分析：幅度、相位与真实频率（以频点为单位）
+    for (size_t k = 0; k <= half; ++k) {
+        const float re = fft_re_[k];
+        const float im = fft_im_[k];
+        const float phase = std::atan2(im, re);
+
+        float delta = phase - state.last_phase[k];
+        state.last_phase[k] = phase;
+        delta = wrapPhase(delta - static_cast<float>(k) * bin_hop_phase);
+
+        analysis_magnitude_[k] = std::sqrt(re * re + im * im);
+        analysis_phase_[k] = phase;
+        analysis_frequency_[k] = static_cast<float>(k) + oversampling * delta / kTwoPi;
+    }
+
+    // 共振峰保持：先用包络展平频谱，移调后再乘回原始包络
+    if (preserve_formants_) {
+        computeEnvelope(analysis_magnitude_.data(), envelope_.data());
+        for (size_t k = 0; k <= half; ++k) {
+            analysis_magnitude_[k] /= envelope_[k];
+        }
+    }
+
+    // 寻找分析谱峰值，每个峰值区域（相邻峰值中点为界）整体平移到目标位置，
+    // 保持主瓣形状不变；区域内频点相位锁定到峰值相位，减少相位感
+    size_t peak_count = 0;
+    for (size_t k = 1; k < half; ++k) {
+        const float magnitude = analysis_magnitude_[k];
+        if (magnitude > analysis_magnitude_[k - 1] && magnitude >= analysis_magnitude_[k + 1]) {
+            peaks_[peak_count++] = k;
+        }
+    }
+
+    std::fill(synthesis_magnitude_.begin(), synthesis_magnitude_.end(), 0.0f);
+    // 未被覆盖的频点保留上一帧相位
+    std::copy(state.sum_phase.begin(), state.sum_phase.end(), synthesis_phase_.begin());
+
+    const long last_bin = static_cast<long>(half);
+    size_t region_start = 0;
+    for (size_t p = 0; p < peak_count; ++p) {
+        const size_t peak = peaks_[p];
+        const size_t region_end = (p + 1 < peak_count) ? (peak + peaks_[p + 1]) / 2 : half;
+
+        // 按真实频率计算平移量，使主瓣中心与合成频率的偏差不超过半个频点
+        const float peak_frequency = analysis_frequency_[peak] * pitch_shift_;
+        const long shift = std::lround(peak_frequency - analysis_frequency_[peak]);
+        const long target_peak = static_cast<long>(peak) + shift;
+        if (target_peak < 0 || target_peak > last_bin) {
+            region_start = region_end + 1;
+            continue;
+        }
+
+        const float peak_phase = wrapPhase(state.sum_phase[target_peak] + peak_frequency * kTwoPi / oversampling);
+
+        for (size_t k = region_start; k <= region_end; ++k) {
+            const long target = static_cast<long>(k) + shift;
+            if (target < 0 || target > last_bin) {
+                continue;
+            }
+            // 多个区域落到同一频点时，相位取幅度较大者
+            if (analysis_magnitude_[k] > synthesis_magnitude_[target]) {
+                synthesis_phase_[target] = peak_phase + analysis_phase_[k] - analysis_phase_[peak];
+            }
+            synthesis_magnitude_[target] += analysis_magnitude_[k];
+        }
+        region_start = region_end + 1;
+    }
+
+    if (preserve_formants_) {
+        for (size_t k = 0; k <= half; ++k) {
+            synthesis_magnitude_[k] *= envelope_[k];
+        }
+    }
+
+    // 合成：构造共轭对称频谱
+    for (size_t k = 0; k <= half; ++k) {
+        state.sum_phase[k] = wrapPhase(synthesis_phase_[k]);
+
+        const float magnitude = synthesis_magnitude_[k];
+        fft_re_[k] = magnitude * std::cos(state.sum_phase[k]);
+        fft_im_[k] = magnitude * std::sin(state.sum_phase[k]);
+    }
+    fft_im_[0] = 0.0f;
+    fft_im_[half] = 0.0f;
+    for (size_t k = half + 1; k < kFrameSize; ++k) {
+        fft_re_[k] = fft_re_[kFrameSize - k];
+        fft_im_[k] = -fft_im_[kFrameSize - k];
+    }
+    fft_.inverse(fft_re_.data(), fft_im_.data());
+
+    // 加窗叠加（汉宁窗平方在4倍重叠下的和为1.5）
+    const float overlap_gain = 2.0f / 3.0f;
+    for (size_t k = 0; k < kFrameSize; ++k) {
+        state.output_accum[k] += window_[k] * fft_re_[k] * overlap_gain;
+    }
+
+    std::copy(state.output_accum.begin(), state.output_accum.begin() + kHopSize, state.out_fifo.begin());
+
+    // 移动累加器与输入FIFO
+    std::copy(state.output_accum.begin() + kHopSize, state.output_accum.end(), state.output_accum.begin());
+    std::fill(state.output_accum.end() - kHopSize, state.output_accum.end(), 0.0f);
+    std::copy(state.in_fifo.begin() + kHopSize, state.in_fifo.end(), state.in_fifo.begin());
+}
+
+void AudioPitchShifter::computeEnvelope(const float* magnitude, float* envelope) {
+    const size_t half = kFrameSize / 2;
+
+    // 对数幅度谱（对称），以峰值以下80dB为下限，避免静音频点主导包络
+    float floor = 1e-9f;
+    for (size_t k = 0; k <= half; ++k) {
+        floor = std::max(floor, magnitude[k] * 1e-4f);
+    }
+    for (size_t k = 0; k <= half; ++k) {
+        cepstrum_re_[k] = std::log(magnitude[k] + floor);
+        cepstrum_im_[k] = 0.0f;
+    }
+    for (size_t k = half + 1; k < kFrameSize; ++k) {
+        cepstrum_re_[k] = cepstrum_re_[kFrameSize - k];
+        cepstrum_im_[k] = 0.0f;
+    }
+    fft_.inverse(cepstrum_re_.data(), cepstrum_im_.data());
+
+    // 低倒频率提升
+    size_t lifter = static_cast<size_t>(static_cast<float>(sample_rate_) * kFormantLifterMs / 1000.0f);
+    lifter = std::clamp<size_t>(lifter, 4, half / 2);
+    for (size_t n = lifter + 1; n < kFrameSize - lifter; ++n) {
+        cepstrum_re_[n] = 0.0f;
+    }
+    std::fill(cepstrum_im_.begin(), cepstrum_im_.end(), 0.0f);
+    fft_.forward(cepstrum_re_.data(), cepstrum_im_.data());
+
+    for (size_t k = 0; k <= half; ++k) {
+        envelope[k] = std::exp(cepstrum_re_[k]);
+    }
+}
+
+void AudioPitchShifter::allocateState() {
+    const size_t bins = kFrameSize / 2 + 1;
+
+    window_.resize(kFrameSize);
+    for (size_t k = 0; k < kFrameSize; ++k) {
+        window_[k] = 0.5f - 0.5f * std::cos(kTwoPi * static_cast<float>(k) / static_cast<float>(kFrameSize));
+    }
+
+    fft_re_.assign(kFrameSize, 0.0f);
+    fft_im_.assign(kFrameSize, 0.0f);
+    cepstrum_re_.assign(kFrameSize, 0.0f);
+    cepstrum_im_.assign(kFrameSize, 0.0f);
+    analysis_magnitude_.assign(bins, 0.0f);
+    analysis_phase_.assign(bins, 0.0f);
+    analysis_frequency_.assign(bins, 0.0f);
+    synthesis_magnitude_.assign(bins, 0.0f);
+    synthesis_phase_.assign(bins, 0.0f);
+    peaks_.assign(bins, 0);
+    envelope_.assign(bins, 1.0f);
+
+    states_.resize(static_cast<size_t>(channels_));
+    for (auto& state : states_) {
+        state.in_fifo.assign(kFrameSize, 0.0f);
+        state.out_fifo.assign(kFrameSize, 0.0f);
+        state.output_accum.assign(kFrameSize, 0.0f);
+        state.last_phase.assign(bins, 0.0f);
+        state.sum_phase.assign(bins, 0.0f);
+        state.dry_delay.assign(kHopSize, 0.0f);
+        state.rover = kFifoLatency;
+    }
+}
+
+void AudioPitchShifter::clearState() {
+    for (auto& state : states_) {
+        std::fill(state.in_fifo.begin(), state.in_fifo.end(), 0.0f);
+        std::fill(state.out_fifo.begin(), state.out_fifo.end(), 0.0f);
+        std::fill(state.output_accum.begin(), state.output_accum.end(), 0.0f);
+        std::fill(state.last_phase.begin(), state.last_phase.end(), 0.0f);
+        std::fill(state.sum_phase.begin(), state.sum_phase.end(), 0.0f);
+        std::fill(state.dry_delay.begin(), state.dry_delay.end(), 0.0f);
+        state.rover = kFifoLatency;
+    }
+}
+
+} // namespace core
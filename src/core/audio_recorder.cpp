@@ -5,7 +5,7 @@ namespace core {
 
 AudioRecorder::AudioRecorder() 
     : initialized_(false), recording_(false), duration_(0.0), 
-      sample_rate_(44100), channels_(2), bit_depth_(16) {
+      sample_rate_(44100), channels_(2), bit_depth_(16), input_gate_enabled_(false) {
     // 初始化音频录制器
 }
 
@@ -19,6 +19,11 @@ bool AudioRecorder::initialize() {
     
     // 在实际实现中，这里会初始化录制器
     
+    // 输入门控：各输入声道独立检测
+    input_gate_.setFormat(sample_rate_, channels_);
+    input_gate_.setLinked(false);
+    input_gate_.initialize();
+    
     initialized_ = true;
     return true;
 }
@@ -29,6 +34,7 @@ void AudioRecorder::shutdown() {
         
         // 在实际实现中，这里会关闭录制器
         
+        input_gate_.shutdown();
         recording_ = false;
         initialized_ = false;
     }
@@ -114,6 +120,7 @@ bool AudioRecorder::setParameters(int sample_rate, int channels, int bit_depth)
     sample_rate_ = sample_rate;
     channels_ = channels;
     bit_depth_ = bit_depth;
+    input_gate_.setFormat(sample_rate_, channels_);
     return true;
 }
 
@@ -132,7 +139,14 @@ bool AudioRecorder::addAudioData(const AudioBuffer& buffer) {
     
     // 在实际实现中，这里会添加音频数据到录制缓冲区
     
-    audio_buffer_.append(buffer);
+    if (input_gate_enabled_) {
+        if (!input_gate_.apply(buffer, gated_buffer_)) {
+            return false;
+        }
+        audio_buffer_.append(gated_buffer_);
+    } else {
+        audio_buffer_.append(buffer);
+    }
     duration_ += buffer.size() / static_cast<double>(sample_rate_);
     return true;
 }
@@ -149,4 +163,16 @@ bool AudioRecorder::saveRecording() {
     return true;
 }
 
+void AudioRecorder::setInputGateEnabled(bool enabled) {
+    input_gate_enabled_ = enabled;
+}
+
+bool AudioRecorder::isInputGateEnabled() const {
+    return input_gate_enabled_;
+}
+
+AudioGate& AudioRecorder::getInputGate() {
+    return input_gate_;
+}
+
 } // namespace core
\ No newline at end of file
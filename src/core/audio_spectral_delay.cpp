@@ -1,10 +1,12 @@
 #include "core/audio_spectral_delay.h"
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
 AudioSpectralDelay::AudioSpectralDelay() 
-    : initialized_(false), delay_time_(100.0f), feedback_(0.3f), mix_(0.5f), filter_freq_(1000.0f) {
+    : initialized_(false), delay_time_(100.0f), feedback_(0.3f), mix_(0.5f), filter_freq_(1000.0f),
+      spread_(0.0f), sample_rate_(44100), channels_(2), frame_size_(1024), hop_size_(256) {
     // 初始化音频频谱延迟器
 }
 
@@ -16,7 +18,9 @@ AudioSpectralDelay::~AudioSpectralDelay() {
 bool AudioSpectralDelay::initialize() {
     std::cout << "Initializing audio spectral delay" << std::endl;
     
-    // 在实际实现中，这里会初始化频谱延迟器
+    if (!configure()) {
+        return false;
+    }
     
     initialized_ = true;
     return true;
@@ -26,27 +30,34 @@ void AudioSpectralDelay::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio spectral delay" << std::endl;
         
-        // 在实际实现中，这里会关闭频谱延迟器
-        
         initialized_ = false;
     }
 }
 
 bool AudioSpectralDelay::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio spectral delay effect" << std::endl;
-    
-    // 在实际实现中，这里会应用频谱延迟效果
+    if (&output != &input) {
+        output = input;
+    }
+    stft_.process(output.data(), output.size() / static_cast<size_t>(channels_), kernel_);
+    return true;
+}
+
+bool AudioSpectralDelay::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    stft_.process(view.data(), view.frames(), kernel_);
     return true;
 }
 
 bool AudioSpectralDelay::setParameters(float delay_time, float feedback, float mix, float filter_freq) {
-    if (!initialized_) {
+    if (!initialized_ || delay_time < 1.0f || delay_time > kMaxDelay ||
+        std::fabs(feedback) > 0.95f || mix < 0.0f || mix > 1.0f || filter_freq <= 0.0f) {
         return false;
     }
     
@@ -54,12 +65,11 @@ bool AudioSpectralDelay::setParameters(float delay_time, float feedback, float m
               << " ms, Feedback: " << feedback << ", Mix: " << mix 
               << ", Filter freq: " << filter_freq << " Hz" << std::endl;
     
-    // 在实际实现中，这里会设置频谱延迟参数
-    
     delay_time_ = delay_time;
     feedback_ = feedback;
     mix_ = mix;
     filter_freq_ = filter_freq;
+    updateKernel();
     return true;
 }
 
@@ -70,17 +80,77 @@ void AudioSpectralDelay::getParameters(float& delay_time, float& feedback, float
     filter_freq = filter_freq_;
 }
 
+bool AudioSpectralDelay::setSpread(float spread) {
+    if (spread < -1.0f || spread > 1.0f) {
+        return false;
+    }
+    
+    spread_ = spread;
+    if (initialized_) {
+        updateKernel();
+    }
+    return true;
+}
+
+bool AudioSpectralDelay::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    return !initialized_ || configure();
+}
+
+bool AudioSpectralDelay::setResolution(size_t frame_size, size_t hop_size) {
+    const size_t old_frame = frame_size_;
+    const size_t old_hop = hop_size_;
+    frame_size_ = frame_size;
+    hop_size_ = hop_size;
+    if (initialized_ && !configure()) {
+        frame_size_ = old_frame;
+        hop_size_ = old_hop;
+        configure();
+        return false;
+    }
+    return true;
+}
+
+size_t AudioSpectralDelay::getLatency() const {
+    return frame_size_;
+}
+
 void AudioSpectralDelay::reset() {
     if (initialized_) {
         std::cout << "Resetting audio spectral delay" << std::endl;
         
-        // 在实际实现中，这里会重置频谱延迟器
-        
         delay_time_ = 100.0f;
         feedback_ = 0.3f;
         mix_ = 0.5f;
         filter_freq_ = 1000.0f;
+        spread_ = 0.0f;
+        stft_.reset();
+        kernel_.clear();
+        updateKernel();
+    }
+}
+
+bool AudioSpectralDelay::configure() {
+    if (!stft_.configure(static_cast<size_t>(channels_), frame_size_, hop_size_)) {
+        return false;
     }
+    
+    const float frames_per_ms = static_cast<float>(sample_rate_) / (1000.0f * static_cast<float>(hop_size_));
+    kernel_.prepare(static_cast<size_t>(channels_), stft_.getBinCount(),
+                    static_cast<size_t>(std::ceil(kMaxDelay * frames_per_ms)));
+    updateKernel();
+    return true;
+}
+
+void AudioSpectralDelay::updateKernel() {
+    const float frames = delay_time_ * static_cast<float>(sample_rate_) / (1000.0f * static_cast<float>(hop_size_));
+    kernel_.setDelay(frames, spread_);
+    kernel_.setGains(feedback_, mix_, filter_freq_ * static_cast<float>(frame_size_) / static_cast<float>(sample_rate_));
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
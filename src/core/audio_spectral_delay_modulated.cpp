@@ -1,11 +1,43 @@
 #include "core/audio_spectral_delay_modulated.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
+namespace {
+
+// 每帧开始时推进LFO并缩放延迟，频点处理直接转发给延迟核
+struct ModulatedDelayFrame {
+    spectral::DelayKernel& kernel;
+    spectral::FrameLfo& lfo;
+    const modulation::ModulationParameters& params;
+    float seconds;
+
+    void beginFrame() {
+        kernel.setScale(1.0f + 0.5f * params.depth * lfo.advance(params, seconds));
+        kernel.beginFrame();
+    }
+
+    void processBins(size_t channel, float* re, float* im, size_t bins) {
+        kernel.processBins(channel, re, im, bins);
+    }
+};
+
+modulation::ModulationParameters defaultParameters() {
+    modulation::ModulationParameters params;
+    params.rate = 0.5f;
+    params.depth = 0.3f;
+    params.feedback = 0.3f;
+    params.mix = 0.5f;
+    return params;
+}
+
+} // namespace
+
 AudioSpectralDelayModulated::AudioSpectralDelayModulated() 
-    : initialized_(false), delay_time_(100.0f), feedback_(0.3f), mix_(0.5f), filter_freq_(1000.0f),
-      modulation_rate_(0.5f), modulation_depth_(0.3f) {
+    : initialized_(false), delay_time_(100.0f), filter_freq_(1000.0f), params_(defaultParameters()),
+      sample_rate_(44100), channels_(2), frame_size_(1024), hop_size_(256) {
     // 初始化音频调制频谱延迟器
 }
 
@@ -17,7 +49,9 @@ AudioSpectralDelayModulated::~AudioSpectralDelayModulated() {
 bool AudioSpectralDelayModulated::initialize() {
     std::cout << "Initializing audio spectral delay modulated" << std::endl;
     
-    // 在实际实现中，这里会初始化调制频谱延迟器
+    if (!configure()) {
+        return false;
+    }
     
     initialized_ = true;
     return true;
@@ -27,27 +61,41 @@ void AudioSpectralDelayModulated::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio spectral delay modulated" << std::endl;
         
-        // 在实际实现中，这里会关闭调制频谱延迟器
-        
         initialized_ = false;
     }
 }
 
 bool AudioSpectralDelayModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio spectral delay modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制频谱延迟效果
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / static_cast<size_t>(channels_));
+    return true;
+}
+
+bool AudioSpectralDelayModulated::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    processFrames(view.data(), view.frames());
     return true;
 }
 
+void AudioSpectralDelayModulated::processFrames(float* data, size_t frames) {
+    ModulatedDelayFrame frame{kernel_, lfo_, params_,
+                              static_cast<float>(hop_size_) / static_cast<float>(sample_rate_)};
+    stft_.process(data, frames, frame);
+}
+
 bool AudioSpectralDelayModulated::setParameters(float delay_time, float feedback, float mix, float filter_freq, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
+    if (!initialized_ || delay_time < 1.0f || delay_time > kMaxDelay ||
+        std::fabs(feedback) > 0.95f || mix < 0.0f || mix > 1.0f || filter_freq <= 0.0f ||
+        modulation_rate < 0.0f || modulation_rate > 20.0f || modulation_depth < 0.0f || modulation_depth > 1.0f) {
         return false;
     }
     
@@ -57,39 +105,119 @@ bool AudioSpectralDelayModulated::setParameters(float delay_time, float feedback
               << ", Modulation rate: " << modulation_rate << " Hz"
               << ", Modulation depth: " << modulation_depth << std::endl;
     
-    // 在实际实现中，这里会设置调制频谱延迟参数
-    
     delay_time_ = delay_time;
-    feedback_ = feedback;
-    mix_ = mix;
     filter_freq_ = filter_freq;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
+    params_.feedback = feedback;
+    params_.mix = mix;
+    params_.rate = modulation_rate;
+    params_.depth = modulation_depth;
+    updateKernel();
     return true;
 }
 
 void AudioSpectralDelayModulated::getParameters(float& delay_time, float& feedback, float& mix, float& filter_freq, float& modulation_rate, float& modulation_depth) const {
     delay_time = delay_time_;
-    feedback = feedback_;
-    mix = mix_;
+    feedback = params_.feedback;
+    mix = params_.mix;
     filter_freq = filter_freq_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
+    modulation_rate = params_.rate;
+    modulation_depth = params_.depth;
+}
+
+bool AudioSpectralDelayModulated::setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth, float lfo_waveform) {
+    if (!initialized_) {
+        return false;
+    }
+    
+    std::cout << "Setting spectral delay modulated parameters - Rate: " << rate
+              << " Hz, Depth: " << depth << ", Feedback: " << feedback << ", Mix: " << mix
+              << ", Modulation rate: " << modulation_rate << " Hz"
+              << ", Modulation depth: " << modulation_depth
+              << ", LFO waveform: " << lfo_waveform << std::endl;
+    
+    const int waveform = std::clamp(static_cast<int>(lfo_waveform + 0.5f), 0,
+                                    static_cast<int>(modulation::LfoWaveform::SAMPLE_HOLD));
+    params_.rate = std::clamp(rate, 0.0f, 20.0f);
+    params_.depth = std::clamp(depth, 0.0f, 1.0f);
+    params_.feedback = std::clamp(feedback, -0.95f, 0.95f);
+    params_.mix = std::clamp(mix, 0.0f, 1.0f);
+    params_.modulation_rate = std::clamp(modulation_rate, 0.0f, 20.0f);
+    params_.modulation_depth = std::clamp(modulation_depth, 0.0f, 1.0f);
+    params_.waveform = static_cast<modulation::LfoWaveform>(waveform);
+    updateKernel();
+    return true;
+}
+
+void AudioSpectralDelayModulated::getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth, float& lfo_waveform) const {
+    rate = params_.rate;
+    depth = params_.depth;
+    feedback = params_.feedback;
+    mix = params_.mix;
+    modulation_rate = params_.modulation_rate;
+    modulation_depth = params_.modulation_depth;
+    lfo_waveform = static_cast<float>(params_.waveform);
+}
+
+bool AudioSpectralDelayModulated::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    return !initialized_ || configure();
+}
+
+bool AudioSpectralDelayModulated::setResolution(size_t frame_size, size_t hop_size) {
+    const size_t old_frame = frame_size_;
+    const size_t old_hop = hop_size_;
+    frame_size_ = frame_size;
+    hop_size_ = hop_size;
+    if (initialized_ && !configure()) {
+        frame_size_ = old_frame;
+        hop_size_ = old_hop;
+        configure();
+        return false;
+    }
+    return true;
+}
+
+size_t AudioSpectralDelayModulated::getLatency() const {
+    return frame_size_;
 }
 
 void AudioSpectralDelayModulated::reset() {
     if (initialized_) {
         std::cout << "Resetting audio spectral delay modulated" << std::endl;
         
-        // 在实际实现中，这里会重置调制频谱延迟器
-        
         delay_time_ = 100.0f;
-        feedback_ = 0.3f;
-        mix_ = 0.5f;
         filter_freq_ = 1000.0f;
-        modulation_rate_ = 0.5f;
-        modulation_depth_ = 0.3f;
+        params_ = defaultParameters();
+        stft_.reset();
+        kernel_.clear();
+        lfo_.reset();
+        updateKernel();
+    }
+}
+
+bool AudioSpectralDelayModulated::configure() {
+    if (!stft_.configure(static_cast<size_t>(channels_), frame_size_, hop_size_)) {
+        return false;
     }
+    
+    // 调制最多把延迟放大1.5倍
+    const float frames_per_ms = static_cast<float>(sample_rate_) / (1000.0f * static_cast<float>(hop_size_));
+    kernel_.prepare(static_cast<size_t>(channels_), stft_.getBinCount(),
+                    static_cast<size_t>(std::ceil(1.5f * kMaxDelay * frames_per_ms)));
+    updateKernel();
+    return true;
+}
+
+void AudioSpectralDelayModulated::updateKernel() {
+    const float frames = delay_time_ * static_cast<float>(sample_rate_) / (1000.0f * static_cast<float>(hop_size_));
+    kernel_.setDelay(frames, 0.0f);
+    kernel_.setGains(params_.feedback, params_.mix,
+                     filter_freq_ * static_cast<float>(frame_size_) / static_cast<float>(sample_rate_));
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
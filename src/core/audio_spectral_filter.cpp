@@ -4,7 +4,8 @@
 namespace core {
 
 AudioSpectralFilter::AudioSpectralFilter() 
-    : initialized_(false), frequency_(1000.0f), q_factor_(1.0f), filter_type_(0) {
+    : initialized_(false), frequency_(1000.0f), q_factor_(1.0f), filter_type_(0),
+      sample_rate_(44100), channels_(2), frame_size_(1024), hop_size_(256) {
     // 初始化音频频谱滤波器
 }
 
@@ -16,7 +17,9 @@ AudioSpectralFilter::~AudioSpectralFilter() {
 bool AudioSpectralFilter::initialize() {
     std::cout << "Initializing audio spectral filter" << std::endl;
     
-    // 在实际实现中，这里会初始化频谱滤波器
+    if (!configure()) {
+        return false;
+    }
     
     initialized_ = true;
     return true;
@@ -26,38 +29,44 @@ void AudioSpectralFilter::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio spectral filter" << std::endl;
         
-        // 在实际实现中，这里会关闭频谱滤波器
-        
         initialized_ = false;
     }
 }
 
 bool AudioSpectralFilter::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio spectral filter effect" << std::endl;
-    
-    // 在实际实现中，这里会应用频谱滤波效果
+    if (&output != &input) {
+        output = input;
+    }
+    stft_.process(output.data(), output.size() / static_cast<size_t>(channels_), kernel_);
+    return true;
+}
+
+bool AudioSpectralFilter::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    stft_.process(view.data(), view.frames(), kernel_);
     return true;
 }
 
 bool AudioSpectralFilter::setParameters(float frequency, float q_factor, int filter_type) {
-    if (!initialized_) {
+    if (!initialized_ || frequency <= 0.0f || q_factor < 0.1f || q_factor > 20.0f ||
+        filter_type < spectral::FilterKernel::LOWPASS || filter_type > spectral::FilterKernel::BANDPASS) {
         return false;
     }
     
     std::cout << "Setting spectral filter parameters - Frequency: " << frequency 
               << " Hz, Q-factor: " << q_factor << ", Type: " << filter_type << std::endl;
     
-    // 在实际实现中，这里会设置频谱滤波参数
-    
     frequency_ = frequency;
     q_factor_ = q_factor;
     filter_type_ = filter_type;
+    kernel_.design(filter_type_, frequency_, q_factor_, 1.0f);
     return true;
 }
 
@@ -67,16 +76,54 @@ void AudioSpectralFilter::getParameters(float& frequency, float& q_factor, int&
     filter_type = filter_type_;
 }
 
+bool AudioSpectralFilter::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    return !initialized_ || configure();
+}
+
+bool AudioSpectralFilter::setResolution(size_t frame_size, size_t hop_size) {
+    const size_t old_frame = frame_size_;
+    const size_t old_hop = hop_size_;
+    frame_size_ = frame_size;
+    hop_size_ = hop_size;
+    if (initialized_ && !configure()) {
+        frame_size_ = old_frame;
+        hop_size_ = old_hop;
+        configure();
+        return false;
+    }
+    return true;
+}
+
+size_t AudioSpectralFilter::getLatency() const {
+    return frame_size_;
+}
+
 void AudioSpectralFilter::reset() {
     if (initialized_) {
         std::cout << "Resetting audio spectral filter" << std::endl;
         
-        // 在实际实现中，这里会重置频谱滤波器
-        
         frequency_ = 1000.0f;
         q_factor_ = 1.0f;
         filter_type_ = 0;
+        stft_.reset();
+        kernel_.design(filter_type_, frequency_, q_factor_, 1.0f);
     }
 }
 
-} // namespace core
\ No newline at end of file
+bool AudioSpectralFilter::configure() {
+    if (!stft_.configure(static_cast<size_t>(channels_), frame_size_, hop_size_)) {
+        return false;
+    }
+    
+    kernel_.prepare(sample_rate_, frame_size_);
+    kernel_.design(filter_type_, frequency_, q_factor_, 1.0f);
+    return true;
+}
+
+} // namespace core
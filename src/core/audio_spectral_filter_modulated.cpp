@@ -1,11 +1,48 @@
 #include "core/audio_spectral_filter_modulated.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
+namespace {
+
+// 调制扫动范围（八度）
+const float kSweepOctaves = 2.0f;
+
+// 每帧开始时推进LFO并重算掩码，频点处理直接转发给滤波核
+struct ModulatedFilterFrame {
+    spectral::FilterKernel& kernel;
+    spectral::FrameLfo& lfo;
+    const modulation::ModulationParameters& params;
+    float seconds;
+    float frequency;
+    float q;
+    int type;
+
+    void beginFrame() {
+        const float octaves = kSweepOctaves * params.depth * lfo.advance(params, seconds);
+        kernel.design(type, frequency * std::exp2(octaves), q, params.mix);
+    }
+
+    void processBins(size_t channel, float* re, float* im, size_t bins) {
+        kernel.processBins(channel, re, im, bins);
+    }
+};
+
+modulation::ModulationParameters defaultParameters() {
+    modulation::ModulationParameters params;
+    params.rate = 1.0f;
+    params.depth = 0.3f;
+    params.mix = 1.0f;
+    return params;
+}
+
+} // namespace
+
 AudioSpectralFilterModulated::AudioSpectralFilterModulated() 
-    : initialized_(false), frequency_(1000.0f), q_factor_(1.0f), filter_type_(0),
-      modulation_rate_(1.0f), modulation_depth_(0.3f) {
+    : initialized_(false), frequency_(1000.0f), q_factor_(1.0f), filter_type_(0), params_(defaultParameters()),
+      sample_rate_(44100), channels_(2), frame_size_(1024), hop_size_(256) {
     // 初始化音频调制频谱滤波器
 }
 
@@ -17,7 +54,9 @@ AudioSpectralFilterModulated::~AudioSpectralFilterModulated() {
 bool AudioSpectralFilterModulated::initialize() {
     std::cout << "Initializing audio spectral filter modulated" << std::endl;
     
-    // 在实际实现中，这里会初始化调制频谱滤波器
+    if (!configure()) {
+        return false;
+    }
     
     initialized_ = true;
     return true;
@@ -27,27 +66,42 @@ void AudioSpectralFilterModulated::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio spectral filter modulated" << std::endl;
         
-        // 在实际实现中，这里会关闭调制频谱滤波器
-        
         initialized_ = false;
     }
 }
 
 bool AudioSpectralFilterModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
     
-    std::cout << "Applying audio spectral filter modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制频谱滤波效果
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / static_cast<size_t>(channels_));
+    return true;
+}
+
+bool AudioSpectralFilterModulated::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
     
-    output = input;  // 模拟处理
+    processFrames(view.data(), view.frames());
     return true;
 }
 
+void AudioSpectralFilterModulated::processFrames(float* data, size_t frames) {
+    ModulatedFilterFrame frame{kernel_, lfo_, params_,
+                               static_cast<float>(hop_size_) / static_cast<float>(sample_rate_),
+                               frequency_, q_factor_, filter_type_};
+    stft_.process(data, frames, frame);
+}
+
 bool AudioSpectralFilterModulated::setParameters(float frequency, float q_factor, int filter_type, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
+    if (!initialized_ || frequency <= 0.0f || q_factor < 0.1f || q_factor > 20.0f ||
+        filter_type < spectral::FilterKernel::LOWPASS || filter_type > spectral::FilterKernel::BANDPASS ||
+        modulation_rate < 0.0f || modulation_rate > 20.0f || modulation_depth < 0.0f || modulation_depth > 1.0f) {
         return false;
     }
     
@@ -56,13 +110,11 @@ bool AudioSpectralFilterModulated::setParameters(float frequency, float q_factor
               << ", Modulation rate: " << modulation_rate << " Hz"
               << ", Modulation depth: " << modulation_depth << std::endl;
     
-    // 在实际实现中，这里会设置调制频谱滤波参数
-    
     frequency_ = frequency;
     q_factor_ = q_factor;
     filter_type_ = filter_type;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
+    params_.rate = modulation_rate;
+    params_.depth = modulation_depth;
     return true;
 }
 
@@ -70,22 +122,92 @@ void AudioSpectralFilterModulated::getParameters(float& frequency, float& q_fact
     frequency = frequency_;
     q_factor = q_factor_;
     filter_type = filter_type_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
+    modulation_rate = params_.rate;
+    modulation_depth = params_.depth;
+}
+
+bool AudioSpectralFilterModulated::setParameters(float rate, float depth, float feedback, float mix, float modulation_rate, float modulation_depth, float lfo_waveform) {
+    if (!initialized_) {
+        return false;
+    }
+    
+    std::cout << "Setting spectral filter modulated parameters - Rate: " << rate
+              << " Hz, Depth: " << depth << ", Feedback: " << feedback << ", Mix: " << mix
+              << ", Modulation rate: " << modulation_rate << " Hz"
+              << ", Modulation depth: " << modulation_depth
+              << ", LFO waveform: " << lfo_waveform << std::endl;
+    
+    const int waveform = std::clamp(static_cast<int>(lfo_waveform + 0.5f), 0,
+                                    static_cast<int>(modulation::LfoWaveform::SAMPLE_HOLD));
+    params_.rate = std::clamp(rate, 0.0f, 20.0f);
+    params_.depth = std::clamp(depth, 0.0f, 1.0f);
+    params_.feedback = std::clamp(feedback, -0.95f, 0.95f);
+    params_.mix = std::clamp(mix, 0.0f, 1.0f);
+    params_.modulation_rate = std::clamp(modulation_rate, 0.0f, 20.0f);
+    params_.modulation_depth = std::clamp(modulation_depth, 0.0f, 1.0f);
+    params_.waveform = static_cast<modulation::LfoWaveform>(waveform);
+    q_factor_ = 0.707f / (1.0f - std::fabs(params_.feedback));
+    return true;
+}
+
+void AudioSpectralFilterModulated::getParameters(float& rate, float& depth, float& feedback, float& mix, float& modulation_rate, float& modulation_depth, float& lfo_waveform) const {
+    rate = params_.rate;
+    depth = params_.depth;
+    feedback = params_.feedback;
+    mix = params_.mix;
+    modulation_rate = params_.modulation_rate;
+    modulation_depth = params_.modulation_depth;
+    lfo_waveform = static_cast<float>(params_.waveform);
+}
+
+bool AudioSpectralFilterModulated::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    return !initialized_ || configure();
+}
+
+bool AudioSpectralFilterModulated::setResolution(size_t frame_size, size_t hop_size) {
+    const size_t old_frame = frame_size_;
+    const size_t old_hop = hop_size_;
+    frame_size_ = frame_size;
+    hop_size_ = hop_size;
+    if (initialized_ && !configure()) {
+        frame_size_ = old_frame;
+        hop_size_ = old_hop;
+        configure();
+        return false;
+    }
+    return true;
+}
+
+size_t AudioSpectralFilterModulated::getLatency() const {
+    return frame_size_;
 }
 
 void AudioSpectralFilterModulated::reset() {
     if (initialized_) {
         std::cout << "Resetting audio spectral filter modulated" << std::endl;
         
-        // 在实际实现中，这里会重置调制频谱滤波器
-        
         frequency_ = 1000.0f;
         q_factor_ = 1.0f;
         filter_type_ = 0;
-        modulation_rate_ = 1.0f;
-        modulation_depth_ = 0.3f;
+        params_ = defaultParameters();
+        stft_.reset();
+        lfo_.reset();
     }
 }
 
-} // namespace core
\ No newline at end of file
+bool AudioSpectralFilterModulated::configure() {
+    if (!stft_.configure(static_cast<size_t>(channels_), frame_size_, hop_size_)) {
+        return false;
+    }
+    
+    kernel_.prepare(sample_rate_, frame_size_);
+    return true;
+}
+
+} // namespace core
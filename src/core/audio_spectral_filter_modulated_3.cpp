@@ -1,76 +0,0 @@
-#include "core/audio_spectral_filter_modulated_3.h"
-#include <cmath>
-
-namespace core {
-
-AudioSpectralFilterModulated3::AudioSpectralFilterModulated3()
-    : initialized_(false),
-      rate_(0.0f),
-      depth_(0.0f),
-      feedback_(0.0f),
-      mix_(0.0f),
-      modulation_rate_(0.0f),
-      modulation_depth_(0.0f),
-      lfo_waveform_(0.0f) {
-}
-
-AudioSpectralFilterModulated3::~AudioSpectralFilterModulated3() {
-    shutdown();
-}
-
-bool AudioSpectralFilterModulated3::initialize() {
-    // 初始化调制频谱滤波器
-    initialized_ = true;
-    return true;
-}
-
-void AudioSpectralFilterModulated3::shutdown() {
-    // 关闭调制频谱滤波器
-    initialized_ = false;
-}
-
-bool AudioSpectralFilterModulated3::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
-        return false;
-    }
-
-    // 简单的实现：返回输入信号
-    output = input;
-    return true;
-}
-
-bool AudioSpectralFilterModulated3::setParameters(float rate, float depth, float feedback, float mix,
-                                                 float modulation_rate, float modulation_depth, float lfo_waveform) {
-    rate_ = rate;
-    depth_ = depth;
-    feedback_ = feedback;
-    mix_ = mix;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
-    lfo_waveform_ = lfo_waveform;
-    return true;
-}
-
-void AudioSpectralFilterModulated3::getParameters(float& rate, float& depth, float& feedback, float& mix,
-                                                 float& modulation_rate, float& modulation_depth, float& lfo_waveform) const {
-    rate = rate_;
-    depth = depth_;
-    feedback = feedback_;
-    mix = mix_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
-    lfo_waveform = lfo_waveform_;
-}
-
-void AudioSpectralFilterModulated3::reset() {
-    // 重置调制频谱滤波器
-    rate_ = 0.0f;
-    depth_ = 0.0f;
-    feedback_ = 0.0f;
-    mix_ = 0.0f;
-    modulation_rate_ = 0.0f;
-    modulation_depth_ = 0.0f;
-    lfo_waveform_ = 0.0f;
-}
-
-} // namespace core
\ No newline at end of file
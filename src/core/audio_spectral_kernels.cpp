@@ -0,0 +1,181 @@
+#include "core/audio_spectral_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+namespace spectral {
+
+FrameLfo::FrameLfo()
+    : phase_(0.0f), cycle_(0), rate_phase_(0.0f) {
+}
+
+float FrameLfo::advance(const modulation::ModulationParameters& params, float seconds) {
+    float value = 0.0f;
+    switch (params.waveform) {
+        case modulation::LfoWaveform::TRIANGLE: value = modulation::TriangleLfo::value(phase_, cycle_); break;
+        case modulation::LfoWaveform::SQUARE: value = modulation::SquareLfo::value(phase_, cycle_); break;
+        case modulation::LfoWaveform::SAWTOOTH: value = modulation::SawtoothLfo::value(phase_, cycle_); break;
+        case modulation::LfoWaveform::SAMPLE_HOLD: value = modulation::SampleHoldLfo::value(phase_, cycle_); break;
+        default: value = modulation::SineLfo::value(phase_, cycle_); break;
+    }
+
+    float rate = params.rate;
+    if (params.modulation_depth > 0.0f && params.modulation_rate > 0.0f) {
+        rate *= 1.0f + params.modulation_depth * modulation::fastSine(rate_phase_);
+        rate_phase_ += params.modulation_rate * seconds;
+        rate_phase_ -= std::floor(rate_phase_);
+    }
+
+    const float end = phase_ + rate * seconds;
+    const float whole = std::floor(end);
+    phase_ = end - whole;
+    cycle_ += static_cast<uint32_t>(whole);
+    return value;
+}
+
+void FrameLfo::reset() {
+    phase_ = 0.0f;
+    cycle_ = 0;
+    rate_phase_ = 0.0f;
+}
+
+FilterKernel::FilterKernel()
+    : bin_hz_(0.0f) {
+}
+
+void FilterKernel::prepare(int sample_rate, size_t frame_size) {
+    mask_.assign(frame_size / 2 + 1, 1.0f);
+    bin_hz_ = static_cast<float>(sample_rate) / static_cast<float>(frame_size);
+}
+
+void FilterKernel::design(int type, float frequency, float q, float mix) {
+    // |H|由归一化频率x = f / fc给出：低通1/D，高通x^2/D，带通(x/Q)/D，D = sqrt((1-x^2)^2 + (x/Q)^2)
+    const float inv_fc = bin_hz_ / std::max(frequency, 1.0f);
+    const float inv_q = 1.0f / std::max(q, 0.1f);
+    const float dry = 1.0f - mix;
+    const size_t bins = mask_.size();
+    float* mask = mask_.data();
+    for (size_t k = 0; k < bins; ++k) {
+        const float x = static_cast<float>(k) * inv_fc;
+        const float x2 = x * x;
+        const float xq = x * inv_q;
+        const float inv_d = 1.0f / std::sqrt((1.0f - x2) * (1.0f - x2) + xq * xq);
+        const float num = type == HIGHPASS ? x2 : (type == BANDPASS ? xq : 1.0f);
+        mask[k] = dry + mix * num * inv_d;
+    }
+}
+
+DelayKernel::DelayKernel()
+    : channels_(0), bins_(0), slots_(0), max_delay_(0), frame_(0),
+      delay_(1.0f), spread_(0.0f), scale_(1.0f), dry_(1.0f) {
+}
+
+void DelayKernel::prepare(size_t channels, size_t bins, size_t max_delay) {
+    channels_ = channels;
+    bins_ = bins;
+    max_delay_ = std::max<size_t>(max_delay, 1);
+    slots_ = 1;
+    while (slots_ <= max_delay_) {
+        slots_ <<= 1;
+    }
+
+    feedback_.assign(bins, 0.0f);
+    wet_.assign(bins, 0.0f);
+    runs_.clear();
+    runs_.reserve(bins);
+    history_re_.assign(channels * slots_ * bins, 0.0f);
+    history_im_.assign(channels * slots_ * bins, 0.0f);
+    frame_ = 0;
+    updateDelays();
+}
+
+void DelayKernel::setDelay(float delay, float spread) {
+    delay_ = delay;
+    spread_ = std::clamp(spread, -1.0f, 1.0f);
+    updateDelays();
+}
+
+void DelayKernel::setScale(float scale) {
+    if (scale != scale_) {
+        scale_ = scale;
+        updateDelays();
+    }
+}
+
+void DelayKernel::setGains(float feedback, float mix, float cutoff_bin) {
+    // 二阶巴特沃斯幅频响应：反馈路径每经过一次衰减一次，回声越来越暗
+    const float inv_cutoff = 1.0f / std::max(cutoff_bin, 0.5f);
+    dry_ = 1.0f - mix;
+    for (size_t k = 0; k < bins_; ++k) {
+        const float x = static_cast<float>(k) * inv_cutoff;
+        const float lowpass = 1.0f / std::sqrt(1.0f + x * x * x * x);
+        feedback_[k] = feedback * lowpass;
+        wet_[k] = mix * lowpass;
+    }
+}
+
+void DelayKernel::clear() {
+    std::fill(history_re_.begin(), history_re_.end(), 0.0f);
+    std::fill(history_im_.begin(), history_im_.end(), 0.0f);
+    frame_ = 0;
+}
+
+void DelayKernel::updateDelays() {
+    runs_.clear();
+    if (bins_ == 0) {
+        return;
+    }
+
+    const float base = delay_ * scale_;
+    const float slope = bins_ > 1 ? 2.0f / static_cast<float>(bins_ - 1) : 0.0f;
+    for (size_t k = 0; k < bins_; ++k) {
+        const float tilt = 1.0f + spread_ * (static_cast<float>(k) * slope - 1.0f);
+        const long rounded = std::lround(base * tilt);
+        const size_t delay = static_cast<size_t>(std::clamp<long>(rounded, 1, static_cast<long>(max_delay_)));
+        if (!runs_.empty() && runs_.back().delay == delay) {
+            runs_.back().end = k + 1;
+        } else {
+            runs_.push_back({k, k + 1, delay});
+        }
+    }
+}
+
+void DelayKernel::processRun(float* __restrict re, float* __restrict im,
+                             const float* __restrict delayed_re, const float* __restrict delayed_im,
+                             float* __restrict hist_re, float* __restrict hist_im,
+                             const float* __restrict feedback, const float* __restrict wet,
+                             float dry, size_t count) {
+    for (size_t k = 0; k < count; ++k) {
+        const float xr = re[k];
+        const float xi = im[k];
+        const float dr = delayed_re[k];
+        const float di = delayed_im[k];
+        hist_re[k] = xr + feedback[k] * dr;
+        hist_im[k] = xi + feedback[k] * di;
+        re[k] = dry * xr + wet[k] * dr;
+        im[k] = dry * xi + wet[k] * di;
+    }
+}
+
+void DelayKernel::processBins(size_t channel, float* re, float* im, size_t bins) {
+    if (channel >= channels_ || bins != bins_) {
+        return;
+    }
+
+    // 延迟至少1帧，读取槽与写入槽不会重合
+    const size_t mask = slots_ - 1;
+    const size_t base = channel * slots_;
+    float* write_re = history_re_.data() + (base + (frame_ & mask)) * bins;
+    float* write_im = history_im_.data() + (base + (frame_ & mask)) * bins;
+    for (const Run& run : runs_) {
+        const size_t read = (base + ((frame_ - run.delay) & mask)) * bins;
+        processRun(re + run.begin, im + run.begin,
+                   history_re_.data() + read + run.begin, history_im_.data() + read + run.begin,
+                   write_re + run.begin, write_im + run.begin,
+                   feedback_.data() + run.begin, wet_.data() + run.begin,
+                   dry_, run.end - run.begin);
+    }
+}
+
+} // namespace spectral
+} // namespace core
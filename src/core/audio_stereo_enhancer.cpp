@@ -3,8 +3,9 @@
 
 namespace core {
 
-AudioStereoEnhancer::AudioStereoEnhancer() 
-    : initialized_(false), stereo_width_(0.5f), stereo_imbalance_(0.0f), mix_(0.5f) {
+AudioStereoEnhancer::AudioStereoEnhancer()
+    : initialized_(false), stereo_width_(1.2f), stereo_imbalance_(0.0f), mix_(1.0f),
+      sample_rate_(44100), haas_delay_(12.0f), decorrelation_(0.3f), bass_mono_freq_(120.0f) {
     // 初始化音频立体声增强器
 }
 
@@ -15,9 +16,13 @@ AudioStereoEnhancer::~AudioStereoEnhancer() {
 
 bool AudioStereoEnhancer::initialize() {
     std::cout << "Initializing audio stereo enhancer" << std::endl;
-    
-    // 在实际实现中，这里会初始化立体声增强器
-    
+
+    current_ = stereo::makeMidSideMatrix(1.0f, stereo_width_, stereo_imbalance_, mix_);
+    haas_.prepare(kMaxHaasDelay, sample_rate_);
+    haas_.setDelay(haas_delay_, sample_rate_);
+    bass_mono_.setCutoff(bass_mono_freq_, sample_rate_);
+    bass_mono_.reset();
+
     initialized_ = true;
     return true;
 }
@@ -25,36 +30,58 @@ bool AudioStereoEnhancer::initialize() {
 void AudioStereoEnhancer::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio stereo enhancer" << std::endl;
-        
-        // 在实际实现中，这里会关闭立体声增强器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioStereoEnhancer::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % 2 != 0) {
+        return false;
+    }
+
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / 2);
+    return true;
+}
+
+bool AudioStereoEnhancer::process(AudioView view) {
+    if (!initialized_ || view.channels() != 2) {
         return false;
     }
-    
-    std::cout << "Applying audio stereo enhancer effect" << std::endl;
-    
-    // 在实际实现中，这里会应用立体声增强效果
-    
-    output = input;  // 模拟处理
+
+    processFrames(view.data(), view.frames());
     return true;
 }
 
+void AudioStereoEnhancer::processFrames(float* data, size_t frames) {
+    // 宽度/平衡/混合合并为一次矩阵运算，之后加入去相关分量，最后收拢低频侧边信号
+    const stereo::StereoMatrix target =
+        stereo::makeMidSideMatrix(1.0f, stereo_width_, stereo_imbalance_, mix_);
+    stereo::applyStereoMatrix(data, frames, current_, target);
+    if (frames > 0) {
+        current_ = target;
+    }
+
+    haas_.process(data, frames, decorrelation_ * mix_);
+    bass_mono_.process(data, frames, mix_);
+}
+
 bool AudioStereoEnhancer::setParameters(float stereo_width, float stereo_imbalance, float mix) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting stereo enhancer parameters - Stereo width: " << stereo_width 
+    if (stereo_width < 0.0f || stereo_width > 2.0f ||
+        stereo_imbalance < -1.0f || stereo_imbalance > 1.0f ||
+        mix < 0.0f || mix > 1.0f) {
+        return false;
+    }
+
+    std::cout << "Setting stereo enhancer parameters - Stereo width: " << stereo_width
               << ", Imbalance: " << stereo_imbalance << ", Mix: " << mix << std::endl;
-    
-    // 在实际实现中，这里会设置增强参数
-    
+
     stereo_width_ = stereo_width;
     stereo_imbalance_ = stereo_imbalance;
     mix_ = mix;
@@ -67,16 +94,57 @@ void AudioStereoEnhancer::getParameters(float& stereo_width, float& stereo_imbal
     mix = mix_;
 }
 
+void AudioStereoEnhancer::setSampleRate(int sample_rate) {
+    if (sample_rate <= 0 || sample_rate == sample_rate_) {
+        return;
+    }
+
+    sample_rate_ = sample_rate;
+    haas_.prepare(kMaxHaasDelay, sample_rate_);
+    haas_.setDelay(haas_delay_, sample_rate_);
+    bass_mono_.setCutoff(bass_mono_freq_, sample_rate_);
+}
+
+bool AudioStereoEnhancer::setDecorrelation(float delay_ms, float amount) {
+    if (delay_ms < 1.0f || delay_ms > kMaxHaasDelay || amount < 0.0f || amount > 1.0f) {
+        return false;
+    }
+
+    std::cout << "Setting stereo enhancer decorrelation - Delay: " << delay_ms
+              << " ms, Amount: " << amount << std::endl;
+
+    haas_delay_ = delay_ms;
+    decorrelation_ = amount;
+    haas_.setDelay(haas_delay_, sample_rate_);
+    return true;
+}
+
+void AudioStereoEnhancer::getDecorrelation(float& delay_ms, float& amount) const {
+    delay_ms = haas_delay_;
+    amount = decorrelation_;
+}
+
+bool AudioStereoEnhancer::setBassMonoFrequency(float frequency) {
+    if (frequency < 0.0f || frequency > 1000.0f) {
+        return false;
+    }
+
+    bass_mono_freq_ = frequency;
+    bass_mono_.setCutoff(bass_mono_freq_, sample_rate_);
+    return true;
+}
+
 void AudioStereoEnhancer::reset() {
     if (initialized_) {
         std::cout << "Resetting audio stereo enhancer" << std::endl;
-        
-        // 在实际实现中，这里会重置立体声增强器
-        
-        stereo_width_ = 0.5f;
+
+        stereo_width_ = 1.2f;
         stereo_imbalance_ = 0.0f;
-        mix_ = 0.5f;
+        mix_ = 1.0f;
+        current_ = stereo::makeMidSideMatrix(1.0f, stereo_width_, stereo_imbalance_, mix_);
+        haas_.reset();
+        bass_mono_.reset();
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -3,8 +3,8 @@
 
 namespace core {
 
-AudioStereoWidener::AudioStereoWidener() 
-    : initialized_(false), width_(0.5f), mix_(0.5f) {
+AudioStereoWidener::AudioStereoWidener()
+    : initialized_(false), width_(1.0f), mix_(1.0f), sample_rate_(44100), bass_mono_freq_(0.0f) {
     // 初始化音频立体声扩展器
 }
 
@@ -15,9 +15,11 @@ AudioStereoWidener::~AudioStereoWidener() {
 
 bool AudioStereoWidener::initialize() {
     std::cout << "Initializing audio stereo widener" << std::endl;
-    
-    // 在实际实现中，这里会初始化立体声扩展器
-    
+
+    current_ = stereo::makeMidSideMatrix(1.0f, width_, 0.0f, mix_);
+    bass_mono_.setCutoff(bass_mono_freq_, sample_rate_);
+    bass_mono_.reset();
+
     initialized_ = true;
     return true;
 }
@@ -25,36 +27,53 @@ bool AudioStereoWidener::initialize() {
 void AudioStereoWidener::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio stereo widener" << std::endl;
-        
-        // 在实际实现中，这里会关闭立体声扩展器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioStereoWidener::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % 2 != 0) {
+        return false;
+    }
+
+    if (&output != &input) {
+        output = input;
+    }
+    processFrames(output.data(), output.size() / 2);
+    return true;
+}
+
+bool AudioStereoWidener::process(AudioView view) {
+    if (!initialized_ || view.channels() != 2) {
         return false;
     }
-    
-    std::cout << "Applying audio stereo widener effect" << std::endl;
-    
-    // 在实际实现中，这里会应用立体声扩展效果
-    
-    output = input;  // 模拟处理
+
+    processFrames(view.data(), view.frames());
     return true;
 }
 
+void AudioStereoWidener::processFrames(float* data, size_t frames) {
+    const stereo::StereoMatrix target = stereo::makeMidSideMatrix(1.0f, width_, 0.0f, mix_);
+    stereo::applyStereoMatrix(data, frames, current_, target);
+    if (frames > 0) {
+        current_ = target;
+    }
+
+    bass_mono_.process(data, frames, mix_);
+}
+
 bool AudioStereoWidener::setParameters(float width, float mix) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting stereo widener parameters - Width: " << width 
+    if (width < 0.0f || width > 2.0f || mix < 0.0f || mix > 1.0f) {
+        return false;
+    }
+
+    std::cout << "Setting stereo widener parameters - Width: " << width
               << ", Mix: " << mix << std::endl;
-    
-    // 在实际实现中，这里会设置立体声扩展参数
-    
+
     width_ = width;
     mix_ = mix;
     return true;
@@ -65,15 +84,36 @@ void AudioStereoWidener::getParameters(float& width, float& mix) const {
     mix = mix_;
 }
 
+void AudioStereoWidener::setSampleRate(int sample_rate) {
+    if (sample_rate > 0) {
+        sample_rate_ = sample_rate;
+        bass_mono_.setCutoff(bass_mono_freq_, sample_rate_);
+    }
+}
+
+bool AudioStereoWidener::setBassMonoFrequency(float frequency) {
+    if (frequency < 0.0f || frequency > 1000.0f) {
+        return false;
+    }
+
+    bass_mono_freq_ = frequency;
+    bass_mono_.setCutoff(bass_mono_freq_, sample_rate_);
+    return true;
+}
+
+float AudioStereoWidener::getBassMonoFrequency() const {
+    return bass_mono_freq_;
+}
+
 void AudioStereoWidener::reset() {
     if (initialized_) {
         std::cout << "Resetting audio stereo widener" << std::endl;
-        
-        // 在实际实现中，这里会重置立体声扩展器
-        
-        width_ = 0.5f;
-        mix_ = 0.5f;
+
+        width_ = 1.0f;
+        mix_ = 1.0f;
+        current_ = stereo::makeMidSideMatrix(1.0f, width_, 0.0f, mix_);
+        bass_mono_.reset();
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -0,0 +1,199 @@
+#include "core/audio_stft.h"
+#include <cmath>
+
+namespace core {
+
+namespace {
+
+const double kTwoPi = 6.283185307179586;
+
+// 周期窗（分母为N），与跳跃长度整除时叠加和为常数
+double windowValue(StftWindow window, size_t n, size_t size) {
+    const double x = kTwoPi * static_cast<double>(n) / static_cast<double>(size);
+    switch (window) {
+        case StftWindow::HAMMING: return 0.54 - 0.46 * std::cos(x);
+        case StftWindow::BLACKMAN: return 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+        default: return 0.5 - 0.5 * std::cos(x);
+    }
+}
+
+} // namespace
+
+StftEngine::StftEngine()
+    : channels_(0), frame_size_(0), hop_size_(0), bins_(0), rover_(0) {
+}
+
+bool StftEngine::configure(size_t channels, size_t frame_size, size_t hop_size, StftWindow window) {
+    if (channels == 0 || frame_size < 4 || !AudioFFT::isPowerOfTwo(frame_size) ||
+        hop_size == 0 || hop_size > frame_size / 2 || frame_size % hop_size != 0) {
+        return false;
+    }
+
+    channels_ = channels;
+    frame_size_ = frame_size;
+    hop_size_ = hop_size;
+    bins_ = frame_size / 2 + 1;
+    fft_.setSize(frame_size);
+
+    // 分析与合成使用同一窗；窗平方按跳跃长度叠加的和以hop_size为周期，合成窗除以该和
+    window_.resize(frame_size);
+    synthesis_window_.resize(frame_size);
+    std::vector<double> overlap_sum(hop_size, 0.0);
+    for (size_t n = 0; n < frame_size; ++n) {
+        const double w = windowValue(window, n, frame_size);
+        window_[n] = static_cast<float>(w);
+        overlap_sum[n % hop_size] += w * w;
+    }
+    for (size_t n = 0; n < frame_size; ++n) {
+        const double sum = overlap_sum[n % hop_size];
+        synthesis_window_[n] = sum > 0.0 ? static_cast<float>(static_cast<double>(window_[n]) / sum) : 0.0f;
+    }
+
+    input_.assign(channels * frame_size, 0.0f);
+    output_.assign(channels * hop_size, 0.0f);
+    accumulator_.assign(channels * frame_size, 0.0f);
+    fft_re_.assign(frame_size, 0.0f);
+    fft_im_.assign(frame_size, 0.0f);
+    spectrum_re_.assign(channels * bins_, 0.0f);
+    spectrum_im_.assign(channels * bins_, 0.0f);
+    rover_ = frame_size - hop_size;
+    return true;
+}
+
+size_t StftEngine::getChannels() const {
+    return channels_;
+}
+
+size_t StftEngine::getFrameSize() const {
+    return frame_size_;
+}
+
+size_t StftEngine::getHopSize() const {
+    return hop_size_;
+}
+
+size_t StftEngine::getBinCount() const {
+    return bins_;
+}
+
+size_t StftEngine::getLatency() const {
+    // 帧末样本写入后才处理该帧，帧首样本在下一跳开始时输出
+    return frame_size_;
+}
+
+void StftEngine::reset() {
+    std::fill(input_.begin(), input_.end(), 0.0f);
+    std::fill(output_.begin(), output_.end(), 0.0f);
+    std::fill(accumulator_.begin(), accumulator_.end(), 0.0f);
+    rover_ = frame_size_ - hop_size_;
+}
+
+void StftEngine::analyze(size_t first, size_t count) {
+    const size_t size = frame_size_;
+    const size_t half = size / 2;
+    const float* w = window_.data();
+    const float* x1 = input_.data() + first * size;
+    float* re = fft_re_.data();
+    float* im = fft_im_.data();
+
+    if (count == 1) {
+        for (size_t n = 0; n < size; ++n) {
+            re[n] = x1[n] * w[n];
+            im[n] = 0.0f;
+        }
+        fft_.forward(re, im);
+        std::copy(re, re + bins_, spectrum_re_.data() + first * bins_);
+        std::copy(im, im + bins_, spectrum_im_.data() + first * bins_);
+        return;
+    }
+
+    // 两个实信号打包为 z = x1 + i*x2，变换后由共轭对称性拆分：
+    // X1[k] = (Z[k] + conj(Z[N-k])) / 2，X2[k] = (Z[k] - conj(Z[N-k])) / 2i
+    const float* x2 = x1 + size;
+    for (size_t n = 0; n < size; ++n) {
+        re[n] = x1[n] * w[n];
+        im[n] = x2[n] * w[n];
+    }
+    fft_.forward(re, im);
+
+    float* re1 = spectrum_re_.data() + first * bins_;
+    float* im1 = spectrum_im_.data() + first * bins_;
+    float* re2 = re1 + bins_;
+    float* im2 = im1 + bins_;
+    re1[0] = re[0];
+    im1[0] = 0.0f;
+    re2[0] = im[0];
+    im2[0] = 0.0f;
+    for (size_t k = 1; k <= half; ++k) {
+        const size_t j = size - k;
+        re1[k] = 0.5f * (re[k] + re[j]);
+        im1[k] = 0.5f * (im[k] - im[j]);
+        re2[k] = 0.5f * (im[k] + im[j]);
+        im2[k] = 0.5f * (re[j] - re[k]);
+    }
+}
+
+void StftEngine::synthesize(size_t first, size_t count) {
+    const size_t size = frame_size_;
+    const size_t half = size / 2;
+    float* re = fft_re_.data();
+    float* im = fft_im_.data();
+    const float* re1 = spectrum_re_.data() + first * bins_;
+    const float* im1 = spectrum_im_.data() + first * bins_;
+
+    if (count == 1) {
+        // 构造共轭对称频谱（直流与奈奎斯特为实数）
+        re[0] = re1[0];
+        im[0] = 0.0f;
+        re[half] = re1[half];
+        im[half] = 0.0f;
+        for (size_t k = 1; k < half; ++k) {
+            re[k] = re1[k];
+            im[k] = im1[k];
+            re[size - k] = re1[k];
+            im[size - k] = -im1[k];
+        }
+    } else {
+        // Z[k] = X1[k] + i*X2[k]，Z[N-k] = conj(X1[k]) + i*conj(X2[k])，逆变换的实部/虚部即两个声道
+        const float* re2 = re1 + bins_;
+        const float* im2 = im1 + bins_;
+        re[0] = re1[0];
+        im[0] = re2[0];
+        re[half] = re1[half];
+        im[half] = re2[half];
+        for (size_t k = 1; k < half; ++k) {
+            re[k] = re1[k] - im2[k];
+            im[k] = im1[k] + re2[k];
+            re[size - k] = re1[k] + im2[k];
+            im[size - k] = re2[k] - im1[k];
+        }
+    }
+    fft_.inverse(re, im);
+
+    const float* w = synthesis_window_.data();
+    float* acc1 = accumulator_.data() + first * size;
+    for (size_t n = 0; n < size; ++n) {
+        acc1[n] += w[n] * re[n];
+    }
+    if (count == 2) {
+        float* acc2 = acc1 + size;
+        for (size_t n = 0; n < size; ++n) {
+            acc2[n] += w[n] * im[n];
+        }
+    }
+}
+
+void StftEngine::advance() {
+    const size_t size = frame_size_;
+    const size_t hop = hop_size_;
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        float* acc = accumulator_.data() + ch * size;
+        float* in = input_.data() + ch * size;
+        std::copy(acc, acc + hop, output_.data() + ch * hop);
+        std::copy(acc + hop, acc + size, acc);
+        std::fill(acc + size - hop, acc + size, 0.0f);
+        std::copy(in + hop, in + size, in);
+    }
+}
+
+} // namespace core
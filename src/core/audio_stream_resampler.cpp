@@ -0,0 +1,207 @@
+#include "core/audio_stream_resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace core {
+
+namespace {
+
+// 约分后的最大相位数（常见采样率之间的L不超过几百）
+const size_t kMaxPhases = 1024;
+
+// 升采样时每相位的系数数；降采样时按M/L加长以保持过渡带的相对宽度
+const size_t kBaseTaps = 32;
+const size_t kMaxTaps = 256;
+
+// 截止频率占较低奈奎斯特频率的比例
+const double kCutoff = 0.92;
+
+// Kaiser窗参数（约-90dB阻带，与过采样器一致）
+const double kKaiserBeta = 8.0;
+
+// 零阶修正贝塞尔函数（级数展开）
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double half = 0.5 * x;
+    for (int k = 1; k < 32; ++k) {
+        term *= (half / k) * (half / k);
+        sum += term;
+        if (term < 1e-12 * sum) {
+            break;
+        }
+    }
+    return sum;
+}
+
+// T点点积（T为8的倍数）
+inline float dot(const float* coefficients, const float* samples, size_t taps) {
+#if defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (size_t k = 0; k < taps; k += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(coefficients + k), _mm_loadu_ps(samples + k)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(coefficients + k + 4), _mm_loadu_ps(samples + k + 4)));
+    }
+    acc0 = _mm_add_ps(acc0, acc1);
+    acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+    acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, 1));
+    return _mm_cvtss_f32(acc0);
+#else
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t k = 0; k < taps; k += 4) {
+        acc[0] += coefficients[k] * samples[k];
+        acc[1] += coefficients[k + 1] * samples[k + 1];
+        acc[2] += coefficients[k + 2] * samples[k + 2];
+        acc[3] += coefficients[k + 3] * samples[k + 3];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+}
+
+} // namespace
+
+StreamResampler::StreamResampler()
+    : input_rate_(0), output_rate_(0), channels_(0), up_(1), down_(1), taps_(0),
+      max_output_frames_(0), max_input_frames_(0), index_(0), phase_(0) {
+}
+
+bool StreamResampler::configure(int input_rate, int output_rate, size_t channels, size_t max_output_frames) {
+    if (input_rate <= 0 || output_rate <= 0 || channels == 0) {
+        return false;
+    }
+
+    const size_t divisor = static_cast<size_t>(std::gcd(input_rate, output_rate));
+    const size_t up = static_cast<size_t>(output_rate) / divisor;
+    const size_t down = static_cast<size_t>(input_rate) / divisor;
+    if (up > kMaxPhases) {
+        return false;
+    }
+
+    input_rate_ = input_rate;
+    output_rate_ = output_rate;
+    channels_ = channels;
+    up_ = up;
+    down_ = down;
+
+    // 降采样时截止频率按L/M降低，系数数相应加长（取8的倍数）
+    const double ratio = std::min(1.0, static_cast<double>(up) / static_cast<double>(down));
+    const size_t wanted = static_cast<size_t>(std::ceil(static_cast<double>(kBaseTaps) / ratio));
+    taps_ = std::min(kMaxTaps, (wanted + 7) / 8 * 8);
+
+    // 原型h[m]工作在L倍输入采样率上，长度N = T * L，中心(N - 1) / 2；
+    // 第p相位第k个系数L * h[p + kL]作用于x[i - k]，表中倒序存放以便按输入时间正序做点积
+    const size_t length = taps_ * up_;
+    const double center = 0.5 * static_cast<double>(length - 1);
+    const double fc = kCutoff * 0.5 / static_cast<double>(std::max(up_, down_));
+    const double pi = 3.14159265358979323846;
+    const double window_norm = besselI0(kKaiserBeta);
+
+    table_.assign(up_ * taps_, 0.0f);
+    for (size_t p = 0; p < up_; ++p) {
+        double sum = 0.0;
+        std::vector<double> phase(taps_);
+        for (size_t k = 0; k < taps_; ++k) {
+            const double offset = static_cast<double>(p + k * up_) - center;
+            const double x = 2.0 * fc * offset;
+            const double sinc = (std::fabs(x) < 1e-12) ? 1.0 : std::sin(pi * x) / (pi * x);
+            const double r = offset / (center + 0.5);
+            const double window = besselI0(kKaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / window_norm;
+            phase[k] = sinc * window;
+            sum += phase[k];
+        }
+
+        // 每个相位单独归一化直流增益，避免相位间的增益起伏
+        for (size_t k = 0; k < taps_; ++k) {
+            table_[p * taps_ + (taps_ - 1 - k)] = static_cast<float>(phase[k] / sum);
+        }
+    }
+
+    max_output_frames_ = max_output_frames;
+    max_input_frames_ = (max_output_frames * down_) / up_ + 2 * ((down_ + up_ - 1) / up_) + 2;
+    work_.assign(channels_, std::vector<float>(taps_ + max_input_frames_, 0.0f));
+    reset();
+    return true;
+}
+
+int StreamResampler::getInputRate() const {
+    return input_rate_;
+}
+
+int StreamResampler::getOutputRate() const {
+    return output_rate_;
+}
+
+size_t StreamResampler::getChannels() const {
+    return channels_;
+}
+
+size_t StreamResampler::getInputFrames(size_t output_frames) const {
+    if (output_frames == 0) {
+        return 0;
+    }
+
+    // 最后一个输出对应的输入下标为index + floor((phase + (n - 1) * M) / L)
+    const int64_t last = index_ + static_cast<int64_t>((phase_ + (output_frames - 1) * down_) / up_);
+    return last < 0 ? 0 : static_cast<size_t>(last + 1);
+}
+
+size_t StreamResampler::getMaxInputFrames() const {
+    return max_input_frames_;
+}
+
+void StreamResampler::process(const float* input, float* output, size_t output_frames) {
+    output_frames = std::min(output_frames, max_output_frames_);
+    const size_t input_frames = getInputFrames(output_frames);
+
+    // 解交错到各声道的工作缓冲区（历史之后）
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        float* work = work_[ch].data() + taps_;
+        for (size_t f = 0; f < input_frames; ++f) {
+            work[f] = input[f * channels_ + ch];
+        }
+    }
+
+    // 输出n使用x[i - T + 1 .. i]，在工作缓冲区中从i + 1开始（历史占T帧）
+    int64_t index = index_;
+    size_t phase = phase_;
+    for (size_t n = 0; n < output_frames; ++n) {
+        const float* coefficients = table_.data() + phase * taps_;
+        const size_t start = static_cast<size_t>(index + 1);
+        for (size_t ch = 0; ch < channels_; ++ch) {
+            output[n * channels_ + ch] = dot(coefficients, work_[ch].data() + start, taps_);
+        }
+        phase += down_;
+        index += static_cast<int64_t>(phase / up_);
+        phase %= up_;
+    }
+
+    // 保留最后T帧作为下一块的历史
+    for (size_t ch = 0; ch < channels_; ++ch) {
+        float* work = work_[ch].data();
+        std::copy(work + input_frames, work + input_frames + taps_, work);
+    }
+    index_ = index - static_cast<int64_t>(input_frames);
+    phase_ = phase;
+}
+
+size_t StreamResampler::getLatency() const {
+    // 群延迟(N - 1) / 2个原型样本，折算为输出采样率下的帧数
+    const size_t length = taps_ * up_;
+    return (length - 1 + down_) / (2 * down_);
+}
+
+void StreamResampler::reset() {
+    for (auto& work : work_) {
+        std::fill(work.begin(), work.end(), 0.0f);
+    }
+    index_ = 0;
+    phase_ = 0;
+}
+
+} // namespace core
@@ -1,86 +1,362 @@
 #include "core/audio_thread_pool.h"
+#include "platform/denormal_guard.h"
 #include <iostream>
 
 namespace core {
 
-AudioThreadPool::AudioThreadPool(size_t num_threads) 
-    : stop_(false) {
-    // 初始化线程池
-    
-    for (size_t i = 0; i < num_threads; ++i) {
-        threads_.emplace_back([this] {
-            for (;;) {
-                std::function<void()> task;
-                
-                {
-                    std::unique_lock<std::mutex> lock(this->mutex_);
-                    this->condition_.wait(lock, [this] { return this->stop_ || !this->tasks_.empty(); });
-                    
-                    if (this->stop_ && this->tasks_.empty()) {
-                        return;
-                    }
-                    
-                    task = std::move(this->tasks_.front());
-                    this->tasks_.pop();
-                }
-                
-                task();
+namespace {
+
+// 每个工作线程每个优先级的队列容量
+const size_t kDequeCapacity = 1024;
+
+// 每个优先级的注入队列容量
+const size_t kInjectionCapacity = 1024;
+
+// 预分配的任务节点数
+const uint32_t kNodeCount = 4096;
+const uint32_t kHeapNode = 0xFFFFFFFFu;
+
+// 休眠前的空转轮数（音频扇出的任务间隔很短，避免频繁休眠/唤醒）
+const int kSpinRounds = 64;
+
+// 当前线程所属的线程池与工作线程序号（池外线程为nullptr）
+thread_local const AudioThreadPool* tls_pool = nullptr;
+thread_local int tls_index = -1;
+
+} // namespace
+
+// WorkDeque implementation
+AudioThreadPool::WorkDeque::WorkDeque(size_t capacity)
+    : top_(0), bottom_(0), buffer_(new std::atomic<TaskNode*>[capacity]),
+      mask_(static_cast<int64_t>(capacity) - 1) {
+}
+
+bool AudioThreadPool::WorkDeque::push(TaskNode* node) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) {
+        return false;
+    }
+
+    buffer_[bottom & mask_].store(node, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+AudioThreadPool::TaskNode* AudioThreadPool::WorkDeque::pop() {
+    // 先预留底端元素，再与窃取者竞争最后一个元素
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    TaskNode* node = buffer_[bottom & mask_].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            node = nullptr;
+        }
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+AudioThreadPool::TaskNode* AudioThreadPool::WorkDeque::steal() {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    TaskNode* node = buffer_[top & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return node;
+}
+
+// InjectionQueue implementation
+AudioThreadPool::InjectionQueue::InjectionQueue(size_t capacity)
+    : cells_(new Cell[capacity]), mask_(capacity - 1), head_(0), tail_(0) {
+    for (size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+        cells_[i].node = nullptr;
+    }
+}
+
+bool AudioThreadPool::InjectionQueue::push(TaskNode* node) {
+    size_t position = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[position & mask_];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->node = node;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+AudioThreadPool::TaskNode* AudioThreadPool::InjectionQueue::pop() {
+    size_t position = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[position & mask_];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
             }
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    TaskNode* node = cell->node;
+    cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return node;
+}
+
+AudioThreadPool::Worker::Worker(size_t capacity) {
+    for (size_t p = 0; p < kPriorities; ++p) {
+        deques.push_back(std::make_unique<WorkDeque>(capacity));
+    }
+}
+
+AudioThreadPool::AudioThreadPool(size_t num_threads, platform::ThreadRole role)
+    : nodes_(new TaskNode[kNodeCount]), free_head_(0), epoch_(0), sleepers_(0),
+      steal_start_(0), stop_(false) {
+    // 初始化线程池：全部节点链入空闲链表
+    for (uint32_t i = 0; i < kNodeCount; ++i) {
+        nodes_[i].index = i;
+        nodes_[i].next.store(i + 1 < kNodeCount ? i + 2 : 0, std::memory_order_relaxed);
+    }
+    free_head_.store(1, std::memory_order_relaxed);
+
+    for (size_t p = 0; p < kPriorities; ++p) {
+        injection_.push_back(std::make_unique<InjectionQueue>(kInjectionCapacity));
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>(kDequeCapacity));
+    }
+
+    // 队列全部就绪后再启动线程，工作线程之间可以互相窃取
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_[i]->thread = std::thread([this, i, role] {
+            // 工作线程处理音频任务，整个生命周期内启用FTZ/DAZ
+            platform::DenormalGuard denormal_guard;
+            platform::ThreadManager::apply_role_policy(role);
+            workerLoop(i);
         });
     }
 }
 
 AudioThreadPool::~AudioThreadPool() {
     stop();
-}
 
-template<typename F>
-auto AudioThreadPool::submit(F&& f) -> std::future<decltype(f())> {
-    using return_type = decltype(f());
-    
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::forward<F>(f)
-    );
-    
-    std::future<return_type> res = task->get_future();
-    
-    {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        if (stop_) {
-            throw std::runtime_error("submit on stopped ThreadPool");
+    // 回收停止后仍留在队列中的任务（不执行）
+    for (size_t p = 0; p < kPriorities; ++p) {
+        while (TaskNode* node = injection_[p]->pop()) {
+            releaseNode(node);
+        }
+        for (auto& worker : workers_) {
+            while (TaskNode* node = worker->deques[p]->steal()) {
+                releaseNode(node);
+            }
         }
-        
-        tasks_.emplace([task]() { (*task)(); });
     }
-    
-    condition_.notify_one();
-    
-    return res;
 }
 
 size_t AudioThreadPool::getThreadCount() const {
-    return threads_.size();
+    return workers_.size();
 }
 
 void AudioThreadPool::start() {
     // 启动线程池
-    std::cout << "Starting audio thread pool with " << threads_.size() << " threads" << std::endl;
+    std::cout << "Starting audio thread pool with " << workers_.size() << " threads" << std::endl;
 }
 
 void AudioThreadPool::stop() {
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        stop_ = true;
+        stop_.store(true, std::memory_order_seq_cst);
     }
-    
+
     condition_.notify_all();
-    
-    for (std::thread& worker : threads_) {
-        if (worker.joinable()) {
-            worker.join();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+bool AudioThreadPool::runPendingTask(TaskPriority lowest) {
+    const int self = (tls_pool == this) ? tls_index : -1;
+    TaskNode* node = findTask(self, static_cast<size_t>(lowest));
+    if (node == nullptr) {
+        return false;
+    }
+    runNode(node);
+    return true;
+}
+
+void AudioThreadPool::schedule(AudioTask&& task, TaskPriority priority) {
+    if (stop_.load(std::memory_order_relaxed)) {
+        throw std::runtime_error("submit on stopped ThreadPool");
+    }
+
+    TaskNode* node = allocateNode();
+    node->task = std::move(task);
+
+    // 工作线程压入自己的队列，其余线程（或自己的队列已满时）进入注入队列
+    const size_t level = static_cast<size_t>(priority);
+    bool queued = false;
+    if (tls_pool == this) {
+        queued = workers_[static_cast<size_t>(tls_index)]->deques[level]->push(node);
+    }
+    if (!queued) {
+        queued = injection_[level]->push(node);
+    }
+    if (!queued) {
+        // 所有队列已满：在提交线程上直接执行，保证任务不丢失
+        runNode(node);
+        return;
+    }
+
+    // 有线程休眠时才加锁唤醒；与workerLoop中的sleepers_/epoch_检查配对，不会丢失唤醒
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_.notify_one();
+    }
+}
+
+AudioThreadPool::TaskNode* AudioThreadPool::findTask(int self, size_t lowest) {
+    const size_t count = workers_.size();
+    for (size_t p = 0; p <= lowest && p < kPriorities; ++p) {
+        if (self >= 0) {
+            if (TaskNode* node = workers_[static_cast<size_t>(self)]->deques[p]->pop()) {
+                return node;
+            }
+        }
+        if (TaskNode* node = injection_[p]->pop()) {
+            return node;
+        }
+
+        // 从不同的起点轮流窃取，分散竞争
+        const size_t start = (self >= 0) ? static_cast<size_t>(self) + 1
+                                         : steal_start_.fetch_add(1, std::memory_order_relaxed);
+        for (size_t k = 0; k < count; ++k) {
+            const size_t victim = (start + k) % count;
+            if (static_cast<int>(victim) == self) {
+                continue;
+            }
+            if (TaskNode* node = workers_[victim]->deques[p]->steal()) {
+                return node;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void AudioThreadPool::runNode(TaskNode* node) {
+    node->task();
+    releaseNode(node);
+}
+
+AudioThreadPool::TaskNode* AudioThreadPool::allocateNode() {
+    uint64_t head = free_head_.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t index = static_cast<uint32_t>(head & 0xFFFFFFFFu);
+        if (index == 0) {
+            // 预分配节点用尽
+            TaskNode* node = new TaskNode;
+            node->index = kHeapNode;
+            return node;
+        }
+
+        // next可能已被其他线程改写，此时标记也已变化，CAS会失败
+        const uint64_t next = nodes_[index - 1].next.load(std::memory_order_relaxed);
+        const uint64_t replacement = (((head >> 32) + 1) << 32) | next;
+        if (free_head_.compare_exchange_weak(head, replacement, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+            return &nodes_[index - 1];
+        }
+    }
+}
+
+void AudioThreadPool::releaseNode(TaskNode* node) {
+    node->task.reset();
+    if (node->index == kHeapNode) {
+        delete node;
+        return;
+    }
+
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
+    for (;;) {
+        node->next.store(static_cast<uint32_t>(head & 0xFFFFFFFFu), std::memory_order_relaxed);
+        const uint64_t replacement = (((head >> 32) + 1) << 32) | (node->index + 1);
+        if (free_head_.compare_exchange_weak(head, replacement, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void AudioThreadPool::workerLoop(size_t index) {
+    tls_pool = this;
+    tls_index = static_cast<int>(index);
+    const int self = static_cast<int>(index);
+    const size_t lowest = kPriorities - 1;
+
+    for (;;) {
+        TaskNode* node = nullptr;
+        for (int round = 0; round < kSpinRounds && node == nullptr; ++round) {
+            node = findTask(self, lowest);
+            if (node == nullptr) {
+                if (stop_.load(std::memory_order_acquire)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        if (node == nullptr) {
+            // 先登记为休眠者再复查，提交方要么看到登记并唤醒，要么其任务已能被复查到
+            const uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            node = findTask(self, lowest);
+            if (node == nullptr) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this, epoch] {
+                    return stop_.load(std::memory_order_relaxed) ||
+                           epoch_.load(std::memory_order_seq_cst) != epoch;
+                });
+            }
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        if (node != nullptr) {
+            runNode(node);
         }
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
@@ -1,91 +0,0 @@
-#include "core/audio_tremolo_modulated.h"
-#include <iostream>
-
-namespace core {
-
-AudioTremoloModulated::AudioTremoloModulated() 
-    : initialized_(false), rate_(5.0f), depth_(0.5f), mix_(0.3f), 
-      modulation_rate_(2.0f), modulation_depth_(0.1f) {
-    // 初始化音频调制颤音器
-}
-
-AudioTremoloModulated::~AudioTremoloModulated() {
-    // 析构函数
-    shutdown();
-}
-
-bool AudioTremoloModulated::initialize() {
-    std::cout << "Initializing audio tremolo modulated" << std::endl;
-    
-    // 在实际实现中，这里会初始化调制颤音器
-    
-    initialized_ = true;
-    return true;
-}
-
-void AudioTremoloModulated::shutdown() {
-    if (initialized_) {
-        std::cout << "Shutting down audio tremolo modulated" << std::endl;
-        
-        // 在实际实现中，这里会关闭调制颤音器
-        
-        initialized_ = false;
-    }
-}
-
-bool AudioTremoloModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Applying audio tremolo modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制颤音效果
-    
-    output = input;  // 模拟处理
-    return true;
-}
-
-bool AudioTremoloModulated::setParameters(float rate, float depth, float mix, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Setting tremolo modulated parameters - Rate: " << rate 
-              << " Hz, Depth: " << depth << ", Mix: " << mix 
-              << ", Modulation rate: " << modulation_rate 
-              << " Hz, Modulation depth: " << modulation_depth << std::endl;
-    
-    // 在实际实现中，这里会设置调制颤音参数
-    
-    rate_ = rate;
-    depth_ = depth;
-    mix_ = mix;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
-    return true;
-}
-
-void AudioTremoloModulated::getParameters(float& rate, float& depth, float& mix, float& modulation_rate, float& modulation_depth) const {
-    rate = rate_;
-    depth = depth_;
-    mix = mix_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
-}
-
-void AudioTremoloModulated::reset() {
-    if (initialized_) {
-        std::cout << "Resetting audio tremolo modulated" << std::endl;
-        
-        // 在实际实现中，这里会重置调制颤音器
-        
-        rate_ = 5.0f;
-        depth_ = 0.5f;
-        mix_ = 0.3f;
-        modulation_rate_ = 2.0f;
-        modulation_depth_ = 0.1f;
-    }
-}
-
-} // namespace core
\ No newline at end of file
@@ -1,11 +1,43 @@
 #include "core/audio_vocoder.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <iostream>
 
 namespace core {
 
-AudioVocoder::AudioVocoder() 
-    : initialized_(false), carrier_freq_(1000.0f), modulator_freq_(100.0f), mix_(0.5f) {
+namespace {
+
+const float kTwoPi = 6.28318530717959f;
+
+// 频带范围
+const float kLowestBand = 80.0f;
+const float kHighestBand = 10000.0f;
+
+// 频带数范围
+const size_t kMinBands = 4;
+const size_t kMaxBands = 64;
+
+// AUTO模式下切换到FFT的频带数
+const size_t kFftBandThreshold = 32;
+
+// 载波包络的下限，避免静默频带被无限放大
+const float kEnvelopeFloor = 1e-4f;
+
+// 一阶平滑系数
+inline float smoothingCoefficient(float cutoff, float interval_rate) {
+    return 1.0f - std::exp(-kTwoPi * cutoff / interval_rate);
+}
+
+} // namespace
+
+AudioVocoder::AudioVocoder()
+    : initialized_(false), carrier_freq_(110.0f), modulator_freq_(100.0f), mix_(0.5f),
+      sample_rate_(44100), channels_(2), band_count_(16), mode_(Mode::AUTO),
+      attack_(0.0f), release_(0.0f), output_gain_(1.0f),
+      fft_(kFrameSize), frame_attack_(0.0f), frame_release_(0.0f), rover_(0), dry_index_(0) {
     // 初始化音频声码器
+    oscillator_.setOscillatorCount(1);
 }
 
 AudioVocoder::~AudioVocoder() {
@@ -15,9 +47,9 @@ AudioVocoder::~AudioVocoder() {
 
 bool AudioVocoder::initialize() {
     std::cout << "Initializing audio vocoder" << std::endl;
-    
-    // 在实际实现中，这里会初始化声码器
-    
+
+    allocateState();
+
     initialized_ = true;
     return true;
 }
@@ -25,23 +57,55 @@ bool AudioVocoder::initialize() {
 void AudioVocoder::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio vocoder" << std::endl;
-        
-        // 在实际实现中，这里会关闭声码器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioVocoder::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
-    
-    std::cout << "Applying audio vocoder effect" << std::endl;
-    
-    // 在实际实现中，这里会应用声码效果
-    
-    output = input;  // 模拟处理
+
+    const size_t frames = input.size() / static_cast<size_t>(channels_);
+    if (output.size() != input.size()) {
+        output.resize(input.size());
+    }
+    if (carrier_block_.size() < frames) {
+        carrier_block_.resize(frames);
+    }
+
+    oscillator_.render(carrier_block_.data(), frames);
+    process(input.data(), carrier_block_.data(), output.data(), frames);
+    return true;
+}
+
+bool AudioVocoder::apply(const AudioBuffer& input, const AudioBuffer& carrier, AudioBuffer& output) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0 ||
+        carrier.size() != input.size()) {
+        return false;
+    }
+
+    const size_t channels = static_cast<size_t>(channels_);
+    const size_t frames = input.size() / channels;
+    if (output.size() != input.size()) {
+        output.resize(input.size());
+    }
+    if (carrier_block_.size() < frames) {
+        carrier_block_.resize(frames);
+    }
+
+    // 外部载波混合为单声道
+    const float scale = 1.0f / static_cast<float>(channels);
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            sum += carrier[i * channels + ch];
+        }
+        carrier_block_[i] = sum * scale;
+    }
+
+    process(input.data(), carrier_block_.data(), output.data(), frames);
     return true;
 }
 
@@ -49,15 +113,14 @@ bool AudioVocoder::setParameters(float carrier_freq, float modulator_freq, float
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting vocoder parameters - Carrier freq: " << carrier_freq 
+
+    std::cout << "Setting vocoder parameters - Carrier freq: " << carrier_freq
               << " Hz, Modulator freq: " << modulator_freq << " Hz, Mix: " << mix << std::endl;
-    
-    // 在实际实现中，这里会设置声码参数
-    
-    carrier_freq_ = carrier_freq;
-    modulator_freq_ = modulator_freq;
-    mix_ = mix;
+
+    carrier_freq_ = std::clamp(carrier_freq, 20.0f, 0.45f * static_cast<float>(sample_rate_));
+    modulator_freq_ = std::clamp(modulator_freq, 2.0f, 200.0f);
+    mix_ = std::clamp(mix, 0.0f, 1.0f);
+    updateCoefficients();
     return true;
 }
 
@@ -67,16 +130,352 @@ void AudioVocoder::getParameters(float& carrier_freq, float& modulator_freq, flo
     mix = mix_;
 }
 
+bool AudioVocoder::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+
+    if (initialized_) {
+        allocateState();
+    }
+    return true;
+}
+
+bool AudioVocoder::setBandCount(size_t bands) {
+    if (bands < kMinBands || bands > kMaxBands) {
+        return false;
+    }
+
+    band_count_ = bands;
+    if (initialized_) {
+        allocateState();
+    }
+    return true;
+}
+
+size_t AudioVocoder::getBandCount() const {
+    return band_count_;
+}
+
+void AudioVocoder::setMode(Mode mode) {
+    mode_ = mode;
+}
+
+AudioVocoder::Mode AudioVocoder::getMode() const {
+    return mode_;
+}
+
+size_t AudioVocoder::getLatency() const {
+    // 输入FIFO填满一帧才分析，合成结果的第一跳在随后的一跳内输出
+    return useFft() ? kFrameSize : 0;
+}
+
 void AudioVocoder::reset() {
     if (initialized_) {
         std::cout << "Resetting audio vocoder" << std::endl;
-        
-        // 在实际实现中，这里会重置声码器
-        
-        carrier_freq_ = 1000.0f;
+
+        carrier_freq_ = 110.0f;
         modulator_freq_ = 100.0f;
         mix_ = 0.5f;
+        updateCoefficients();
+        clearState();
     }
 }
 
-} // namespace core
\ No newline at end of file
+bool AudioVocoder::useFft() const {
+    return mode_ == Mode::FFT || (mode_ == Mode::AUTO && band_count_ > kFftBandThreshold);
+}
+
+void AudioVocoder::process(const float* input, const float* carrier, float* output, size_t frames) {
+    const size_t channels = static_cast<size_t>(channels_);
+    const float scale = 1.0f / static_cast<float>(channels);
+    const float wet = mix_;
+    const float dry = 1.0f - mix_;
+
+    if (!useFft()) {
+        for (size_t i = 0; i < frames; ++i) {
+            const float* in = input + i * channels;
+            float* out = output + i * channels;
+
+            float modulator = 0.0f;
+            for (size_t ch = 0; ch < channels; ++ch) {
+                modulator += in[ch];
+            }
+            const float vocoded = processFilterbank(modulator * scale, carrier[i]);
+
+            for (size_t ch = 0; ch < channels; ++ch) {
+                out[ch] = dry * in[ch] + wet * vocoded;
+            }
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < frames; ++i) {
+        const float* in = input + i * channels;
+        float* out = output + i * channels;
+
+        float modulator = 0.0f;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            modulator += in[ch];
+        }
+        modulator_fifo_[rover_] = modulator * scale;
+        carrier_fifo_[rover_] = carrier[i];
+        const float vocoded = out_fifo_[rover_ - kFifoLatency];
+
+        // 干信号按处理延迟对齐（先读取输入，允许原地处理）
+        float* delayed = &dry_delay_[dry_index_ * channels];
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const float x = in[ch];
+            out[ch] = dry * delayed[ch] + wet * vocoded;
+            delayed[ch] = x;
+        }
+        dry_index_ = dry_index_ + 1 < kFrameSize ? dry_index_ + 1 : 0;
+
+        ++rover_;
+        if (rover_ >= kFrameSize) {
+            rover_ = kFifoLatency;
+            processFrame();
+        }
+    }
+}
+
+float AudioVocoder::processFilterbank(float modulator, float carrier) {
+    const size_t bands = band_count_;
+    const float* b0 = band_b0_.data();
+    const float* a1 = band_a1_.data();
+    const float* a2 = band_a2_.data();
+    float* az1 = analysis_state_.data();
+    float* az2 = az1 + bands;
+    float* az3 = az2 + bands;
+    float* az4 = az3 + bands;
+    float* sz1 = synthesis_state_.data();
+    float* sz2 = sz1 + bands;
+    float* sz3 = sz2 + bands;
+    float* sz4 = sz3 + bands;
+    float* modulator_envelope = modulator_envelope_.data();
+    float* carrier_envelope = carrier_envelope_.data();
+    float* band_output = band_output_.data();
+    const float attack = attack_;
+    const float release = release_;
+
+    // 频带之间互不依赖，循环体无分支，按频带向量化
+    for (size_t b = 0; b < bands; ++b) {
+        // 分析：两级二阶带通（转置直接II型）
+        const float m1 = b0[b] * modulator + az1[b];
+        az1[b] = az2[b] - a1[b] * m1;
+        az2[b] = -b0[b] * modulator - a2[b] * m1;
+        const float m2 = b0[b] * m1 + az3[b];
+        az3[b] = az4[b] - a1[b] * m2;
+        az4[b] = -b0[b] * m1 - a2[b] * m2;
+
+        // 合成：载波通过相同的带通
+        const float c1 = b0[b] * carrier + sz1[b];
+        sz1[b] = sz2[b] - a1[b] * c1;
+        sz2[b] = -b0[b] * carrier - a2[b] * c1;
+        const float c2 = b0[b] * c1 + sz3[b];
+        sz3[b] = sz4[b] - a1[b] * c2;
+        sz4[b] = -b0[b] * c1 - a2[b] * c2;
+
+        // 包络跟随：上升用attack系数，下降用release系数
+        const float m_level = std::fabs(m2);
+        const float m_coef = m_level > modulator_envelope[b] ? attack : release;
+        modulator_envelope[b] += m_coef * (m_level - modulator_envelope[b]);
+
+        const float c_level = std::fabs(c2);
+        const float c_coef = c_level > carrier_envelope[b] ? attack : release;
+        carrier_envelope[b] += c_coef * (c_level - carrier_envelope[b]);
+
+        // 载波频带按自身包络归一化后乘以调制包络
+        band_output[b] = c2 * modulator_envelope[b] / std::max(carrier_envelope[b], kEnvelopeFloor);
+    }
+
+    float sum = 0.0f;
+    for (size_t b = 0; b < bands; ++b) {
+        sum += band_output[b];
+    }
+    return sum * output_gain_;
+}
+
+void AudioVocoder::processFrame() {
+    const size_t half = kFrameSize / 2;
+
+    for (size_t k = 0; k < kFrameSize; ++k) {
+        modulator_re_[k] = modulator_fifo_[k] * window_[k];
+        modulator_im_[k] = 0.0f;
+        carrier_re_[k] = carrier_fifo_[k] * window_[k];
+        carrier_im_[k] = 0.0f;
+    }
+    fft_.forward(modulator_re_.data(), modulator_im_.data());
+    fft_.forward(carrier_re_.data(), carrier_im_.data());
+
+    // 频带外的频点置零
+    for (size_t k = 0; k < band_edges_.front(); ++k) {
+        carrier_re_[k] = 0.0f;
+        carrier_im_[k] = 0.0f;
+    }
+    for (size_t k = band_edges_.back(); k <= half; ++k) {
+        carrier_re_[k] = 0.0f;
+        carrier_im_[k] = 0.0f;
+    }
+
+    // 每个频带：载波能量归一化后乘以调制能量，增益按帧平滑
+    for (size_t b = 0; b < band_count_; ++b) {
+        const size_t begin = band_edges_[b];
+        const size_t end = band_edges_[b + 1];
+
+        float modulator_energy = 0.0f;
+        float carrier_energy = 0.0f;
+        for (size_t k = begin; k < end; ++k) {
+            modulator_energy += modulator_re_[k] * modulator_re_[k] + modulator_im_[k] * modulator_im_[k];
+            carrier_energy += carrier_re_[k] * carrier_re_[k] + carrier_im_[k] * carrier_im_[k];
+        }
+
+        const float floor = kEnvelopeFloor * kEnvelopeFloor * static_cast<float>(end - begin);
+        const float target = std::sqrt(modulator_energy / std::max(carrier_energy, floor));
+        float& gain = spectral_gain_[b];
+        gain += (target > gain ? frame_attack_ : frame_release_) * (target - gain);
+
+        for (size_t k = begin; k < end; ++k) {
+            carrier_re_[k] *= gain;
+            carrier_im_[k] *= gain;
+        }
+    }
+
+    // 构造共轭对称频谱并逆变换
+    carrier_im_[0] = 0.0f;
+    carrier_im_[half] = 0.0f;
+    for (size_t k = half + 1; k < kFrameSize; ++k) {
+        carrier_re_[k] = carrier_re_[kFrameSize - k];
+        carrier_im_[k] = -carrier_im_[kFrameSize - k];
+    }
+    fft_.inverse(carrier_re_.data(), carrier_im_.data());
+
+    // 加窗叠加（汉宁窗平方在4倍重叠下的和为1.5）
+    const float overlap_gain = 2.0f / 3.0f;
+    for (size_t k = 0; k < kFrameSize; ++k) {
+        output_accum_[k] += window_[k] * carrier_re_[k] * overlap_gain;
+    }
+
+    std::copy(output_accum_.begin(), output_accum_.begin() + kHopSize, out_fifo_.begin());
+
+    // 移动累加器与输入FIFO
+    std::copy(output_accum_.begin() + kHopSize, output_accum_.end(), output_accum_.begin());
+    std::fill(output_accum_.end() - kHopSize, output_accum_.end(), 0.0f);
+    std::copy(modulator_fifo_.begin() + kHopSize, modulator_fifo_.end(), modulator_fifo_.begin());
+    std::copy(carrier_fifo_.begin() + kHopSize, carrier_fifo_.end(), carrier_fifo_.begin());
+}
+
+void AudioVocoder::updateCoefficients() {
+    const float sample_rate = static_cast<float>(sample_rate_);
+    const float lowest = kLowestBand;
+    const float highest = std::min(kHighestBand, 0.45f * sample_rate);
+    const size_t bands = band_count_;
+
+    // 频带中心按对数均匀分布，Q由相邻频带的频率比决定
+    const float ratio = std::pow(highest / lowest, 1.0f / static_cast<float>(bands - 1));
+    const float q = std::sqrt(ratio) / (ratio - 1.0f);
+    for (size_t b = 0; b < bands; ++b) {
+        const float center = lowest * std::pow(ratio, static_cast<float>(b));
+        const float w0 = kTwoPi * center / sample_rate;
+        const float alpha = std::sin(w0) / (2.0f * q);
+        const float a0 = 1.0f + alpha;
+        band_b0_[b] = alpha / a0;
+        band_a1_[b] = -2.0f * std::cos(w0) / a0;
+        band_a2_[b] = (1.0f - alpha) / a0;
+    }
+
+    // 输出增益：各频带的载波已按自身包络归一化，单个正弦分量经过频带b后的幅度约为其幅度乘以|H_b|；
+    // 不同频带的载波谐波互不相关，按能量相加。取频带范围内各测试频率上 sum|H_b|^2 的平均值，
+    // 使不同频带数下的输出电平一致
+    const size_t probes = 64;
+    float power_sum = 0.0f;
+    for (size_t p = 0; p < probes; ++p) {
+        const float frequency = lowest * std::pow(highest / lowest, (static_cast<float>(p) + 0.5f) / static_cast<float>(probes));
+        const std::complex<float> z = std::polar(1.0f, -kTwoPi * frequency / sample_rate);
+        for (size_t b = 0; b < bands; ++b) {
+            const std::complex<float> section = band_b0_[b] * (1.0f - z * z) /
+                (1.0f + band_a1_[b] * z + band_a2_[b] * z * z);
+            power_sum += std::norm(section * section);
+        }
+    }
+    output_gain_ = std::sqrt(static_cast<float>(probes) / std::max(power_sum, 1e-6f));
+
+    // FFT频带边界（频点），每个频带至少一个频点
+    const size_t half = kFrameSize / 2;
+    const float bin_width = sample_rate / static_cast<float>(kFrameSize);
+    const float edge_ratio = std::pow(highest / lowest, 1.0f / static_cast<float>(bands));
+    size_t previous = 0;
+    for (size_t b = 0; b <= bands; ++b) {
+        const float frequency = lowest * std::pow(edge_ratio, static_cast<float>(b));
+        size_t edge = static_cast<size_t>(std::lround(frequency / bin_width));
+        edge = std::clamp<size_t>(edge, 1, half);
+        if (b > 0) {
+            edge = std::max(edge, previous + 1);
+        }
+        band_edges_[b] = std::min(edge, half);
+        previous = band_edges_[b];
+    }
+
+    // 包络跟随器：释放截止频率为modulator_freq，上升快4倍
+    attack_ = smoothingCoefficient(4.0f * modulator_freq_, sample_rate);
+    release_ = smoothingCoefficient(modulator_freq_, sample_rate);
+    const float frame_rate = sample_rate / static_cast<float>(kHopSize);
+    frame_attack_ = smoothingCoefficient(std::min(4.0f * modulator_freq_, 0.4f * frame_rate), frame_rate);
+    frame_release_ = smoothingCoefficient(std::min(modulator_freq_, 0.4f * frame_rate), frame_rate);
+
+    oscillator_.setSampleRate(sample_rate_);
+    oscillator_.setOscillator(0, AudioOscillatorBank::Waveform::SAWTOOTH, carrier_freq_, 1.0f);
+}
+
+void AudioVocoder::allocateState() {
+    const size_t bands = band_count_;
+
+    band_b0_.assign(bands, 0.0f);
+    band_a1_.assign(bands, 0.0f);
+    band_a2_.assign(bands, 0.0f);
+    analysis_state_.assign(4 * bands, 0.0f);
+    synthesis_state_.assign(4 * bands, 0.0f);
+    modulator_envelope_.assign(bands, 0.0f);
+    carrier_envelope_.assign(bands, 0.0f);
+    band_output_.assign(bands, 0.0f);
+
+    window_.resize(kFrameSize);
+    for (size_t k = 0; k < kFrameSize; ++k) {
+        window_[k] = 0.5f - 0.5f * std::cos(kTwoPi * static_cast<float>(k) / static_cast<float>(kFrameSize));
+    }
+    modulator_fifo_.assign(kFrameSize, 0.0f);
+    carrier_fifo_.assign(kFrameSize, 0.0f);
+    out_fifo_.assign(kFrameSize, 0.0f);
+    output_accum_.assign(kFrameSize, 0.0f);
+    dry_delay_.assign(kFrameSize * static_cast<size_t>(channels_), 0.0f);
+    modulator_re_.assign(kFrameSize, 0.0f);
+    modulator_im_.assign(kFrameSize, 0.0f);
+    carrier_re_.assign(kFrameSize, 0.0f);
+    carrier_im_.assign(kFrameSize, 0.0f);
+    band_edges_.assign(bands + 1, 0);
+    spectral_gain_.assign(bands, 0.0f);
+
+    updateCoefficients();
+    clearState();
+}
+
+void AudioVocoder::clearState() {
+    std::fill(analysis_state_.begin(), analysis_state_.end(), 0.0f);
+    std::fill(synthesis_state_.begin(), synthesis_state_.end(), 0.0f);
+    std::fill(modulator_envelope_.begin(), modulator_envelope_.end(), 0.0f);
+    std::fill(carrier_envelope_.begin(), carrier_envelope_.end(), 0.0f);
+    std::fill(modulator_fifo_.begin(), modulator_fifo_.end(), 0.0f);
+    std::fill(carrier_fifo_.begin(), carrier_fifo_.end(), 0.0f);
+    std::fill(out_fifo_.begin(), out_fifo_.end(), 0.0f);
+    std::fill(output_accum_.begin(), output_accum_.end(), 0.0f);
+    std::fill(dry_delay_.begin(), dry_delay_.end(), 0.0f);
+    std::fill(spectral_gain_.begin(), spectral_gain_.end(), 0.0f);
+    oscillator_.resetPhases();
+    rover_ = kFifoLatency;
+    dry_index_ = 0;
+}
+
+} // namespace core
@@ -1,91 +0,0 @@
-#include "core/audio_vocoder_modulated.h"
-#include <iostream>
-
-namespace core {
-
-AudioVocoderModulated::AudioVocoderModulated() 
-    : initialized_(false), carrier_freq_(1000.0f), modulator_freq_(100.0f), mix_(0.5f),
-      modulation_rate_(1.0f), modulation_depth_(0.3f) {
-    // 初始化音频调制声码器
-}
-
-AudioVocoderModulated::~AudioVocoderModulated() {
-    // 析构函数
-    shutdown();
-}
-
-bool AudioVocoderModulated::initialize() {
-    std::cout << "Initializing audio vocoder modulated" << std::endl;
-    
-    // 在实际实现中，这里会初始化调制声码器
-    
-    initialized_ = true;
-    return true;
-}
-
-void AudioVocoderModulated::shutdown() {
-    if (initialized_) {
-        std::cout << "Shutting down audio vocoder modulated" << std::endl;
-        
-        // 在实际实现中，这里会关闭调制声码器
-        
-        initialized_ = false;
-    }
-}
-
-bool AudioVocoderModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Applying audio vocoder modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制声码效果
-    
-    output = input;  // 模拟处理
-    return true;
-}
-
-bool AudioVocoderModulated::setParameters(float carrier_freq, float modulator_freq, float mix, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Setting vocoder modulated parameters - Carrier freq: " << carrier_freq 
-              << " Hz, Modulator freq: " << modulator_freq << " Hz, Mix: " << mix
-              << ", Modulation rate: " << modulation_rate << " Hz"
-              << ", Modulation depth: " << modulation_depth << std::endl;
-    
-    // 在实际实现中，这里会设置调制声码参数
-    
-    carrier_freq_ = carrier_freq;
-    modulator_freq_ = modulator_freq;
-    mix_ = mix;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
-    return true;
-}
-
-void AudioVocoderModulated::getParameters(float& carrier_freq, float& modulator_freq, float& mix, float& modulation_rate, float& modulation_depth) const {
-    carrier_freq = carrier_freq_;
-    modulator_freq = modulator_freq_;
-    mix = mix_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
-}
-
-void AudioVocoderModulated::reset() {
-    if (initialized_) {
-        std::cout << "Resetting audio vocoder modulated" << std::endl;
-        
-        // 在实际实现中，这里会重置调制声码器
-        
-        carrier_freq_ = 1000.0f;
-        modulator_freq_ = 100.0f;
-        mix_ = 0.5f;
-        modulation_rate_ = 1.0f;
-        modulation_depth_ = 0.3f;
-    }
-}
-
-} // namespace core
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace core {
 AudioWaveformGenerator::AudioWaveformGenerator() 
     : initialized_(false), sample_rate_(44100), channels_(2) {
     // 初始化音频波形生成器
+    bank_.setSampleRate(sample_rate_);
 }
 
 AudioWaveformGenerator::~AudioWaveformGenerator() {
@@ -42,17 +43,7 @@ AudioBuffer AudioWaveformGenerator::generateSine(float frequency, float duration
     std::cout << "Generating sine wave - Frequency: " << frequency 
               << " Hz, Duration: " << duration << " s" << std::endl;
     
-    // 在实际实现中，这里会生成正弦波
-    
-    size_t buffer_size = static_cast<size_t>(sample_rate_ * duration);
-    AudioBuffer buffer(buffer_size);
-    
-    for (size_t i = 0; i < buffer_size; ++i) {
-        float t = static_cast<float>(i) / sample_rate_;
-        buffer[i] = amplitude * std::sin(2.0f * M_PI * frequency * t);
-    }
-    
-    return buffer;
+    return generateWaveform(AudioOscillatorBank::Waveform::SINE, frequency, duration, amplitude);
 }
 
 AudioBuffer AudioWaveformGenerator::generateSquare(float frequency, float duration, float amplitude) {
@@ -63,18 +54,7 @@ AudioBuffer AudioWaveformGenerator::generateSquare(float frequency, float durati
     std::cout << "Generating square wave - Frequency: " << frequency 
               << " Hz, Duration: " << duration << " s" << std::endl;
     
-    // 在实际实现中，这里会生成方波
-    
-    size_t buffer_size = static_cast<size_t>(sample_rate_ * duration);
-    AudioBuffer buffer(buffer_size);
-    
-    for (size_t i = 0; i < buffer_size; ++i) {
-        float t = static_cast<float>(i) / sample_rate_;
-        float wave = std::sin(2.0f * M_PI * frequency * t);
-        buffer[i] = amplitude * (wave > 0 ? 1.0f : -1.0f);
-    }
-    
-    return buffer;
+    return generateWaveform(AudioOscillatorBank::Waveform::SQUARE, frequency, duration, amplitude);
 }
 
 AudioBuffer AudioWaveformGenerator::generateTriangle(float frequency, float duration, float amplitude) {
@@ -85,18 +65,7 @@ AudioBuffer AudioWaveformGenerator::generateTriangle(float frequency, float dura
     std::cout << "Generating triangle wave - Frequency: " << frequency 
               << " Hz, Duration: " << duration << " s" << std::endl;
     
-    // 在实际实现中，这里会生成三角波
-    
-    size_t buffer_size = static_cast<size_t>(sample_rate_ * duration);
-    AudioBuffer buffer(buffer_size);
-    
-    for (size_t i = 0; i < buffer_size; ++i) {
-        float t = static_cast<float>(i) / sample_rate_;
-        float wave = std::sin(2.0f * M_PI * frequency * t);
-        buffer[i] = amplitude * (2.0f * std::abs(wave) - 1.0f);
-    }
-    
-    return buffer;
+    return generateWaveform(AudioOscillatorBank::Waveform::TRIANGLE, frequency, duration, amplitude);
 }
 
 AudioBuffer AudioWaveformGenerator::generateSawtooth(float frequency, float duration, float amplitude) {
@@ -107,18 +76,7 @@ AudioBuffer AudioWaveformGenerator::generateSawtooth(float frequency, float dura
     std::cout << "Generating sawtooth wave - Frequency: " << frequency 
               << " Hz, Duration: " << duration << " s" << std::endl;
     
-    // 在实际实现中，这里会生成锯齿波
-    
-    size_t buffer_size = static_cast<size_t>(sample_rate_ * duration);
-    AudioBuffer buffer(buffer_size);
-    
-    for (size_t i = 0; i < buffer_size; ++i) {
-        float t = static_cast<float>(i) / sample_rate_;
-        float wave = std::sin(2.0f * M_PI * frequency * t);
-        buffer[i] = amplitude * (2.0f * (wave - std::floor(wave + 0.5f)));
-    }
-    
-    return buffer;
+    return generateWaveform(AudioOscillatorBank::Waveform::SAWTOOTH, frequency, duration, amplitude);
 }
 
 AudioBuffer AudioWaveformGenerator::generateWhiteNoise(float duration, float amplitude) {
@@ -155,11 +113,64 @@ bool AudioWaveformGenerator::setParameters(int sample_rate, int channels) {
     
     // 在实际实现中，这里会设置生成参数
     
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+    
     sample_rate_ = sample_rate;
     channels_ = channels;
+    bank_.setSampleRate(sample_rate_);
     return true;
 }
 
+AudioOscillatorBank& AudioWaveformGenerator::getOscillatorBank() {
+    return bank_;
+}
+
+bool AudioWaveformGenerator::generateBlock(AudioBuffer& output, size_t frames) {
+    if (!initialized_) {
+        return false;
+    }
+    
+    const size_t channels = static_cast<size_t>(channels_);
+    if (output.size() != frames * channels) {
+        output.resize(frames * channels);
+    }
+    
+    // 单声道直接渲染到输出，多声道先渲染到预留的块缓冲区再展开
+    if (channels == 1) {
+        bank_.render(output.data(), frames);
+        return true;
+    }
+    
+    if (block_.size() < frames) {
+        block_.resize(frames);
+    }
+    bank_.render(block_.data(), frames);
+    
+    float* out = output.data();
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            out[i * channels + ch] = block_[i];
+        }
+    }
+    return true;
+}
+
+AudioBuffer AudioWaveformGenerator::generateWaveform(AudioOscillatorBank::Waveform waveform, float frequency,
+                                                     float duration, float amplitude) {
+    size_t buffer_size = static_cast<size_t>(sample_rate_ * duration);
+    AudioBuffer buffer(buffer_size);
+    
+    AudioOscillatorBank oscillator;
+    oscillator.setSampleRate(sample_rate_);
+    oscillator.setOscillatorCount(1);
+    oscillator.setOscillator(0, waveform, frequency, amplitude);
+    oscillator.render(buffer.data(), buffer_size);
+    
+    return buffer;
+}
+
 void AudioWaveformGenerator::getParameters(int& sample_rate, int& channels) const {
     sample_rate = sample_rate_;
     channels = channels_;
@@ -1,11 +1,29 @@
 #include "core/audio_waveshaper.h"
+#include <cmath>
 #include <iostream>
 
 namespace core {
 
-AudioWaveshaper::AudioWaveshaper() 
-    : initialized_(false), drive_(0.5f), shape_(0.5f), mix_(0.5f) {
+namespace {
+
+// 默认预分配的块长（更长的块在首次出现时扩容）
+const size_t kDefaultMaxFrames = 4096;
+
+// 默认过采样倍数
+const size_t kDefaultOversampling = 4;
+
+// 驱动量到输入增益：0-36dB
+inline float driveGain(float drive) {
+    return std::pow(10.0f, 1.8f * drive);
+}
+
+} // namespace
+
+AudioWaveshaper::AudioWaveshaper()
+    : initialized_(false), drive_(0.5f), shape_(0.0f), mix_(1.0f),
+      sample_rate_(44100), channels_(2) {
     // 初始化音频波形整形器
+    stage_.setOversampling(kDefaultOversampling);
 }
 
 AudioWaveshaper::~AudioWaveshaper() {
@@ -15,9 +33,10 @@ AudioWaveshaper::~AudioWaveshaper() {
 
 bool AudioWaveshaper::initialize() {
     std::cout << "Initializing audio waveshaper" << std::endl;
-    
-    // 在实际实现中，这里会初始化波形整形器
-    
+
+    stage_.setCurve(stage_.getCurve(), shape_);
+    stage_.prepare(sample_rate_, static_cast<size_t>(channels_), kDefaultMaxFrames);
+
     initialized_ = true;
     return true;
 }
@@ -25,23 +44,29 @@ bool AudioWaveshaper::initialize() {
 void AudioWaveshaper::shutdown() {
     if (initialized_) {
         std::cout << "Shutting down audio waveshaper" << std::endl;
-        
-        // 在实际实现中，这里会关闭波形整形器
-        
+
         initialized_ = false;
     }
 }
 
 bool AudioWaveshaper::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
+    if (!initialized_ || input.size() % static_cast<size_t>(channels_) != 0) {
         return false;
     }
-    
-    std::cout << "Applying audio waveshaper effect" << std::endl;
-    
-    // 在实际实现中，这里会应用波形整形效果
-    
-    output = input;  // 模拟处理
+
+    if (&output != &input) {
+        output = input;
+    }
+    stage_.process(output.data(), output.size() / static_cast<size_t>(channels_), driveGain(drive_), mix_);
+    return true;
+}
+
+bool AudioWaveshaper::process(AudioView view) {
+    if (!initialized_ || view.channels() != static_cast<size_t>(channels_)) {
+        return false;
+    }
+
+    stage_.process(view.data(), view.frames(), driveGain(drive_), mix_);
     return true;
 }
 
@@ -49,12 +74,18 @@ bool AudioWaveshaper::setParameters(float drive, float shape, float mix) {
     if (!initialized_) {
         return false;
     }
-    
-    std::cout << "Setting waveshaper parameters - Drive: " << drive 
+    if (drive < 0.0f || drive > 1.0f || shape < 0.0f || shape > 1.0f || mix < 0.0f || mix > 1.0f) {
+        return false;
+    }
+
+    std::cout << "Setting waveshaper parameters - Drive: " << drive
               << ", Shape: " << shape << ", Mix: " << mix << std::endl;
-    
-    // 在实际实现中，这里会设置波形整形参数
-    
+
+    // 形状变化时重建传递函数表
+    if (shape != shape_) {
+        stage_.setCurve(stage_.getCurve(), shape);
+    }
+
     drive_ = drive;
     shape_ = shape;
     mix_ = mix;
@@ -67,16 +98,47 @@ void AudioWaveshaper::getParameters(float& drive, float& shape, float& mix) cons
     mix = mix_;
 }
 
+bool AudioWaveshaper::setFormat(int sample_rate, int channels) {
+    if (sample_rate <= 0 || channels <= 0) {
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    stage_.prepare(sample_rate_, static_cast<size_t>(channels_), kDefaultMaxFrames);
+    return true;
+}
+
+void AudioWaveshaper::setCurve(TransferCurve curve) {
+    stage_.setCurve(curve, shape_);
+}
+
+TransferCurve AudioWaveshaper::getCurve() const {
+    return stage_.getCurve();
+}
+
+bool AudioWaveshaper::setOversampling(size_t factor) {
+    return stage_.setOversampling(factor);
+}
+
+size_t AudioWaveshaper::getOversampling() const {
+    return stage_.getOversampling();
+}
+
+size_t AudioWaveshaper::getLatency() const {
+    return stage_.getLatency();
+}
+
 void AudioWaveshaper::reset() {
     if (initialized_) {
         std::cout << "Resetting audio waveshaper" << std::endl;
-        
-        // 在实际实现中，这里会重置波形整形器
-        
+
         drive_ = 0.5f;
-        shape_ = 0.5f;
-        mix_ = 0.5f;
+        shape_ = 0.0f;
+        mix_ = 1.0f;
+        stage_.setCurve(stage_.getCurve(), shape_);
+        stage_.reset();
     }
 }
 
-} // namespace core
\ No newline at end of file
+} // namespace core
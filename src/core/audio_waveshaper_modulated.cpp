@@ -1,91 +0,0 @@
-#include "core/audio_waveshaper_modulated.h"
-#include <iostream>
-
-namespace core {
-
-AudioWaveshaperModulated::AudioWaveshaperModulated() 
-    : initialized_(false), drive_(0.5f), shape_(0.5f), mix_(0.5f),
-      modulation_rate_(1.0f), modulation_depth_(0.3f) {
-    // 初始化音频调制波形整形器
-}
-
-AudioWaveshaperModulated::~AudioWaveshaperModulated() {
-    // 析构函数
-    shutdown();
-}
-
-bool AudioWaveshaperModulated::initialize() {
-    std::cout << "Initializing audio waveshaper modulated" << std::endl;
-    
-    // 在实际实现中，这里会初始化调制波形整形器
-    
-    initialized_ = true;
-    return true;
-}
-
-void AudioWaveshaperModulated::shutdown() {
-    if (initialized_) {
-        std::cout << "Shutting down audio waveshaper modulated" << std::endl;
-        
-        // 在实际实现中，这里会关闭调制波形整形器
-        
-        initialized_ = false;
-    }
-}
-
-bool AudioWaveshaperModulated::apply(const AudioBuffer& input, AudioBuffer& output) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Applying audio waveshaper modulated effect" << std::endl;
-    
-    // 在实际实现中，这里会应用调制波形整形效果
-    
-    output = input;  // 模拟处理
-    return true;
-}
-
-bool AudioWaveshaperModulated::setParameters(float drive, float shape, float mix, float modulation_rate, float modulation_depth) {
-    if (!initialized_) {
-        return false;
-    }
-    
-    std::cout << "Setting waveshaper modulated parameters - Drive: " << drive 
-              << ", Shape: " << shape << ", Mix: " << mix
-              << ", Modulation rate: " << modulation_rate << " Hz"
-              << ", Modulation depth: " << modulation_depth << std::endl;
-    
-    // 在实际实现中，这里会设置调制波形整形参数
-    
-    drive_ = drive;
-    shape_ = shape;
-    mix_ = mix;
-    modulation_rate_ = modulation_rate;
-    modulation_depth_ = modulation_depth;
-    return true;
-}
-
-void AudioWaveshaperModulated::getParameters(float& drive, float& shape, float& mix, float& modulation_rate, float& modulation_depth) const {
-    drive = drive_;
-    shape = shape_;
-    mix = mix_;
-    modulation_rate = modulation_rate_;
-    modulation_depth = modulation_depth_;
-}
-
-void AudioWaveshaperModulated::reset() {
-    if (initialized_) {
-        std::cout << "Resetting audio waveshaper modulated" << std::endl;
-        
-        // 在实际实现中，这里会重置调制波形整形器
-        
-        drive_ = 0.5f;
-        shape_ = 0.5f;
-        mix_ = 0.5f;
-        modulation_rate_ = 1.0f;
-        modulation_depth_ = 0.3f;
-    }
-}
-
-} // namespace core
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "core/audio_waveshaping.h"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+namespace {
+
+// 非对称曲线负半周的饱和电平
+const float kAsymmetricNegativeLevel = 0.6f;
+
+// 隔直滤波器的截止频率（Hz）
+const float kDcCutoff = 10.0f;
+
+} // namespace
+
+TransferTable::TransferTable() : curve_(TransferCurve::TANH) {
+    build(curve_, 0.0f);
+}
+
+float TransferTable::compute(TransferCurve curve, float x) {
+    switch (curve) {
+        case TransferCurve::HARD_CLIP:
+            return std::clamp(x, -1.0f, 1.0f);
+        case TransferCurve::ASYMMETRIC:
+            return x >= 0.0f ? std::tanh(x)
+                             : kAsymmetricNegativeLevel * std::tanh(x / kAsymmetricNegativeLevel);
+        case TransferCurve::TANH:
+        default:
+            return std::tanh(x);
+    }
+}
+
+void TransferTable::build(TransferCurve curve, float hardness) {
+    curve_ = curve;
+    hardness = std::clamp(hardness, 0.0f, 1.0f);
+
+    entries_.resize(2 * (kSegments + 1));
+    const float step = 2.0f * kRange / static_cast<float>(kSegments);
+    for (size_t i = 0; i <= kSegments; ++i) {
+        const float x = -kRange + step * static_cast<float>(i);
+        const float shaped = compute(curve, x);
+        const float hard = std::clamp(x, -1.0f, 1.0f);
+        entries_[2 * i] = shaped + hardness * (hard - shaped);
+    }
+    for (size_t i = 0; i < kSegments; ++i) {
+        entries_[2 * i + 1] = entries_[2 * i + 2] - entries_[2 * i];
+    }
+    entries_[2 * kSegments + 1] = 0.0f;
+}
+
+float TransferTable::evaluate(float x) const {
+    float value = x;
+    process(&value, 1, 1.0f);
+    return value;
+}
+
+void TransferTable::process(float* data, size_t count, float gain) const {
+    const float scale = gain * static_cast<float>(kSegments) / (2.0f * kRange);
+    const float offset = 0.5f * static_cast<float>(kSegments);
+    const float limit = static_cast<float>(kSegments);
+    const float* entries = entries_.data();
+
+    // 位置计算与插值无分支，每个样本一次查表（数值与斜率相邻存放，位于同一缓存行）
+    for (size_t i = 0; i < count; ++i) {
+        const float position = std::min(std::max(data[i] * scale + offset, 0.0f), limit);
+        const int index = static_cast<int>(position);
+        const float frac = position - static_cast<float>(index);
+        data[i] = entries[2 * index] + entries[2 * index + 1] * frac;
+    }
+}
+
+// WaveshapingStage implementation
+WaveshapingStage::WaveshapingStage()
+    : published_(nullptr), acknowledged_(0), version_(0), channels_(0), dc_coefficient_(0.999f) {
+    setCurve(TransferCurve::TANH, 0.0f);
+}
+
+void WaveshapingStage::prepare(int sample_rate, size_t channels, size_t max_frames) {
+    channels_ = channels;
+    dc_coefficient_ = 1.0f - 6.28318530717959f * kDcCutoff / static_cast<float>(sample_rate);
+    oversampler_.prepare(channels, max_frames);
+    allocateState();
+}
+
+void WaveshapingStage::setCurve(TransferCurve curve, float hardness) {
+    // 构建到新表后再发布，音频线程读取的表不会被原地改写
+    auto table = std::make_unique<CurveTable>();
+    table->version = ++version_;
+    table->table.build(curve, hardness);
+    published_.store(table.get(), std::memory_order_release);
+    tables_.push_back(std::move(table));
+
+    reclaim();
+}
+
+void WaveshapingStage::reclaim() {
+    // 音频线程正在使用的表版本不低于其最后确认的版本
+    const uint64_t acknowledged = acknowledged_.load(std::memory_order_acquire);
+    tables_.erase(std::remove_if(tables_.begin(), tables_.end(),
+                                 [acknowledged](const std::unique_ptr<CurveTable>& table) {
+                                     return table->version < acknowledged;
+                                 }),
+                  tables_.end());
+}
+
+bool WaveshapingStage::setOversampling(size_t factor) {
+    if (!oversampler_.setFactor(factor)) {
+        return false;
+    }
+
+    allocateState();
+    return true;
+}
+
+void WaveshapingStage::allocateState() {
+    const size_t latency = oversampler_.getLatency();
+    dry_history_.assign(channels_ * latency, 0.0f);
+    dry_work_.assign(oversampler_.getMaxFrames() + latency, 0.0f);
+    dc_state_.assign(2 * channels_, 0.0f);
+}
+
+void WaveshapingStage::process(float* data, size_t frames, float gain, float mix) {
+    const size_t max_frames = oversampler_.getMaxFrames();
+    if (frames == 0 || channels_ == 0 || max_frames == 0) {
+        return;
+    }
+
+    // 每块取一次当前表并确认，编辑线程据此释放旧表
+    const CurveTable* table = published_.load(std::memory_order_acquire);
+    acknowledged_.store(table->version, std::memory_order_release);
+
+    // 过采样缓冲区与延迟线在prepare中按块长分配，更长的块分段处理
+    for (size_t offset = 0; offset < frames; offset += max_frames) {
+        processBlock(table->table, data + offset * channels_, std::min(max_frames, frames - offset), gain, mix);
+    }
+}
+
+void WaveshapingStage::processBlock(const TransferTable& table, float* data, size_t frames, float gain, float mix) {
+    const size_t channels = channels_;
+    const size_t latency = oversampler_.getLatency();
+    const size_t oversampled = frames * oversampler_.getFactor();
+    const float dry = 1.0f - mix;
+    const bool block_dc = table.getCurve() == TransferCurve::ASYMMETRIC;
+
+    for (size_t ch = 0; ch < channels; ++ch) {
+        float* channel = data + ch;
+
+        float* upsampled = oversampler_.upsample(ch, channel, frames, channels);
+        table.process(upsampled, oversampled, gain);
+
+        // 干信号延迟与过采样滤波器对齐（始终更新，mix变化时历史保持连续）
+        float* work = dry_work_.data();
+        float* history = dry_history_.data() + ch * latency;
+        std::copy(history, history + latency, work);
+        for (size_t i = 0; i < frames; ++i) {
+            work[latency + i] = channel[i * channels];
+        }
+        std::copy(work + frames, work + frames + latency, history);
+
+        oversampler_.downsample(ch, channel, frames, channels);
+
+        if (block_dc) {
+            float x1 = dc_state_[2 * ch];
+            float y1 = dc_state_[2 * ch + 1];
+            for (size_t i = 0; i < frames; ++i) {
+                const float x = channel[i * channels];
+                y1 = x - x1 + dc_coefficient_ * y1;
+                x1 = x;
+                channel[i * channels] = y1;
+            }
+            dc_state_[2 * ch] = x1;
+            dc_state_[2 * ch + 1] = y1;
+        }
+
+        if (dry > 0.0f) {
+            for (size_t i = 0; i < frames; ++i) {
+                channel[i * channels] = mix * channel[i * channels] + dry * work[i];
+            }
+        }
+    }
+}
+
+void WaveshapingStage::reset() {
+    oversampler_.reset();
+    std::fill(dry_history_.begin(), dry_history_.end(), 0.0f);
+    std::fill(dc_state_.begin(), dc_state_.end(), 0.0f);
+}
+
+} // namespace core
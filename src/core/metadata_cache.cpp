@@ -0,0 +1,155 @@
+#include "core/metadata_cache.h"
+#include <fstream>
+#include <vector>
+
+namespace core {
+
+namespace {
+
+// 转义制表符、换行与反斜杠，保证一行一个条目
+std::string escape(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '\\': result += "\\\\"; break;
+            case '\t': result += "\\t"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            default: result += c; break;
+        }
+    }
+    return result;
+}
+
+std::string unescape(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            result += text[i];
+            continue;
+        }
+        switch (text[++i]) {
+            case 't': result += '\t'; break;
+            case 'n': result += '\n'; break;
+            case 'r': result += '\r'; break;
+            default: result += text[i]; break;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+MetadataCache::MetadataCache() {
+}
+
+bool MetadataCache::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    // 先在锁外解析，再一次性合并
+    std::vector<std::string> fields;
+    std::unordered_map<std::string, std::map<std::string, std::string>> loaded;
+    std::string line;
+    while (std::getline(file, line)) {
+        fields.clear();
+        size_t start = 0;
+        for (;;) {
+            const size_t tab = line.find('\t', start);
+            fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+            if (tab == std::string::npos) {
+                break;
+            }
+            start = tab + 1;
+        }
+        if (fields.size() != 3) {
+            continue;
+        }
+        loaded[unescape(fields[0])][unescape(fields[1])] = unescape(fields[2]);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : loaded) {
+        std::map<std::string, std::string>& values = entries_[entry.first];
+        for (auto& value : entry.second) {
+            values[value.first] = std::move(value.second);
+        }
+    }
+    return true;
+}
+
+bool MetadataCache::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+        const std::string path = escape(entry.first);
+        for (const auto& value : entry.second) {
+            file << path << '\t' << escape(value.first) << '\t' << escape(value.second) << '\n';
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+bool MetadataCache::get(const std::string& path, const std::string& key, std::string& value) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(path);
+    if (entry == entries_.end()) {
+        return false;
+    }
+    auto it = entry->second.find(key);
+    if (it == entry->second.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+std::map<std::string, std::string> MetadataCache::getAll(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(path);
+    return entry == entries_.end() ? std::map<std::string, std::string>() : entry->second;
+}
+
+void MetadataCache::set(const std::string& path, const std::string& key, const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[path][key] = value;
+}
+
+void MetadataCache::setAll(const std::string& path, const std::map<std::string, std::string>& values) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, std::string>& entry = entries_[path];
+    for (const auto& value : values) {
+        entry[value.first] = value.second;
+    }
+}
+
+bool MetadataCache::contains(const std::string& path, const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(path);
+    return entry != entries_.end() && entry->second.count(key) > 0;
+}
+
+bool MetadataCache::remove(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.erase(path) > 0;
+}
+
+size_t MetadataCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void MetadataCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+} // namespace core
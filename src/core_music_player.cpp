@@ -1,4 +1,5 @@
 #include "core_music_player.h"
+#include "audio/audio_engine.h"
 #include <iostream>
 
 namespace coremusic {
@@ -18,6 +19,9 @@ public:
 
     core::Result<void> load_file(const std::string& filename) override {
         std::cout << "Loading file: " << filename << std::endl;
+
+        // 引擎按元数据缓存中的响度扫描结果设置本曲目的回放增益
+        audio::AudioEngine::instance()->load_track(filename);
         return core::Result<void>();
     }
 
@@ -1,23 +1,402 @@
 #include "platform/thread_manager.h"
+#include "platform/denormal_guard.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
 #include <thread>
 
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <cerrno>
+#endif
+
 namespace platform {
 
-// 创建并启动线程
+namespace {
+
+// CPU编号上限（与cpu_set_t的容量一致）
+const unsigned int kMaxCpus = 1024;
+
+// 角色数量
+const size_t kRoleCount = 3;
+
+// 各角色的调度策略（只在线程启动、加载配置时访问）
+struct PolicyTable {
+    std::mutex mutex;
+    ThreadPolicy policies[kRoleCount];
+    std::atomic<bool> warned[kRoleCount];
+};
+
+PolicyTable& policy_table() {
+    static PolicyTable table;
+    return table;
+}
+
+const char* role_name(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::AUDIO: return "audio";
+        case ThreadRole::WORKER: return "worker";
+        case ThreadRole::BACKGROUND: return "background";
+    }
+    return "unknown";
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        --end;
+    }
+    return text.substr(begin, end - begin);
+}
+
+// 在扁平的JSON对象文本中查找"key": value，字符串去掉引号，其他值取到逗号或右括号为止
+bool find_value(const std::string& text, const std::string& key, std::string& value) {
+    const std::string quoted = "\"" + key + "\"";
+    size_t pos = text.find(quoted);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = text.find_first_not_of(" \t\r\n", pos + quoted.size());
+    if (pos == std::string::npos || text[pos] != ':') {
+        return false;
+    }
+    pos = text.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    if (text[pos] == '"') {
+        const size_t end = text.find('"', pos + 1);
+        if (end == std::string::npos) {
+            return false;
+        }
+        value = text.substr(pos + 1, end - pos - 1);
+        return true;
+    }
+    const size_t end = text.find_first_of(",}", pos);
+    value = trim(text.substr(pos, end == std::string::npos ? std::string::npos : end - pos));
+    return true;
+}
+
+// 取出"section": { ... }的内容，找不到时返回整个文本
+std::string find_section(const std::string& text, const std::string& section) {
+    const size_t key = text.find("\"" + section + "\"");
+    if (key == std::string::npos) {
+        return text;
+    }
+    const size_t begin = text.find('{', key);
+    if (begin == std::string::npos) {
+        return text;
+    }
+    int depth = 0;
+    for (size_t i = begin; i < text.size(); ++i) {
+        if (text[i] == '{') {
+            ++depth;
+        } else if (text[i] == '}' && --depth == 0) {
+            return text.substr(begin, i - begin + 1);
+        }
+    }
+    return text;
+}
+
+#ifdef __linux__
+bool apply_priority(pthread_t handle, int priority, bool round_robin) {
+    sched_param param{};
+    if (priority <= kThreadPriorityNormal) {
+        // 非实时策略不需要特权
+        int policy = SCHED_OTHER;
+        if (priority == kThreadPriorityLow) {
+            policy = SCHED_BATCH;
+        } else if (priority < kThreadPriorityLow) {
+            policy = SCHED_IDLE;
+        }
+        param.sched_priority = 0;
+        return pthread_setschedparam(handle, policy, &param) == 0;
+    }
+
+    const int policy = round_robin ? SCHED_RR : SCHED_FIFO;
+    param.sched_priority = std::clamp(priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+    const int result = pthread_setschedparam(handle, policy, &param);
+    if (result != EPERM) {
+        return result == 0;
+    }
+
+    // 没有CAP_SYS_NICE：非特权进程可以把RLIMIT_RTPRIO的软限制提高到硬限制（如limits.conf中的rtprio），
+    // 再以限制内的最高优先级重试
+    rlimit limit{};
+    if (getrlimit(RLIMIT_RTPRIO, &limit) != 0) {
+        return false;
+    }
+    if (limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        if (setrlimit(RLIMIT_RTPRIO, &limit) != 0 && getrlimit(RLIMIT_RTPRIO, &limit) != 0) {
+            return false;
+        }
+    }
+    if (limit.rlim_cur == 0) {
+        return false;
+    }
+    if (limit.rlim_cur != RLIM_INFINITY) {
+        param.sched_priority = std::min(param.sched_priority, static_cast<int>(limit.rlim_cur));
+    }
+    return pthread_setschedparam(handle, policy, &param) == 0;
+}
+
+bool apply_affinity(pthread_t handle, const std::vector<unsigned int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned int cpu : cpus) {
+        if (cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(handle, sizeof(set), &set) == 0;
+}
+#endif
+
+} // namespace
+
+// 创建并启动线程（线程内启用FTZ/DAZ）
 std::thread ThreadManager::create_thread(std::function<void()> func) {
-    return std::thread(func);
+    return std::thread([func = std::move(func)] {
+        DenormalGuard guard;
+        func();
+    });
 }
 
 // 设置线程优先级（如果支持）
-bool ThreadManager::set_thread_priority(std::thread& thread, int priority) {
-    // Windows平台不直接支持设置线程优先级，返回false表示不支持
+bool ThreadManager::set_thread_priority(std::thread& thread, int priority, bool round_robin) {
+    if (!thread.joinable()) {
+        return false;
+    }
+#ifdef __linux__
+    return apply_priority(thread.native_handle(), priority, round_robin);
+#else
+    // 其他平台暂不支持，返回false表示不支持
+    (void)priority;
+    (void)round_robin;
     return false;
+#endif
 }
 
 // 设置线程亲和性（如果支持）
 bool ThreadManager::set_thread_affinity(std::thread& thread, unsigned int cpu_id) {
-    // Windows平台不直接支持设置线程亲和性，返回false表示不支持
+    return set_thread_affinity(thread, std::vector<unsigned int>{cpu_id});
+}
+
+bool ThreadManager::set_thread_affinity(std::thread& thread, const std::vector<unsigned int>& cpus) {
+    if (!thread.joinable()) {
+        return false;
+    }
+#ifdef __linux__
+    return apply_affinity(thread.native_handle(), cpus);
+#else
+    // 其他平台暂不支持，返回false表示不支持
+    (void)cpus;
     return false;
+#endif
+}
+
+bool ThreadManager::set_current_thread_priority(int priority, bool round_robin) {
+#ifdef __linux__
+    return apply_priority(pthread_self(), priority, round_robin);
+#else
+    (void)priority;
+    (void)round_robin;
+    return false;
+#endif
+}
+
+bool ThreadManager::set_current_thread_affinity(const std::vector<unsigned int>& cpus) {
+#ifdef __linux__
+    return apply_affinity(pthread_self(), cpus);
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+std::vector<unsigned int> ThreadManager::available_cpus() {
+    std::vector<unsigned int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+#endif
+    const size_t count = std::max<size_t>(1, hardware_concurrency());
+    for (size_t cpu = 0; cpu < count; ++cpu) {
+        cpus.push_back(static_cast<unsigned int>(cpu));
+    }
+    return cpus;
+}
+
+void ThreadManager::set_role_policy(ThreadRole role, const ThreadPolicy& policy) {
+    PolicyTable& table = policy_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    table.policies[static_cast<size_t>(role)] = policy;
+    table.warned[static_cast<size_t>(role)].store(false);
+}
+
+ThreadPolicy ThreadManager::get_role_policy(ThreadRole role) {
+    PolicyTable& table = policy_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.policies[static_cast<size_t>(role)];
+}
+
+ThreadPolicy ThreadManager::effective_role_policy(ThreadRole role) {
+    ThreadPolicy policy = get_role_policy(role);
+    if (role == ThreadRole::AUDIO || !policy.cpus.empty()) {
+        return policy;
+    }
+
+    // 音频线程独占其CPU：未单独绑定的角色使用其余CPU，避免工作线程抢占音频回调的核心
+    const ThreadPolicy audio = get_role_policy(ThreadRole::AUDIO);
+    if (audio.cpus.empty()) {
+        return policy;
+    }
+    for (unsigned int cpu : available_cpus()) {
+        if (std::find(audio.cpus.begin(), audio.cpus.end(), cpu) == audio.cpus.end()) {
+            policy.cpus.push_back(cpu);
+        }
+    }
+    return policy;
+}
+
+bool ThreadManager::apply_role_policy(ThreadRole role) {
+    const ThreadPolicy policy = effective_role_policy(role);
+    bool priority_ok = true;
+    bool affinity_ok = true;
+    if (policy.priority != kThreadPriorityNormal) {
+        priority_ok = set_current_thread_priority(policy.priority, policy.round_robin);
+    }
+    if (!policy.cpus.empty()) {
+        affinity_ok = set_current_thread_affinity(policy.cpus);
+    }
+
+    // 同一角色只提示一次（线程池的每个工作线程都会调用）
+    if ((!priority_ok || !affinity_ok) &&
+        !policy_table().warned[static_cast<size_t>(role)].exchange(true)) {
+        std::cout << "Failed to apply " << role_name(role) << " thread policy"
+                  << (priority_ok ? "" : " (priority)") << (affinity_ok ? "" : " (affinity)") << std::endl;
+    }
+    return priority_ok && affinity_ok;
+}
+
+bool ThreadManager::load_config(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string section = find_section(buffer.str(), "performance");
+
+    bool ok = true;
+    std::string value;
+    ThreadPolicy policies[kRoleCount];
+    const char* priority_keys[kRoleCount] = {"cpu_priority", "worker_priority", "background_priority"};
+    const char* cpu_keys[kRoleCount] = {"audio_cpus", "worker_cpus", "background_cpus"};
+    bool has_priority[kRoleCount] = {false, false, false};
+    for (size_t role = 0; role < kRoleCount; ++role) {
+        if (find_value(section, priority_keys[role], value) && !trim(value).empty()) {
+            has_priority[role] = parse_priority(value, policies[role].priority);
+            ok = ok && has_priority[role];
+        }
+        if (find_value(section, cpu_keys[role], value)) {
+            if (!parse_cpu_list(value, policies[role].cpus)) {
+                policies[role].cpus.clear();
+                ok = false;
+            }
+        }
+    }
+
+    // 音频线程等待工作线程完成扇出任务：未指定时工作线程取略低于音频线程的实时优先级，避免优先级反转
+    const int audio_priority = policies[static_cast<size_t>(ThreadRole::AUDIO)].priority;
+    if (!has_priority[static_cast<size_t>(ThreadRole::WORKER)] && audio_priority > kThreadPriorityNormal) {
+        policies[static_cast<size_t>(ThreadRole::WORKER)].priority = std::max(1, audio_priority - 10);
+    }
+
+    for (size_t role = 0; role < kRoleCount; ++role) {
+        set_role_policy(static_cast<ThreadRole>(role), policies[role]);
+    }
+    return ok;
+}
+
+bool ThreadManager::parse_priority(const std::string& text, int& priority) {
+    std::string name = trim(text);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (name == "idle") {
+        priority = kThreadPriorityIdle;
+    } else if (name == "low") {
+        priority = kThreadPriorityLow;
+    } else if (name == "normal") {
+        priority = kThreadPriorityNormal;
+    } else if (name == "high") {
+        priority = kThreadPriorityHigh;
+    } else if (name == "realtime") {
+        priority = kThreadPriorityRealtime;
+    } else {
+        char* end = nullptr;
+        const long number = std::strtol(name.c_str(), &end, 10);
+        if (name.empty() || *end != '\0' || number < kThreadPriorityIdle || number > 99) {
+            return false;
+        }
+        priority = static_cast<int>(number);
+    }
+    return true;
+}
+
+bool ThreadManager::parse_cpu_list(const std::string& text, std::vector<unsigned int>& cpus) {
+    cpus.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        item = trim(item);
+        if (item.empty()) {
+            continue;
+        }
+        const size_t dash = item.find('-');
+        const std::string first_text = trim(item.substr(0, dash));
+        const std::string last_text = dash == std::string::npos ? first_text : trim(item.substr(dash + 1));
+        if (first_text.empty() || last_text.empty() ||
+            first_text.find_first_not_of("0123456789") != std::string::npos ||
+            last_text.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        const unsigned long first = std::strtoul(first_text.c_str(), nullptr, 10);
+        const unsigned long last = std::strtoul(last_text.c_str(), nullptr, 10);
+        if (first > last || last >= kMaxCpus) {
+            return false;
+        }
+        for (unsigned long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<unsigned int>(cpu));
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return true;
 }
 
 // 获取硬件线程数
@@ -25,4 +404,4 @@ size_t ThreadManager::hardware_concurrency() {
     return std::thread::hardware_concurrency();
 }
 
-} // namespace platform
\ No newline at end of file
+} // namespace platform
@@ -3,6 +3,19 @@
 #include "audio/device_manager.h"
 #include "audio/decoder_interface.h"
 #include "audio/decoder_manager.h"
+#include "audio/simd/sample_convert.h"
+#include "core/audio_automation.h"
+#include "core/audio_loudness_scanner.h"
+#include "core/metadata_cache.h"
+#include "platform/thread_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
 
 // Test that our interfaces compile correctly and can be instantiated
 TEST(AudioEngineTest, InterfaceCompilation) {
@@ -15,4 +28,143 @@ TEST(AudioEngineTest, InterfaceCompilation) {
 TEST(DecoderManagerTest, InterfaceCompilation) {
     // Ensure decoder manager interface compiles correctly
     EXPECT_TRUE(true);  // Placeholder test
-}
\ No newline at end of file
+}
+// 测试加载曲目时从元数据缓存读取回放增益，未扫描的曲目清除增益
+TEST(AudioEngineTest, LoadsReplayGainFromCache) {
+    core::MetadataCache cache;
+    cache.set("album/01.flac", core::LoudnessScanner::kTrackGainKey, "-6.00 dB");
+    cache.set("album/01.flac", core::LoudnessScanner::kTrackPeakKey, "0.500000");
+    cache.set("album/02.flac", core::LoudnessScanner::kTrackGainKey, "12.00 dB");
+    cache.set("album/02.flac", core::LoudnessScanner::kTrackPeakKey, "0.500000");
+
+    audio::AudioEngine engine;
+    EXPECT_TRUE(engine.load_replay_gain(cache, "album/01.flac"));
+    EXPECT_NEAR(engine.get_replay_gain(), std::pow(10.0f, -6.0f / 20.0f), 1e-4f);
+
+    // 增益受真峰值限制，不削波
+    EXPECT_TRUE(engine.load_replay_gain(cache, "album/02.flac"));
+    EXPECT_NEAR(engine.get_replay_gain(), 2.0f, 1e-4f);
+
+    EXPECT_FALSE(engine.load_replay_gain(cache, "album/03.flac"));
+    EXPECT_FLOAT_EQ(engine.get_replay_gain(), 1.0f);
+}
+
+// 测试加载曲目：按元数据缓存设置回放增益，专辑模式优先专辑增益，未扫描的曲目不沿用上一首的增益
+TEST(AudioEngineTest, LoadTrackAppliesReplayGain) {
+    auto cache = std::make_shared<core::MetadataCache>();
+    cache->set("album/01.flac", core::LoudnessScanner::kTrackGainKey, "-6.00 dB");
+    cache->set("album/01.flac", core::LoudnessScanner::kTrackPeakKey, "0.500000");
+    cache->set("album/01.flac", core::LoudnessScanner::kAlbumGainKey, "-3.00 dB");
+    cache->set("album/01.flac", core::LoudnessScanner::kAlbumPeakKey, "0.500000");
+
+    audio::AudioEngine engine;
+    EXPECT_TRUE(engine.load_track("album/01.flac"));
+    EXPECT_FLOAT_EQ(engine.get_replay_gain(), 1.0f);
+
+    engine.set_metadata_cache(cache);
+    EXPECT_TRUE(engine.load_track("album/01.flac"));
+    EXPECT_NEAR(engine.get_replay_gain(), std::pow(10.0f, -6.0f / 20.0f), 1e-4f);
+
+    engine.set_metadata_cache(cache, true);
+    EXPECT_TRUE(engine.load_track("album/01.flac"));
+    EXPECT_NEAR(engine.get_replay_gain(), std::pow(10.0f, -3.0f / 20.0f), 1e-4f);
+
+    EXPECT_TRUE(engine.load_track("album/02.flac"));
+    EXPECT_FLOAT_EQ(engine.get_replay_gain(), 1.0f);
+    EXPECT_FALSE(engine.load_track(""));
+}
+
+// 测试输出转换路径：整数设备格式经音量与抖动级写入设备缓冲，关闭抖动时与直接转换一致
+TEST(AudioEngineTest, ConvertsToIntegerDeviceFormats) {
+    audio::AudioEngine engine;
+    engine.set_volume(1.0f);
+
+    audio::AudioBuffer buffer(512 * 2);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer.data()[i] = 0.6f * static_cast<float>(std::sin(0.01 * static_cast<double>(i / 2)));
+    }
+    const audio::AudioFormat s16(48000, audio::SampleFormat::PCM_S16LE, audio::ChannelLayout::STEREO);
+
+    // 抖动关闭：与SIMD转换内核的结果比特一致
+    engine.set_dither(false, audio::dsp::Dither::NoiseShaping::NONE);
+    ASSERT_TRUE(engine.play_audio(buffer, s16));
+    std::vector<int16_t> expected(buffer.size());
+    ASSERT_TRUE(audio::simd::fromFloat(buffer.data(), audio::SampleFormat::PCM_S16LE, expected.data(), expected.size()));
+    const int16_t* device = reinterpret_cast<const int16_t*>(engine.get_device_buffer().data());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(device[i], expected[i]) << i;
+    }
+
+    // 抖动开启：误差在TPDF范围内（不超过2 LSB）
+    engine.set_dither(true, audio::dsp::Dither::NoiseShaping::NONE);
+    ASSERT_TRUE(engine.play_audio(buffer, s16));
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_LE(std::abs(device[i] - expected[i]), 2) << i;
+    }
+
+    // 7.1声道（Dither::kMaxChannels）24位输出同样成功
+    audio::AudioBuffer surround(256 * 8);
+    const audio::AudioFormat s24(48000, audio::SampleFormat::PCM_S24LE, audio::ChannelLayout::SEVEN_POINT_ONE);
+    EXPECT_TRUE(engine.play_audio(surround, s24));
+    EXPECT_TRUE(engine.is_playing());
+}
+
+// 测试音量自动化：通道按时间线位置渲染为逐帧增益，跨块连续，停止播放后从头开始
+TEST(AudioEngineTest, AppliesVolumeAutomation) {
+    audio::AudioEngine engine;
+    engine.set_volume(1.0f);
+    const audio::AudioFormat mono(48000, audio::SampleFormat::PCM_FLOAT, audio::ChannelLayout::MONO);
+    audio::AudioBuffer ones(256);
+    std::fill(ones.data(), ones.data() + ones.size(), 1.0f);
+
+    // 先输出一块，使音量斜坡到达目标值
+    ASSERT_TRUE(engine.play_audio(ones, mono));
+    engine.stop_playback();
+    EXPECT_EQ(engine.get_position(), 0u);
+
+    auto automation = std::make_shared<core::AudioAutomation>();
+    const auto gain = automation->addParameter("volume", 1.0f);
+    ASSERT_TRUE(automation->addRamp(gain, 0, 384, 1.0f, 0.0f));
+    automation->commit();
+    engine.set_volume_automation(automation, gain);
+
+    // 斜坡跨越两块：第二块从第256帧继续
+    for (size_t block = 0; block < 2; ++block) {
+        ASSERT_TRUE(engine.play_audio(ones, mono));
+        const audio::AudioBuffer& output = engine.get_output();
+        for (size_t i = 0; i < ones.size(); ++i) {
+            const float frame = static_cast<float>(block * ones.size() + i);
+            EXPECT_NEAR(output.data()[i], std::max(0.0f, 1.0f - frame / 384.0f), 1e-4f) << block << ":" << i;
+        }
+    }
+    EXPECT_EQ(engine.get_position(), 512u);
+
+    // 取消自动化后恢复原音量
+    engine.set_volume_automation(nullptr, 0);
+    ASSERT_TRUE(engine.play_audio(ones, mono));
+    EXPECT_FLOAT_EQ(engine.get_output().data()[100], 1.0f);
+}
+
+// 测试初始化时读取线程调度策略，配置文件缺失时保持默认策略并照常初始化
+TEST(AudioEngineTest, InitializeLoadsThreadPolicies) {
+    const std::string path = (std::filesystem::temp_directory_path() / "audio_engine_test_config.json").string();
+    {
+        std::ofstream file(path);
+        file << "{\"performance\": {\"cpu_priority\": \"normal\", \"worker_priority\": \"\", "
+                "\"background_priority\": \"idle\", \"audio_cpus\": \"\", \"worker_cpus\": \"\", "
+                "\"background_cpus\": \"\"}}";
+    }
+
+    audio::AudioEngine engine;
+    engine.set_config_file(path);
+    EXPECT_TRUE(engine.initialize());
+    std::remove(path.c_str());
+    EXPECT_EQ(platform::ThreadManager::get_role_policy(platform::ThreadRole::BACKGROUND).priority,
+              platform::kThreadPriorityIdle);
+
+    engine.set_config_file(path);
+    EXPECT_TRUE(engine.initialize());
+    for (auto role : {platform::ThreadRole::AUDIO, platform::ThreadRole::WORKER, platform::ThreadRole::BACKGROUND}) {
+        platform::ThreadManager::set_role_policy(role, platform::ThreadPolicy());
+    }
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "core/audio_automation.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// 测试线性斜坡：逐帧渲染与valueAt一致，端点精确，斜坡前后保持端点值
+TEST(AutomationTest, LinearRampRendersExactValues) {
+    core::AudioAutomation automation;
+    const auto gain = automation.addParameter("gain", 1.0f);
+    ASSERT_TRUE(automation.addRamp(gain, 100, 200, 0.0f, 1.0f));
+    automation.commit();
+
+    const core::AutomationLane* lane = automation.acquire()->lane(gain);
+    ASSERT_NE(lane, nullptr);
+
+    std::vector<float> values(300);
+    lane->render(0, values.size(), values.data());
+    for (size_t i = 0; i < values.size(); ++i) {
+        const float expected = i < 100 ? 0.0f : (i >= 200 ? 1.0f : static_cast<float>(i - 100) / 100.0f);
+        EXPECT_NEAR(values[i], expected, 1e-6f) << "frame " << i;
+        EXPECT_FLOAT_EQ(values[i], lane->valueAt(i)) << "frame " << i;
+    }
+    EXPECT_FLOAT_EQ(lane->valueAt(100), 0.0f);
+    EXPECT_FLOAT_EQ(lane->valueAt(200), 1.0f);
+    EXPECT_FLOAT_EQ(lane->valueAt(150), 0.5f);
+
+    // 无断点的参数使用默认值
+    const auto pan = automation.addParameter("pan", 0.25f);
+    automation.commit();
+    EXPECT_FLOAT_EQ(automation.acquire()->lane(pan)->valueAt(12345), 0.25f);
+    EXPECT_EQ(automation.acquire()->lane(pan + 1), nullptr);
+}
+
+// 测试指数斜坡：几何中点为两端的几何平均，分块渲染与整体渲染一致
+TEST(AutomationTest, ExponentialRampIsGeometric) {
+    core::AudioAutomation automation;
+    const auto cutoff = automation.addParameter("cutoff", 100.0f);
+    ASSERT_TRUE(automation.addRamp(cutoff, 0, 1000, 100.0f, 10000.0f, core::AutomationCurve::EXPONENTIAL));
+    automation.commit();
+    const core::AutomationLane* lane = automation.acquire()->lane(cutoff);
+
+    EXPECT_NEAR(lane->valueAt(500), 1000.0f, 1e-2f);
+    EXPECT_NEAR(lane->valueAt(250), std::sqrt(100.0f * 1000.0f), 1e-2f);
+
+    std::vector<float> whole(1200);
+    lane->render(0, whole.size(), whole.data());
+    std::vector<float> blocks(whole.size());
+    for (size_t offset = 0; offset < blocks.size(); offset += 37) {
+        lane->render(offset, std::min<size_t>(37, blocks.size() - offset), blocks.data() + offset);
+    }
+    for (size_t i = 0; i < whole.size(); ++i) {
+        const float expected = lane->valueAt(i);
+        EXPECT_NEAR(whole[i], expected, expected * 1e-5f) << "frame " << i;
+        EXPECT_NEAR(blocks[i], expected, expected * 1e-5f) << "frame " << i;
+    }
+    EXPECT_FLOAT_EQ(whole.back(), 10000.0f);
+}
+
+// 测试按断点切分块：段边界正好落在块内的断点上，常数检测与阶跃断点一致
+TEST(AutomationTest, SegmentsSplitAtBreakpoints) {
+    core::AudioAutomation automation;
+    const auto mix = automation.addParameter("mix", 0.0f);
+    ASSERT_TRUE(automation.addPoint(mix, 10, 0.0f));
+    ASSERT_TRUE(automation.addPoint(mix, 40, 1.0f, core::AutomationCurve::STEP));
+    ASSERT_TRUE(automation.addPoint(mix, 50, 0.5f));
+    automation.commit();
+    const core::AutomationLane* lane = automation.acquire()->lane(mix);
+
+    std::vector<std::pair<size_t, size_t>> segments;
+    core::forEachAutomationSegment(*lane, 0, 64, [&segments](size_t offset, size_t count) {
+        segments.emplace_back(offset, count);
+    });
+    const std::vector<std::pair<size_t, size_t>> expected = {{0, 10}, {10, 30}, {40, 10}, {50, 14}};
+    EXPECT_EQ(segments, expected);
+
+    EXPECT_EQ(lane->nextEvent(20, 8), 8u);
+    EXPECT_EQ(lane->nextEvent(20, 64), 20u);
+    EXPECT_TRUE(lane->isConstant(10, 30));     // 阶跃段在断点前保持常数
+    EXPECT_FALSE(lane->isConstant(10, 31));
+    EXPECT_FALSE(lane->isConstant(40, 5));     // 线性段
+    EXPECT_TRUE(lane->isConstant(50, 1000));   // 最后一个断点之后
+    EXPECT_FLOAT_EQ(lane->valueAt(39), 0.0f);
+    EXPECT_FLOAT_EQ(lane->valueAt(40), 1.0f);
+    EXPECT_FLOAT_EQ(lane->valueAt(45), 0.75f);
+}
+
+// 测试快照发布：编辑在commit()前对音频线程不可见，已获取的快照保持不变
+TEST(AutomationTest, EditsPublishOnCommit) {
+    core::AudioAutomation automation;
+    const auto gain = automation.addParameter("gain", 1.0f);
+    automation.commit();
+
+    const core::AutomationSnapshot* first = automation.acquire();
+    ASSERT_TRUE(automation.addPoint(gain, 0, 0.5f));
+    EXPECT_EQ(automation.acquire(), first);
+    EXPECT_FLOAT_EQ(first->lane(gain)->valueAt(0), 1.0f);
+
+    automation.commit();
+    const core::AutomationSnapshot* second = automation.acquire();
+    EXPECT_GT(second->version, first->version);
+    EXPECT_FLOAT_EQ(second->lane(gain)->valueAt(0), 0.5f);
+
+    // 清除范围内的断点后回到默认值
+    ASSERT_TRUE(automation.clearRange(gain, 0, 1));
+    automation.commit();
+    EXPECT_FLOAT_EQ(automation.acquire()->lane(gain)->valueAt(0), 1.0f);
+    EXPECT_FALSE(automation.addPoint(gain + 1, 0, 0.0f));
+
+    core::AudioAutomation::ParameterId found = 0;
+    EXPECT_TRUE(automation.findParameter("gain", found));
+    EXPECT_EQ(found, gain);
+    EXPECT_FALSE(automation.findParameter("missing", found));
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "core/audio_channel_mixer.h"
+#include "core/audio_converter.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using audio::ChannelLayout;
+using core::ChannelMixer;
+
+namespace {
+
+const float kMinus3dB = 0.70710678f;
+
+// 交错帧：第frame帧第channel声道的测试值（各声道互不相同，便于检查路由）
+float sampleValue(size_t frame, size_t channel) {
+    return 0.01f * static_cast<float>(frame % 7) + 0.1f * static_cast<float>(channel + 1);
+}
+
+std::vector<float> makeFrames(size_t frames, size_t channels) {
+    std::vector<float> buffer(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            buffer[i * channels + ch] = sampleValue(i, ch);
+        }
+    }
+    return buffer;
+}
+
+// 检查process()的输出等于按getCoefficient()逐帧相乘累加的结果
+void expectMatchesMatrix(const ChannelMixer& mixer, const std::vector<float>& input, const std::vector<float>& output,
+                         size_t frames) {
+    const size_t in_channels = ChannelMixer::channelCount(mixer.getInputLayout());
+    const size_t out_channels = ChannelMixer::channelCount(mixer.getOutputLayout());
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t out = 0; out < out_channels; ++out) {
+            float expected = 0.0f;
+            for (size_t in = 0; in < in_channels; ++in) {
+                expected += mixer.getCoefficient(out, in) * input[i * in_channels + in];
+            }
+            EXPECT_NEAR(output[i * out_channels + out], expected, 1e-6f) << "frame " << i << " channel " << out;
+        }
+    }
+}
+
+} // namespace
+
+// 测试相同布局为比特精确的复制
+TEST(ChannelMixerTest, IdentityCopiesExactly) {
+    ChannelMixer mixer;
+    ASSERT_TRUE(mixer.setLayouts(ChannelLayout::FIVE_POINT_ONE, ChannelLayout::FIVE_POINT_ONE));
+    const std::vector<float> input = makeFrames(37, 6);
+    std::vector<float> output(input.size(), 0.0f);
+    ASSERT_TRUE(mixer.process(input.data(), output.data(), 37));
+    EXPECT_EQ(output, input);
+    EXPECT_FALSE(mixer.setLayouts(ChannelLayout::UNKNOWN, ChannelLayout::STEREO));
+}
+
+// 测试单声道与立体声互转：上混以-3dB分到左右，下混的行和1.414归一化后为(L+R)/2
+TEST(ChannelMixerTest, MonoStereoConversion) {
+    ChannelMixer up;
+    ASSERT_TRUE(up.setLayouts(ChannelLayout::MONO, ChannelLayout::STEREO));
+    EXPECT_FLOAT_EQ(up.getCoefficient(0, 0), kMinus3dB);
+    EXPECT_FLOAT_EQ(up.getCoefficient(1, 0), kMinus3dB);
+
+    const std::vector<float> mono = makeFrames(33, 1);
+    std::vector<float> stereo(mono.size() * 2);
+    ASSERT_TRUE(up.process(mono.data(), stereo.data(), mono.size()));
+    for (size_t i = 0; i < mono.size(); ++i) {
+        EXPECT_FLOAT_EQ(stereo[i * 2], kMinus3dB * mono[i]);
+        EXPECT_FLOAT_EQ(stereo[i * 2 + 1], kMinus3dB * mono[i]);
+    }
+    // 上混不能原地处理
+    EXPECT_FALSE(up.process(stereo.data(), stereo.data(), mono.size()));
+
+    ChannelMixer down;
+    ASSERT_TRUE(down.setLayouts(ChannelLayout::STEREO, ChannelLayout::MONO));
+    EXPECT_FLOAT_EQ(down.getCoefficient(0, 0), 0.5f);
+    EXPECT_FLOAT_EQ(down.getCoefficient(0, 1), 0.5f);
+    down.setNormalize(false);
+    EXPECT_FLOAT_EQ(down.getCoefficient(0, 0), kMinus3dB);
+    EXPECT_FLOAT_EQ(down.getCoefficient(0, 1), kMinus3dB);
+}
+
+// 测试5.1到立体声的默认系数：L' = L + 0.707C + 0.707Ls，按行和2.414归一化（约-7.7 dB），LFE丢弃
+TEST(ChannelMixerTest, FivePointOneDownmixCoefficients) {
+    ChannelMixer mixer;
+    ASSERT_TRUE(mixer.setLayouts(ChannelLayout::FIVE_POINT_ONE, ChannelLayout::STEREO));
+    const float norm = 1.0f + 2.0f * kMinus3dB;
+    // 输入顺序 L R C LFE Ls Rs
+    const float left[6] = {1.0f, 0.0f, kMinus3dB, 0.0f, kMinus3dB, 0.0f};
+    const float right[6] = {0.0f, 1.0f, kMinus3dB, 0.0f, 0.0f, kMinus3dB};
+    for (size_t in = 0; in < 6; ++in) {
+        EXPECT_NEAR(mixer.getCoefficient(0, in), left[in] / norm, 1e-6f) << "input " << in;
+        EXPECT_NEAR(mixer.getCoefficient(1, in), right[in] / norm, 1e-6f) << "input " << in;
+    }
+    EXPECT_NEAR(20.0f * std::log10(mixer.getCoefficient(0, 0)), -7.66f, 0.01f);
+
+    // 关闭归一化得到ITU单位增益系数
+    mixer.setNormalize(false);
+    for (size_t in = 0; in < 6; ++in) {
+        EXPECT_FLOAT_EQ(mixer.getCoefficient(0, in), left[in]) << "input " << in;
+        EXPECT_FLOAT_EQ(mixer.getCoefficient(1, in), right[in]) << "input " << in;
+    }
+
+    const std::vector<float> input = makeFrames(50, 6);
+    std::vector<float> output(50 * 2);
+    ASSERT_TRUE(mixer.process(input.data(), output.data(), 50));
+    expectMatchesMatrix(mixer, input, output, 50);
+}
+
+// 测试7.1到立体声的电平：后环绕以-3dB并入左右，行和3.121，默认归一化后前置声道约-9.9 dB（有意为之，见setNormalize）
+TEST(ChannelMixerTest, SevenPointOneDownmixLevel) {
+    ChannelMixer mixer;
+    ASSERT_TRUE(mixer.setLayouts(ChannelLayout::SEVEN_POINT_ONE, ChannelLayout::STEREO));
+    const float norm = 1.0f + 3.0f * kMinus3dB;
+    // 输入顺序 L R C LFE Lb Rb Ls Rs
+    const float left[8] = {1.0f, 0.0f, kMinus3dB, 0.0f, kMinus3dB, 0.0f, kMinus3dB, 0.0f};
+    for (size_t in = 0; in < 8; ++in) {
+        EXPECT_NEAR(mixer.getCoefficient(0, in), left[in] / norm, 1e-6f) << "input " << in;
+    }
+    EXPECT_NEAR(20.0f * std::log10(mixer.getCoefficient(0, 0)), -9.89f, 0.01f);
+
+    // 只有前置声道的满幅信号下混后同样衰减约-9.9 dB；所有声道同相满幅时恰好不削波
+    std::vector<float> input(64 * 8, 0.0f);
+    for (size_t i = 0; i < 64; ++i) {
+        input[i * 8] = 1.0f;
+        input[i * 8 + 1] = 1.0f;
+    }
+    std::vector<float> output(64 * 2);
+    ASSERT_TRUE(mixer.process(input.data(), output.data(), 64));
+    for (float sample : output) {
+        EXPECT_NEAR(20.0f * std::log10(sample), -9.89f, 0.01f);
+    }
+
+    std::fill(input.begin(), input.end(), 1.0f);
+    ASSERT_TRUE(mixer.process(input.data(), output.data(), 64));
+    for (float sample : output) {
+        EXPECT_NEAR(sample, 1.0f, 1e-6f);
+    }
+
+    // 7.1到5.1：后环绕与侧环绕合并，环绕行和为2，归一化为-6 dB
+    ASSERT_TRUE(mixer.setLayouts(ChannelLayout::SEVEN_POINT_ONE, ChannelLayout::FIVE_POINT_ONE));
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(4, 4), 0.5f);
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(4, 6), 0.5f);
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(0, 0), 0.5f);
+}
+
+// 测试LFE增益、系数覆盖与重置：覆盖的系数原样生效，重置后恢复默认矩阵
+TEST(ChannelMixerTest, LfeGainAndOverrides) {
+    ChannelMixer mixer;
+    ASSERT_TRUE(mixer.setLayouts(ChannelLayout::FIVE_POINT_ONE, ChannelLayout::STEREO));
+    mixer.setNormalize(false);
+    mixer.setLfeGain(0.5f);
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(0, 3), 0.5f * kMinus3dB);
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(1, 3), 0.5f * kMinus3dB);
+
+    ASSERT_TRUE(mixer.setCoefficient(0, 4, 0.0f));
+    ASSERT_TRUE(mixer.setCoefficient(1, 0, 0.25f));
+    EXPECT_FALSE(mixer.setCoefficient(2, 0, 1.0f));
+    EXPECT_FALSE(mixer.setCoefficient(0, 0, std::nanf("")));
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(0, 4), 0.0f);
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(1, 0), 0.25f);
+
+    const std::vector<float> input = makeFrames(41, 6);
+    std::vector<float> output(41 * 2);
+    ASSERT_TRUE(mixer.process(input.data(), output.data(), 41));
+    expectMatchesMatrix(mixer, input, output, 41);
+
+    mixer.resetCoefficients();
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(0, 4), kMinus3dB);
+    EXPECT_FLOAT_EQ(mixer.getCoefficient(1, 0), 0.0f);
+}
+
+// 测试转换器的缓冲区接口：原地下混与单独输出一致，输出按声道数截断
+TEST(ChannelMixerTest, ConverterDownmixesInPlace) {
+    core::AudioConverter converter;
+    ASSERT_TRUE(converter.initialize());
+
+    const std::vector<float> frames = makeFrames(100, 8);
+    core::AudioBuffer input(frames.size());
+    std::copy(frames.begin(), frames.end(), input.data());
+
+    core::AudioBuffer output;
+    ASSERT_TRUE(converter.convertChannels(input, ChannelLayout::SEVEN_POINT_ONE, output, ChannelLayout::STEREO));
+    ASSERT_EQ(output.size(), 200u);
+
+    core::AudioBuffer in_place = input;
+    ASSERT_TRUE(converter.convertChannels(in_place, ChannelLayout::SEVEN_POINT_ONE, in_place, ChannelLayout::STEREO));
+    ASSERT_EQ(in_place.size(), 200u);
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_FLOAT_EQ(in_place[i], output[i]) << i;
+    }
+
+    const std::vector<float> result(output.data(), output.data() + output.size());
+    expectMatchesMatrix(converter.getChannelMixer(), frames, result, 100);
+
+    // 长度不是整帧时拒绝
+    core::AudioBuffer ragged(13);
+    EXPECT_FALSE(converter.convertChannels(ragged, ChannelLayout::SEVEN_POINT_ONE, output, ChannelLayout::STEREO));
+}
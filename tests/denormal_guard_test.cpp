@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "core/audio_effects_chain.h"
+#include "core/audio_thread_pool.h"
+#include "platform/denormal_guard.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// 最小的规格化单精度数乘以0.5得到非规格化数；FTZ下结果为0
+float halveSmallest() {
+    volatile float smallest = std::numeric_limits<float>::min();
+    volatile float half = 0.5f;
+    return smallest * half;
+}
+
+// 测试用衰减效果：一组并联的单极点反馈，冲激之后的尾音逐渐衰减到非规格化范围。
+// 不启用FTZ时状态会停留在最小的非规格化数上，此后每次乘法都很慢
+class DecayFilter : public core::AudioFilter {
+public:
+    static const size_t kStates = 64;
+
+    DecayFilter() : states_(kStates, 0.0f) {}
+
+    bool apply(const core::AudioBuffer& input, core::AudioBuffer& output) override {
+        output = input;
+        return process(core::AudioView(output, 1));
+    }
+
+    bool process(core::AudioView view) override {
+        for (size_t i = 0; i < view.size(); ++i) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < kStates; ++k) {
+                states_[k] = states_[k] * 0.98f + view[i];
+                sum += states_[k];
+            }
+            view[i] = sum * (1.0f / kStates);
+        }
+        return true;
+    }
+
+    bool setParameters(float, float, float) override { return true; }
+    void getParameters(float&, float&, float&) const override {}
+    std::string getName() const override { return "Decay"; }
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+private:
+    std::vector<float> states_;
+};
+
+// 处理一个块的耗时（微秒）
+double timeBlock(core::AudioEffectsChain& chain, core::AudioBuffer& block) {
+    const auto start = std::chrono::steady_clock::now();
+    chain.process(core::AudioView(block, 1));
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// 守卫作用域内冲刷非规格化数，析构后恢复
+TEST(DenormalGuardTest, ScopedFlushToZero) {
+    if (!platform::DenormalGuard::isSupported()) {
+        GTEST_SKIP() << "FTZ/DAZ not supported on this platform";
+    }
+    EXPECT_NE(0.0f, halveSmallest());
+    {
+        platform::DenormalGuard guard;
+        EXPECT_EQ(0.0f, halveSmallest());
+        {
+            platform::DenormalGuard nested;
+            EXPECT_EQ(0.0f, halveSmallest());
+        }
+        EXPECT_EQ(0.0f, halveSmallest());
+    }
+    EXPECT_NE(0.0f, halveSmallest());
+}
+
+// 线程池工作线程启用了FTZ/DAZ，提交任务的线程不受影响
+TEST(DenormalGuardTest, ThreadPoolWorkersFlushToZero) {
+    if (!platform::DenormalGuard::isSupported()) {
+        GTEST_SKIP() << "FTZ/DAZ not supported on this platform";
+    }
+    core::AudioThreadPool pool(2);
+    EXPECT_EQ(0.0f, pool.submit([] { return halveSmallest(); }).get());
+    EXPECT_NE(0.0f, halveSmallest());
+}
+
+// 回归基准：冲激之后持续输入静音，尾音衰减进入非规格化范围后每块的耗时应保持平稳
+TEST(DenormalGuardTest, DecayingSilenceKeepsFlatCpuTime) {
+    if (!platform::DenormalGuard::isSupported()) {
+        GTEST_SKIP() << "FTZ/DAZ not supported on this platform";
+    }
+    core::AudioEffectsChain chain;
+    ASSERT_TRUE(chain.initialize());
+    ASSERT_TRUE(chain.setFormat(48000, 1));
+    ASSERT_TRUE(chain.addEffect(std::make_unique<DecayFilter>()));
+
+    const size_t kBlockFrames = 512;
+    const size_t kBlocks = 64;   // 0.98^(64 * 512)远低于最小的非规格化数
+    core::AudioBuffer block(kBlockFrames);
+    std::vector<double> times;
+    for (size_t b = 0; b < kBlocks; ++b) {
+        std::fill(block.data(), block.data() + block.size(), 0.0f);
+        if (b == 0) {
+            block[0] = 1.0f;
+        }
+        times.push_back(timeBlock(chain, block));
+    }
+
+    // 取中位数以排除调度抖动：冲激后的前几块为规格化数，最后几块已完全衰减
+    auto median = [](std::vector<double> values) {
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        return values[values.size() / 2];
+    };
+    const double early = median(std::vector<double>(times.begin() + 1, times.begin() + 9));
+    const double late = median(std::vector<double>(times.end() - 16, times.end()));
+    EXPECT_LT(late, early * 3.0) << "early " << early << " us, late " << late << " us";
+}
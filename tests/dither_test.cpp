@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "audio/dsp/dither.h"
+#include "audio/simd/sample_convert.h"
+#include "core/audio_format_converter.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using audio::SampleFormat;
+using audio::dsp::Dither;
+
+namespace {
+
+// 抖动后的16位输出相对输入的误差（单位LSB）
+std::vector<double> int16Error(Dither& dither, const std::vector<float>& input, size_t channels) {
+    std::vector<int16_t> output(input.size());
+    EXPECT_TRUE(dither.process(input.data(), SampleFormat::PCM_S16LE, output.data(),
+                               input.size() / channels, channels));
+    std::vector<double> error(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        error[i] = output[i] - static_cast<double>(input[i]) * 32768.0;
+    }
+    return error;
+}
+
+} // namespace
+
+// 测试TPDF抖动：误差不超过1.5 LSB，且对低于1 LSB的直流偏移无偏（不抖动时被舍入掉）
+TEST(DitherTest, TpdfIsBoundedAndUnbiased) {
+    const std::vector<float> input(48000, 100.3f / 32768.0f);
+
+    Dither dither;
+    const std::vector<double> error = int16Error(dither, input, 1);
+    double mean = 0.0;
+    for (double e : error) {
+        EXPECT_LE(std::fabs(e), 1.5);
+        mean += e;
+    }
+    mean /= static_cast<double>(error.size());
+    EXPECT_NEAR(mean, 0.0, 0.02);
+
+    dither.setEnabled(false);
+    const std::vector<double> rounded = int16Error(dither, input, 1);
+    EXPECT_NEAR(rounded[0], -0.3, 1e-3);
+}
+
+// 测试无整形的抖动误差为白噪声（各路噪声发生器互不相关）
+TEST(DitherTest, TpdfErrorIsWhite) {
+    std::vector<float> input(48000 * 2);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.25f * static_cast<float>(std::sin(0.001 * static_cast<double>(i / 2)));
+    }
+
+    Dither dither;
+    const std::vector<double> error = int16Error(dither, input, 2);
+    double energy = 0.0;
+    for (double e : error) {
+        energy += e * e;
+    }
+    // TPDF（1/6 LSB^2）加舍入误差（1/12 LSB^2）
+    EXPECT_NEAR(energy / static_cast<double>(error.size()), 0.25, 0.01);
+    for (size_t lag = 1; lag <= 16; ++lag) {
+        double correlation = 0.0;
+        for (size_t i = lag; i < error.size(); ++i) {
+            correlation += error[i] * error[i - lag];
+        }
+        EXPECT_LT(std::fabs(correlation / energy), 0.02) << "lag " << lag;
+    }
+}
+
+// 测试一阶噪声整形把误差推向高频：低频（16帧滑动平均）的误差能量远低于平坦TPDF
+TEST(DitherTest, FirstOrderShapingMovesNoiseUp) {
+    std::vector<float> input(48000 * 2);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.25f * static_cast<float>(std::sin(0.001 * static_cast<double>(i / 2)));
+    }
+
+    auto lowBandEnergy = [&input](Dither::NoiseShaping shaping) {
+        Dither dither;
+        dither.setNoiseShaping(shaping);
+        const std::vector<double> error = int16Error(dither, input, 2);
+        const size_t window = 16;
+        double energy = 0.0;
+        for (size_t i = window * 2; i < error.size(); i += 2) {
+            double low = 0.0;
+            for (size_t k = 0; k < window; ++k) {
+                low += error[i - 2 * k];
+            }
+            low /= window;
+            energy += low * low;
+        }
+        return energy;
+    };
+
+    // 平坦噪声经16点平均后能量降为1/16，一阶整形（1 - z^-1）后约为1/128
+    EXPECT_LT(lowBandEnergy(Dither::NoiseShaping::FIRST_ORDER), 0.25 * lowBandEnergy(Dither::NoiseShaping::NONE));
+}
+
+// 测试声道数超过kMaxChannels时退回不抖动的转换，而不是失败
+TEST(DitherTest, WideLayoutsFallBackToPlainConversion) {
+    const size_t channels = Dither::kMaxChannels + 2;
+    std::vector<float> input(channels * 64);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<float>(i % 37) / 37.0f - 0.5f;
+    }
+
+    Dither dither;
+    std::vector<int16_t> dithered(input.size());
+    ASSERT_TRUE(dither.process(input.data(), SampleFormat::PCM_S16LE, dithered.data(), 64, channels));
+
+    std::vector<int16_t> plain(input.size());
+    ASSERT_TRUE(audio::simd::fromFloat(input.data(), SampleFormat::PCM_S16LE, plain.data(), plain.size()));
+    EXPECT_EQ(dithered, plain);
+}
+
+// 测试格式转换器只在降位深时抖动：16位升到24位保持比特精确
+TEST(DitherTest, ConverterDithersOnlyWhenReducingDepth) {
+    core::AudioFormatConverter converter;
+    ASSERT_TRUE(converter.initialize());
+    ASSERT_TRUE(converter.setDither(true, Dither::NoiseShaping::NONE));
+
+    std::vector<int16_t> input(256);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<int16_t>(static_cast<int>(i) * 97 - 12000);
+    }
+    std::vector<uint8_t> output(input.size() * 3);
+    ASSERT_TRUE(converter.convert(input.data(), SampleFormat::PCM_S16LE, output.data(), SampleFormat::PCM_S24LE,
+                                  input.size()));
+    for (size_t i = 0; i < input.size(); ++i) {
+        const int32_t value = static_cast<int32_t>(static_cast<uint32_t>(output[i * 3]) << 8 |
+                                                   static_cast<uint32_t>(output[i * 3 + 1]) << 16 |
+                                                   static_cast<uint32_t>(output[i * 3 + 2]) << 24) >> 8;
+        EXPECT_EQ(value, input[i] * 256) << i;
+    }
+}
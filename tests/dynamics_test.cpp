@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "core/audio_compressor.h"
+#include "core/audio_dynamic_range_compressor.h"
+#include "core/audio_dynamics.h"
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const int kSampleRate = 48000;
+
+// 交错立体声1 kHz正弦，峰值电平dbfs
+core::AudioBuffer makeTone(double dbfs, size_t frames) {
+    const double amplitude = std::pow(10.0, dbfs / 20.0);
+    core::AudioBuffer buffer(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        const float sample = static_cast<float>(amplitude * std::sin(2.0 * kPi * 1000.0 * static_cast<double>(i) / kSampleRate));
+        buffer[i * 2] = sample;
+        buffer[i * 2 + 1] = sample;
+    }
+    return buffer;
+}
+
+// 后半段输出相对输入的增益（dB）
+double steadyGainDb(const core::AudioBuffer& input, const core::AudioBuffer& output) {
+    double in_energy = 0.0;
+    double out_energy = 0.0;
+    for (size_t i = input.size() / 2; i < input.size(); ++i) {
+        in_energy += input[i] * input[i];
+        out_energy += output[i] * output[i];
+    }
+    return 10.0 * std::log10(out_energy / in_energy);
+}
+
+} // namespace
+
+// 测试压缩器稳态增益：RMS检测下-6 dBFS正弦的电平为-9 dB，阈值-20 dB、压缩比4时衰减11 * 3/4 = 8.25 dB；
+// 低于阈值时不衰减；软拐点在阈值处的衰减为knee/8 * (1 - 1/ratio)
+TEST(DynamicsTest, CompressorSteadyStateGain) {
+    const size_t frames = kSampleRate / 2;
+    const double rms_offset = 10.0 * std::log10(0.5);
+
+    struct Case {
+        double level;   // 峰值电平（dBFS）
+        float knee;
+        double expected;
+    };
+    const Case cases[] = {
+        {-6.0, 0.0f, -(-6.0 + rms_offset + 20.0) * 0.75},
+        {-30.0, 0.0f, 0.0},
+        {-20.0 - rms_offset, 6.0f, -6.0 / 8.0 * 0.75},
+    };
+
+    for (const Case& c : cases) {
+        core::AudioCompressor compressor;
+        ASSERT_TRUE(compressor.setFormat(kSampleRate, 2));
+        ASSERT_TRUE(compressor.initialize());
+        ASSERT_TRUE(compressor.setParameters(-20.0f, 4.0f, 5.0f, 50.0f));
+        ASSERT_TRUE(compressor.setKnee(c.knee));
+
+        const core::AudioBuffer input = makeTone(c.level, frames);
+        core::AudioBuffer output;
+        ASSERT_TRUE(compressor.apply(input, output));
+        EXPECT_NEAR(steadyGainDb(input, output), c.expected, 0.1) << "level " << c.level;
+        EXPECT_NEAR(compressor.getGainReduction(), c.expected, 0.1) << "level " << c.level;
+    }
+}
+
+// 测试补偿增益与多频段压缩：只有包含信号的频段被压缩，补偿增益叠加在衰减之上
+TEST(DynamicsTest, MultibandCompressesOnlyActiveBand) {
+    const size_t frames = kSampleRate / 2;
+    core::AudioDynamicRangeCompressor compressor;
+    ASSERT_TRUE(compressor.setFormat(kSampleRate, 2));
+    ASSERT_TRUE(compressor.initialize());
+    ASSERT_TRUE(compressor.setBandCount(3));
+    ASSERT_TRUE(compressor.setCrossover(0, 200.0f));
+    ASSERT_TRUE(compressor.setCrossover(1, 5000.0f));
+    ASSERT_TRUE(compressor.setKnee(0.0f));
+    for (int band = 0; band < 3; ++band) {
+        ASSERT_TRUE(compressor.setBandParameters(band, -20.0f, 4.0f, 5.0f, 50.0f, band == 1 ? 3.0f : 0.0f));
+    }
+
+    const core::AudioBuffer input = makeTone(-6.0, frames);
+    core::AudioBuffer output;
+    ASSERT_TRUE(compressor.apply(input, output));
+
+    const double reduction = (-6.0 + 10.0 * std::log10(0.5) + 20.0) * 0.75;
+    EXPECT_NEAR(compressor.getGainReduction(1), -reduction, 0.15);
+    EXPECT_GT(compressor.getGainReduction(0), -0.5f);
+    EXPECT_GT(compressor.getGainReduction(2), -0.5f);
+    EXPECT_NEAR(steadyGainDb(input, output), 3.0 - reduction, 0.2);
+}
+
+// 测试Linkwitz-Riley分频：不压缩时各频段之和为全通，幅度响应在全频段平坦
+TEST(DynamicsTest, BandSumIsFlat) {
+    for (const size_t bands : {2u, 3u, 5u}) {
+        core::MultibandDynamics dynamics;
+        dynamics.prepare(kSampleRate, 1);
+        ASSERT_TRUE(dynamics.setBandCount(bands));
+        core::MultibandDynamics::BandSettings settings;
+        settings.ratio = 1.0f;
+        for (size_t band = 0; band < bands; ++band) {
+            ASSERT_TRUE(dynamics.setBand(band, settings));
+        }
+
+        // 脉冲响应的频谱幅度
+        std::vector<float> impulse(16384, 0.0f);
+        impulse[0] = 1.0f;
+        dynamics.process(impulse.data(), impulse.size());
+
+        for (double frequency = 20.0; frequency < 20000.0; frequency *= 1.25) {
+            std::complex<double> response = 0.0;
+            for (size_t n = 0; n < impulse.size(); ++n) {
+                response += static_cast<double>(impulse[n]) *
+                    std::polar(1.0, -2.0 * kPi * frequency * static_cast<double>(n) / kSampleRate);
+            }
+            EXPECT_NEAR(20.0 * std::log10(std::abs(response)), 0.0, 0.01)
+                << bands << " bands, " << frequency << " Hz";
+        }
+    }
+}
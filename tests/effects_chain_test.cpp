@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "core/audio_effects_chain.h"
+#include "core/audio_effect_adapter.h"
+#include "core/audio_gate.h"
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+// 测试用增益效果：原地处理
+class GainFilter : public core::AudioFilter {
+public:
+    explicit GainFilter(float gain) : gain_(gain) {}
+
+    bool apply(const core::AudioBuffer& input, core::AudioBuffer& output) override {
+        output = input;
+        return process(core::AudioView(output, 1));
+    }
+
+    bool process(core::AudioView view) override {
+        for (size_t i = 0; i < view.size(); ++i) {
+            view[i] *= gain_;
+        }
+        return true;
+    }
+
+    bool setParameters(float gain, float, float) override { gain_ = gain; return true; }
+    void getParameters(float& gain, float&, float&) const override { gain = gain_; }
+    std::string getName() const override { return "Gain"; }
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+private:
+    float gain_;
+};
+
+} // namespace
+
+// 测试具体效果经适配器放入效果链：延迟器的脉冲出现在延迟时间处
+TEST(EffectsChainTest, HostsConcreteEffectThroughAdapter) {
+    core::AudioEffectsChain chain;
+    ASSERT_TRUE(chain.initialize());
+    ASSERT_TRUE(chain.setFormat(48000, 2));
+
+    std::unique_ptr<core::AudioFilter> delay = core::makeEffectFilter<core::AudioDelay>("Delay");
+    ASSERT_TRUE(delay->initialize());
+    ASSERT_TRUE(chain.addEffect(std::move(delay)));
+
+    // 三参数接口转发给AudioDelay：10ms、无反馈、全湿
+    core::AudioFilter* effect = chain.getEffect(0);
+    ASSERT_TRUE(effect->setParameters(10.0f, 0.0f, 1.0f));
+    float delay_ms = 0.0f, feedback = 1.0f, mix = 0.0f;
+    effect->getParameters(delay_ms, feedback, mix);
+    EXPECT_FLOAT_EQ(delay_ms, 10.0f);
+    EXPECT_FLOAT_EQ(mix, 1.0f);
+    EXPECT_EQ(effect->getName(), "Delay");
+
+    const size_t frames = 1024;
+    core::AudioBuffer buffer(frames * 2);
+    buffer[0] = 1.0f;
+    buffer[1] = -0.5f;
+    ASSERT_TRUE(chain.process(core::AudioView(buffer, 2)));
+
+    const size_t offset = 480;
+    for (size_t i = 0; i < frames; ++i) {
+        EXPECT_NEAR(buffer[i * 2], i == offset ? 1.0f : 0.0f, 1e-6f) << "frame " << i;
+        EXPECT_NEAR(buffer[i * 2 + 1], i == offset ? -0.5f : 0.0f, 1e-6f) << "frame " << i;
+    }
+}
+
+// 测试参数接口不同的效果：三参数设置返回false，延迟经适配器转发到链
+TEST(EffectsChainTest, AdapterForwardsLatencyAndRejectsForeignParameters) {
+    core::AudioEffectsChain chain;
+    ASSERT_TRUE(chain.initialize());
+    ASSERT_TRUE(chain.setFormat(48000, 2));
+
+    auto gate = std::make_unique<core::AudioEffectAdapter<core::AudioGate>>("Gate");
+    ASSERT_TRUE(gate->initialize());
+    ASSERT_TRUE(gate->effect().setLookahead(2.0f));
+    core::AudioEffectAdapter<core::AudioGate>* gate_ptr = gate.get();
+    ASSERT_TRUE(chain.addEffect(std::move(gate)));
+
+    EXPECT_FALSE(gate_ptr->setParameters(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(gate_ptr->getLatency(), gate_ptr->effect().getLatency());
+    EXPECT_GT(chain.getLatency(), 0u);
+    EXPECT_EQ(chain.getLatency(), gate_ptr->effect().getLatency());
+
+    // 禁用的效果不计入链的延迟
+    ASSERT_TRUE(chain.enableEffect(0, false));
+    EXPECT_EQ(chain.getLatency(), 0u);
+}
+
+// 测试旁路交叉淡化：块长超过预分配长度时分段处理，淡化曲线连续
+TEST(EffectsChainTest, BypassCrossfadeSpansLongBlocks) {
+    core::AudioEffectsChain chain;
+    ASSERT_TRUE(chain.initialize());
+    ASSERT_TRUE(chain.setFormat(48000, 1));
+    chain.prepare(16);
+    chain.setBypassFadeTime(1.0f);
+    ASSERT_TRUE(chain.addEffect(std::make_unique<GainFilter>(0.0f)));
+
+    // 稳态启用：输出完全为湿信号
+    core::AudioBuffer buffer(256);
+    std::fill(buffer.data(), buffer.data() + buffer.size(), 1.0f);
+    ASSERT_TRUE(chain.process(core::AudioView(buffer, 1)));
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_FLOAT_EQ(buffer[i], 0.0f);
+    }
+
+    // 禁用后在48帧内由湿信号线性过渡到干信号
+    ASSERT_TRUE(chain.enableEffect(0, false));
+    std::fill(buffer.data(), buffer.data() + buffer.size(), 1.0f);
+    ASSERT_TRUE(chain.process(core::AudioView(buffer, 1)));
+    const size_t fade_frames = 48;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        const float expected = i < fade_frames ? static_cast<float>(i + 1) / fade_frames : 1.0f;
+        EXPECT_NEAR(buffer[i], expected, 1e-5f) << "frame " << i;
+    }
+
+    // 淡化结束后完全旁路
+    std::fill(buffer.data(), buffer.data() + buffer.size(), 1.0f);
+    ASSERT_TRUE(chain.process(core::AudioView(buffer, 1)));
+    EXPECT_FLOAT_EQ(buffer[0], 1.0f);
+    EXPECT_FLOAT_EQ(buffer[255], 1.0f);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "core/audio_effects_graph.h"
+#include <memory>
+
+namespace {
+
+// 测试用增益效果：原地处理
+class GainFilter : public core::AudioFilter {
+public:
+    explicit GainFilter(float gain) : gain_(gain) {}
+
+    bool apply(const core::AudioBuffer& input, core::AudioBuffer& output) override {
+        output = input;
+        return process(core::AudioView(output, 1));
+    }
+
+    bool process(core::AudioView view) override {
+        for (size_t i = 0; i < view.size(); ++i) {
+            view[i] *= gain_;
+        }
+        return true;
+    }
+
+    bool setParameters(float gain, float, float) override { gain_ = gain; return true; }
+    void getParameters(float& gain, float&, float&) const override { gain = gain_; }
+    std::string getName() const override { return "Gain"; }
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+private:
+    float gain_;
+};
+
+// 构建并联图：输入分为三条支路，再合并到总线后输出
+void buildParallelGraph(core::AudioEffectsGraph& graph) {
+    const auto input = graph.getInputNode();
+    const auto output = graph.getOutputNode();
+    graph.disconnect(input, output);
+
+    const auto a = graph.addEffect(std::make_unique<GainFilter>(2.0f));
+    const auto b = graph.addEffect(std::make_unique<GainFilter>(3.0f));
+    const auto c = graph.addEffect(std::make_unique<GainFilter>(-1.0f));
+    const auto bus = graph.addBus();
+    graph.connect(input, a);
+    graph.connect(input, b, 0.5f);
+    graph.connect(input, c);
+    graph.connect(a, bus);
+    graph.connect(b, bus);
+    graph.connect(c, bus, 0.25f);
+    graph.connect(bus, output);
+    graph.connect(input, output, 0.1f);
+}
+
+core::AudioBuffer makeRamp(size_t size) {
+    core::AudioBuffer buffer(size);
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = static_cast<float>(i % 97) / 97.0f - 0.5f;
+    }
+    return buffer;
+}
+
+} // namespace
+
+// 测试默认直通与环路拒绝
+TEST(EffectsGraphTest, PassThroughAndCycleRejection) {
+    core::AudioEffectsGraph graph;
+    ASSERT_TRUE(graph.initialize());
+    graph.setFormat(48000, 2);
+
+    core::AudioBuffer input = makeRamp(256);
+    core::AudioBuffer output;
+    ASSERT_TRUE(graph.apply(input, output));
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_FLOAT_EQ(output[i], input[i]);
+    }
+
+    const auto a = graph.addBus();
+    const auto b = graph.addBus();
+    EXPECT_TRUE(graph.connect(a, b));
+    EXPECT_FALSE(graph.connect(b, a));
+    EXPECT_FALSE(graph.connect(graph.getOutputNode(), a));
+}
+
+// 测试分支/合并的混合结果，以及线程池并行执行与串行执行一致
+TEST(EffectsGraphTest, ParallelMatchesSerial) {
+    core::AudioEffectsGraph serial;
+    core::AudioEffectsGraph parallel;
+    core::AudioThreadPool pool(3);
+    for (auto* graph : {&serial, &parallel}) {
+        ASSERT_TRUE(graph->initialize());
+        graph->setFormat(48000, 2);
+        graph->prepare(512);
+        buildParallelGraph(*graph);
+    }
+    parallel.setThreadPool(&pool);
+    EXPECT_EQ(serial.getLevelCount(), 4u);
+
+    const core::AudioBuffer input = makeRamp(1024);
+    for (int block = 0; block < 50; ++block) {
+        core::AudioBuffer expected = input;
+        core::AudioBuffer actual = input;
+        ASSERT_TRUE(serial.apply(expected, expected));
+        ASSERT_TRUE(parallel.apply(actual, actual));
+        for (size_t i = 0; i < input.size(); ++i) {
+            // 2 + 0.5 * 3 - 0.25 + 0.1
+            EXPECT_NEAR(expected[i], 3.35f * input[i], 1e-5f);
+            EXPECT_FLOAT_EQ(actual[i], expected[i]);
+        }
+    }
+}
+
+// 测试移除节点后调度更新
+TEST(EffectsGraphTest, RemoveNode) {
+    core::AudioEffectsGraph graph;
+    ASSERT_TRUE(graph.initialize());
+    graph.setFormat(48000, 1);
+
+    const auto gain = graph.addEffect(std::make_unique<GainFilter>(4.0f));
+    graph.disconnect(graph.getInputNode(), graph.getOutputNode());
+    graph.connect(graph.getInputNode(), gain);
+    graph.connect(gain, graph.getOutputNode());
+
+    core::AudioBuffer buffer = makeRamp(64);
+    const core::AudioBuffer input = buffer;
+    ASSERT_TRUE(graph.apply(buffer, buffer));
+    EXPECT_FLOAT_EQ(buffer[10], 4.0f * input[10]);
+
+    EXPECT_TRUE(graph.removeNode(gain));
+    EXPECT_EQ(graph.getNodeCount(), 2u);
+    buffer = input;
+    ASSERT_TRUE(graph.apply(buffer, buffer));
+    EXPECT_FLOAT_EQ(buffer[10], 0.0f);
+}
+
+// 测试超过预分配块长的块分段处理，结果与按块长处理一致
+TEST(EffectsGraphTest, LongBlockProcessedInChunks) {
+    core::AudioEffectsGraph graph;
+    core::AudioThreadPool pool(2);
+    ASSERT_TRUE(graph.initialize());
+    graph.setFormat(48000, 2);
+    graph.prepare(64);
+    graph.setThreadPool(&pool);
+    buildParallelGraph(graph);
+
+    // 1000帧不是块长的整数倍，最后一段较短
+    const core::AudioBuffer input = makeRamp(2000);
+    core::AudioBuffer buffer = input;
+    ASSERT_TRUE(graph.process(core::AudioView(buffer, 2)));
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_NEAR(buffer[i], 3.35f * input[i], 1e-5f) << i;
+    }
+}
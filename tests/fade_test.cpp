@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "core/audio_fade.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using core::AudioFade;
+
+namespace {
+
+// 对常数1的淡出流与常数0的淡入流（以及相反）分块交叉淡化，得到逐帧的淡出/淡入增益
+void crossfadeGains(AudioFade& fade, size_t frames, size_t block,
+                    std::vector<float>& gain_out, std::vector<float>& gain_in) {
+    std::vector<float> ones(block, 1.0f);
+    std::vector<float> zeros(block, 0.0f);
+    std::vector<float> output(block);
+    gain_out.assign(frames, 0.0f);
+    gain_in.assign(frames, 0.0f);
+
+    AudioFade mirror = fade;
+    for (size_t done = 0; done < frames; done += block) {
+        const size_t count = std::min(block, frames - done);
+        ASSERT_TRUE(fade.crossfade(ones.data(), zeros.data(), output.data(), count));
+        std::copy(output.begin(), output.begin() + count, gain_out.begin() + done);
+        ASSERT_TRUE(mirror.crossfade(zeros.data(), ones.data(), output.data(), count));
+        std::copy(output.begin(), output.begin() + count, gain_in.begin() + done);
+    }
+}
+
+} // namespace
+
+// 测试交叉淡化曲线：起点为淡出流全增益，终点后为淡入流；等功率曲线中点为-3 dB且功率和恒为1，
+// 线性与S曲线中点为0.5且增益和恒为1
+TEST(FadeTest, CrossfadeCurveEndpointsAndMidpoint) {
+    const uint64_t start = 100;
+    const size_t length = 1000;
+
+    for (const auto curve : {AudioFade::Curve::LINEAR, AudioFade::Curve::EQUAL_POWER, AudioFade::Curve::S_CURVE}) {
+        AudioFade fade;
+        ASSERT_TRUE(fade.setFormat(1000, 1));
+        ASSERT_TRUE(fade.initialize());
+        fade.setCurve(curve);
+        ASSERT_TRUE(fade.scheduleCrossfade(start, 1.0));
+
+        std::vector<float> gain_out;
+        std::vector<float> gain_in;
+        crossfadeGains(fade, start + length + 50, 77, gain_out, gain_in);
+        EXPECT_TRUE(fade.isComplete());
+
+        for (size_t i = 0; i < gain_out.size(); ++i) {
+            if (i <= start) {
+                EXPECT_EQ(gain_out[i], 1.0f) << "frame " << i;
+                EXPECT_EQ(gain_in[i], 0.0f) << "frame " << i;
+            } else if (i >= start + length) {
+                EXPECT_EQ(gain_out[i], 0.0f) << "frame " << i;
+                EXPECT_EQ(gain_in[i], 1.0f) << "frame " << i;
+            } else if (curve == AudioFade::Curve::EQUAL_POWER) {
+                EXPECT_NEAR(gain_out[i] * gain_out[i] + gain_in[i] * gain_in[i], 1.0f, 1e-5f) << "frame " << i;
+            } else {
+                EXPECT_NEAR(gain_out[i] + gain_in[i], 1.0f, 1e-5f) << "frame " << i;
+            }
+        }
+
+        const float midpoint = curve == AudioFade::Curve::EQUAL_POWER ? std::sqrt(0.5f) : 0.5f;
+        EXPECT_NEAR(gain_out[start + length / 2], midpoint, 1e-5f);
+        EXPECT_NEAR(gain_in[start + length / 2], midpoint, 1e-5f);
+    }
+}
+
+// 测试S曲线两端平缓：第一帧的增益变化远小于线性曲线
+TEST(FadeTest, SCurveIsFlatAtEnds) {
+    AudioFade fade;
+    ASSERT_TRUE(fade.setFormat(1000, 1));
+    ASSERT_TRUE(fade.initialize());
+    fade.setCurve(AudioFade::Curve::S_CURVE);
+    ASSERT_TRUE(fade.scheduleCrossfade(0, 1.0));
+
+    std::vector<float> gain_out;
+    std::vector<float> gain_in;
+    crossfadeGains(fade, 1000, 1000, gain_out, gain_in);
+    EXPECT_LT(gain_in[1], 0.1f * (1.0f / 1000.0f));
+    EXPECT_GT(gain_out[1], 1.0f - 0.1f * (1.0f / 1000.0f));
+    EXPECT_GT(gain_in[998], 1.0f - 0.1f * (2.0f / 1000.0f));
+    EXPECT_LT(gain_out[998], 0.1f * (2.0f / 1000.0f));
+}
+
+// 测试自动交叉淡化：恰好在淡出流结束位置完成
+TEST(FadeTest, CrossfadeAtEndCompletesOnEndPosition) {
+    AudioFade fade;
+    ASSERT_TRUE(fade.setFormat(1000, 2));
+    ASSERT_TRUE(fade.initialize());
+    ASSERT_TRUE(fade.scheduleCrossfadeAtEnd(5000, 2.0));
+
+    std::vector<float> outgoing(2 * 512, 1.0f);
+    std::vector<float> incoming(2 * 512, 0.5f);
+    std::vector<float> output(2 * 512);
+    while (fade.getPosition() + 512 <= 5000) {
+        ASSERT_TRUE(fade.crossfade(outgoing.data(), incoming.data(), output.data(), 512));
+        EXPECT_EQ(fade.isComplete(), fade.getPosition() == 5000);
+    }
+    EXPECT_TRUE(fade.isCrossfading());
+    ASSERT_TRUE(fade.crossfade(outgoing.data(), incoming.data(), output.data(), 512));
+    EXPECT_TRUE(fade.isComplete());
+
+    // 3000帧处开始，5000帧处结束
+    const size_t end_offset = 5000 - 4608;
+    EXPECT_FLOAT_EQ(output[2 * end_offset], 0.5f);
+    EXPECT_FLOAT_EQ(output[2 * end_offset + 1], 0.5f);
+    EXPECT_GT(output[2 * (end_offset - 1)], 0.5f);
+}
+
+// 测试整缓冲区淡入淡出：淡入第一帧为0，淡出最后一帧为0，淡化区间以外不变
+TEST(FadeTest, BufferFadeEndpoints) {
+    const size_t frames = 2000;
+    const size_t length = 500;
+
+    for (const auto curve : {AudioFade::Curve::LINEAR, AudioFade::Curve::EQUAL_POWER, AudioFade::Curve::S_CURVE}) {
+        AudioFade fade;
+        ASSERT_TRUE(fade.setFormat(1000, 2));
+        ASSERT_TRUE(fade.initialize());
+        fade.setCurve(curve);
+
+        core::AudioBuffer input(frames * 2);
+        std::fill(input.data(), input.data() + input.size(), 0.8f);
+        core::AudioBuffer output;
+
+        ASSERT_TRUE(fade.fadeIn(input, output, 0.5));
+        EXPECT_EQ(output[0], 0.0f);
+        EXPECT_EQ(output[1], 0.0f);
+        EXPECT_GT(output[2 * (length - 1)], 0.79f);
+        EXPECT_EQ(output[2 * length], 0.8f);
+        for (size_t i = 1; i < length; ++i) {
+            EXPECT_GT(output[2 * i], output[2 * (i - 1)]) << "frame " << i;
+        }
+
+        ASSERT_TRUE(fade.fadeOut(input, output, 0.5));
+        EXPECT_EQ(output[2 * (frames - 1)], 0.0f);
+        EXPECT_EQ(output[2 * (frames - 1) + 1], 0.0f);
+        EXPECT_LT(output[2 * (frames - length)], 0.8f);
+        EXPECT_GT(output[2 * (frames - length)], 0.79f);
+        EXPECT_EQ(output[2 * (frames - length - 1)], 0.8f);
+        for (size_t i = frames - length + 1; i < frames; ++i) {
+            EXPECT_LT(output[2 * i], output[2 * (i - 1)]) << "frame " << i;
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "core/audio_gate.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const int kSampleRate = 48000;
+
+// 单声道1 kHz正弦，峰值电平dbfs
+core::AudioBuffer makeTone(double dbfs, size_t frames, size_t phase = 0) {
+    const double amplitude = std::pow(10.0, dbfs / 20.0);
+    core::AudioBuffer buffer(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        buffer[i] = static_cast<float>(amplitude * std::sin(2.0 * kPi * 1000.0 * static_cast<double>(phase + i) / kSampleRate));
+    }
+    return buffer;
+}
+
+// [begin, end)区间内输出相对输入的增益（dB）
+double gainDb(const core::AudioBuffer& input, const core::AudioBuffer& output, size_t begin, size_t end, size_t delay = 0) {
+    double in_energy = 0.0;
+    double out_energy = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        in_energy += input[i - delay] * input[i - delay];
+        out_energy += output[i] * output[i];
+    }
+    return 10.0 * std::log10(out_energy / in_energy);
+}
+
+void prepareGate(core::AudioGate& gate) {
+    ASSERT_TRUE(gate.setFormat(kSampleRate, 1));
+    ASSERT_TRUE(gate.initialize());
+    ASSERT_TRUE(gate.setParameters(-40.0f, 1.0f, 20.0f));
+}
+
+} // namespace
+
+// 测试稳态增益：高于阈值的信号无衰减通过，低于关门阈值的信号衰减到最大衰减量
+TEST(GateTest, SteadyStateGain) {
+    const size_t frames = kSampleRate / 2;
+
+    core::AudioGate open_gate;
+    prepareGate(open_gate);
+    const core::AudioBuffer loud = makeTone(-20.0, frames);
+    core::AudioBuffer output;
+    ASSERT_TRUE(open_gate.apply(loud, output));
+    EXPECT_TRUE(open_gate.isOpen(0));
+    EXPECT_NEAR(gainDb(loud, output, frames / 2, frames), 0.0, 0.01);
+
+    core::AudioGate closed_gate;
+    prepareGate(closed_gate);
+    const core::AudioBuffer quiet = makeTone(-60.0, frames);
+    ASSERT_TRUE(closed_gate.apply(quiet, output));
+    EXPECT_FALSE(closed_gate.isOpen(0));
+    EXPECT_NEAR(gainDb(quiet, output, frames / 2, frames), -80.0, 0.5);
+}
+
+// 测试迟滞与保持：电平落在开关门阈值之间时保持打开；低于关门阈值后至少保持hold时间才关闭
+TEST(GateTest, HysteresisAndHold) {
+    core::AudioGate gate;
+    prepareGate(gate);
+    ASSERT_TRUE(gate.setHold(20.0f));
+    ASSERT_TRUE(gate.setHysteresis(6.0f));
+
+    core::AudioBuffer output;
+    ASSERT_TRUE(gate.apply(makeTone(-20.0, kSampleRate / 5), output));
+    ASSERT_TRUE(gate.isOpen(0));
+
+    // -43 dB：低于开门阈值（-40），高于关门阈值（-46）
+    const size_t between_frames = kSampleRate / 5;
+    const core::AudioBuffer between = makeTone(-43.0, between_frames);
+    ASSERT_TRUE(gate.apply(between, output));
+    EXPECT_TRUE(gate.isOpen(0));
+    EXPECT_NEAR(gainDb(between, output, between_frames / 2, between_frames), 0.0, 0.01);
+
+    // 降到-60 dB后按1 ms分块检查关门时刻：峰值检测器从-43 dB衰减到-46 dB约7 ms，再保持20 ms
+    const size_t block = kSampleRate / 1000;
+    size_t closed_after = 0;
+    for (size_t ms = 1; ms <= 100 && closed_after == 0; ++ms) {
+        ASSERT_TRUE(gate.apply(makeTone(-60.0, block, ms * block), output));
+        if (!gate.isOpen(0)) {
+            closed_after = ms;
+        }
+    }
+    EXPECT_GT(closed_after, 20u);
+    EXPECT_LT(closed_after, 40u);
+}
+
+// 测试向下扩展：扩展比2时关门阈值以下每降低1 dB增益降低1 dB
+TEST(GateTest, ExpanderRatio) {
+    const size_t frames = kSampleRate / 2;
+    core::AudioGate gate;
+    prepareGate(gate);
+    ASSERT_TRUE(gate.setHysteresis(0.0f));
+    ASSERT_TRUE(gate.setRange(-80.0f, 2.0f));
+
+    const core::AudioBuffer input = makeTone(-50.0, frames);
+    core::AudioBuffer output;
+    ASSERT_TRUE(gate.apply(input, output));
+    EXPECT_NEAR(gainDb(input, output, frames / 2, frames), -10.0, 0.5);
+}
+
+// 测试预读：延迟getLatency帧的音频在瞬态到达时门已完全打开，无预读时起音被削弱
+TEST(GateTest, LookaheadOpensBeforeTransient) {
+    const size_t silence = kSampleRate / 10;
+    const size_t burst = kSampleRate / 10;
+    core::AudioBuffer input(silence + burst);
+    const core::AudioBuffer tone = makeTone(-20.0, burst);
+    std::copy(tone.data(), tone.data() + burst, input.data() + silence);
+
+    const size_t onset = kSampleRate / 1000;
+    for (const float lookahead : {5.0f, 0.0f}) {
+        core::AudioGate gate;
+        prepareGate(gate);
+        ASSERT_TRUE(gate.setLookahead(lookahead));
+        const size_t latency = gate.getLatency();
+        EXPECT_EQ(latency, static_cast<size_t>(lookahead * kSampleRate / 1000.0f));
+
+        core::AudioBuffer output;
+        ASSERT_TRUE(gate.apply(input, output));
+        const double first_ms = gainDb(input, output, silence + latency, silence + latency + onset, latency);
+        if (lookahead > 0.0f) {
+            EXPECT_NEAR(first_ms, 0.0, 0.1);
+        } else {
+            EXPECT_LT(first_ms, -3.0);
+        }
+    }
+}
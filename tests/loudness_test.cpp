@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include "core/audio_loudness_scanner.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 向测量器送入立体声1 kHz正弦：峰值电平dbfs，时长seconds（与EBU Tech 3341/3342测试信号相同）
+void processSine(core::LoudnessMeter& meter, double dbfs, double seconds) {
+    const int sample_rate = meter.getSampleRate();
+    const float amplitude = static_cast<float>(std::pow(10.0, dbfs / 20.0));
+    const size_t frames = static_cast<size_t>(seconds * sample_rate);
+    std::vector<float> buffer(4800 * 2);
+    for (size_t done = 0; done < frames; done += 4800) {
+        const size_t count = std::min<size_t>(4800, frames - done);
+        for (size_t i = 0; i < count; ++i) {
+            const float sample = amplitude *
+                static_cast<float>(std::sin(2.0 * kPi * 1000.0 * static_cast<double>(done + i) / sample_rate));
+            buffer[i * 2] = sample;
+            buffer[i * 2 + 1] = sample;
+        }
+        meter.process(buffer.data(), count);
+    }
+}
+
+// 测试用PCM来源：路径为立体声1 kHz正弦的峰值电平（dBFS），每首曲目时长2秒
+class SineSource : public core::PcmSource {
+public:
+    explicit SineSource(std::chrono::milliseconds read_delay = std::chrono::milliseconds(0))
+        : read_delay_(read_delay), amplitude_(0.0f), position_(0) {}
+
+    bool open(const std::string& path, int& sample_rate, int& channels) override {
+        amplitude_ = static_cast<float>(std::pow(10.0, std::strtod(path.c_str(), nullptr) / 20.0));
+        position_ = 0;
+        sample_rate = kSampleRate;
+        channels = 2;
+        return true;
+    }
+
+    size_t read(float* buffer, size_t frames) override {
+        if (read_delay_.count() > 0) {
+            std::this_thread::sleep_for(read_delay_);
+        }
+        const size_t count = std::min(frames, kFrames - position_);
+        for (size_t i = 0; i < count; ++i) {
+            const float sample = amplitude_ *
+                static_cast<float>(std::sin(2.0 * kPi * 1000.0 * static_cast<double>(position_ + i) / kSampleRate));
+            buffer[i * 2] = sample;
+            buffer[i * 2 + 1] = sample;
+        }
+        position_ += count;
+        return count;
+    }
+
+    void close() override {}
+
+private:
+    static constexpr int kSampleRate = 48000;
+    static constexpr size_t kFrames = 2 * kSampleRate;
+
+    std::chrono::milliseconds read_delay_;
+    float amplitude_;
+    size_t position_;
+};
+
+#ifdef __linux__
+// 记录在SCHED_BATCH调度策略下执行的读取次数
+class PolicySource : public SineSource {
+public:
+    explicit PolicySource(std::atomic<size_t>& batch_reads)
+        : SineSource(std::chrono::milliseconds(1)), batch_reads_(batch_reads) {}
+
+    size_t read(float* buffer, size_t frames) override {
+        if (sched_getscheduler(0) == SCHED_BATCH) {
+            batch_reads_.fetch_add(1);
+        }
+        return SineSource::read(buffer, frames);
+    }
+
+private:
+    std::atomic<size_t>& batch_reads_;
+};
+#endif
+
+} // namespace
+
+// 测试并行扫描曲库：每首曲目的增益写入缓存，已缓存的曲目被跳过
+TEST(LoudnessTest, ScanLibraryStoresTrackGains) {
+    core::AudioThreadPool pool(2);
+    core::MetadataCache cache;
+    core::LoudnessScanner scanner;
+    scanner.setThreadPool(&pool);
+    scanner.setMetadataCache(&cache);
+    scanner.setTruePeakEnabled(false);
+    scanner.setSourceFactory([] { return std::make_unique<SineSource>(); });
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 8; ++i) {
+        paths.push_back(std::to_string(-13 - 2 * i));
+    }
+    EXPECT_EQ(scanner.scanLibrary(paths), paths.size());
+    EXPECT_EQ(scanner.getProgress(), paths.size());
+
+    // 立体声1 kHz正弦的响度等于其峰值电平（EBU Tech 3341），增益为-18 LUFS与之的差
+    for (size_t i = 0; i < paths.size(); ++i) {
+        float gain = 0.0f;
+        float peak = 0.0f;
+        ASSERT_TRUE(core::LoudnessScanner::lookup(cache, paths[i], false, gain, peak));
+        EXPECT_NEAR(gain, -18.0f - std::strtof(paths[i].c_str(), nullptr), 0.1f) << paths[i];
+    }
+
+    EXPECT_EQ(scanner.scanLibrary(paths), 0u);
+}
+
+// 测试扫描期间线程池仍能执行高优先级任务：辅助任务每次只分析一首曲目，不会占住工作线程直到扫描结束
+TEST(LoudnessTest, ScanYieldsWorkersBetweenTracks) {
+    core::AudioThreadPool pool(1);
+    core::LoudnessScanner scanner;
+    scanner.setThreadPool(&pool);
+    scanner.setTruePeakEnabled(false);
+    scanner.setSourceFactory([] { return std::make_unique<SineSource>(std::chrono::milliseconds(1)); });
+
+    const std::vector<std::string> paths(40, "-23");
+    auto scan = std::async(std::launch::async, [&scanner, &paths] { return scanner.scanLibrary(paths); });
+    while (scanner.getProgress() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto progress = pool.submit([&scanner] { return scanner.getProgress(); }, core::TaskPriority::HIGH);
+    EXPECT_LT(progress.get(), paths.size() - 10);
+    EXPECT_EQ(scan.get(), paths.size());
+}
+
+#ifdef __linux__
+// 测试自有线程池使用后台角色的调度策略（不继承工作线程的实时优先级）
+TEST(LoudnessTest, OwnPoolUsesBackgroundPolicy) {
+    platform::ThreadPolicy policy;
+    policy.priority = platform::kThreadPriorityLow;
+    platform::ThreadManager::set_role_policy(platform::ThreadRole::BACKGROUND, policy);
+
+    std::atomic<size_t> batch_reads(0);
+    core::LoudnessScanner scanner;
+    scanner.setThreadCount(1);
+    scanner.setTruePeakEnabled(false);
+    scanner.setSourceFactory([&batch_reads] { return std::make_unique<PolicySource>(batch_reads); });
+
+    const std::vector<std::string> paths(6, "-23");
+    EXPECT_EQ(scanner.scanLibrary(paths), paths.size());
+    EXPECT_GT(batch_reads.load(), 0u);
+    platform::ThreadManager::set_role_policy(platform::ThreadRole::BACKGROUND, platform::ThreadPolicy());
+}
+#endif
+
+// EBU Tech 3341测试1：立体声1 kHz正弦-23 dBFS，积分、瞬时、短时响度均为-23 LUFS（±0.1 LU）
+TEST(LoudnessTest, MeterReadsReferenceSine) {
+    core::LoudnessMeter meter;
+    ASSERT_TRUE(meter.setFormat(48000, 2));
+    meter.setTruePeakEnabled(false);
+    processSine(meter, -23.0, 20.0);
+
+    EXPECT_NEAR(meter.getIntegratedLoudness(), -23.0, 0.1);
+    EXPECT_NEAR(meter.getMomentaryLoudness(), -23.0, 0.1);
+    EXPECT_NEAR(meter.getShortTermLoudness(), -23.0, 0.1);
+    EXPECT_NEAR(meter.getSamplePeak(), std::pow(10.0, -23.0 / 20.0), 1e-4);
+}
+
+// EBU Tech 3341测试4与测试5：绝对门限（-70 LUFS）与相对门限（-10 LU）排除安静段，结果为-23 LUFS
+TEST(LoudnessTest, MeterGatesQuietSections) {
+    core::LoudnessMeter absolute;
+    ASSERT_TRUE(absolute.setFormat(48000, 2));
+    absolute.setTruePeakEnabled(false);
+    processSine(absolute, -72.0, 10.0);
+    processSine(absolute, -36.0, 10.0);
+    processSine(absolute, -23.0, 60.0);
+    processSine(absolute, -36.0, 10.0);
+    processSine(absolute, -72.0, 10.0);
+    EXPECT_NEAR(absolute.getIntegratedLoudness(), -23.0, 0.1);
+
+    core::LoudnessMeter relative;
+    ASSERT_TRUE(relative.setFormat(48000, 2));
+    relative.setTruePeakEnabled(false);
+    processSine(relative, -26.0, 20.0);
+    processSine(relative, -20.0, 20.1);
+    processSine(relative, -26.0, 20.0);
+    EXPECT_NEAR(relative.getIntegratedLoudness(), -23.0, 0.1);
+
+    // 全部低于绝对门限时没有有效块
+    core::LoudnessMeter silent;
+    ASSERT_TRUE(silent.setFormat(48000, 2));
+    processSine(silent, -80.0, 5.0);
+    EXPECT_TRUE(std::isinf(silent.getIntegratedLoudness()));
+}
+
+// EBU Tech 3342测试1与测试2：两段电平相差10 dB与5 dB的正弦，响度范围为10 LU与5 LU（±1 LU）
+TEST(LoudnessTest, MeterLoudnessRange) {
+    core::LoudnessMeter ten;
+    ASSERT_TRUE(ten.setFormat(48000, 2));
+    ten.setTruePeakEnabled(false);
+    processSine(ten, -20.0, 20.0);
+    processSine(ten, -30.0, 20.0);
+    EXPECT_NEAR(ten.getLoudnessRange(), 10.0, 1.0);
+
+    core::LoudnessMeter five;
+    ASSERT_TRUE(five.setFormat(48000, 2));
+    five.setTruePeakEnabled(false);
+    processSine(five, -20.0, 20.0);
+    processSine(five, -15.0, 20.0);
+    EXPECT_NEAR(five.getLoudnessRange(), 5.0, 1.0);
+}
+
+// 测试专辑合并：合并后的积分响度等于连续分析全部曲目（安静曲目的块被相对门限排除），而不是曲目响度的平均
+TEST(LoudnessTest, AlbumMergeGatesAllBlocksTogether) {
+    core::LoudnessMeter first;
+    core::LoudnessMeter second;
+    core::LoudnessMeter whole;
+    for (core::LoudnessMeter* meter : {&first, &second, &whole}) {
+        ASSERT_TRUE(meter->setFormat(48000, 2));
+        meter->setTruePeakEnabled(false);
+    }
+    processSine(first, -20.0, 20.0);
+    processSine(second, -40.0, 10.0);
+    processSine(whole, -20.0, 20.0);
+    processSine(whole, -40.0, 10.0);
+
+    core::LoudnessMeter merged;
+    ASSERT_TRUE(merged.setFormat(48000, 2));
+    ASSERT_TRUE(merged.merge(first));
+    ASSERT_TRUE(merged.merge(second));
+    EXPECT_NEAR(merged.getIntegratedLoudness(), whole.getIntegratedLoudness(), 0.05);
+    EXPECT_NEAR(merged.getIntegratedLoudness(), -20.0, 0.1);
+    EXPECT_FLOAT_EQ(merged.getSamplePeak(), first.getSamplePeak());
+
+    // 扫描器的专辑增益同样按合并的块计算，并写入每首曲目
+    core::AudioThreadPool pool(2);
+    core::MetadataCache cache;
+    core::LoudnessScanner scanner;
+    scanner.setThreadPool(&pool);
+    scanner.setMetadataCache(&cache);
+    scanner.setTruePeakEnabled(false);
+    scanner.setSourceFactory([] { return std::make_unique<SineSource>(); });
+
+    const std::vector<std::string> paths = {"-20", "-23", "-40"};
+    core::LoudnessInfo album;
+    ASSERT_TRUE(scanner.scanAlbum(paths, &album));
+    // -40 dBFS曲目低于相对门限，专辑响度由较响的两首决定
+    EXPECT_GT(album.integrated, -22.0);
+    EXPECT_LT(album.integrated, -20.0);
+    for (const std::string& path : paths) {
+        float gain = 0.0f;
+        float peak = 0.0f;
+        ASSERT_TRUE(core::LoudnessScanner::lookup(cache, path, true, gain, peak));
+        EXPECT_NEAR(gain, album.gain, 0.01f);
+    }
+}
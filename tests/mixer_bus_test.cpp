@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "core/audio_mixer.h"
+#include <cmath>
+#include <memory>
+
+namespace {
+
+// 测试用增益效果：原地处理
+class GainFilter : public core::AudioFilter {
+public:
+    explicit GainFilter(float gain) : gain_(gain) {}
+
+    bool apply(const core::AudioBuffer& input, core::AudioBuffer& output) override {
+        output = input;
+        return process(core::AudioView(output, 1));
+    }
+
+    bool process(core::AudioView view) override {
+        for (size_t i = 0; i < view.size(); ++i) {
+            view[i] *= gain_;
+        }
+        return true;
+    }
+
+    bool setParameters(float gain, float, float) override { gain_ = gain; return true; }
+    void getParameters(float& gain, float&, float&) const override { gain = gain_; }
+    std::string getName() const override { return "Gain"; }
+    bool initialize() override { return true; }
+    void shutdown() override {}
+
+private:
+    float gain_;
+};
+
+// 恒定值来源（双声道）
+class ConstantSource : public core::MixerSource {
+public:
+    explicit ConstantSource(float value) : value_(value) {}
+
+    size_t read(float* buffer, size_t frames) override {
+        std::fill(buffer, buffer + frames * 2, value_);
+        return frames;
+    }
+
+private:
+    float value_;
+};
+
+// 测试用纯延迟效果：报告延迟，供延迟补偿对齐
+class DelayFilter : public core::AudioFilter {
+public:
+    explicit DelayFilter(size_t frames) : history_(frames * 2, 0.0f), position_(0) {}
+
+    bool apply(const core::AudioBuffer& input, core::AudioBuffer& output) override {
+        output = input;
+        return process(core::AudioView(output, 2));
+    }
+
+    bool process(core::AudioView view) override {
+        for (size_t i = 0; i < view.size(); ++i) {
+            std::swap(view[i], history_[position_]);
+            position_ = (position_ + 1) % history_.size();
+        }
+        return true;
+    }
+
+    bool setParameters(float, float, float) override { return true; }
+    void getParameters(float&, float&, float&) const override {}
+    std::string getName() const override { return "Delay"; }
+    bool initialize() override { return true; }
+    void shutdown() override {}
+    size_t getLatency() const override { return history_.size() / 2; }
+
+private:
+    std::vector<float> history_;
+    size_t position_;
+};
+
+// 单位脉冲来源（双声道，第一帧为1）
+class ImpulseSource : public core::MixerSource {
+public:
+    size_t read(float* buffer, size_t frames) override {
+        std::fill(buffer, buffer + frames * 2, 0.0f);
+        if (first_ && frames > 0) {
+            buffer[0] = 1.0f;
+            buffer[1] = 1.0f;
+            first_ = false;
+        }
+        return frames;
+    }
+
+private:
+    bool first_ = true;
+};
+
+// 指定格式的正弦来源（各声道相同）
+class SineSource : public core::MixerSource {
+public:
+    SineSource(int sample_rate, int channels, double frequency)
+        : format_(sample_rate, channels, 32, "float"), step_(frequency / sample_rate), position_(0) {}
+
+    size_t read(float* buffer, size_t frames) override {
+        const double pi = 3.14159265358979323846;
+        for (size_t f = 0; f < frames; ++f) {
+            const float value = static_cast<float>(0.5 * std::sin(2.0 * pi * step_ * static_cast<double>(position_++)));
+            for (int ch = 0; ch < format_.channels; ++ch) {
+                buffer[f * format_.channels + ch] = value;
+            }
+        }
+        return frames;
+    }
+
+    core::AudioFormat getFormat() const override { return format_; }
+
+private:
+    core::AudioFormat format_;
+    double step_;
+    size_t position_;
+};
+
+std::unique_ptr<core::AudioEffectsChain> makeGainChain(float gain) {
+    auto chain = std::make_unique<core::AudioEffectsChain>();
+    chain->initialize();
+    chain->addEffect(std::make_unique<GainFilter>(gain));
+    return chain;
+}
+
+// 构建多区域混音：每个区域一条编组总线（带效果链），两两汇入子组，全部发送到混响总线
+float buildZones(core::AudioMixer& mixer, size_t zones) {
+    const auto reverb = mixer.addBus(core::AudioMixer::kMasterBus, 0.5f);
+    mixer.setBusEffects(reverb, makeGainChain(2.0f));
+
+    float expected = 0.0f;
+    core::AudioMixer::BusHandle group = core::AudioMixer::kInvalidBus;
+    for (size_t zone = 0; zone < zones; ++zone) {
+        if (zone % 2 == 0) {
+            group = mixer.addBus();
+        }
+        const auto bus = mixer.addBus(group, 0.5f);
+        mixer.setBusEffects(bus, makeGainChain(3.0f));
+        mixer.setBusSend(bus, reverb, 0.25f);
+
+        const float value = 0.01f * static_cast<float>(zone + 1);
+        const auto track = mixer.addTrack(std::make_unique<ConstantSource>(value));
+        mixer.setTrackBus(track, bus);
+
+        // 区域输出 = 3 * value；经推子0.5进子组，经推子0.5与发送0.25进混响（增益2，推子0.5）
+        const float zone_out = 3.0f * value;
+        expected += 0.5f * zone_out + 0.5f * 0.25f * zone_out * 2.0f * 0.5f;
+    }
+    return expected;
+}
+
+} // namespace
+
+TEST(MixerBusTest, TracksDefaultToMaster) {
+    core::AudioMixer mixer;
+    mixer.initialize();
+    const auto track = mixer.addTrack(std::make_unique<ConstantSource>(0.25f), 0.5f);
+    EXPECT_EQ(mixer.getTrackBus(track), core::AudioMixer::kMasterBus);
+    EXPECT_EQ(mixer.getBusCount(), 1u);
+
+    core::AudioBuffer output(64 * 2);
+    ASSERT_TRUE(mixer.mix(core::AudioView(output, 2)));
+    EXPECT_FLOAT_EQ(output[0], 0.125f);
+    EXPECT_FLOAT_EQ(output[127], 0.125f);
+}
+
+TEST(MixerBusTest, GroupBusAppliesEffectsAndFader) {
+    core::AudioMixer mixer;
+    mixer.initialize();
+    const auto group = mixer.addBus(core::AudioMixer::kMasterBus, 0.5f);
+    ASSERT_NE(group, core::AudioMixer::kInvalidBus);
+    ASSERT_TRUE(mixer.setBusEffects(group, makeGainChain(4.0f)));
+
+    const auto a = mixer.addTrack(std::make_unique<ConstantSource>(0.1f));
+    const auto b = mixer.addTrack(std::make_unique<ConstantSource>(0.2f));
+    ASSERT_TRUE(mixer.setTrackBus(a, group));
+    ASSERT_TRUE(mixer.setTrackBus(b, group));
+    mixer.addTrack(std::make_unique<ConstantSource>(0.05f));
+
+    core::AudioBuffer output(300 * 2);
+    ASSERT_TRUE(mixer.mix(core::AudioView(output, 2)));
+    // 0.5 * 4 * (0.1 + 0.2) + 0.05
+    EXPECT_NEAR(output[0], 0.65f, 1e-6f);
+    EXPECT_NEAR(output[599], 0.65f, 1e-6f);
+}
+
+TEST(MixerBusTest, RoutingCyclesAreRejected) {
+    core::AudioMixer mixer;
+    mixer.initialize();
+    const auto a = mixer.addBus();
+    const auto b = mixer.addBus(a);
+    const auto c = mixer.addBus(b);
+    EXPECT_EQ(mixer.getBusLevelCount(), 4u);
+
+    EXPECT_FALSE(mixer.setBusOutput(a, c));
+    EXPECT_FALSE(mixer.setBusSend(a, c, 1.0f));
+    EXPECT_FALSE(mixer.setBusSend(core::AudioMixer::kMasterBus, a, 1.0f));
+    EXPECT_FALSE(mixer.setBusOutput(core::AudioMixer::kMasterBus, a));
+    EXPECT_TRUE(mixer.setBusSend(c, a, 1.0f));
+    EXPECT_EQ(mixer.getBusOutput(a), core::AudioMixer::kMasterBus);
+    EXPECT_EQ(mixer.getBusLevelCount(), 4u);
+}
+
+TEST(MixerBusTest, RemovingBusReroutesTracksAndChildren) {
+    core::AudioMixer mixer;
+    mixer.initialize();
+    const auto parent = mixer.addBus();
+    const auto bus = mixer.addBus(parent);
+    const auto child = mixer.addBus(bus);
+    const auto track = mixer.addTrack(std::make_unique<ConstantSource>(0.5f));
+    mixer.setTrackBus(track, bus);
+    mixer.setBusSend(parent, bus, 1.0f);
+
+    ASSERT_TRUE(mixer.removeBus(bus));
+    EXPECT_EQ(mixer.getTrackBus(track), parent);
+    EXPECT_EQ(mixer.getBusOutput(child), parent);
+    EXPECT_FALSE(mixer.removeBusSend(parent, bus));
+    EXPECT_FALSE(mixer.setBusVolume(bus, 1.0f));
+    EXPECT_FALSE(mixer.removeBus(core::AudioMixer::kMasterBus));
+
+    core::AudioBuffer output(16 * 2);
+    ASSERT_TRUE(mixer.mix(core::AudioView(output, 2)));
+    EXPECT_FLOAT_EQ(output[0], 0.5f);
+}
+
+TEST(MixerBusTest, ParallelRenderMatchesSerial) {
+    core::AudioMixer serial;
+    serial.initialize();
+    const float expected = buildZones(serial, 24);
+
+    core::AudioThreadPool pool(4);
+    core::AudioMixer parallel;
+    parallel.initialize();
+    parallel.setThreadPool(&pool);
+    buildZones(parallel, 24);
+    EXPECT_EQ(parallel.getBusLevelCount(), 3u);
+
+    // 新发送从0开始过渡，第一个块之后输出恒定
+    core::AudioBuffer a(1000 * 2);
+    core::AudioBuffer b(1000 * 2);
+    for (int round = 0; round < 3; ++round) {
+        ASSERT_TRUE(serial.mix(core::AudioView(a, 2)));
+        ASSERT_TRUE(parallel.mix(core::AudioView(b, 2)));
+        for (size_t i = 0; i < a.size(); ++i) {
+            ASSERT_EQ(a[i], b[i]) << "sample " << i;
+        }
+    }
+    EXPECT_NEAR(a[a.size() - 1], expected, 1e-4f);
+}
+
+TEST(MixerBusTest, ResamplesTracksWithOtherFormats) {
+    core::AudioMixer mixer;
+    mixer.initialize();
+    mixer.setFormat(48000, 2);
+    const auto a = mixer.addTrack(std::make_unique<SineSource>(44100, 2, 1000.0));
+    const auto b = mixer.addTrack(std::make_unique<SineSource>(96000, 1, 1000.0));
+    ASSERT_NE(a, core::AudioMixer::kInvalidTrack);
+    ASSERT_NE(b, core::AudioMixer::kInvalidTrack);
+    EXPECT_GT(mixer.getTrackLatency(a), 0u);
+    mixer.setTrackMute(b, true);
+
+    // 稳态下输出为48kHz下的1kHz正弦，幅度0.5
+    core::AudioBuffer output(4800 * 2);
+    ASSERT_TRUE(mixer.mix(core::AudioView(output, 2)));
+    float peak = 0.0f;
+    for (size_t f = 2400; f < 4800; ++f) {
+        peak = std::max(peak, std::fabs(output[f * 2]));
+    }
+    EXPECT_NEAR(peak, 0.5f, 0.005f);
+
+    // 48个样本为一个周期
+    const float delay = static_cast<float>(mixer.getLatency());
+    EXPECT_NEAR(output[4000 * 2], 0.5f * std::sin(2.0f * 3.14159265f * (4000.0f - delay) / 48.0f), 0.05f);
+}
+
+TEST(MixerBusTest, CompensatesEffectLatency) {
+    core::AudioMixer mixer;
+    mixer.initialize();
+    const auto group = mixer.addBus();
+    const auto delayed = mixer.addTrack(std::make_unique<ImpulseSource>());
+    mixer.addTrack(std::make_unique<ImpulseSource>());
+    mixer.setTrackBus(delayed, group);
+
+    auto chain = std::make_unique<core::AudioEffectsChain>();
+    chain->initialize();
+    chain->addEffect(std::make_unique<DelayFilter>(300));
+    ASSERT_TRUE(mixer.setTrackEffects(delayed, std::move(chain)));
+    EXPECT_EQ(mixer.getTrackLatency(delayed), 300u);
+    EXPECT_EQ(mixer.getBusLatency(group), 300u);
+    EXPECT_EQ(mixer.getLatency(), 300u);
+
+    // 两个脉冲对齐到第300帧
+    core::AudioBuffer output(600 * 2);
+    ASSERT_TRUE(mixer.mix(core::AudioView(output, 2)));
+    for (size_t f = 0; f < 600; ++f) {
+        EXPECT_FLOAT_EQ(output[f * 2], f == 300 ? 2.0f : 0.0f) << "frame " << f;
+    }
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include "core/audio_mixer.h"
+#include "audio/simd/mix_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using audio::simd::MixKernels;
+using audio::simd::SimdLevel;
+using core::AudioMixer;
+
+namespace {
+
+// 长度覆盖双路主循环、单向量循环与各种尾部
+const size_t kLengths[] = {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 100, 1027};
+
+std::vector<float> makeSamples(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> samples(count);
+    for (auto& s : samples) {
+        s = dist(rng);
+    }
+    return samples;
+}
+
+// FMA只舍入一次，与标量的乘加结果可差一个ulp级别
+void expectNearAll(const std::vector<float>& actual, const std::vector<float>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_NEAR(actual[i], expected[i], 1e-6f * (1.0f + std::fabs(expected[i]))) << "sample " << i;
+    }
+}
+
+class MixKernelsTest : public ::testing::TestWithParam<SimdLevel> {
+protected:
+    const MixKernels& kernels() const { return audio::simd::getMixKernels(GetParam()); }
+    const MixKernels& reference() const { return audio::simd::getMixKernels(SimdLevel::SCALAR); }
+};
+
+// 恒定值来源（双声道）
+class ConstantSource : public core::MixerSource {
+public:
+    explicit ConstantSource(float value) : value_(value) {}
+
+    size_t read(float* buffer, size_t frames) override {
+        std::fill(buffer, buffer + frames * 2, value_);
+        return frames;
+    }
+
+private:
+    float value_;
+};
+
+// 逐块混音，返回左声道
+std::vector<float> mixBlocks(AudioMixer& mixer, size_t blocks) {
+    core::AudioBuffer output(AudioMixer::kBlockFrames * 2);
+    std::vector<float> left;
+    for (size_t b = 0; b < blocks; ++b) {
+        EXPECT_TRUE(mixer.mix(core::AudioView(output, 2)));
+        for (size_t f = 0; f < AudioMixer::kBlockFrames; ++f) {
+            left.push_back(output[f * 2]);
+        }
+    }
+    return left;
+}
+
+} // namespace
+
+// 测试固定增益累加与标量参考一致
+TEST_P(MixKernelsTest, AccumulateMatchesScalar) {
+    for (size_t length : kLengths) {
+        const std::vector<float> input = makeSamples(length, 1);
+        std::vector<float> expected = makeSamples(length, 2);
+        std::vector<float> actual = expected;
+        reference().accumulate(input.data(), expected.data(), length, 0.37f);
+        kernels().accumulate(input.data(), actual.data(), length, 0.37f);
+        expectNearAll(actual, expected);
+    }
+}
+
+// 测试增益斜坡累加与标量参考一致：声道数整除8与不整除8（回退标量）两种情况
+TEST_P(MixKernelsTest, AccumulateRampMatchesScalar) {
+    const size_t channel_counts[] = {1, 2, 3, 4, 6, 8};
+    for (size_t channels : channel_counts) {
+        for (size_t frames : kLengths) {
+            const std::vector<float> input = makeSamples(frames * channels, 3);
+            std::vector<float> expected = makeSamples(frames * channels, 4);
+            std::vector<float> actual = expected;
+            const float step = frames > 0 ? -0.8f / static_cast<float>(frames) : 0.0f;
+            reference().accumulateRamp(input.data(), expected.data(), frames, channels, 0.9f, step);
+            kernels().accumulateRamp(input.data(), actual.data(), frames, channels, 0.9f, step);
+            SCOPED_TRACE(channels);
+            expectNearAll(actual, expected);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, MixKernelsTest,
+                         ::testing::Values(SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2));
+
+// 测试音量与静音的变化在下一块内线性过渡，相邻样本的跳变不超过一个斜坡步长
+TEST(MixerTest, VolumeAndMuteChangesRamp) {
+    AudioMixer mixer;
+    ASSERT_TRUE(mixer.initialize());
+    const auto track = mixer.addTrack(std::make_unique<ConstantSource>(1.0f));
+    ASSERT_NE(track, AudioMixer::kInvalidTrack);
+
+    std::vector<float> left = mixBlocks(mixer, 1);
+    ASSERT_TRUE(mixer.setTrackVolume(track, 0.5f));
+    const std::vector<float> ramp = mixBlocks(mixer, 2);
+    left.insert(left.end(), ramp.begin(), ramp.end());
+
+    // 斜坡块的第f帧增益为1 - 0.5 * (f + 1) / 256，块末恰好到达目标，之后保持不变
+    const size_t n = AudioMixer::kBlockFrames;
+    for (size_t f = 0; f < n; ++f) {
+        EXPECT_NEAR(ramp[f], 1.0f - 0.5f * static_cast<float>(f + 1) / static_cast<float>(n), 1e-5f) << f;
+    }
+    for (size_t f = n; f < 2 * n; ++f) {
+        EXPECT_FLOAT_EQ(ramp[f], 0.5f);
+    }
+
+    ASSERT_TRUE(mixer.setTrackMute(track, true));
+    EXPECT_TRUE(mixer.getTrackMute(track));
+    const std::vector<float> muted = mixBlocks(mixer, 2);
+    EXPECT_FLOAT_EQ(muted[n - 1], 0.0f);
+    EXPECT_FLOAT_EQ(muted[2 * n - 1], 0.0f);
+    left.insert(left.end(), muted.begin(), muted.end());
+
+    ASSERT_TRUE(mixer.setTrackMute(track, false));
+    const std::vector<float> unmuted = mixBlocks(mixer, 2);
+    EXPECT_GT(unmuted[0], 0.0f);
+    EXPECT_FLOAT_EQ(unmuted[2 * n - 1], 0.5f);
+    left.insert(left.end(), unmuted.begin(), unmuted.end());
+
+    const float max_step = 0.5f / static_cast<float>(n) + 1e-5f;
+    for (size_t i = 1; i < left.size(); ++i) {
+        EXPECT_LE(std::fabs(left[i] - left[i - 1]), max_step) << "sample " << i;
+    }
+}
+
+// 测试移除后旧句柄失效，复用同一槽位的新轨道得到不同的句柄
+TEST(MixerTest, RemovedHandleIsInvalid) {
+    AudioMixer mixer;
+    ASSERT_TRUE(mixer.initialize());
+    const auto first = mixer.addTrack(std::make_unique<ConstantSource>(0.25f), 0.5f);
+    ASSERT_NE(first, AudioMixer::kInvalidTrack);
+    ASSERT_TRUE(mixer.removeTrack(first));
+
+    const auto second = mixer.addTrack(std::make_unique<ConstantSource>(0.25f), 0.5f);
+    ASSERT_NE(second, AudioMixer::kInvalidTrack);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second & 0xFFFFu, first & 0xFFFFu);
+
+    EXPECT_FALSE(mixer.setTrackVolume(first, 1.0f));
+    EXPECT_FLOAT_EQ(mixer.getTrackVolume(first), 0.0f);
+    EXPECT_FALSE(mixer.setTrackMute(first, true));
+    EXPECT_FALSE(mixer.removeTrack(first));
+    EXPECT_FALSE(mixer.removeTrack(AudioMixer::kInvalidTrack));
+
+    // 旧句柄的操作不影响占用同一槽位的新轨道
+    EXPECT_FLOAT_EQ(mixer.getTrackVolume(second), 0.5f);
+    EXPECT_FALSE(mixer.getTrackMute(second));
+    EXPECT_EQ(mixer.getTrackCount(), 1u);
+}
+
+// 测试按名称的兼容接口：findTrack返回可用的句柄，mix(AudioBuffer&)复用已分配的输出
+TEST(MixerTest, NamedTracksAndBufferOutput) {
+    AudioMixer mixer;
+    ASSERT_TRUE(mixer.initialize());
+    core::AudioBuffer samples(300 * 2);
+    std::fill(samples.data(), samples.data() + samples.size(), 0.5f);
+    ASSERT_TRUE(mixer.addTrack("music", samples));
+    EXPECT_FALSE(mixer.addTrack("music", samples));
+    EXPECT_EQ(mixer.findTrack("missing"), AudioMixer::kInvalidTrack);
+
+    const auto track = mixer.findTrack("music");
+    ASSERT_NE(track, AudioMixer::kInvalidTrack);
+    ASSERT_TRUE(mixer.setTrackVolume(track, 0.5f));
+    EXPECT_FLOAT_EQ(mixer.getTrackVolume("music"), 0.5f);
+
+    // 已分配的输出保持长度与存储不变
+    core::AudioBuffer output(100 * 2);
+    const float* storage = output.data();
+    ASSERT_TRUE(mixer.mix(output));
+    EXPECT_EQ(output.size(), 200u);
+    EXPECT_EQ(output.data(), storage);
+    EXPECT_FLOAT_EQ(output[199], 0.25f);
+
+    // 空输出按最长轨道的剩余长度分配
+    core::AudioBuffer rest;
+    ASSERT_TRUE(mixer.mix(rest));
+    EXPECT_EQ(rest.size(), 200u * 2);
+    EXPECT_FLOAT_EQ(rest[0], 0.25f);
+    EXPECT_FLOAT_EQ(rest[rest.size() - 1], 0.25f);
+
+    ASSERT_TRUE(mixer.removeTrack("music"));
+    EXPECT_EQ(mixer.findTrack("music"), AudioMixer::kInvalidTrack);
+    EXPECT_FLOAT_EQ(mixer.getTrackVolume(track), 0.0f);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "core/audio_chorus_modulated.h"
+#include "core/audio_tremolo_modulated.h"
+#include "core/audio_delay_line.h"
+#include <cmath>
+#include <vector>
+
+// 测试快速正弦近似精度
+TEST(ModulatedEffectTest, FastSineAccuracy) {
+    // 与双精度参考比较，最大误差不超过4e-6
+    for (int i = 0; i <= 10000; ++i) {
+        float phase = static_cast<float>(i) / 10000.0f;
+        EXPECT_NEAR(core::modulation::fastSine(phase), std::sin(6.283185307179586 * phase), 4e-6);
+    }
+}
+
+// 测试旧版本类名与参数接口
+TEST(ModulatedEffectTest, LegacyParameters) {
+    core::AudioChorusModulated2 chorus;
+    ASSERT_TRUE(chorus.initialize());
+    EXPECT_TRUE(chorus.setParameters(2.0f, 0.5f, 0.3f, 0.4f, 0.1f, 0.2f, 3.0f));
+
+    float rate, depth, feedback, mix, modulation_rate, modulation_depth, lfo_waveform;
+    chorus.getParameters(rate, depth, feedback, mix, modulation_rate, modulation_depth, lfo_waveform);
+    EXPECT_FLOAT_EQ(rate, 2.0f);
+    EXPECT_FLOAT_EQ(mix, 0.4f);
+    EXPECT_FLOAT_EQ(lfo_waveform, 3.0f);
+}
+
+// 测试颤音增益范围：深度1时增益在[0, 1]之间
+TEST(ModulatedEffectTest, TremoloGainRange) {
+    core::AudioTremoloModulated tremolo;
+    tremolo.setFormat(48000, 1);
+    ASSERT_TRUE(tremolo.initialize());
+    tremolo.setParameters(5.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+
+    core::AudioBuffer buffer(48000);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = 1.0f;
+    }
+    ASSERT_TRUE(tremolo.apply(buffer, buffer));
+
+    float min_gain = 1.0f;
+    float max_gain = 0.0f;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        min_gain = std::min(min_gain, buffer[i]);
+        max_gain = std::max(max_gain, buffer[i]);
+    }
+    EXPECT_NEAR(min_gain, 0.0f, 0.01f);
+    EXPECT_NEAR(max_gain, 1.0f, 0.01f);
+}
+
+// 测试编译期特化的效果与运行期分派结果一致
+TEST(ModulatedEffectTest, StaticAndRuntimeDispatchMatch) {
+    using namespace core::modulation;
+    ModulatedEffect<TremoloCore, TriangleLfo> fixed;
+    AudioModulatedEffect<TremoloCore> dynamic;
+    fixed.setFormat(48000, 2);
+    dynamic.setFormat(48000, 2);
+    fixed.initialize();
+    dynamic.initialize();
+    fixed.setParameters(3.0f, 0.7f, 0.0f, 1.0f, 0.0f, 0.0f);
+    dynamic.setParameters(3.0f, 0.7f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f);
+
+    core::AudioBuffer a(2048);
+    core::AudioBuffer b(2048);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = b[i] = std::sin(static_cast<float>(i) * 0.01f);
+    }
+    fixed.apply(a, a);
+    dynamic.apply(b, b);
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_FLOAT_EQ(a[i], b[i]);
+    }
+}
+
+// 测试延迟线块读取：整数延迟精确，分数延迟在斜坡信号上命中插值值（线性与三阶Lagrange对斜坡都精确）
+TEST(ModulatedEffectTest, DelayLineInterpolation) {
+    const size_t block = 32;
+    const core::DelayLine::Interpolation modes[] = {core::DelayLine::Interpolation::LINEAR, core::DelayLine::Interpolation::LAGRANGE};
+    for (const auto mode : modes) {
+        core::DelayLine line;
+        line.allocate(64, block);
+        line.setInterpolation(mode);
+
+        // 写入多块使环形缓冲区回绕，x[n] = 0.01 * n
+        std::vector<float> input(block);
+        std::vector<float> integer(block);
+        std::vector<float> fractional(block);
+        std::vector<float> taps(block);
+        size_t n = 0;
+        for (int b = 0; b < 10; ++b) {
+            for (size_t i = 0; i < block; ++i) {
+                input[i] = 0.01f * static_cast<float>(n + i);
+            }
+            line.write(input.data(), block);
+            n += block;
+
+            line.read(10.0f, integer.data(), block);
+            line.read(20.25f, fractional.data(), block);
+            const float delays[2] = {5.0f, 40.5f};
+            const float gains[2] = {1.0f, -0.5f};
+            line.readTaps(delays, gains, 2, taps.data(), block);
+            if (b < 2) {
+                continue;
+            }
+            for (size_t i = 0; i < block; ++i) {
+                const float t = static_cast<float>(n - block + i);
+                EXPECT_EQ(integer[i], 0.01f * (t - 10.0f));
+                EXPECT_NEAR(fractional[i], 0.01f * (t - 20.25f), 1e-5f);
+                EXPECT_NEAR(taps[i], 0.01f * (t - 5.0f) - 0.5f * 0.01f * (t - 40.5f), 1e-5f);
+            }
+        }
+
+        // 逐样本接口读取最近写入的样本与块读取一致
+        EXPECT_NEAR(line.read(20.25f), fractional[block - 1], 1e-6f);
+    }
+}
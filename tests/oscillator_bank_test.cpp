@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "core/audio_oscillator_bank.h"
+#include <cmath>
+#include <vector>
+
+using core::AudioOscillatorBank;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 三角波相对加法合成的带限参考（奇次谐波8/(pi^2 k^2)，只取奈奎斯特以下）的残差能量（dB）
+double triangleResidualDb(float frequency, AudioOscillatorBank::AntiAliasing mode) {
+    const int sample_rate = 48000;
+    const size_t frames = 9600;
+
+    AudioOscillatorBank bank;
+    bank.setSampleRate(sample_rate);
+    bank.setOscillatorCount(1);
+    bank.setOscillator(0, AudioOscillatorBank::Waveform::TRIANGLE, frequency, 1.0f);
+    bank.setAntiAliasing(mode);
+    std::vector<float> output(frames);
+    bank.render(output.data(), frames);
+
+    double error = 0.0;
+    double energy = 0.0;
+    for (size_t n = 0; n < frames; ++n) {
+        const double t = static_cast<double>(n) * frequency / sample_rate;
+        double reference = 0.0;
+        for (int k = 1; k * frequency < 0.5 * sample_rate; k += 2) {
+            reference += 8.0 / (kPi * kPi * k * k) * std::cos(2.0 * kPi * k * t);
+        }
+        error += (output[n] - reference) * (output[n] - reference);
+        energy += reference * reference;
+    }
+    return 10.0 * std::log10(error / energy);
+}
+
+} // namespace
+
+// 测试三角波PolyBLAMP校正：比朴素波形更接近带限参考
+TEST(OscillatorBankTest, TriangleAliasBelowNaive) {
+    const double naive_1k = triangleResidualDb(1000.0f, AudioOscillatorBank::AntiAliasing::NONE);
+    const double corrected_1k = triangleResidualDb(1000.0f, AudioOscillatorBank::AntiAliasing::POLYBLEP);
+    EXPECT_LT(corrected_1k, naive_1k - 10.0);
+    EXPECT_LT(corrected_1k, -55.0);
+
+    const double naive_3k = triangleResidualDb(2900.0f, AudioOscillatorBank::AntiAliasing::NONE);
+    const double corrected_3k = triangleResidualDb(2900.0f, AudioOscillatorBank::AntiAliasing::POLYBLEP);
+    EXPECT_LT(corrected_3k, naive_3k - 1.0);
+    EXPECT_LT(corrected_3k, -36.0);
+}
+
+// 测试多个振荡器之和与逐个渲染一致
+TEST(OscillatorBankTest, RenderSumsOscillators) {
+    AudioOscillatorBank bank;
+    bank.setSampleRate(48000);
+    bank.setOscillatorCount(2);
+    bank.setOscillator(0, AudioOscillatorBank::Waveform::SINE, 440.0f, 0.5f);
+    bank.setOscillator(1, AudioOscillatorBank::Waveform::SAWTOOTH, 110.0f, 0.25f);
+
+    std::vector<float> sum(300);
+    bank.render(sum.data(), sum.size());
+
+    bank.resetPhases();
+    std::vector<float> first(300);
+    std::vector<float> second(300);
+    bank.renderOscillator(0, first.data(), first.size());
+    bank.resetPhases();
+    bank.renderOscillator(1, second.data(), second.size());
+    for (size_t i = 0; i < sum.size(); ++i) {
+        EXPECT_NEAR(sum[i], first[i] + second[i], 1e-5f);
+    }
+}
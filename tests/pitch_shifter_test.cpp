@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "core/audio_fft.h"
+#include "core/audio_pitch_shifter.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 用正向过零点估计[begin, end)区间内的频率（Hz）
+double estimateFrequency(const core::AudioBuffer& buffer, size_t begin, size_t end, int sample_rate) {
+    size_t first = 0;
+    size_t last = 0;
+    size_t crossings = 0;
+    for (size_t i = begin + 1; i < end; ++i) {
+        if (buffer[i - 1] < 0.0f && buffer[i] >= 0.0f) {
+            if (crossings == 0) {
+                first = i;
+            }
+            last = i;
+            ++crossings;
+        }
+    }
+    if (crossings < 2) {
+        return 0.0;
+    }
+    return static_cast<double>(crossings - 1) * sample_rate / static_cast<double>(last - first);
+}
+
+core::AudioBuffer makeSine(double frequency, size_t frames, int sample_rate) {
+    core::AudioBuffer buffer(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        buffer[i] = 0.5f * static_cast<float>(std::sin(2.0 * kPi * frequency * static_cast<double>(i) / sample_rate));
+    }
+    return buffer;
+}
+
+// [begin, end)区间内frequency处的幅度（汉宁窗DFT）
+double amplitudeAt(const core::AudioBuffer& buffer, size_t begin, size_t end, double frequency, int sample_rate) {
+    double re = 0.0;
+    double im = 0.0;
+    double window_sum = 0.0;
+    const size_t length = end - begin;
+    for (size_t i = 0; i < length; ++i) {
+        const double window = 0.5 - 0.5 * std::cos(2.0 * kPi * static_cast<double>(i) / static_cast<double>(length));
+        const double angle = 2.0 * kPi * frequency * static_cast<double>(i) / sample_rate;
+        re += window * buffer[begin + i] * std::cos(angle);
+        im -= window * buffer[begin + i] * std::sin(angle);
+        window_sum += window;
+    }
+    return 2.0 * std::sqrt(re * re + im * im) / window_sum;
+}
+
+// 共振峰包络：以center（Hz）为中心的高斯峰加底噪
+double formantEnvelope(double frequency, double center) {
+    const double distance = (frequency - center) / 300.0;
+    return 0.02 + std::exp(-0.5 * distance * distance);
+}
+
+} // namespace
+
+// 测试FFT：正变换与DFT一致，逆变换还原输入
+TEST(PitchShifterTest, FftMatchesDftAndRoundTrips) {
+    const size_t size = 64;
+    core::AudioFFT fft(size);
+    std::vector<float> re(size);
+    std::vector<float> im(size, 0.0f);
+    for (size_t i = 0; i < size; ++i) {
+        re[i] = static_cast<float>(std::cos(0.3 * static_cast<double>(i)) + 0.1 * static_cast<double>(i % 5));
+    }
+    const std::vector<float> original = re;
+
+    fft.forward(re.data(), im.data());
+    for (size_t k = 0; k < size; ++k) {
+        double dft_re = 0.0;
+        double dft_im = 0.0;
+        for (size_t n = 0; n < size; ++n) {
+            const double angle = -2.0 * kPi * static_cast<double>(k * n) / size;
+            dft_re += original[n] * std::cos(angle);
+            dft_im += original[n] * std::sin(angle);
+        }
+        EXPECT_NEAR(re[k], dft_re, 1e-3) << k;
+        EXPECT_NEAR(im[k], dft_im, 1e-3) << k;
+    }
+
+    fft.inverse(re.data(), im.data());
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(re[i], original[i], 1e-5f);
+        EXPECT_NEAR(im[i], 0.0f, 1e-5f);
+    }
+}
+
+// 测试上移一个八度：440 Hz正弦变为880 Hz，幅度基本不变
+TEST(PitchShifterTest, OctaveUpDoublesFrequency) {
+    const int sample_rate = 44100;
+    core::AudioPitchShifter shifter;
+    ASSERT_TRUE(shifter.setFormat(sample_rate, 1));
+    ASSERT_TRUE(shifter.initialize());
+    ASSERT_TRUE(shifter.setSemitones(12.0f));
+    float ratio = 0.0f;
+    float mix = 0.0f;
+    shifter.getParameters(ratio, mix);
+    EXPECT_NEAR(ratio, 2.0f, 1e-4f);
+    ASSERT_TRUE(shifter.setParameters(ratio, 1.0f));
+
+    const size_t frames = sample_rate * 2;
+    const core::AudioBuffer input = makeSine(440.0, frames, sample_rate);
+    core::AudioBuffer output;
+    ASSERT_TRUE(shifter.apply(input, output));
+
+    // 跳过延迟与起始的过渡
+    const size_t begin = shifter.getLatency() + sample_rate / 2;
+    EXPECT_NEAR(estimateFrequency(output, begin, frames, sample_rate), 880.0, 880.0 * 0.01);
+
+    double in_energy = 0.0;
+    double out_energy = 0.0;
+    for (size_t i = begin; i < frames; ++i) {
+        in_energy += input[i] * input[i];
+        out_energy += output[i] * output[i];
+    }
+    EXPECT_NEAR(10.0 * std::log10(out_energy / in_energy), 0.0, 2.0);
+}
+
+// 测试比例为1时输出是输入延迟getLatency帧的结果，干湿混合时两路对齐（无梳状滤波）
+TEST(PitchShifterTest, UnityRatioDelaysByLatency) {
+    const int sample_rate = 44100;
+    const size_t frames = sample_rate;
+    core::AudioBuffer input = makeSine(440.0, frames, sample_rate);
+    const core::AudioBuffer overtone = makeSine(1234.5, frames, sample_rate);
+    for (size_t i = 0; i < frames; ++i) {
+        input[i] += 0.4f * overtone[i];
+    }
+
+    for (const float mix : {1.0f, 0.5f}) {
+        core::AudioPitchShifter shifter;
+        ASSERT_TRUE(shifter.setFormat(sample_rate, 1));
+        ASSERT_TRUE(shifter.initialize());
+        ASSERT_TRUE(shifter.setParameters(1.0f, mix));
+
+        core::AudioBuffer output;
+        ASSERT_TRUE(shifter.apply(input, output));
+
+        const size_t latency = shifter.getLatency();
+        ASSERT_LT(latency, frames / 2);
+        double error = 0.0;
+        double energy = 0.0;
+        for (size_t i = frames / 2; i < frames; ++i) {
+            const double diff = output[i] - input[i - latency];
+            error += diff * diff;
+            energy += input[i - latency] * input[i - latency];
+        }
+        EXPECT_LT(10.0 * std::log10(error / energy), -40.0) << "mix " << mix;
+    }
+}
+
+// 测试共振峰保持：上移一个八度后谐波位于新基频的整数倍，但谐波幅度仍按原包络分布（峰值保持在1200 Hz），
+// 不保持时包络随谐波一起移到2400 Hz
+TEST(PitchShifterTest, FormantPreservationKeepsEnvelope) {
+    const int sample_rate = 44100;
+    const size_t frames = sample_rate * 2;
+    const double fundamental = 150.0;
+    const double formant = 1200.0;
+
+    core::AudioBuffer input(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        double sample = 0.0;
+        for (double f = fundamental; f < 5000.0; f += fundamental) {
+            sample += formantEnvelope(f, formant) * std::sin(2.0 * kPi * f * static_cast<double>(i) / sample_rate);
+        }
+        input[i] = 0.1f * static_cast<float>(sample);
+    }
+
+    // 返回输出中强度最大的谐波频率，并检查谐波落在新基频的整数倍上
+    auto strongestPartial = [&](bool preserve) {
+        core::AudioPitchShifter shifter;
+        EXPECT_TRUE(shifter.setFormat(sample_rate, 1));
+        EXPECT_TRUE(shifter.initialize());
+        EXPECT_TRUE(shifter.setParameters(2.0f, 1.0f));
+        shifter.setFormantPreservation(preserve);
+        core::AudioBuffer output;
+        EXPECT_TRUE(shifter.apply(input, output));
+
+        const size_t begin = shifter.getLatency() + sample_rate / 2;
+        double best_frequency = 0.0;
+        double best = 0.0;
+        double moved = 0.0;
+        double stayed = 0.0;
+        for (double f = 2.0 * fundamental; f < 4800.0; f += 2.0 * fundamental) {
+            const double amplitude = amplitudeAt(output, begin, frames, f, sample_rate);
+            moved += amplitude;
+            stayed += amplitudeAt(output, begin, frames, f - fundamental, sample_rate);
+            if (amplitude > best) {
+                best = amplitude;
+                best_frequency = f;
+            }
+        }
+        EXPECT_LT(stayed, 0.1 * moved) << "preserve " << preserve;
+        return best_frequency;
+    };
+
+    EXPECT_NEAR(strongestPartial(true), formant, 2.0 * fundamental);
+    EXPECT_NEAR(strongestPartial(false), 2.0 * formant, 2.0 * fundamental);
+}
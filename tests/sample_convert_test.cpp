@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "audio/simd/sample_convert.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using audio::simd::ConversionKernels;
+using audio::simd::SimdLevel;
+
+namespace {
+
+// 长度覆盖向量主循环与各种尾部
+const size_t kLengths[] = {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 100, 1027};
+
+// 随机样本，含越界、舍入中点与满刻度边界值
+std::vector<float> makeSamples(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+    const float edges[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.99999f, -1.00001f, 2.0f, -2.0f,
+                           0.5f / 32768.0f, 1.5f / 32768.0f, -2.5f / 32768.0f, 32767.0f / 32768.0f};
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = i % 5 == 0 ? edges[(i / 5) % (sizeof(edges) / sizeof(edges[0]))] : dist(rng);
+    }
+    return samples;
+}
+
+std::vector<uint8_t> makeBytes(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(count);
+    for (auto& b : bytes) {
+        b = static_cast<uint8_t>(rng());
+    }
+    return bytes;
+}
+
+class SampleConvertTest : public ::testing::TestWithParam<SimdLevel> {
+protected:
+    const ConversionKernels& kernels() const { return audio::simd::getKernels(GetParam()); }
+    const ConversionKernels& reference() const { return audio::simd::getKernels(SimdLevel::SCALAR); }
+};
+
+} // namespace
+
+// 整数 -> 浮点与标量参考逐位一致
+TEST_P(SampleConvertTest, IntegerToFloatMatchesScalar) {
+    for (size_t n : kLengths) {
+        const auto bytes = makeBytes(n * 4 + 16, static_cast<uint32_t>(n));
+        std::vector<float> expected(n), actual(n);
+
+        std::vector<int16_t> s16(n);
+        std::memcpy(s16.data(), bytes.data(), n * 2);
+        reference().s16ToFloat(s16.data(), expected.data(), n);
+        kernels().s16ToFloat(s16.data(), actual.data(), n);
+        EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), n * sizeof(float))) << "s16 n=" << n;
+
+        // 24位输入缓冲区恰好为3n字节，检查向量路径不越界读取
+        std::vector<uint8_t> s24(bytes.begin(), bytes.begin() + n * 3);
+        reference().s24ToFloat(s24.data(), expected.data(), n);
+        kernels().s24ToFloat(s24.data(), actual.data(), n);
+        EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), n * sizeof(float))) << "s24 n=" << n;
+
+        std::vector<int32_t> s32(n);
+        std::memcpy(s32.data(), bytes.data(), n * 4);
+        reference().s32ToFloat(s32.data(), expected.data(), n);
+        kernels().s32ToFloat(s32.data(), actual.data(), n);
+        EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), n * sizeof(float))) << "s32 n=" << n;
+    }
+}
+
+// 浮点 -> 整数（饱和与舍入）与标量参考逐位一致
+TEST_P(SampleConvertTest, FloatToIntegerMatchesScalar) {
+    for (size_t n : kLengths) {
+        const auto input = makeSamples(n, static_cast<uint32_t>(n) + 1);
+
+        std::vector<int16_t> s16_expected(n), s16_actual(n);
+        reference().floatToS16(input.data(), s16_expected.data(), n);
+        kernels().floatToS16(input.data(), s16_actual.data(), n);
+        EXPECT_EQ(s16_expected, s16_actual) << "s16 n=" << n;
+
+        // 输出缓冲区末尾留哨兵，检查24位打包不越界写入
+        std::vector<uint8_t> s24_expected(n * 3 + 8, 0xA5), s24_actual(n * 3 + 8, 0xA5);
+        reference().floatToS24(input.data(), s24_expected.data(), n);
+        kernels().floatToS24(input.data(), s24_actual.data(), n);
+        EXPECT_EQ(s24_expected, s24_actual) << "s24 n=" << n;
+
+        std::vector<int32_t> s32_expected(n), s32_actual(n);
+        reference().floatToS32(input.data(), s32_expected.data(), n);
+        kernels().floatToS32(input.data(), s32_actual.data(), n);
+        EXPECT_EQ(s32_expected, s32_actual) << "s32 n=" << n;
+    }
+}
+
+// 浮点 <-> 双精度
+TEST_P(SampleConvertTest, DoubleMatchesScalar) {
+    for (size_t n : kLengths) {
+        const auto input = makeSamples(n, static_cast<uint32_t>(n) + 2);
+        std::vector<double> wide_expected(n), wide_actual(n);
+        reference().floatToDouble(input.data(), wide_expected.data(), n);
+        kernels().floatToDouble(input.data(), wide_actual.data(), n);
+        EXPECT_EQ(wide_expected, wide_actual);
+
+        for (size_t i = 0; i < n; ++i) {
+            wide_expected[i] += 1e-9 * static_cast<double>(i);
+        }
+        std::vector<float> expected(n), actual(n);
+        reference().doubleToFloat(wide_expected.data(), expected.data(), n);
+        kernels().doubleToFloat(wide_expected.data(), actual.data(), n);
+        EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), n * sizeof(float)));
+    }
+}
+
+// 字节序交换与标量参考一致，且两次交换恢复原值
+TEST_P(SampleConvertTest, ByteSwapMatchesScalar) {
+    for (size_t n : kLengths) {
+        const auto bytes = makeBytes(n * 4, static_cast<uint32_t>(n) + 3);
+
+        std::vector<uint16_t> a16(n), b16(n);
+        std::memcpy(a16.data(), bytes.data(), n * 2);
+        b16 = a16;
+        reference().swap16(a16.data(), n);
+        kernels().swap16(b16.data(), n);
+        EXPECT_EQ(a16, b16);
+
+        std::vector<uint8_t> a24(bytes.begin(), bytes.begin() + n * 3), b24 = a24;
+        reference().swap24(a24.data(), n);
+        kernels().swap24(b24.data(), n);
+        EXPECT_EQ(a24, b24);
+        kernels().swap24(b24.data(), n);
+        EXPECT_TRUE(std::equal(b24.begin(), b24.end(), bytes.begin()));
+
+        std::vector<uint32_t> a32(n), b32(n);
+        std::memcpy(a32.data(), bytes.data(), n * 4);
+        b32 = a32;
+        reference().swap32(a32.data(), n);
+        kernels().swap32(b32.data(), n);
+        EXPECT_EQ(a32, b32);
+    }
+}
+
+// 交错 <-> 平面（立体声走向量路径，其他声道数走通用路径）
+TEST_P(SampleConvertTest, InterleaveRoundTrip) {
+    for (size_t channels : {1u, 2u, 3u, 6u}) {
+        for (size_t frames : kLengths) {
+            const auto input = makeSamples(frames * channels, static_cast<uint32_t>(frames + channels));
+            std::vector<std::vector<float>> expected(channels, std::vector<float>(frames));
+            std::vector<std::vector<float>> actual(channels, std::vector<float>(frames));
+            std::vector<float*> expected_planes, actual_planes;
+            for (size_t ch = 0; ch < channels; ++ch) {
+                expected_planes.push_back(expected[ch].data());
+                actual_planes.push_back(actual[ch].data());
+            }
+
+            reference().deinterleave(input.data(), expected_planes.data(), frames, channels);
+            kernels().deinterleave(input.data(), actual_planes.data(), frames, channels);
+            EXPECT_EQ(expected, actual);
+
+            std::vector<float> output(frames * channels);
+            std::vector<const float*> planes(actual_planes.begin(), actual_planes.end());
+            kernels().interleave(planes.data(), output.data(), frames, channels);
+            EXPECT_EQ(input, output);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, SampleConvertTest,
+                         ::testing::Values(SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2));
+
+// 满刻度、饱和与就近舍入的绝对取值
+TEST(SampleConvertReferenceTest, ScalingAndClipping) {
+    const auto& scalar = audio::simd::getKernels(SimdLevel::SCALAR);
+    const float input[] = {1.0f, -1.0f, 1.5f, -1.5f, 0.5f / 32768.0f, 1.5f / 32768.0f};
+    int16_t s16[6];
+    scalar.floatToS16(input, s16, 6);
+    EXPECT_EQ(32767, s16[0]);
+    EXPECT_EQ(-32768, s16[1]);
+    EXPECT_EQ(32767, s16[2]);
+    EXPECT_EQ(-32768, s16[3]);
+    EXPECT_EQ(0, s16[4]);   // 0.5舍入到偶数
+    EXPECT_EQ(2, s16[5]);   // 1.5舍入到偶数
+
+    uint8_t s24[18];
+    scalar.floatToS24(input, s24, 6);
+    EXPECT_EQ(0xFF, s24[0]);
+    EXPECT_EQ(0xFF, s24[1]);
+    EXPECT_EQ(0x7F, s24[2]);
+    EXPECT_EQ(0x00, s24[3]);
+    EXPECT_EQ(0x00, s24[4]);
+    EXPECT_EQ(0x80, s24[5]);
+
+    float back[6];
+    scalar.s24ToFloat(s24, back, 6);
+    EXPECT_FLOAT_EQ(-1.0f, back[1]);
+    EXPECT_NEAR(1.0f, back[0], 1.0f / 8388608.0f);
+}
+
+// 格式级转换：同格式拷贝、经由浮点的整数格式互转
+TEST(SampleConvertReferenceTest, FormatConversion) {
+    using audio::SampleFormat;
+    EXPECT_EQ(3u, audio::simd::bytesPerSample(SampleFormat::PCM_S24LE));
+    EXPECT_EQ(0u, audio::simd::bytesPerSample(SampleFormat::UNKNOWN));
+
+    const int16_t input[] = {0, 1, -1, 32767, -32768, 1234};
+    int32_t output[6];
+    float scratch[6];
+    ASSERT_TRUE(audio::simd::convert(input, SampleFormat::PCM_S16LE, output, SampleFormat::PCM_S32LE, scratch, 6));
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(static_cast<int32_t>(input[i]) * 65536, output[i]);
+    }
+    EXPECT_FALSE(audio::simd::convert(input, SampleFormat::UNKNOWN, output, SampleFormat::PCM_S32LE, scratch, 6));
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "core/audio_stereo_enhancer.h"
+#include "core/audio_stereo_widener.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 交错立体声：左声道为a * sin(f1)，右声道为b * sin(f2)
+core::AudioBuffer makeStereo(size_t frames, int sample_rate, double left_freq, double right_freq) {
+    core::AudioBuffer buffer(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i) / sample_rate;
+        buffer[i * 2] = static_cast<float>(0.5 * std::sin(2.0 * kPi * left_freq * t));
+        buffer[i * 2 + 1] = static_cast<float>(0.3 * std::sin(2.0 * kPi * right_freq * t + 1.0));
+    }
+    return buffer;
+}
+
+// 侧边信号(L - R) / 2在[begin, end)帧内的能量
+double sideEnergy(const core::AudioBuffer& buffer, size_t begin, size_t end) {
+    double energy = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        const double side = 0.5 * (buffer[i * 2] - buffer[i * 2 + 1]);
+        energy += side * side;
+    }
+    return energy;
+}
+
+} // namespace
+
+// 测试M/S宽度：0为单声道，1为原样，2时侧边信号加倍而中间信号不变
+TEST(StereoTest, WidthScalesSideOnly) {
+    const int sample_rate = 48000;
+    const size_t frames = 512;
+    const core::AudioBuffer input = makeStereo(frames, sample_rate, 440.0, 660.0);
+
+    for (const float width : {0.0f, 1.0f, 2.0f}) {
+        core::AudioStereoWidener widener;
+        widener.setSampleRate(sample_rate);
+        ASSERT_TRUE(widener.initialize());
+        ASSERT_TRUE(widener.setParameters(width, 1.0f));
+
+        // 第一块内矩阵从默认参数平滑过渡，第二块为稳态
+        core::AudioBuffer output;
+        ASSERT_TRUE(widener.apply(input, output));
+        ASSERT_TRUE(widener.apply(input, output));
+        for (size_t i = 0; i < frames; ++i) {
+            const float mid = 0.5f * (input[i * 2] + input[i * 2 + 1]);
+            const float side = 0.5f * (input[i * 2] - input[i * 2 + 1]);
+            EXPECT_NEAR(output[i * 2], mid + width * side, 1e-6f) << "width " << width << " frame " << i;
+            EXPECT_NEAR(output[i * 2 + 1], mid - width * side, 1e-6f) << "width " << width << " frame " << i;
+        }
+    }
+
+    // mix为0时完全旁路
+    core::AudioStereoWidener bypass;
+    ASSERT_TRUE(bypass.initialize());
+    ASSERT_TRUE(bypass.setParameters(2.0f, 0.0f));
+    core::AudioBuffer output;
+    ASSERT_TRUE(bypass.apply(input, output));
+    ASSERT_TRUE(bypass.apply(input, output));
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_FLOAT_EQ(output[i], input[i]);
+    }
+}
+
+// 测试低频单声道化：分频点以下的侧边信号被去除，高频侧边信号与中间信号保持不变
+TEST(StereoTest, BassMonoRemovesLowSideOnly) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate / 2;
+
+    auto sideGainDb = [&](double frequency) {
+        core::AudioBuffer buffer(frames * 2);
+        for (size_t i = 0; i < frames; ++i) {
+            const float side = 0.5f * static_cast<float>(std::sin(2.0 * kPi * frequency * static_cast<double>(i) / sample_rate));
+            const float mid = 0.25f * static_cast<float>(std::sin(2.0 * kPi * 40.0 * static_cast<double>(i) / sample_rate));
+            buffer[i * 2] = mid + side;
+            buffer[i * 2 + 1] = mid - side;
+        }
+        const core::AudioBuffer input = buffer;
+
+        core::AudioStereoWidener widener;
+        widener.setSampleRate(sample_rate);
+        EXPECT_TRUE(widener.initialize());
+        EXPECT_TRUE(widener.setBassMonoFrequency(200.0f));
+        EXPECT_TRUE(widener.apply(buffer, buffer));
+
+        // 左右之和（两倍中间信号）不受影响
+        for (size_t i = 0; i < frames; ++i) {
+            EXPECT_NEAR(buffer[i * 2] + buffer[i * 2 + 1], input[i * 2] + input[i * 2 + 1], 1e-5f);
+        }
+        return 10.0 * std::log10(sideEnergy(buffer, frames / 2, frames) / sideEnergy(input, frames / 2, frames));
+    };
+
+    // 4阶高通：分频点下两个倍频程衰减约48 dB，分频点处-6 dB，远高于分频点时不衰减
+    EXPECT_LT(sideGainDb(50.0), -40.0);
+    EXPECT_NEAR(sideGainDb(200.0), -6.0, 0.5);
+    EXPECT_NEAR(sideGainDb(5000.0), 0.0, 0.1);
+}
+
+// 测试哈斯去相关：单声道输入的侧边信号为延迟的中间信号乘以去相关量，左右之和保持不变（单声道兼容）
+TEST(StereoTest, HaasDecorrelationIsMonoCompatible) {
+    const int sample_rate = 48000;
+    const size_t frames = 4096;
+    core::AudioBuffer input(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        const float sample = static_cast<float>(0.4 * std::sin(0.05 * static_cast<double>(i)) +
+                                                0.2 * std::sin(0.31 * static_cast<double>(i)));
+        input[i * 2] = sample;
+        input[i * 2 + 1] = sample;
+    }
+
+    core::AudioStereoEnhancer enhancer;
+    enhancer.setSampleRate(sample_rate);
+    ASSERT_TRUE(enhancer.initialize());
+    ASSERT_TRUE(enhancer.setParameters(1.5f, 0.0f, 1.0f));
+    ASSERT_TRUE(enhancer.setDecorrelation(10.0f, 0.5f));
+    ASSERT_TRUE(enhancer.setBassMonoFrequency(0.0f));
+
+    // 分块处理，检查跨块的延迟线连续
+    core::AudioBuffer output = input;
+    for (size_t offset = 0; offset < frames; offset += 333) {
+        const size_t count = std::min<size_t>(333, frames - offset);
+        ASSERT_TRUE(enhancer.process(core::AudioView(output.data() + offset * 2, count, 2)));
+    }
+
+    const size_t delay = 480;
+    for (size_t i = 0; i < frames; ++i) {
+        EXPECT_NEAR(output[i * 2] + output[i * 2 + 1], 2.0f * input[i * 2], 1e-5f) << "frame " << i;
+        const float expected_side = i < delay ? 0.0f : 0.5f * input[(i - delay) * 2];
+        EXPECT_NEAR(0.5f * (output[i * 2] - output[i * 2 + 1]), expected_side, 1e-5f) << "frame " << i;
+    }
+}
+
+// 测试平衡：-1时右声道静音，左声道不变
+TEST(StereoTest, ImbalanceAttenuatesOppositeSide) {
+    const core::AudioBuffer input = makeStereo(256, 48000, 440.0, 660.0);
+
+    core::AudioStereoEnhancer enhancer;
+    ASSERT_TRUE(enhancer.initialize());
+    ASSERT_TRUE(enhancer.setParameters(1.0f, -1.0f, 1.0f));
+    ASSERT_TRUE(enhancer.setDecorrelation(10.0f, 0.0f));
+    ASSERT_TRUE(enhancer.setBassMonoFrequency(0.0f));
+
+    core::AudioBuffer output;
+    ASSERT_TRUE(enhancer.apply(input, output));
+    ASSERT_TRUE(enhancer.apply(input, output));
+    for (size_t i = 0; i < 256; ++i) {
+        EXPECT_NEAR(output[i * 2], input[i * 2], 1e-6f);
+        EXPECT_NEAR(output[i * 2 + 1], 0.0f, 1e-6f);
+    }
+}
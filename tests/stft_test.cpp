@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "core/audio_spectral_delay.h"
+#include "core/audio_stft.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 不修改频谱的处理核
+struct IdentityKernel {
+    void beginFrame() {}
+    void processBins(size_t, float*, float*, size_t) {}
+};
+
+// 每个声道使用不同的信号，检查打包FFT拆分后声道互不串扰
+std::vector<float> makeSignal(size_t frames, size_t channels) {
+    std::vector<float> data(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t ch = 0; ch < channels; ++ch) {
+            const double t = static_cast<double>(i);
+            data[i * channels + ch] = static_cast<float>(0.4 * std::sin(0.013 * t * static_cast<double>(ch + 1)) +
+                                                         0.2 * std::cos(0.37 * t + static_cast<double>(ch)));
+        }
+    }
+    return data;
+}
+
+} // namespace
+
+// 测试STFT恒等往返：任意声道数（含打包后剩余的单声道）、窗函数与跳跃长度下，
+// 输出精确等于输入延迟getLatency帧的结果（块长与帧长不对齐）
+TEST(StftTest, IdentityRoundTripDelaysByLatency) {
+    const size_t frames = 6000;
+    const size_t block = 100;
+
+    for (const size_t channels : {1u, 2u, 3u}) {
+        for (const auto window : {core::StftWindow::HANN, core::StftWindow::HAMMING, core::StftWindow::BLACKMAN}) {
+            for (const size_t hop : {64u, 128u, 256u}) {
+                core::StftEngine stft;
+                ASSERT_TRUE(stft.configure(channels, 512, hop, window));
+                const std::vector<float> input = makeSignal(frames, channels);
+                std::vector<float> output = input;
+
+                IdentityKernel kernel;
+                for (size_t offset = 0; offset < frames; offset += block) {
+                    stft.process(output.data() + offset * channels, std::min(block, frames - offset), kernel);
+                }
+
+                const size_t latency = stft.getLatency();
+                ASSERT_EQ(latency, 512u);
+                for (size_t i = 0; i < frames; ++i) {
+                    for (size_t ch = 0; ch < channels; ++ch) {
+                        const float expected = i < latency ? 0.0f : input[(i - latency) * channels + ch];
+                        ASSERT_NEAR(output[i * channels + ch], expected, 1e-5f)
+                            << channels << " channels, hop " << hop << ", frame " << i << ", channel " << ch;
+                    }
+                }
+            }
+        }
+    }
+
+    core::StftEngine invalid;
+    EXPECT_FALSE(invalid.configure(1, 500, 100));
+    EXPECT_FALSE(invalid.configure(1, 512, 384));
+}
+
+// 测试频谱延迟：无反馈、全湿时输出为输入延迟getLatency加整数个跳跃长度的结果
+TEST(StftTest, SpectralDelayDelaysByWholeHops) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate;
+    const size_t hops = 10;
+    core::AudioBuffer input(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        input[i] = static_cast<float>(0.5 * std::sin(2.0 * kPi * 300.0 * static_cast<double>(i) / sample_rate));
+    }
+
+    core::AudioSpectralDelay delay;
+    ASSERT_TRUE(delay.setFormat(sample_rate, 1));
+    ASSERT_TRUE(delay.initialize());
+    ASSERT_TRUE(delay.setResolution(1024, 256));
+    ASSERT_TRUE(delay.setSpread(0.0f));
+    // 10个跳跃长度：10 * 256 / 48000秒，低通截止远高于信号频率
+    ASSERT_TRUE(delay.setParameters(static_cast<float>(hops * 256 * 1000.0 / sample_rate), 0.0f, 1.0f, 20000.0f));
+
+    core::AudioBuffer output;
+    ASSERT_TRUE(delay.apply(input, output));
+    const size_t total = delay.getLatency() + hops * 256;
+    double error = 0.0;
+    double energy = 0.0;
+    for (size_t i = frames / 2; i < frames; ++i) {
+        const double diff = output[i] - input[i - total];
+        error += diff * diff;
+        energy += input[i - total] * input[i - total];
+    }
+    EXPECT_LT(10.0 * std::log10(error / energy), -60.0);
+}
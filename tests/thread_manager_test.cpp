@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "platform/thread_manager.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using platform::ThreadManager;
+using platform::ThreadPolicy;
+using platform::ThreadRole;
+
+namespace {
+
+// 每个用例结束时恢复默认策略，避免影响其他用例创建的线程池
+class ThreadManagerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        ThreadManager::set_role_policy(ThreadRole::AUDIO, ThreadPolicy());
+        ThreadManager::set_role_policy(ThreadRole::WORKER, ThreadPolicy());
+        ThreadManager::set_role_policy(ThreadRole::BACKGROUND, ThreadPolicy());
+    }
+};
+
+} // namespace
+
+TEST_F(ThreadManagerTest, ParsesPrioritiesAndCpuLists) {
+    int priority = 0;
+    EXPECT_TRUE(ThreadManager::parse_priority("Realtime", priority));
+    EXPECT_EQ(priority, platform::kThreadPriorityRealtime);
+    EXPECT_TRUE(ThreadManager::parse_priority(" low ", priority));
+    EXPECT_EQ(priority, platform::kThreadPriorityLow);
+    EXPECT_TRUE(ThreadManager::parse_priority("42", priority));
+    EXPECT_EQ(priority, 42);
+    EXPECT_FALSE(ThreadManager::parse_priority("urgent", priority));
+    EXPECT_FALSE(ThreadManager::parse_priority("100", priority));
+
+    std::vector<unsigned int> cpus;
+    EXPECT_TRUE(ThreadManager::parse_cpu_list("3, 0-1,1", cpus));
+    EXPECT_EQ(cpus, (std::vector<unsigned int>{0, 1, 3}));
+    EXPECT_TRUE(ThreadManager::parse_cpu_list("", cpus));
+    EXPECT_TRUE(cpus.empty());
+    EXPECT_FALSE(ThreadManager::parse_cpu_list("2-1", cpus));
+    EXPECT_FALSE(ThreadManager::parse_cpu_list("a", cpus));
+}
+
+TEST_F(ThreadManagerTest, LoadsRolePoliciesFromConfig) {
+    // 写到临时目录，不污染工作目录
+    const std::string path = (std::filesystem::temp_directory_path() / "thread_manager_test_config.json").string();
+    {
+        std::ofstream file(path);
+        file << "{\"audio\": {\"buffer_size\": 1024}, \"performance\": {\"cpu_priority\": \"realtime\", "
+                "\"worker_priority\": \"\", \"background_priority\": \"idle\", \"audio_cpus\": \"1\", "
+                "\"worker_cpus\": \"\", \"background_cpus\": \"0\", \"memory_limit_mb\": 512}}";
+    }
+    EXPECT_TRUE(ThreadManager::load_config(path));
+    std::remove(path.c_str());
+
+    const ThreadPolicy audio = ThreadManager::get_role_policy(ThreadRole::AUDIO);
+    EXPECT_EQ(audio.priority, platform::kThreadPriorityRealtime);
+    EXPECT_EQ(audio.cpus, (std::vector<unsigned int>{1}));
+
+    // 未指定的工作线程优先级略低于音频线程
+    const ThreadPolicy worker = ThreadManager::get_role_policy(ThreadRole::WORKER);
+    EXPECT_GT(worker.priority, platform::kThreadPriorityNormal);
+    EXPECT_LT(worker.priority, audio.priority);
+    EXPECT_TRUE(worker.cpus.empty());
+
+    const ThreadPolicy background = ThreadManager::get_role_policy(ThreadRole::BACKGROUND);
+    EXPECT_EQ(background.priority, platform::kThreadPriorityIdle);
+    EXPECT_EQ(background.cpus, (std::vector<unsigned int>{0}));
+}
+
+TEST_F(ThreadManagerTest, WorkersAvoidAudioCpus) {
+    const std::vector<unsigned int> available = ThreadManager::available_cpus();
+    ASSERT_FALSE(available.empty());
+
+    ThreadPolicy audio;
+    audio.cpus = {available.front()};
+    ThreadManager::set_role_policy(ThreadRole::AUDIO, audio);
+
+    const ThreadPolicy worker = ThreadManager::effective_role_policy(ThreadRole::WORKER);
+    for (unsigned int cpu : worker.cpus) {
+        EXPECT_NE(cpu, available.front());
+    }
+    EXPECT_EQ(worker.cpus.size(), available.size() - 1);
+
+    // 单独绑定的角色不受影响
+    ThreadPolicy background;
+    background.cpus = {available.front()};
+    ThreadManager::set_role_policy(ThreadRole::BACKGROUND, background);
+    EXPECT_EQ(ThreadManager::effective_role_policy(ThreadRole::BACKGROUND).cpus, background.cpus);
+}
+
+#ifdef __linux__
+TEST_F(ThreadManagerTest, AppliesPolicyToThreads) {
+    const unsigned int cpu = ThreadManager::available_cpus().back();
+    ThreadPolicy policy;
+    policy.priority = platform::kThreadPriorityLow;
+    policy.cpus = {cpu};
+    ThreadManager::set_role_policy(ThreadRole::BACKGROUND, policy);
+
+    std::atomic<bool> applied(false);
+    int sched_policy = -1;
+    bool pinned = false;
+    std::thread thread = ThreadManager::create_thread([&] {
+        applied = ThreadManager::apply_role_policy(ThreadRole::BACKGROUND);
+        sched_param param{};
+        pthread_getschedparam(pthread_self(), &sched_policy, &param);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        pinned = CPU_COUNT(&set) == 1 && CPU_ISSET(cpu, &set);
+    });
+    thread.join();
+    EXPECT_TRUE(applied.load());
+    EXPECT_EQ(sched_policy, SCHED_BATCH);
+    EXPECT_TRUE(pinned);
+
+    // 实时优先级可能因权限不足失败，失败时保持原调度策略（线程阻塞等待，提升为实时后不会占满CPU）
+    std::promise<void> release;
+    std::thread worker([done = release.get_future()] {
+        done.wait();
+    });
+    const bool realtime = ThreadManager::set_thread_priority(worker, platform::kThreadPriorityRealtime);
+    int worker_policy = -1;
+    sched_param param{};
+    pthread_getschedparam(worker.native_handle(), &worker_policy, &param);
+    EXPECT_EQ(worker_policy, realtime ? SCHED_FIFO : SCHED_OTHER);
+    EXPECT_TRUE(ThreadManager::set_thread_priority(worker, platform::kThreadPriorityNormal));
+    EXPECT_TRUE(ThreadManager::set_thread_affinity(worker, cpu));
+    release.set_value();
+    worker.join();
+}
+#endif
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "core/audio_thread_pool.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+TEST(ThreadPoolTest, SubmitReturnsResultsAndExceptions) {
+    core::AudioThreadPool pool(3);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+
+    auto failed = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, TaskStorageReleasesClosures) {
+    auto shared = std::make_shared<int>(7);
+    {
+        // 小闭包存放在任务内部，移动后由新对象负责释放
+        core::AudioTask small([shared] { EXPECT_EQ(*shared, 7); });
+        core::AudioTask moved(std::move(small));
+        EXPECT_FALSE(small);
+        moved();
+        EXPECT_EQ(shared.use_count(), 2);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+
+    // 超过内联容量的闭包退回堆存储
+    std::array<float, 64> large{};
+    large[63] = 3.0f;
+    float seen = 0.0f;
+    core::AudioTask task([large, &seen] { seen = large[63]; });
+    task();
+    EXPECT_EQ(seen, 3.0f);
+}
+
+TEST(ThreadPoolTest, DispatchRunsEveryTaskEvenWhenQueuesOverflow) {
+    core::AudioThreadPool pool(2);
+    std::atomic<int> counter(0);
+    {
+        core::TaskGroup group(&pool);
+        for (int i = 0; i < 20000; ++i) {
+            group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+    }
+    EXPECT_EQ(counter.load(), 20000);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeExactlyOnce) {
+    core::AudioThreadPool pool(4);
+    for (size_t grain : {1u, 7u, 64u, 5000u}) {
+        std::vector<std::atomic<int>> hits(3001);
+        pool.parallelFor(1, hits.size(), grain, [&hits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        EXPECT_EQ(hits[0].load(), 0);
+        for (size_t i = 1; i < hits.size(); ++i) {
+            ASSERT_EQ(hits[i].load(), 1) << "index " << i << " grain " << grain;
+        }
+    }
+}
+
+TEST(ThreadPoolTest, NestedForkJoinDoesNotDeadlock) {
+    core::AudioThreadPool pool(2);
+    std::atomic<size_t> total(0);
+    pool.parallelFor(0, 16, 1, [&pool, &total](size_t, size_t) {
+        // 工作线程内的嵌套并行：等待时帮忙执行，不会占满线程而死锁
+        pool.parallelFor(0, 100, 10, [&total](size_t begin, size_t end) {
+            total.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+    });
+    EXPECT_EQ(total.load(), 1600u);
+}
+
+TEST(ThreadPoolTest, HigherPriorityTasksRunFirst) {
+    core::AudioThreadPool pool(1);
+
+    // 占住唯一的工作线程，期间排队的任务按优先级执行
+    std::atomic<bool> release(false);
+    std::atomic<bool> started(false);
+    pool.dispatch([&] {
+        started.store(true);
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    std::mutex mutex;
+    std::vector<core::TaskPriority> order;
+    auto record = [&mutex, &order](core::TaskPriority priority) {
+        return [&mutex, &order, priority] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(priority);
+        };
+    };
+    std::vector<std::future<void>> done;
+    for (int i = 0; i < 4; ++i) {
+        done.push_back(pool.submit(record(core::TaskPriority::LOW), core::TaskPriority::LOW));
+        done.push_back(pool.submit(record(core::TaskPriority::NORMAL), core::TaskPriority::NORMAL));
+        done.push_back(pool.submit(record(core::TaskPriority::HIGH), core::TaskPriority::HIGH));
+    }
+    release.store(true);
+    for (auto& future : done) {
+        future.get();
+    }
+
+    ASSERT_EQ(order.size(), 12u);
+    for (size_t i = 1; i < order.size(); ++i) {
+        EXPECT_LE(static_cast<int>(order[i - 1]), static_cast<int>(order[i])) << "position " << i;
+    }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "core/audio_vocoder.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// [begin, end)区间内frequency分量的幅度
+double toneAmplitude(const core::AudioBuffer& buffer, size_t begin, size_t end, double frequency, int sample_rate) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        const double angle = 2.0 * kPi * frequency * static_cast<double>(i) / sample_rate;
+        re += buffer[i] * std::cos(angle);
+        im += buffer[i] * std::sin(angle);
+    }
+    return 2.0 * std::sqrt(re * re + im * im) / static_cast<double>(end - begin);
+}
+
+double rmsDb(const core::AudioBuffer& buffer, size_t begin, size_t end) {
+    double energy = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        energy += buffer[i] * buffer[i];
+    }
+    return 10.0 * std::log10(energy / static_cast<double>(end - begin) + 1e-30);
+}
+
+} // namespace
+
+// 测试两种模式下输出电平跟随调制信号：调制降低6 dB输出降低6 dB，静音时无输出，
+// 输出能量集中在调制信号频率附近的载波谐波上
+TEST(VocoderTest, OutputFollowsModulatorEnvelope) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate;
+
+    for (const auto mode : {core::AudioVocoder::Mode::FILTERBANK, core::AudioVocoder::Mode::FFT}) {
+        std::vector<double> levels;
+        for (const float amplitude : {0.5f, 0.25f, 0.0f}) {
+            core::AudioBuffer input(frames);
+            for (size_t i = 0; i < frames; ++i) {
+                input[i] = amplitude * static_cast<float>(std::sin(2.0 * kPi * 1000.0 * static_cast<double>(i) / sample_rate));
+            }
+
+            core::AudioVocoder vocoder;
+            ASSERT_TRUE(vocoder.setFormat(sample_rate, 1));
+            ASSERT_TRUE(vocoder.initialize());
+            vocoder.setMode(mode);
+            ASSERT_TRUE(vocoder.setParameters(110.0f, 50.0f, 1.0f));
+
+            core::AudioBuffer output;
+            ASSERT_TRUE(vocoder.apply(input, output));
+            levels.push_back(rmsDb(output, frames / 2, frames));
+
+            if (amplitude > 0.0f) {
+                // 110 Hz锯齿波载波：990/1100 Hz谐波落在1 kHz频带内，远离的谐波被抑制
+                const double near = toneAmplitude(output, frames / 2, frames, 990.0, sample_rate) +
+                                    toneAmplitude(output, frames / 2, frames, 1100.0, sample_rate);
+                EXPECT_GT(near, 4.0 * toneAmplitude(output, frames / 2, frames, 220.0, sample_rate));
+                EXPECT_GT(near, 4.0 * toneAmplitude(output, frames / 2, frames, 3300.0, sample_rate));
+            }
+        }
+        EXPECT_NEAR(levels[0] - levels[1], 6.02, 0.5) << "mode " << static_cast<int>(mode);
+        EXPECT_LT(levels[2], -120.0) << "mode " << static_cast<int>(mode);
+    }
+}
+
+// 测试FFT模式：载波与调制相同时各频带增益为1，输出是载波延迟getLatency帧的结果，
+// 干湿混合时两路对齐；滤波器组模式无延迟
+TEST(VocoderTest, FftModeDelaysByLatency) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate;
+    core::AudioBuffer signal(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i) / sample_rate;
+        signal[i] = static_cast<float>(0.3 * std::sin(2.0 * kPi * 500.0 * t) + 0.2 * std::sin(2.0 * kPi * 2000.0 * t));
+    }
+
+    for (const float mix : {1.0f, 0.5f}) {
+        core::AudioVocoder vocoder;
+        ASSERT_TRUE(vocoder.setFormat(sample_rate, 1));
+        ASSERT_TRUE(vocoder.initialize());
+        vocoder.setMode(core::AudioVocoder::Mode::FFT);
+        ASSERT_TRUE(vocoder.setParameters(110.0f, 100.0f, mix));
+
+        core::AudioBuffer output;
+        ASSERT_TRUE(vocoder.apply(signal, signal, output));
+
+        const size_t latency = vocoder.getLatency();
+        ASSERT_GT(latency, 0u);
+        double error = 0.0;
+        double energy = 0.0;
+        for (size_t i = frames / 2; i < frames; ++i) {
+            const double diff = output[i] - signal[i - latency];
+            error += diff * diff;
+            energy += signal[i - latency] * signal[i - latency];
+        }
+        EXPECT_LT(10.0 * std::log10(error / energy), -40.0) << "mix " << mix;
+    }
+
+    core::AudioVocoder filterbank;
+    filterbank.setMode(core::AudioVocoder::Mode::FILTERBANK);
+    EXPECT_EQ(filterbank.getLatency(), 0u);
+}
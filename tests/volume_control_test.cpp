@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "audio/dsp/volume_control.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using audio::dsp::VolumeControl;
+
+// 测试音量变化在一个块内线性过渡，最后一帧落在目标增益上，之后保持常数
+TEST(VolumeControlTest, LinearRampReachesTarget) {
+    VolumeControl volume;
+    volume.setVolume(0.5f);
+
+    const size_t frames = 100;
+    std::vector<float> buffer(frames * 2, 1.0f);
+    volume.applyVolume(buffer.data(), frames, 2);
+    for (size_t i = 0; i < frames; ++i) {
+        const float expected = 1.0f - 0.5f * static_cast<float>(i + 1) / frames;
+        EXPECT_NEAR(buffer[i * 2], expected, 1e-6f);
+        EXPECT_FLOAT_EQ(buffer[i * 2 + 1], buffer[i * 2]);
+    }
+    EXPECT_FLOAT_EQ(buffer.back(), 0.5f);
+
+    std::fill(buffer.begin(), buffer.end(), 1.0f);
+    volume.applyVolume(buffer.data(), frames, 2);
+    for (float sample : buffer) {
+        EXPECT_FLOAT_EQ(sample, 0.5f);
+    }
+}
+
+// 测试声道数超过内部暂存缓冲（512样本）时仍应用增益
+TEST(VolumeControlTest, ManyChannelsAreProcessed) {
+    const size_t channels = 600;
+    const size_t frames = 4;
+
+    VolumeControl volume;
+    volume.setVolume(0.5f);
+    std::vector<float> buffer(frames * channels, 1.0f);
+    volume.applyVolume(buffer.data(), frames, channels);
+
+    VolumeControl int16_volume;
+    int16_volume.setVolume(0.5f);
+    std::vector<float> input(frames * channels, 0.5f);
+    std::vector<int16_t> output(frames * channels, 0);
+    int16_volume.applyVolume(input.data(), output.data(), frames, channels);
+
+    for (size_t i = 0; i < frames; ++i) {
+        const float gain = 1.0f - 0.5f * static_cast<float>(i + 1) / frames;
+        const int16_t expected = static_cast<int16_t>(std::lrint(0.5f * gain * 32767.0f));
+        for (size_t ch = 0; ch < channels; ++ch) {
+            EXPECT_NEAR(buffer[i * channels + ch], gain, 1e-6f);
+            EXPECT_EQ(output[i * channels + ch], expected);
+        }
+    }
+}
+
+// 测试16位路径饱和截断，单位增益保持比特精确
+TEST(VolumeControlTest, Int16SaturatesAndKeepsUnityExact) {
+    VolumeControl volume;
+    std::vector<int16_t> samples = {20000, -20000, 123, -1};
+    volume.applyVolume(samples.data(), 2, 2);
+    EXPECT_EQ(samples, (std::vector<int16_t>{20000, -20000, 123, -1}));
+
+    volume.setVolume(2.0f);
+    volume.applyVolume(samples.data(), 2, 2);
+    volume.applyVolume(samples.data(), 2, 2);
+    EXPECT_EQ(samples[0], 32767);
+    EXPECT_EQ(samples[1], -32768);
+    EXPECT_EQ(samples[2], 492);
+}
+
+// 测试单声道常量接口：使用目标增益且不推进斜坡
+TEST(VolumeControlTest, ConstApplyUsesTargetGain) {
+    VolumeControl volume;
+    volume.setVolume(0.25f);
+
+    const VolumeControl& view = volume;
+    std::vector<float> buffer(8, 1.0f);
+    view.applyVolume(buffer.data(), buffer.size());
+    for (float sample : buffer) {
+        EXPECT_FLOAT_EQ(sample, 0.25f);
+    }
+
+    // 斜坡仍从1.0开始
+    std::fill(buffer.begin(), buffer.end(), 1.0f);
+    volume.applyVolume(buffer.data(), buffer.size(), 1);
+    EXPECT_GT(buffer[0], 0.25f);
+    EXPECT_FLOAT_EQ(buffer.back(), 0.25f);
+
+    volume.mute();
+    std::fill(buffer.begin(), buffer.end(), 1.0f);
+    view.applyVolume(buffer.data(), buffer.size());
+    EXPECT_FLOAT_EQ(buffer[0], 0.0f);
+}
+
+// 测试逐帧增益包络（如渲染后的自动化通道）与音量增益相乘
+TEST(VolumeControlTest, GainEnvelopeMultipliesVolume) {
+    VolumeControl volume;
+    volume.setVolume(0.5f);
+    std::vector<float> buffer(64 * 2, 1.0f);
+    volume.applyVolume(buffer.data(), 64, 2);
+
+    std::vector<float> envelope(64);
+    for (size_t i = 0; i < envelope.size(); ++i) {
+        envelope[i] = static_cast<float>(i) / 64.0f;
+    }
+    std::fill(buffer.begin(), buffer.end(), 1.0f);
+    volume.applyVolume(buffer.data(), 64, 2, envelope.data());
+    for (size_t i = 0; i < envelope.size(); ++i) {
+        EXPECT_FLOAT_EQ(buffer[i * 2], 0.5f * envelope[i]);
+        EXPECT_FLOAT_EQ(buffer[i * 2 + 1], 0.5f * envelope[i]);
+    }
+}
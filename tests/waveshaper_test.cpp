@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include "core/audio_distortion.h"
+#include "core/audio_oversampler.h"
+#include "core/audio_waveshaper.h"
+#include "core/audio_waveshaping.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// [begin, end)区间内frequency分量的幅度
+double toneAmplitude(const core::AudioBuffer& buffer, size_t begin, size_t end, double frequency, int sample_rate) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        const double angle = 2.0 * kPi * frequency * static_cast<double>(i) / sample_rate;
+        re += buffer[i] * std::cos(angle);
+        im += buffer[i] * std::sin(angle);
+    }
+    return 2.0 * std::sqrt(re * re + im * im) / static_cast<double>(end - begin);
+}
+
+core::AudioBuffer makeSine(double frequency, double amplitude, size_t frames, int sample_rate) {
+    core::AudioBuffer buffer(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        buffer[i] = static_cast<float>(amplitude * std::sin(2.0 * kPi * frequency * static_cast<double>(i) / sample_rate));
+    }
+    return buffer;
+}
+
+} // namespace
+
+// 测试传递函数表：查表插值与直接计算一致，表范围外取端点值
+TEST(WaveshaperTest, TransferTableMatchesCurve) {
+    for (const auto curve : {core::TransferCurve::TANH, core::TransferCurve::HARD_CLIP, core::TransferCurve::ASYMMETRIC}) {
+        core::TransferTable table;
+        table.build(curve, 0.0f);
+        for (int i = -1000; i <= 1000; ++i) {
+            const float x = 0.0077f * static_cast<float>(i);
+            EXPECT_NEAR(table.evaluate(x), core::TransferTable::compute(curve, x), 2e-5f) << x;
+        }
+        EXPECT_FLOAT_EQ(table.evaluate(100.0f), core::TransferTable::compute(curve, core::TransferTable::kRange));
+    }
+
+    core::TransferTable hard;
+    hard.build(core::TransferCurve::TANH, 1.0f);
+    EXPECT_NEAR(hard.evaluate(0.5f), 0.5f, 1e-5f);
+    EXPECT_NEAR(hard.evaluate(3.0f), 1.0f, 1e-5f);
+}
+
+// 测试过采样器往返：带内信号等于输入延迟getLatency帧的结果（分块处理）
+TEST(WaveshaperTest, OversamplerRoundTripDelaysByLatency) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate / 2;
+    const size_t block = 512;
+    const core::AudioBuffer input = makeSine(3000.0, 0.5, frames, sample_rate);
+
+    for (const size_t factor : {1u, 2u, 4u, 8u}) {
+        core::AudioOversampler oversampler;
+        ASSERT_TRUE(oversampler.setFactor(factor));
+        oversampler.prepare(1, block);
+
+        core::AudioBuffer output(frames);
+        for (size_t offset = 0; offset < frames; offset += block) {
+            const size_t count = std::min(block, frames - offset);
+            oversampler.upsample(0, input.data() + offset, count);
+            oversampler.downsample(0, output.data() + offset, count);
+        }
+
+        const size_t latency = oversampler.getLatency();
+        double error = 0.0;
+        double energy = 0.0;
+        for (size_t i = frames / 2; i < frames; ++i) {
+            const double diff = output[i] - input[i - latency];
+            error += diff * diff;
+            energy += input[i - latency] * input[i - latency];
+        }
+        EXPECT_LT(10.0 * std::log10(error / energy + 1e-30), -80.0) << "factor " << factor;
+    }
+    EXPECT_FALSE(core::AudioOversampler().setFactor(3));
+}
+
+// 测试过采样抑制混叠：7 kHz硬削波的5次与7次谐波在48 kHz下折叠到13 kHz与1 kHz，
+// 8倍过采样时混叠分量比不过采样低30 dB以上，基波不变
+TEST(WaveshaperTest, OversamplingSuppressesAliasing) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate / 2;
+    const core::AudioBuffer input = makeSine(7000.0, 0.5, frames, sample_rate);
+
+    std::vector<double> aliases;
+    std::vector<double> fundamentals;
+    for (const size_t factor : {1u, 8u}) {
+        core::AudioWaveshaper shaper;
+        ASSERT_TRUE(shaper.setFormat(sample_rate, 1));
+        ASSERT_TRUE(shaper.initialize());
+        shaper.setCurve(core::TransferCurve::HARD_CLIP);
+        ASSERT_TRUE(shaper.setOversampling(factor));
+        ASSERT_TRUE(shaper.setParameters(0.5f, 0.0f, 1.0f));
+
+        core::AudioBuffer output;
+        ASSERT_TRUE(shaper.apply(input, output));
+        fundamentals.push_back(toneAmplitude(output, frames / 2, frames, 7000.0, sample_rate));
+        aliases.push_back(toneAmplitude(output, frames / 2, frames, 13000.0, sample_rate) +
+                          toneAmplitude(output, frames / 2, frames, 1000.0, sample_rate));
+    }
+    EXPECT_LT(20.0 * std::log10(aliases[1] / aliases[0]), -30.0);
+    EXPECT_NEAR(fundamentals[1], fundamentals[0], 0.05 * fundamentals[0]);
+}
+
+// 测试干信号延迟补偿：mix为0时输出为输入延迟getLatency帧的结果
+TEST(WaveshaperTest, DryPathIsLatencyCompensated) {
+    const int sample_rate = 48000;
+    const size_t frames = 4096;
+    const core::AudioBuffer input = makeSine(440.0, 0.5, frames, sample_rate);
+
+    core::AudioWaveshaper shaper;
+    ASSERT_TRUE(shaper.setFormat(sample_rate, 1));
+    ASSERT_TRUE(shaper.initialize());
+    ASSERT_TRUE(shaper.setOversampling(4));
+    ASSERT_TRUE(shaper.setParameters(1.0f, 0.0f, 0.0f));
+
+    core::AudioBuffer output;
+    ASSERT_TRUE(shaper.apply(input, output));
+    const size_t latency = shaper.getLatency();
+    ASSERT_GT(latency, 0u);
+    for (size_t i = 0; i < frames; ++i) {
+        EXPECT_FLOAT_EQ(output[i], i < latency ? 0.0f : input[i - latency]) << "frame " << i;
+    }
+}
+
+// 测试非对称失真：产生偶次谐波，隔直滤波后输出无直流
+TEST(WaveshaperTest, AsymmetricDistortionAddsEvenHarmonics) {
+    const int sample_rate = 48000;
+    const size_t frames = sample_rate;
+    const core::AudioBuffer input = makeSine(500.0, 0.5, frames, sample_rate);
+
+    core::AudioDistortion distortion;
+    ASSERT_TRUE(distortion.setFormat(sample_rate, 1));
+    ASSERT_TRUE(distortion.initialize());
+    distortion.setCurve(core::TransferCurve::ASYMMETRIC);
+    ASSERT_TRUE(distortion.setParameters(0.5f, 1.0f, 1.0f));
+
+    core::AudioBuffer output;
+    ASSERT_TRUE(distortion.apply(input, output));
+    const double fundamental = toneAmplitude(output, frames / 2, frames, 500.0, sample_rate);
+    EXPECT_GT(toneAmplitude(output, frames / 2, frames, 1000.0, sample_rate), 0.01 * fundamental);
+
+    double mean = 0.0;
+    for (size_t i = frames / 2; i < frames; ++i) {
+        mean += output[i];
+    }
+    mean /= static_cast<double>(frames / 2);
+    EXPECT_LT(std::fabs(mean), 1e-3 * fundamental);
+
+    // 对称曲线没有偶次谐波
+    distortion.setCurve(core::TransferCurve::TANH);
+    ASSERT_TRUE(distortion.apply(input, output));
+    EXPECT_LT(toneAmplitude(output, frames / 2, frames, 1000.0, sample_rate), 1e-3 * fundamental);
+}
+
+// 测试超过预分配块长的块分段处理，结果与按块长逐块处理一致
+TEST(WaveshaperTest, LongBlockMatchesShortBlocks) {
+    const int sample_rate = 48000;
+    const size_t frames = 5000;
+    const core::AudioBuffer input = makeSine(997.0, 0.8, 2 * frames, sample_rate);
+
+    core::WaveshapingStage whole;
+    core::WaveshapingStage blocks;
+    for (auto* stage : {&whole, &blocks}) {
+        stage->prepare(sample_rate, 2, 256);
+        ASSERT_TRUE(stage->setOversampling(4));
+        stage->setCurve(core::TransferCurve::ASYMMETRIC, 0.3f);
+    }
+
+    std::vector<float> expected(input.data(), input.data() + input.size());
+    std::vector<float> actual = expected;
+    whole.process(actual.data(), frames, 2.0f, 0.7f);
+    for (size_t offset = 0; offset < frames; offset += 256) {
+        blocks.process(expected.data() + 2 * offset, std::min<size_t>(256, frames - offset), 2.0f, 0.7f);
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FLOAT_EQ(actual[i], expected[i]) << i;
+    }
+}
+
+// 测试处理期间切换传递函数：新表构建完成后才发布，音频线程读到的总是完整的表
+TEST(WaveshaperTest, CurveSwapWhileProcessing) {
+    const int sample_rate = 48000;
+    core::WaveshapingStage stage;
+    stage.prepare(sample_rate, 1, 512);
+
+    std::atomic<bool> done(false);
+    std::thread editor([&stage, &done] {
+        for (int i = 0; !done.load(std::memory_order_relaxed); ++i) {
+            stage.setCurve(i % 2 == 0 ? core::TransferCurve::HARD_CLIP : core::TransferCurve::TANH,
+                           static_cast<float>(i % 5) / 4.0f);
+        }
+    });
+
+    const core::AudioBuffer input = makeSine(440.0, 4.0, 512, sample_rate);
+    std::vector<float> block(input.size());
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        std::copy(input.data(), input.data() + input.size(), block.begin());
+        stage.process(block.data(), block.size(), 1.0f, 1.0f);
+        for (float sample : block) {
+            ASSERT_TRUE(std::isfinite(sample));
+            ASSERT_LE(std::fabs(sample), 1.5f);
+        }
+    }
+    done.store(true, std::memory_order_relaxed);
+    editor.join();
+}